@@ -0,0 +1,499 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+// Batch front end for the import, patch and export pipelines. Loads one MVR
+// or project file, optionally imports a rider and auto patches the result,
+// then writes the requested exports without opening a window. Every stage
+// is timed and the run ends with a JSON report including the peak RSS, so
+// the same binary serves nightly batch jobs and profiling.
+//
+// Usage: perastage-cli [--rider rider.txt|pdf] [--autopatch|--autopatch-packed]
+//                      [--lock-patched] [--position-universe NAME=UNIVERSE]...
+//                      [--export-mvr out.mvr] [--export-csv dir]
+//                      [--export-pdf layouts.pdf] [--report report.json]
+//                      scene.mvr|project.pstg
+//
+// --lock-patched keeps the address of every fixture that already has one and
+// patches only the rest. --position-universe makes the packed auto patch try
+// UNIVERSE first for fixtures hung on position NAME; it can be repeated.
+//
+// One input is processed per run so the peak RSS belongs to that file. The
+// report goes to stdout unless --report is given; the exit code is non-zero
+// when any stage fails.
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <wx/init.h>
+
+#include "autopatcher.h"
+#include "configmanager.h"
+#include "gdtfloader.h"
+#include "json.hpp"
+#include "LayoutManager.h"
+#include "matrixutils.h"
+#include "mvrexporter.h"
+#include "mvrimporter.h"
+#include "projectutils.h"
+#include "riderimporter.h"
+#include "scenetableformat.h"
+#include "Viewer2DPrintSettings.h"
+#include "viewer2dheadlessrenderer.h"
+#include "viewer2dpdfexporter.h"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+std::optional<std::size_t> ReadStatusFieldKb(const std::string &key) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind(key, 0) == 0) {
+      std::istringstream ss(line.substr(key.size()));
+      std::size_t value = 0;
+      ss >> value;
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+std::size_t ReadPeakRssKb() {
+  return ReadStatusFieldKb("VmHWM:\t").value_or(0);
+}
+
+// Creates the directory an output file goes into, so a batch job can point
+// every run at a fresh folder.
+void EnsureParentDirectory(const std::string &path) {
+  const fs::path parent = fs::path(path).parent_path();
+  if (!parent.empty()) {
+    std::error_code ec;
+    fs::create_directories(parent, ec);
+  }
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start,
+                 std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+struct Options {
+  std::string input;
+  std::string riderPath;
+  std::optional<AutoPatcher::AutoPatchMode> autoPatch;
+  bool lockPatched = false;
+  std::map<std::string, int> positionUniverses;
+  std::string mvrOutput;
+  std::string csvDir;
+  std::string pdfOutput;
+  std::string reportPath;
+};
+
+// Runs one stage and appends its timing to `stages`. The stage fills
+// `detail` with whatever it wants to report and returns false on failure.
+bool RunStage(json &stages, const std::string &name,
+              const std::function<bool(json &detail)> &stage) {
+  json detail = json::object();
+  const auto start = std::chrono::steady_clock::now();
+  const bool ok = stage(detail);
+  const double ms = ElapsedMs(start, std::chrono::steady_clock::now());
+  json entry = {{"stage", name},
+                {"ok", ok},
+                {"ms", ms},
+                {"peakRssKb", ReadPeakRssKb()}};
+  if (!detail.empty())
+    entry["detail"] = std::move(detail);
+  stages.push_back(std::move(entry));
+  if (!ok)
+    std::cerr << name << " failed" << std::endl;
+  return ok;
+}
+
+bool LoadInput(const std::string &path, json &detail) {
+  ConfigManager &cfg = ConfigManager::Get();
+  std::string ext = fs::path(path).extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  bool ok = false;
+  if (ext == ProjectUtils::PROJECT_EXTENSION) {
+    ok = cfg.LoadProject(path);
+  } else {
+    cfg.Reset();
+    ok = MvrImporter::ImportAndRegister(path, false);
+  }
+  const MvrScene &scene = std::as_const(cfg).GetScene();
+  detail = {{"fixtures", scene.fixtures.size()},
+            {"trusses", scene.trusses.size()},
+            {"supports", scene.supports.size()},
+            {"sceneObjects", scene.sceneObjects.size()}};
+  return ok;
+}
+
+bool RunAutoPatch(const Options &cliOptions, json &detail) {
+  MvrScene &scene = ConfigManager::Get().GetScene();
+  AutoPatcher::AutoPatchOptions options;
+  options.mode = *cliOptions.autoPatch;
+  options.positionUniverses = cliOptions.positionUniverses;
+  if (cliOptions.lockPatched) {
+    for (const auto &[uuid, fixture] : scene.fixtures)
+      if (!fixture.address.empty())
+        options.lockedUuids.insert(uuid);
+  }
+  const AutoPatcher::AutoPatchReport report =
+      AutoPatcher::AutoPatch(scene, options);
+  detail = {{"patched", report.patched},
+            {"locked", report.locked},
+            {"skipped", report.skipped},
+            {"unplaced", report.unplaced},
+            {"universes", report.universes.size()},
+            {"utilization", report.Utilization()}};
+  return true;
+}
+
+std::string LayerCell(const std::string &layer) {
+  return layer == DEFAULT_LAYER_NAME ? std::string() : layer;
+}
+
+std::string ResolveScenePath(const std::string &base, const std::string &ref) {
+  if (ref.empty())
+    return {};
+  return (base.empty() ? fs::path(ref) : fs::path(base) / ref).string();
+}
+
+// Writes the fixture and truss tables with the columns and cell text of the
+// tables in the main window, sorted so nightly outputs can be diffed.
+bool ExportCsvTables(const fs::path &dir, json &detail) {
+  std::error_code ec;
+  fs::create_directories(dir, ec);
+  const MvrScene &scene = std::as_const(ConfigManager::Get()).GetScene();
+
+  std::vector<const Fixture *> fixtures;
+  fixtures.reserve(scene.fixtures.size());
+  for (const auto &[uuid, fixture] : scene.fixtures)
+    fixtures.push_back(&fixture);
+  std::sort(fixtures.begin(), fixtures.end(),
+            [](const Fixture *a, const Fixture *b) {
+              if (a->fixtureId != b->fixtureId)
+                return a->fixtureId < b->fixtureId;
+              if (a->instanceName != b->instanceName)
+                return a->instanceName < b->instanceName;
+              return a->uuid < b->uuid;
+            });
+
+  std::ofstream fixtureFile(dir / "fixtures.csv");
+  if (!fixtureFile)
+    return false;
+  SceneTableFormat::WriteCsvRow(fixtureFile,
+                                SceneTableFormat::FixtureColumns());
+  for (const Fixture *f : fixtures) {
+    // Same parsing as the table: "universe.channel", zero when missing.
+    const size_t dot = f->address.find('.');
+    const long universe =
+        std::strtol(f->address.substr(0, dot).c_str(), nullptr, 10);
+    long channel = 0;
+    if (dot != std::string::npos)
+      channel = std::strtol(f->address.c_str() + dot + 1, nullptr, 10);
+    const std::string gdtfPath = ResolveScenePath(scene.basePath, f->gdtfSpec);
+    const int channelCount = GetGdtfModeChannelCount(gdtfPath, f->gdtfMode);
+    const std::string type = !f->typeName.empty()
+                                 ? f->typeName
+                                 : fs::path(gdtfPath).stem().string();
+    const auto euler = MatrixUtils::MatrixToEuler(f->transform);
+    SceneTableFormat::WriteCsvRow(
+        fixtureFile,
+        {std::to_string(f->fixtureId), f->instanceName, type,
+         LayerCell(f->layer), f->positionName, std::to_string(universe),
+         std::to_string(channel), f->gdtfMode,
+         channelCount >= 0 ? std::to_string(channelCount) : std::string(),
+         fs::path(gdtfPath).filename().string(),
+         SceneTableFormat::Position(f->transform.o[0]),
+         SceneTableFormat::Position(f->transform.o[1]),
+         SceneTableFormat::Position(f->transform.o[2]),
+         SceneTableFormat::Angle(euler[2]), SceneTableFormat::Angle(euler[1]),
+         SceneTableFormat::Angle(euler[0]),
+         SceneTableFormat::Decimal(f->powerConsumptionW, 1),
+         SceneTableFormat::Decimal(f->weightKg, 2), f->color});
+  }
+
+  std::vector<const Truss *> trusses;
+  trusses.reserve(scene.trusses.size());
+  for (const auto &[uuid, truss] : scene.trusses)
+    trusses.push_back(&truss);
+  std::sort(trusses.begin(), trusses.end(),
+            [](const Truss *a, const Truss *b) {
+              if (a->name != b->name)
+                return a->name < b->name;
+              return a->uuid < b->uuid;
+            });
+
+  std::ofstream trussFile(dir / "trusses.csv");
+  if (!trussFile)
+    return false;
+  SceneTableFormat::WriteCsvRow(trussFile, SceneTableFormat::TrussColumns());
+  for (const Truss *t : trusses) {
+    const std::string &model =
+        !t->modelFile.empty() ? t->modelFile : t->symbolFile;
+    const auto euler = MatrixUtils::MatrixToEuler(t->transform);
+    SceneTableFormat::WriteCsvRow(
+        trussFile,
+        {t->name, LayerCell(t->layer), fs::path(model).filename().string(),
+         t->positionName, SceneTableFormat::Position(t->transform.o[0]),
+         SceneTableFormat::Position(t->transform.o[1]),
+         SceneTableFormat::Position(t->transform.o[2]),
+         SceneTableFormat::Angle(euler[2]), SceneTableFormat::Angle(euler[1]),
+         SceneTableFormat::Angle(euler[0]), t->manufacturer, t->model,
+         SceneTableFormat::Metres(t->lengthMm),
+         SceneTableFormat::OptionalMetres(t->widthMm),
+         SceneTableFormat::OptionalMetres(t->heightMm),
+         SceneTableFormat::Decimal(t->weightKg, 2)});
+  }
+
+  detail = {{"fixtureRows", fixtures.size()}, {"trussRows", trusses.size()}};
+  return static_cast<bool>(fixtureFile) && static_cast<bool>(trussFile);
+}
+
+layouts::Layout2DViewFrame ScaleFrame(layouts::Layout2DViewFrame frame,
+                                      double scaleX, double scaleY) {
+  frame.x = static_cast<int>(std::lround(frame.x * scaleX));
+  frame.y = static_cast<int>(std::lround(frame.y * scaleY));
+  frame.width = static_cast<int>(std::lround(frame.width * scaleX));
+  frame.height = static_cast<int>(std::lround(frame.height * scaleY));
+  return frame;
+}
+
+// Same page setup as "Print All Layouts" in the main window, with the 2D
+// views recorded by the headless renderer. Legends and text boxes are laid
+// out with GUI fonts and are left out; views carry no fixture labels.
+bool ExportLayoutPdf(const fs::path &path, json &detail) {
+  ConfigManager &cfg = ConfigManager::Get();
+  const auto &layoutsToPrint = layouts::LayoutManager::Get().GetLayouts().Items();
+  if (layoutsToPrint.empty())
+    return false;
+  const print::Viewer2DPrintSettings settings =
+      print::Viewer2DPrintSettings::LoadFromConfig(cfg);
+  const bool useSimplifiedFootprints = !settings.detailedFootprints;
+
+  Viewer2DHeadlessRenderer renderer;
+  std::vector<LayoutPageExportData> pages;
+  pages.reserve(layoutsToPrint.size());
+  size_t viewCount = 0;
+  double captureMs = 0.0;
+  for (const auto &layout : layoutsToPrint) {
+    print::PageSetup outputSetup = settings;
+    outputSetup.landscape = layout.pageSetup.landscape;
+    const double layoutPageW = layout.pageSetup.PageWidthPt();
+    const double layoutPageH = layout.pageSetup.PageHeightPt();
+    LayoutPageExportData page;
+    page.pageWidthPt = outputSetup.PageWidthPt();
+    page.pageHeightPt = outputSetup.PageHeightPt();
+    const double scaleX =
+        layoutPageW > 0.0 ? page.pageWidthPt / layoutPageW : 1.0;
+    const double scaleY =
+        layoutPageH > 0.0 ? page.pageHeightPt / layoutPageH : 1.0;
+
+    for (const auto &table : layout.eventTables) {
+      LayoutEventTableExportData tableData;
+      tableData.fields = table.fields;
+      tableData.zIndex = table.zIndex;
+      tableData.frame = ScaleFrame(table.frame, scaleX, scaleY);
+      page.tables.push_back(std::move(tableData));
+    }
+
+    for (const auto &view : layout.view2dViews) {
+      viewer2d::Viewer2DState state;
+      state.camera = view.camera;
+      state.renderOptions = view.renderOptions;
+      state.layers = view.layers;
+      state.renderOptions.darkMode = false;
+      if (state.camera.viewportWidth <= 0)
+        state.camera.viewportWidth =
+            view.frame.width > 0 ? view.frame.width : 1600;
+      if (state.camera.viewportHeight <= 0)
+        state.camera.viewportHeight =
+            view.frame.height > 0 ? view.frame.height : 900;
+
+      const auto start = std::chrono::steady_clock::now();
+      LayoutViewExportData data;
+      data.viewState = renderer.Capture(state, data.buffer,
+                                        useSimplifiedFootprints,
+                                        settings.includeGrid);
+      captureMs += ElapsedMs(start, std::chrono::steady_clock::now());
+      data.frame = ScaleFrame(view.frame, scaleX, scaleY);
+      data.zIndex = view.zIndex;
+      data.symbolSnapshot = renderer.GetBottomSymbolCacheSnapshot();
+      page.views.push_back(std::move(data));
+      ++viewCount;
+    }
+    pages.push_back(std::move(page));
+  }
+
+  Viewer2DPrintOptions opts;
+  opts.pageWidthPt = pages.front().pageWidthPt;
+  opts.pageHeightPt = pages.front().pageHeightPt;
+  opts.marginPt = 0.0;
+  opts.landscape = layoutsToPrint.front().pageSetup.landscape;
+  opts.printIncludeGrid = settings.includeGrid;
+  opts.useSimplifiedFootprints = useSimplifiedFootprints;
+  const Viewer2DExportResult result = ExportLayoutsToPdf(pages, opts, path);
+  detail = {{"pages", pages.size()},
+            {"views", viewCount},
+            {"captureMs", captureMs}};
+  if (!result.success)
+    detail["error"] = result.message;
+  return result.success;
+}
+
+// Parses NAME=UNIVERSE into `out`. The name may itself contain '=', so the
+// universe is taken after the last one.
+bool ParsePositionUniverse(const std::string &arg,
+                           std::map<std::string, int> &out) {
+  const size_t eq = arg.rfind('=');
+  if (eq == std::string::npos || eq == 0)
+    return false;
+  int universe = 0;
+  const char *first = arg.data() + eq + 1;
+  const char *last = arg.data() + arg.size();
+  const auto [end, ec] = std::from_chars(first, last, universe);
+  if (ec != std::errc() || end != last || universe < 1)
+    return false;
+  out[arg.substr(0, eq)] = universe;
+  return true;
+}
+
+void PrintUsage() {
+  std::cerr << "Usage: perastage-cli [--rider rider.txt|pdf] "
+               "[--autopatch|--autopatch-packed]\n"
+               "                     [--lock-patched] "
+               "[--position-universe NAME=UNIVERSE]...\n"
+               "                     [--export-mvr out.mvr] "
+               "[--export-csv dir]\n"
+               "                     [--export-pdf layouts.pdf] "
+               "[--report report.json]\n"
+               "                     scene.mvr|project.pstg"
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  wxInitializer initializer;
+  if (!initializer.IsOk()) {
+    std::cerr << "wxWidgets failed to initialize" << std::endl;
+    return 1;
+  }
+
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--rider" && i + 1 < argc)
+      options.riderPath = argv[++i];
+    else if (arg == "--autopatch")
+      options.autoPatch = AutoPatcher::AutoPatchMode::Sequential;
+    else if (arg == "--autopatch-packed")
+      options.autoPatch = AutoPatcher::AutoPatchMode::Packed;
+    else if (arg == "--lock-patched")
+      options.lockPatched = true;
+    else if (arg == "--position-universe" && i + 1 < argc &&
+             ParsePositionUniverse(argv[i + 1], options.positionUniverses))
+      ++i;
+    else if (arg == "--export-mvr" && i + 1 < argc)
+      options.mvrOutput = argv[++i];
+    else if (arg == "--export-csv" && i + 1 < argc)
+      options.csvDir = argv[++i];
+    else if (arg == "--export-pdf" && i + 1 < argc)
+      options.pdfOutput = argv[++i];
+    else if (arg == "--report" && i + 1 < argc)
+      options.reportPath = argv[++i];
+    else if (options.input.empty() && arg.rfind("--", 0) != 0)
+      options.input = arg;
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+  if (options.input.empty()) {
+    PrintUsage();
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  json stages = json::array();
+  // Later stages only make sense on a loaded scene; exports still run after
+  // a failed patch or rider import so one bad step does not hide the others.
+  bool ok = RunStage(stages, "load", [&](json &detail) {
+    return LoadInput(options.input, detail);
+  });
+  if (ok && !options.riderPath.empty())
+    ok &= RunStage(stages, "rider", [&](json &detail) {
+      const bool imported = RiderImporter::Import(options.riderPath);
+      detail = {{"fixtures", std::as_const(ConfigManager::Get()).GetScene().fixtures.size()}};
+      return imported;
+    });
+  if (stages.front()["ok"].get<bool>()) {
+    if (options.autoPatch)
+      ok &= RunStage(stages, "autopatch", [&](json &detail) {
+        return RunAutoPatch(options, detail);
+      });
+    if (!options.mvrOutput.empty())
+      ok &= RunStage(stages, "export-mvr", [&](json &) {
+        EnsureParentDirectory(options.mvrOutput);
+        MvrExporter exporter;
+        return exporter.ExportToFile(options.mvrOutput);
+      });
+    if (!options.csvDir.empty())
+      ok &= RunStage(stages, "export-csv", [&](json &detail) {
+        return ExportCsvTables(options.csvDir, detail);
+      });
+    if (!options.pdfOutput.empty())
+      ok &= RunStage(stages, "export-pdf", [&](json &detail) {
+        EnsureParentDirectory(options.pdfOutput);
+        return ExportLayoutPdf(options.pdfOutput, detail);
+      });
+  }
+
+  json report = {{"input", options.input},
+                 {"ok", ok},
+                 {"stages", std::move(stages)},
+                 {"totalMs", ElapsedMs(start, std::chrono::steady_clock::now())},
+                 {"peakRssKb", ReadPeakRssKb()}};
+  if (options.reportPath.empty()) {
+    std::cout << report.dump(2) << std::endl;
+  } else {
+    EnsureParentDirectory(options.reportPath);
+    std::ofstream out(options.reportPath);
+    out << report.dump(2) << std::endl;
+    if (!out) {
+      std::cerr << "Failed to write " << options.reportPath << std::endl;
+      return 1;
+    }
+  }
+  return ok ? 0 : 1;
+}
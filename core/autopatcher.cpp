@@ -17,44 +17,336 @@
  */
 #include "autopatcher.h"
 #include "gdtfloader.h"
-#include "patchmanager.h"
+#include "workerpool.h"
 #include <algorithm>
+#include <bitset>
+#include <cstdlib>
 #include <filesystem>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace fs = std::filesystem;
 
 namespace AutoPatcher {
 
-void AutoPatch(MvrScene &scene, int startUniverse, int startChannel) {
-  struct FixtureInfo {
-    std::string uuid;
-    int channels;
-    float x;
-    float y;
-    std::string type;
-    std::string hang;
-  };
+namespace {
 
-  std::vector<FixtureInfo> fixtures;
-  fixtures.reserve(scene.fixtures.size());
+constexpr int kUniverseSize = 512;
+
+struct FixtureInfo {
+  Fixture *fixture;
+  int channels;
+  float x;
+  float y;
+  std::string type;
+  std::string hang;
+};
+
+struct Group {
+  std::vector<size_t> indices;
+  int total = 0;
+};
+
+// Channels taken in one universe. largestFree lets the packer skip full
+// universes without scanning them.
+struct UniverseSlots {
+  std::bitset<kUniverseSize> used;
+  int largestFree = kUniverseSize;
+  int usedChannels = 0;
+  int lockedChannels = 0;
+
+  // First taken channel in [channel, channel + count), or 0 if all are free.
+  int FirstUsed(int channel, int count) const {
+    for (int c = channel; c < channel + count && c <= kUniverseSize; ++c) {
+      if (used[c - 1])
+        return c;
+    }
+    return 0;
+  }
+
+  // First channel of a free block of `count` channels, or 0.
+  int FindFree(int count) const {
+    if (count > largestFree)
+      return 0;
+    int run = 0;
+    for (int c = 1; c <= kUniverseSize; ++c) {
+      run = used[c - 1] ? 0 : run + 1;
+      if (run == count)
+        return c - count + 1;
+    }
+    return 0;
+  }
+
+  void Occupy(int channel, int count) {
+    for (int c = channel; c < channel + count && c <= kUniverseSize; ++c) {
+      if (!used[c - 1]) {
+        used.set(c - 1);
+        ++usedChannels;
+      }
+    }
+    largestFree = 0;
+    int run = 0;
+    for (int c = 0; c < kUniverseSize; ++c) {
+      run = used[c] ? 0 : run + 1;
+      largestFree = std::max(largestFree, run);
+    }
+  }
+};
+
+class UniverseTable {
+public:
+  UniverseSlots &At(int universe) {
+    if (static_cast<size_t>(universe) >= slots_.size())
+      slots_.resize(static_cast<size_t>(universe) + 1);
+    return slots_[universe];
+  }
+
+  std::vector<UniverseUsage> Usage() const {
+    std::vector<UniverseUsage> usage;
+    for (size_t u = 1; u < slots_.size(); ++u) {
+      if (slots_[u].usedChannels > 0)
+        usage.push_back({static_cast<int>(u), slots_[u].usedChannels,
+                         slots_[u].lockedChannels});
+    }
+    return usage;
+  }
+
+private:
+  std::vector<UniverseSlots> slots_;
+};
+
+bool ParseAddress(const std::string &address, int &universe, int &channel) {
+  const size_t dot = address.find('.');
+  if (dot == std::string::npos)
+    return false;
+  char *end = nullptr;
+  const long u = std::strtol(address.c_str(), &end, 10);
+  if (end != address.c_str() + dot)
+    return false;
+  const char *chStart = address.c_str() + dot + 1;
+  const long c = std::strtol(chStart, &end, 10);
+  if (end == chStart || *end != '\0')
+    return false;
+  if (u < 1 || c < 1 || c > kUniverseSize)
+    return false;
+  universe = static_cast<int>(u);
+  channel = static_cast<int>(c);
+  return true;
+}
 
-  for (auto &pair : scene.fixtures) {
-    auto &f = pair.second;
+std::string FormatAddress(int universe, int channel) {
+  return std::to_string(universe) + "." + std::to_string(channel);
+}
+
+// Resolves the channel count of every fixture. A festival patch uses few
+// distinct GDTF files and modes, so each pair is looked up once and the
+// lookups run on the worker pool.
+std::vector<int> ResolveChannelCounts(const MvrScene &scene,
+                                      const std::vector<Fixture *> &fixtures) {
+  std::vector<std::pair<std::string, std::string>> keys;
+  std::unordered_map<std::string, size_t> keyIndex;
+  std::vector<size_t> fixtureKeys;
+  fixtureKeys.reserve(fixtures.size());
+  for (const Fixture *f : fixtures) {
     std::string fullPath;
-    if (!f.gdtfSpec.empty()) {
+    if (!f->gdtfSpec.empty()) {
       fs::path p = scene.basePath.empty()
-                       ? fs::path(f.gdtfSpec)
-                       : fs::path(scene.basePath) / f.gdtfSpec;
+                       ? fs::path(f->gdtfSpec)
+                       : fs::path(scene.basePath) / f->gdtfSpec;
       fullPath = p.string();
     }
-    int chCount = GetGdtfModeChannelCount(fullPath, f.gdtfMode);
-    if (chCount <= 0)
+    std::string key = fullPath + '\n' + f->gdtfMode;
+    auto [it, inserted] = keyIndex.emplace(std::move(key), keys.size());
+    if (inserted)
+      keys.emplace_back(std::move(fullPath), f->gdtfMode);
+    fixtureKeys.push_back(it->second);
+  }
+
+  std::vector<int> keyCounts(keys.size(), -1);
+  ParallelFor(keys.size(), [&](size_t i) {
+    keyCounts[i] = GetGdtfModeChannelCount(keys[i].first, keys[i].second);
+  });
+
+  std::vector<int> counts;
+  counts.reserve(fixtures.size());
+  for (size_t k : fixtureKeys)
+    counts.push_back(keyCounts[k]);
+  return counts;
+}
+
+void AssignRun(const std::vector<FixtureInfo> &fixtures,
+               const std::vector<size_t> &indices, int universe, int channel,
+               UniverseTable &table) {
+  UniverseSlots &slots = table.At(universe);
+  for (size_t idx : indices) {
+    const auto &f = fixtures[idx];
+    f.fixture->address = FormatAddress(universe, channel);
+    slots.Occupy(channel, f.channels);
+    channel += f.channels;
+  }
+}
+
+// Moves (universe, channel) forward until `channels` free channels follow it
+// in one universe, skipping locked fixtures in the way.
+void SkipToFree(UniverseTable &table, int channels, int &uni, int &ch) {
+  for (;;) {
+    if (ch + channels - 1 > kUniverseSize) {
+      ++uni;
+      ch = 1;
+      continue;
+    }
+    const int blocked = table.At(uni).FirstUsed(ch, channels);
+    if (blocked == 0)
+      return;
+    ch = blocked + 1;
+  }
+}
+
+// Patches the fixtures one after another from the cursor on, wrapping to the
+// next universe when a fixture does not fit.
+void Flow(const std::vector<FixtureInfo> &fixtures,
+          const std::vector<size_t> &indices, UniverseTable &table, int &uni,
+          int &ch, AutoPatchReport &report) {
+  for (size_t idx : indices) {
+    const auto &f = fixtures[idx];
+    if (f.channels > kUniverseSize) {
+      ++report.unplaced;
+      continue;
+    }
+    SkipToFree(table, f.channels, uni, ch);
+
+    f.fixture->address = FormatAddress(uni, ch);
+    table.At(uni).Occupy(ch, f.channels);
+    ++report.patched;
+
+    ch += f.channels;
+    if (ch > kUniverseSize) {
+      ++uni;
+      ch = 1;
+    }
+  }
+}
+
+void PatchSequential(const std::vector<FixtureInfo> &fixtures,
+                     const std::vector<Group> &groups,
+                     const AutoPatchOptions &options, UniverseTable &table,
+                     AutoPatchReport &report) {
+  int uni = options.startUniverse < 1 ? 1 : options.startUniverse;
+  int ch = options.startChannel < 1 ? 1 : options.startChannel;
+
+  for (const auto &g : groups) {
+    if (g.total <= kUniverseSize && ch + g.total - 1 > kUniverseSize) {
+      ++uni;
+      ch = 1;
+    }
+    Flow(fixtures, g.indices, table, uni, ch, report);
+  }
+}
+
+void PatchPacked(const std::vector<FixtureInfo> &fixtures,
+                 const std::vector<Group> &groups,
+                 const AutoPatchOptions &options, UniverseTable &table,
+                 AutoPatchReport &report) {
+  const int firstUniverse =
+      options.startUniverse < 1 ? 1 : options.startUniverse;
+
+  // Groups larger than a universe are split anyway. They flow through
+  // universes of their own, in front-to-back order, like the sequential
+  // patch does, so only the last universe of the flow has room left.
+  std::vector<const Group *> small;
+  small.reserve(groups.size());
+  int uni = firstUniverse;
+  int ch = 1;
+  for (const auto &g : groups) {
+    if (g.total <= kUniverseSize) {
+      small.push_back(&g);
+      continue;
+    }
+    Flow(fixtures, g.indices, table, uni, ch, report);
+  }
+
+  // The remaining groups are packed first fit decreasing: each takes the
+  // first universe with a free block large enough for the whole group.
+  // Equal sizes keep the front-to-back order.
+  std::stable_sort(small.begin(), small.end(),
+                   [](const Group *a, const Group *b) {
+                     return a->total > b->total;
+                   });
+
+  for (const Group *g : small) {
+    int universe = 0;
+    int channel = 0;
+    auto pref =
+        options.positionUniverses.find(fixtures[g->indices.front()].hang);
+    if (pref != options.positionUniverses.end() && pref->second >= 1) {
+      channel = table.At(pref->second).FindFree(g->total);
+      if (channel > 0)
+        universe = pref->second;
+    }
+    for (int u = firstUniverse; channel == 0; ++u) {
+      channel = table.At(u).FindFree(g->total);
+      if (channel > 0)
+        universe = u;
+    }
+    AssignRun(fixtures, g->indices, universe, channel, table);
+    report.patched += g->indices.size();
+  }
+}
+
+} // namespace
+
+double AutoPatchReport::Utilization() const {
+  if (universes.empty())
+    return 0.0;
+  double used = 0.0;
+  for (const auto &u : universes)
+    used += u.usedChannels;
+  return used / (static_cast<double>(universes.size()) * kUniverseSize);
+}
+
+void AutoPatch(MvrScene &scene, int startUniverse, int startChannel) {
+  AutoPatchOptions options;
+  options.startUniverse = startUniverse;
+  options.startChannel = startChannel;
+  AutoPatch(scene, options);
+}
+
+AutoPatchReport AutoPatch(MvrScene &scene, const AutoPatchOptions &options) {
+  AutoPatchReport report;
+
+  std::vector<Fixture *> sceneFixtures;
+  sceneFixtures.reserve(scene.fixtures.size());
+  for (auto &pair : scene.fixtures)
+    sceneFixtures.push_back(&pair.second);
+  const std::vector<int> channelCounts =
+      ResolveChannelCounts(scene, sceneFixtures);
+
+  UniverseTable table;
+  std::vector<FixtureInfo> fixtures;
+  fixtures.reserve(sceneFixtures.size());
+
+  for (size_t i = 0; i < sceneFixtures.size(); ++i) {
+    Fixture &f = *sceneFixtures[i];
+    int chCount = channelCounts[i];
+    if (chCount <= 0) {
+      ++report.skipped;
       continue; // skip fixtures without a valid channel count
+    }
+    int lockedUniverse = 0;
+    int lockedChannel = 0;
+    if (options.lockedUuids.count(f.uuid) &&
+        ParseAddress(f.address, lockedUniverse, lockedChannel)) {
+      UniverseSlots &slots = table.At(lockedUniverse);
+      const int before = slots.usedChannels;
+      slots.Occupy(lockedChannel, chCount);
+      slots.lockedChannels += slots.usedChannels - before;
+      ++report.locked;
+      continue;
+    }
     auto pos = f.GetPosition();
-    fixtures.push_back(
-        {pair.first, chCount, pos[0], pos[1], f.typeName, f.positionName});
+    fixtures.push_back({&f, chCount, pos[0], pos[1], f.typeName,
+                        f.positionName});
   }
 
   std::sort(fixtures.begin(), fixtures.end(),
@@ -70,14 +362,9 @@ void AutoPatch(MvrScene &scene, int startUniverse, int startChannel) {
               return a.y < b.y;
             });
 
-  struct Group {
-    std::vector<size_t> indices;
-    int total = 0;
-  };
-
   std::vector<Group> groups;
   // Reserve upfront to avoid repeated reallocations when processing large
-  // rigs where fixtures.size() can be in the hundreds.
+  // rigs where fixtures.size() can be in the thousands.
   groups.reserve(fixtures.size());
   for (size_t i = 0; i < fixtures.size(); ++i) {
     const auto &f = fixtures[i];
@@ -95,32 +382,13 @@ void AutoPatch(MvrScene &scene, int startUniverse, int startChannel) {
     }
   }
 
-  int uni = startUniverse < 1 ? 1 : startUniverse;
-  int ch = startChannel < 1 ? 1 : startChannel;
-
-  for (const auto &g : groups) {
-    if (g.total <= 512 && ch + g.total - 1 > 512) {
-      ++uni;
-      ch = 1;
-    }
-
-    for (size_t idx : g.indices) {
-      const auto &f = fixtures[idx];
-      if (ch + f.channels - 1 > 512) {
-        ++uni;
-        ch = 1;
-      }
-
-      scene.fixtures[f.uuid].address =
-          std::to_string(uni) + "." + std::to_string(ch);
+  if (options.mode == AutoPatchMode::Packed)
+    PatchPacked(fixtures, groups, options, table, report);
+  else
+    PatchSequential(fixtures, groups, options, table, report);
 
-      ch += f.channels;
-      if (ch > 512) {
-        ++uni;
-        ch = 1;
-      }
-    }
-  }
+  report.universes = table.Usage();
+  return report;
 }
 
 } // namespace AutoPatcher
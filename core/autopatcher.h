@@ -19,7 +19,52 @@
 
 #include "mvrscene.h"
 
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 namespace AutoPatcher {
+
+enum class AutoPatchMode {
+  // Patch groups one after another, as AutoPatch(scene, universe, channel).
+  Sequential,
+  // Pack groups into as few universes as possible: each group takes the
+  // first universe with a free block large enough, largest groups first.
+  // Groups larger than a universe flow through universes of their own.
+  Packed,
+};
+
+struct AutoPatchOptions {
+  AutoPatchMode mode = AutoPatchMode::Sequential;
+  int startUniverse = 1;
+  int startChannel = 1; // only used by Sequential
+  // Fixtures whose current address is kept. Their channels are reserved so
+  // no other fixture is patched on top of them.
+  std::set<std::string> lockedUuids;
+  // Universe tried first for groups hung on the given position name (Packed
+  // only). Groups fall back to the first universe that fits.
+  std::map<std::string, int> positionUniverses;
+};
+
+struct UniverseUsage {
+  int universe = 0;
+  int usedChannels = 0;   // including locked fixtures
+  int lockedChannels = 0;
+};
+
+struct AutoPatchReport {
+  size_t patched = 0;
+  size_t locked = 0;
+  size_t skipped = 0;  // no channel count could be resolved
+  size_t unplaced = 0; // needs more than 512 channels
+  std::vector<UniverseUsage> universes; // ascending, only used universes
+
+  // Used channels over the capacity of the used universes, in [0, 1].
+  double Utilization() const;
+};
+
 // Automatically assign DMX addresses to fixtures in the scene.
 // Fixtures are grouped by hang position and type to keep identical fixtures
 // together. Groups are patched sequentially starting at the given universe and
@@ -27,4 +72,8 @@ namespace AutoPatcher {
 // split. The order is front-to-back (Y axis), then by hang position, then by
 // type, and finally left-to-right (X axis).
 void AutoPatch(MvrScene &scene, int startUniverse = 1, int startChannel = 1);
+
+// Same grouping and ordering as above with the mode and constraints taken
+// from `options`. Channel counts are resolved once per GDTF file and mode.
+AutoPatchReport AutoPatch(MvrScene &scene, const AutoPatchOptions &options);
 } // namespace AutoPatcher
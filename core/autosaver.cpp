@@ -0,0 +1,79 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "autosaver.h"
+
+#include "workerpool.h"
+
+#include <utility>
+
+Autosaver::Autosaver(WorkerPool &pool, PostFn post)
+    : pool(pool), post(std::move(post)) {}
+
+Autosaver::~Autosaver() { state->alive = false; }
+
+void Autosaver::SetInterval(Clock::duration value) { interval = value; }
+
+void Autosaver::SetOnFinished(FinishedFn onFinished) {
+  state->onFinished = std::move(onFinished);
+}
+
+bool Autosaver::IsSaving() const { return state->saving; }
+
+size_t Autosaver::SavedRevision() const { return state->savedRevision; }
+
+bool Autosaver::Tick(size_t revision, bool dirty, Clock::time_point now,
+                     const PrepareFn &prepare) {
+  // A clean project is already on disk up to this revision; this also
+  // follows revisions that restart after loading a project.
+  if (!dirty) {
+    if (!state->saving)
+      state->savedRevision = revision;
+    return false;
+  }
+  if (interval <= Clock::duration::zero() || state->saving ||
+      revision == state->savedRevision)
+    return false;
+  if (started && now - lastStart < interval)
+    return false;
+
+  std::function<bool()> work = prepare ? prepare() : nullptr;
+  if (!work)
+    return false;
+
+  started = true;
+  lastStart = now;
+  state->saving = true;
+  pool.Submit([work = std::move(work), state = state, post = post,
+               revision]() mutable {
+    const bool ok = work();
+    // The work may hold the snapshot; hand it back so it is released on
+    // the UI thread, where references into the scene are taken.
+    post([work = std::move(work), state = std::move(state), ok,
+          revision]() mutable {
+      work = nullptr;
+      if (!state->alive)
+        return;
+      state->saving = false;
+      if (ok)
+        state->savedRevision = revision;
+      if (state->onFinished)
+        state->onFinished(ok, revision);
+    });
+  });
+  return true;
+}
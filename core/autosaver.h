@@ -0,0 +1,77 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+class WorkerPool;
+
+// Decides when to autosave and writes the save on a worker thread. Tick()
+// is called from the UI thread on a timer; a save starts when the project
+// has unsaved changes the last autosave did not cover, no save is running
+// and the interval has passed since the previous one started. The UI
+// thread only prepares the save, e.g. takes a copy-on-write snapshot, so
+// large rigs are written without blocking it.
+class Autosaver {
+public:
+  using Clock = std::chrono::steady_clock;
+  // Runs on the UI thread and returns the work for the worker, which
+  // reports whether the save succeeded.
+  using PrepareFn = std::function<std::function<bool()>()>;
+  // Runs a function on the UI thread, e.g. through wxApp::CallAfter.
+  using PostFn = std::function<void(std::function<void()>)>;
+  using FinishedFn = std::function<void(bool ok, size_t revision)>;
+
+  Autosaver(WorkerPool &pool, PostFn post);
+  // Results of a save still running are dropped.
+  ~Autosaver();
+
+  Autosaver(const Autosaver &) = delete;
+  Autosaver &operator=(const Autosaver &) = delete;
+
+  // Zero or less turns autosave off.
+  void SetInterval(Clock::duration interval);
+  // Called on the UI thread when a save finished.
+  void SetOnFinished(FinishedFn onFinished);
+
+  // Returns true when a save was started.
+  bool Tick(size_t revision, bool dirty, Clock::time_point now,
+            const PrepareFn &prepare);
+
+  bool IsSaving() const;
+  // Revision the last successful autosave or manual save wrote.
+  size_t SavedRevision() const;
+
+private:
+  struct State {
+    bool alive = true;
+    bool saving = false;
+    size_t savedRevision = 0;
+    FinishedFn onFinished;
+  };
+
+  WorkerPool &pool;
+  PostFn post;
+  std::shared_ptr<State> state = std::make_shared<State>();
+  Clock::duration interval = std::chrono::seconds(60);
+  bool started = false;
+  Clock::time_point lastStart;
+};
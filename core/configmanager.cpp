@@ -27,6 +27,7 @@
 #include <string_view>
 #include <cctype>
 #include <algorithm>
+#include <utility>
 #include <wx/stdpaths.h>
 
 ConfigManager::RevisionGuard::RevisionGuard(ConfigManager &cfg)
@@ -126,6 +127,9 @@ ConfigManager::ConfigManager() {
   RegisterVariable("label_max_fixtures", "float", 250.0f, 0.0f, 5000.0f);
   RegisterVariable("label_max_trusses", "float", 150.0f, 0.0f, 5000.0f);
   RegisterVariable("label_max_objects", "float", 150.0f, 0.0f, 5000.0f);
+  // 0 turns autosave off.
+  RegisterVariable("autosave_interval_seconds", "float", 60.0f, 0.0f,
+                   3600.0f);
   LoadUserConfig();
   if (!HasKey("rider_autopatch"))
     SetValue("rider_autopatch", "1");
@@ -204,6 +208,24 @@ void ConfigManager::SetFloat(const std::string &name, float v) {
 
 void ConfigManager::ApplyDefaults() { preferencesStore.ApplyDefaults(); }
 
+ConfigManager::FloatHandle
+ConfigManager::ResolveFloat(const std::string &name) const {
+  return preferencesStore.ResolveFloat(name);
+}
+
+float ConfigManager::GetFloat(FloatHandle handle) const {
+  return preferencesStore.GetFloat(handle);
+}
+
+std::shared_ptr<const ConfigManager::FloatSnapshot>
+ConfigManager::GetFloatSnapshot() const {
+  return preferencesStore.GetFloatSnapshot();
+}
+
+uint64_t ConfigManager::GetFloatRevision() const {
+  return preferencesStore.GetFloatRevision();
+}
+
 std::vector<std::string> ConfigManager::GetFixturePrintColumns() const {
   return preferencesStore.GetFixturePrintColumns();
 }
@@ -290,6 +312,18 @@ const MvrScene &ConfigManager::GetScene() const {
   return projectSession.GetScene();
 }
 
+SceneChangeJournal &ConfigManager::GetSceneJournal() { return sceneJournal; }
+
+void ConfigManager::NotifySceneChanged(SceneEntityKind kind,
+                                       const std::vector<std::string> &uuids,
+                                       uint32_t components) {
+  if (uuids.empty() || components == 0)
+    return;
+  if (!suppressRevision)
+    projectSession.Touch();
+  sceneJournal.Publish(kind, uuids, components);
+}
+
 const std::vector<std::string> &ConfigManager::GetSelectedFixtures() const {
   return selectionState.GetSelectedFixtures();
 }
@@ -339,18 +373,36 @@ bool ConfigManager::SaveToFile(const std::string &path) const {
 }
 
 bool ConfigManager::SaveProject(const std::string &path) {
+  bool ok = WriteProjectSnapshot(TakeProjectSnapshot(), path);
+  if (ok)
+    projectSession.MarkSaved();
+  return ok;
+}
+
+ConfigManager::ProjectSnapshot ConfigManager::TakeProjectSnapshot() {
   layouts::LayoutManager::Get().SaveToConfig(*this);
-  bool ok = projectSession.SaveProject(
-      path, [this](const std::string &configPath) {
-        return SaveToFile(configPath);
+  ProjectSnapshot snapshot;
+  snapshot.scene = projectSession.Snapshot();
+  snapshot.config = preferencesStore.Serialize();
+  snapshot.revision = projectSession.GetRevision();
+  return snapshot;
+}
+
+bool ConfigManager::WriteProjectSnapshot(const ProjectSnapshot &snapshot,
+                                         const std::string &path) {
+  if (!snapshot.scene)
+    return false;
+  return ProjectSession::SaveProject(
+      path,
+      [&snapshot](const std::string &configPath) {
+        std::ofstream file(configPath, std::ios::binary);
+        file << snapshot.config;
+        return file.good();
       },
-      [](const std::string &scenePath) {
+      [&snapshot](const std::string &scenePath) {
         MvrExporter exporter;
-        return exporter.ExportToFile(scenePath);
+        return exporter.ExportToFile(*snapshot.scene, scenePath);
       });
-  if (ok)
-    projectSession.MarkSaved();
-  return ok;
 }
 
 bool ConfigManager::LoadProject(const std::string &path) {
@@ -378,6 +430,7 @@ bool ConfigManager::LoadProject(const std::string &path) {
     selectionState.Clear();
     projectSession.ResetDirty();
   }
+  sceneJournal.PublishReset();
   return ok;
 }
 
@@ -393,6 +446,7 @@ void ConfigManager::Reset() {
   layerVisibilityState.SetCurrentLayer(DEFAULT_LAYER_NAME);
   ClearHistory();
   projectSession.ResetDirty();
+  sceneJournal.PublishReset();
 }
 
 std::string ConfigManager::GetUserConfigFile() {
@@ -408,7 +462,7 @@ bool ConfigManager::SaveUserConfig() const {
 }
 
 void ConfigManager::PushUndoState(const std::string &description) {
-  historyManager.PushUndoState(projectSession.GetScene(), selectionState,
+  historyManager.PushUndoState(std::as_const(projectSession).GetScene(), selectionState,
                                description);
   projectSession.Touch();
 }
@@ -418,12 +472,22 @@ bool ConfigManager::CanUndo() const { return historyManager.CanUndo(); }
 bool ConfigManager::CanRedo() const { return historyManager.CanRedo(); }
 
 std::string ConfigManager::Undo() {
-  return historyManager.Undo(projectSession.GetScene(), selectionState);
+  if (!historyManager.CanUndo())
+    return {};
+  std::string description =
+      historyManager.Undo(projectSession.GetScene(), selectionState);
+  sceneJournal.PublishReset();
+  return description;
 }
 
 std::string ConfigManager::Redo() {
   projectSession.Touch();
-  return historyManager.Redo(projectSession.GetScene(), selectionState);
+  if (!historyManager.CanRedo())
+    return {};
+  std::string description =
+      historyManager.Redo(projectSession.GetScene(), selectionState);
+  sceneJournal.PublishReset();
+  return description;
 }
 
 void ConfigManager::ClearHistory() { historyManager.ClearHistory(); }
@@ -431,3 +495,7 @@ void ConfigManager::ClearHistory() { historyManager.ClearHistory(); }
 bool ConfigManager::IsDirty() const { return projectSession.IsDirty(); }
 
 void ConfigManager::MarkSaved() { projectSession.MarkSaved(); }
+
+size_t ConfigManager::GetSceneRevision() const {
+  return projectSession.GetRevision();
+}
@@ -17,12 +17,14 @@
  */
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <optional>
 #include <vector>
 #include "configservices.h"
+#include "scenechangejournal.h"
 
 // Singleton to manage configuration and MVR scene data globally
 class ConfigManager
@@ -40,6 +42,19 @@ public:
 
     bool SaveProject(const std::string& path);
     bool LoadProject(const std::string& path);
+
+    // Everything SaveProject writes, taken on the UI thread. The scene is
+    // shared copy-on-write, so taking one costs no scene copy and editing
+    // can go on while it is written.
+    struct ProjectSnapshot {
+        std::shared_ptr<const MvrScene> scene;
+        std::string config;
+        size_t revision = 0;
+    };
+    ProjectSnapshot TakeProjectSnapshot();
+    // Writes a snapshot as a project file. May run on any thread.
+    static bool WriteProjectSnapshot(const ProjectSnapshot& snapshot,
+                                     const std::string& path);
     // Save/load configuration file (e.g., JSON, INI, TXT…)
     bool LoadFromFile(const std::string& path);
     bool SaveToFile(const std::string& path) const;
@@ -52,6 +67,15 @@ public:
     MvrScene& GetScene();
     const MvrScene& GetScene() const;
 
+    // Fine-grained scene change notifications. Code that edits entities in
+    // place reports them through NotifySceneChanged() so tables, summaries
+    // and caches update only those entities; loading, undo and redo publish
+    // a reset.
+    SceneChangeJournal& GetSceneJournal();
+    void NotifySceneChanged(SceneEntityKind kind,
+                            const std::vector<std::string>& uuids,
+                            uint32_t components);
+
     // Current selections for different object types
     const std::vector<std::string>& GetSelectedFixtures() const;
     void SetSelectedFixtures(const std::vector<std::string>& uuids);
@@ -69,6 +93,16 @@ public:
     void SetFloat(const std::string& name, float v);
     void ApplyDefaults();
 
+    // Handles to registered float variables for code that reads them every
+    // frame. Resolve once, then read through GetFloat(handle) on the UI
+    // thread or through a snapshot from any other thread.
+    using FloatHandle = UserPreferencesStore::FloatHandle;
+    using FloatSnapshot = UserPreferencesStore::FloatSnapshot;
+    FloatHandle ResolveFloat(const std::string& name) const;
+    float GetFloat(FloatHandle handle) const;
+    std::shared_ptr<const FloatSnapshot> GetFloatSnapshot() const;
+    uint64_t GetFloatRevision() const;
+
     // Column printing preferences
     std::vector<std::string> GetFixturePrintColumns() const;
     void SetFixturePrintColumns(const std::vector<std::string>& cols);
@@ -109,6 +143,9 @@ public:
     // Track unsaved changes
     bool IsDirty() const;
     void MarkSaved();
+    // Bumped by every undo state and scene notification, so caches built
+    // from the scene can tell whether it may have been edited since.
+    size_t GetSceneRevision() const;
 
 private:
     class RevisionGuard {
@@ -130,6 +167,7 @@ private:
     SelectionState selectionState;
     HistoryManager historyManager;
     LayerVisibilityState layerVisibilityState;
+    SceneChangeJournal sceneJournal;
 
     bool suppressRevision = false;
 };
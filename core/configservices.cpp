@@ -14,6 +14,7 @@
 #include <string_view>
 
 #include <wx/stdpaths.h>
+#include <wx/thread.h>
 #include <wx/wfstream.h>
 class wxZipStreamLink;
 #include <wx/zipstrm.h>
@@ -118,6 +119,9 @@ std::string ToLowerCopy(std::string text) {
 }
 } // namespace
 
+UserPreferencesStore::UserPreferencesStore()
+    : floatSnapshot(std::make_shared<const FloatSnapshot>()) {}
+
 void UserPreferencesStore::SetValue(const std::string &key,
                                     const std::string &value) {
   std::string newValue = value;
@@ -133,6 +137,10 @@ void UserPreferencesStore::SetValue(const std::string &key,
   }
 
   configData[key] = newValue;
+  if (var != variables.end()) {
+    SyncFloatSlot(key);
+    PublishFloats();
+  }
 }
 
 std::optional<std::string>
@@ -149,9 +157,17 @@ bool UserPreferencesStore::HasKey(const std::string &key) const {
 
 void UserPreferencesStore::RemoveKey(const std::string &key) {
   configData.erase(key);
+  if (variables.count(key)) {
+    SyncFloatSlot(key);
+    PublishFloats();
+  }
 }
 
-void UserPreferencesStore::ClearValues() { configData.clear(); }
+void UserPreferencesStore::ClearValues() {
+  configData.clear();
+  SyncAllFloatSlots();
+  PublishFloats();
+}
 
 void UserPreferencesStore::RegisterVariable(const std::string &name,
                                             const std::string &type,
@@ -165,23 +181,33 @@ void UserPreferencesStore::RegisterVariable(const std::string &name,
   info.minValue = minVal;
   info.maxValue = maxVal;
   info.legacyNames = std::move(legacyNames);
-  variables[name] = info;
+
+  // Re-registering keeps the slot so handles resolved earlier stay valid.
+  auto existing = variables.find(name);
+  if (existing != variables.end()) {
+    info.slot = existing->second.slot;
+  } else {
+    info.slot = static_cast<uint32_t>(floatValues.size());
+    floatValues.push_back(defVal);
+    floatsDirty = true;
+  }
+  variables[name] = std::move(info);
+  SyncFloatSlot(name);
+  PublishFloats();
 }
 
 float UserPreferencesStore::GetFloat(const std::string &name) const {
   auto it = variables.find(name);
-  float defVal = 0.0f;
   if (it != variables.end())
-    defVal = it->second.defaultValue;
+    return floatValues[it->second.slot];
 
-  auto valStr = GetValue(name);
-  if (valStr) {
+  auto valStr = configData.find(name);
+  if (valStr != configData.end()) {
     float parsed = 0.0f;
-    if (TryParseFloat(*valStr, parsed))
+    if (TryParseFloat(valStr->second, parsed))
       return parsed;
-    return defVal;
   }
-  return defVal;
+  return 0.0f;
 }
 
 void UserPreferencesStore::SetFloat(const std::string &name, float v) {
@@ -194,7 +220,7 @@ void UserPreferencesStore::SetFloat(const std::string &name, float v) {
 }
 
 void UserPreferencesStore::ApplyDefaults() {
-  for (const auto &[name, info] : variables) {
+  for (auto &[name, info] : variables) {
     float value = info.defaultValue;
     auto raw = GetValue(name);
     if (raw) {
@@ -213,8 +239,73 @@ void UserPreferencesStore::ApplyDefaults() {
         }
       }
     }
-    SetValue(name, std::to_string(value));
+    if (info.type == "float")
+      info.value = value;
+    configData[name] = std::to_string(value);
+    SyncFloatSlot(name);
+  }
+  PublishFloats();
+}
+
+UserPreferencesStore::FloatHandle
+UserPreferencesStore::ResolveFloat(const std::string &name) const {
+  FloatHandle handle;
+  auto it = variables.find(name);
+  if (it != variables.end())
+    handle.slot = it->second.slot;
+  return handle;
+}
+
+float UserPreferencesStore::GetFloat(FloatHandle handle) const {
+  return handle.slot < floatValues.size() ? floatValues[handle.slot] : 0.0f;
+}
+
+std::shared_ptr<const UserPreferencesStore::FloatSnapshot>
+UserPreferencesStore::GetFloatSnapshot() const {
+  std::lock_guard<std::mutex> lock(floatSnapshotMutex);
+  return floatSnapshot;
+}
+
+uint64_t UserPreferencesStore::GetFloatRevision() const {
+  return floatRevision.load(std::memory_order_acquire);
+}
+
+void UserPreferencesStore::SyncFloatSlot(const std::string &name) {
+  auto it = variables.find(name);
+  if (it == variables.end())
+    return;
+  float value = it->second.defaultValue;
+  auto raw = configData.find(name);
+  if (raw != configData.end()) {
+    float parsed = 0.0f;
+    if (TryParseFloat(raw->second, parsed))
+      value = parsed;
   }
+  float &slot = floatValues[it->second.slot];
+  if (slot != value) {
+    slot = value;
+    floatsDirty = true;
+  }
+}
+
+void UserPreferencesStore::SyncAllFloatSlots() {
+  for (const auto &[name, info] : variables)
+    SyncFloatSlot(name);
+}
+
+void UserPreferencesStore::PublishFloats() {
+  if (!floatsDirty)
+    return;
+  floatsDirty = false;
+  auto snapshot = std::make_shared<FloatSnapshot>();
+  snapshot->values = floatValues;
+  snapshot->revision = floatRevision.load(std::memory_order_relaxed) + 1;
+  const uint64_t revision = snapshot->revision;
+  {
+    std::lock_guard<std::mutex> lock(floatSnapshotMutex);
+    floatSnapshot = std::move(snapshot);
+  }
+  floatRevision.store(revision, std::memory_order_release);
 }
 
 void UserPreferencesStore::ApplyColumnDefaults() {
@@ -296,6 +387,7 @@ bool UserPreferencesStore::LoadFromFile(const std::string &path) {
   } catch (...) {
     return false;
   }
+  SyncAllFloatSlots();
   ApplyColumnDefaults();
   ApplyDefaults();
   return true;
@@ -306,11 +398,15 @@ bool UserPreferencesStore::SaveToFile(const std::string &path) const {
   if (!file.is_open())
     return false;
 
-  nlohmann::json j(configData);
-  file << j.dump(4);
+  file << Serialize();
   return true;
 }
 
+std::string UserPreferencesStore::Serialize() const {
+  nlohmann::json j(configData);
+  return j.dump(4);
+}
+
 std::string UserPreferencesStore::GetUserConfigFile() {
   wxString dir = wxStandardPaths::Get().GetUserDataDir();
   std::filesystem::path p = std::filesystem::path(dir.ToStdString());
@@ -507,13 +603,24 @@ void LayerVisibilityState::SetCurrentLayer(const std::string &name) {
     currentLayer = name;
 }
 
-MvrScene &ProjectSession::GetScene() { return scene; }
+MvrScene &ProjectSession::GetScene() {
+  // Swapping `scene` races with every other access, and only the UI thread
+  // edits the scene.
+  wxASSERT(wxIsMainThread());
+  if (scene.use_count() > 1)
+    scene = std::make_shared<MvrScene>(*scene);
+  return *scene;
+}
+
+const MvrScene &ProjectSession::GetScene() const { return *scene; }
 
-const MvrScene &ProjectSession::GetScene() const { return scene; }
+std::shared_ptr<const MvrScene> ProjectSession::Snapshot() const {
+  return scene;
+}
 
 bool ProjectSession::SaveProject(const std::string &path,
                                  const SaveConfigFn &saveConfig,
-                                 const SaveSceneFn &saveScene) const {
+                                 const SaveSceneFn &saveScene) {
   namespace fs = std::filesystem;
   if (!saveConfig || !saveScene)
     return false;
@@ -527,29 +634,45 @@ bool ProjectSession::SaveProject(const std::string &path,
   if (!saveConfig(configPath.string()) || !saveScene(scenePath.string()))
     return false;
 
-  wxFileOutputStream out(path);
-  if (!out.IsOk())
-    return false;
-  wxZipOutputStream zip(out);
-
-  auto addFile = [&](const fs::path &source, const std::string &entryName) {
-    auto *entry = new wxZipEntry(entryName);
-    entry->SetMethod(wxZIP_METHOD_DEFLATE);
-    zip.PutNextEntry(entry);
-    std::ifstream in(source, std::ios::binary);
-    char buf[4096];
-    while (in.good()) {
-      in.read(buf, sizeof(buf));
-      std::streamsize s = in.gcount();
-      if (s > 0)
-        zip.Write(buf, s);
+  fs::path partPath = fs::path(path);
+  partPath += ".part";
+  {
+    wxFileOutputStream out(partPath.string());
+    if (!out.IsOk())
+      return false;
+    wxZipOutputStream zip(out);
+
+    auto addFile = [&](const fs::path &source, const std::string &entryName) {
+      auto *entry = new wxZipEntry(entryName);
+      entry->SetMethod(wxZIP_METHOD_DEFLATE);
+      zip.PutNextEntry(entry);
+      std::ifstream in(source, std::ios::binary);
+      char buf[4096];
+      while (in.good()) {
+        in.read(buf, sizeof(buf));
+        std::streamsize s = in.gcount();
+        if (s > 0)
+          zip.Write(buf, s);
+      }
+      zip.CloseEntry();
+    };
+
+    addFile(configPath, "config.json");
+    addFile(scenePath, "scene.mvr");
+    const bool written = zip.Close() && out.Close();
+    if (!written) {
+      std::error_code ec;
+      fs::remove(partPath, ec);
+      return false;
     }
-    zip.CloseEntry();
-  };
+  }
 
-  addFile(configPath, "config.json");
-  addFile(scenePath, "scene.mvr");
-  zip.Close();
+  std::error_code ec;
+  fs::rename(partPath, path, ec);
+  if (ec) {
+    fs::remove(partPath, ec);
+    return false;
+  }
   return true;
 }
 
@@ -631,6 +754,8 @@ bool ProjectSession::LoadProject(const std::string &path,
 
 bool ProjectSession::IsDirty() const { return revision != savedRevision; }
 
+size_t ProjectSession::GetRevision() const { return revision; }
+
 void ProjectSession::Touch() { ++revision; }
 
 void ProjectSession::MarkSaved() { savedRevision = revision; }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <optional>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -19,8 +23,36 @@ public:
     float minValue = 0.0f;
     float maxValue = 0.0f;
     std::vector<std::string> legacyNames;
+    uint32_t slot = 0;
   };
 
+  // Pre-resolved reference to a registered float variable. Resolve it once
+  // (registration never removes a variable, so the handle stays valid) and
+  // read it in per-frame code instead of looking the name up every time.
+  class FloatHandle {
+  public:
+    bool IsValid() const { return slot != kInvalidSlot; }
+
+  private:
+    friend class UserPreferencesStore;
+    static constexpr uint32_t kInvalidSlot = UINT32_MAX;
+    uint32_t slot = kInvalidSlot;
+  };
+
+  // Parsed values of every registered float variable, indexed by handle.
+  // A new snapshot is published whenever one of them changes; readers keep
+  // the one they loaded, so a frame sees a consistent set of values.
+  struct FloatSnapshot {
+    std::vector<float> values;
+    uint64_t revision = 0;
+
+    float Get(FloatHandle handle) const {
+      return handle.slot < values.size() ? values[handle.slot] : 0.0f;
+    }
+  };
+
+  UserPreferencesStore();
+
   void SetValue(const std::string &key, const std::string &value);
   std::optional<std::string> GetValue(const std::string &key) const;
   bool HasKey(const std::string &key) const;
@@ -29,6 +61,8 @@ public:
 
   bool LoadFromFile(const std::string &path);
   bool SaveToFile(const std::string &path) const;
+  // The JSON SaveToFile writes.
+  std::string Serialize() const;
   static std::string GetUserConfigFile();
   bool LoadUserConfig();
   bool SaveUserConfig() const;
@@ -40,6 +74,12 @@ public:
   void SetFloat(const std::string &name, float v);
   void ApplyDefaults();
 
+  FloatHandle ResolveFloat(const std::string &name) const;
+  float GetFloat(FloatHandle handle) const;
+  std::shared_ptr<const FloatSnapshot> GetFloatSnapshot() const;
+  // Bumped every time a new float snapshot is published.
+  uint64_t GetFloatRevision() const;
+
   std::vector<std::string> GetFixturePrintColumns() const;
   void SetFixturePrintColumns(const std::vector<std::string> &cols);
   std::vector<std::string> GetTrussPrintColumns() const;
@@ -51,9 +91,21 @@ public:
 
 private:
   void ApplyColumnDefaults();
+  void SyncFloatSlot(const std::string &name);
+  void SyncAllFloatSlots();
+  void PublishFloats();
 
   std::unordered_map<std::string, std::string> configData;
   std::unordered_map<std::string, VariableInfo> variables;
+  // Authoritative parsed values, indexed by VariableInfo::slot. Only touched
+  // by writers; readers go through the published snapshot.
+  std::vector<float> floatValues;
+  bool floatsDirty = false;
+  // Guards only the pointer swap; std::atomic<std::shared_ptr> is not
+  // available in every standard library we build with.
+  mutable std::mutex floatSnapshotMutex;
+  std::shared_ptr<const FloatSnapshot> floatSnapshot;
+  std::atomic<uint64_t> floatRevision{0};
 };
 
 class SelectionState {
@@ -127,21 +179,34 @@ public:
   using LoadConfigFn = std::function<bool(const std::string &path)>;
   using LoadSceneFn = std::function<bool(const std::string &path)>;
 
+  // The mutable overload copies the scene first while a snapshot still
+  // shares it, so snapshots never see later edits. It is for editing on
+  // the UI thread only; code that just reads goes through the const one,
+  // which never copies.
   MvrScene &GetScene();
   const MvrScene &GetScene() const;
-
-  bool SaveProject(const std::string &path, const SaveConfigFn &saveConfig,
-                   const SaveSceneFn &saveScene) const;
+  // Shares the current scene without copying it, for reading on another
+  // thread. Drop snapshots on the UI thread: a reference the UI took from
+  // the const GetScene() may point into one.
+  std::shared_ptr<const MvrScene> Snapshot() const;
+
+  // Writes the project next to `path` and renames it into place, so a
+  // failed save keeps the previous file. Uses no session state and may run
+  // on any thread.
+  static bool SaveProject(const std::string &path,
+                          const SaveConfigFn &saveConfig,
+                          const SaveSceneFn &saveScene);
   bool LoadProject(const std::string &path, const LoadConfigFn &loadConfig,
                    const LoadSceneFn &loadScene);
 
   bool IsDirty() const;
+  size_t GetRevision() const;
   void Touch();
   void MarkSaved();
   void ResetDirty();
 
 private:
-  MvrScene scene;
+  std::shared_ptr<MvrScene> scene = std::make_shared<MvrScene>();
   size_t revision = 0;
   size_t savedRevision = 0;
 };
@@ -0,0 +1,149 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "dmxpatchindex.h"
+
+#include <algorithm>
+
+void DmxPatchIndex::AddLoad(Universe &universe, const Footprint &footprint,
+                            int delta) {
+  const int last = footprint.channel + footprint.count - 1;
+  for (int c = footprint.channel; c <= last; ++c) {
+    uint16_t &load = universe.load[c - 1];
+    const bool wasOverloaded = load > 1;
+    load = static_cast<uint16_t>(load + delta);
+    const bool isOverloaded = load > 1;
+    if (wasOverloaded != isOverloaded) {
+      const int change = isOverloaded ? 1 : -1;
+      universe.overloadedChannels += change;
+      overloadedChannels_ += change;
+    }
+  }
+}
+
+bool DmxPatchIndex::RangeOverloaded(const Universe &universe,
+                                    const Footprint &footprint) const {
+  if (universe.overloadedChannels == 0)
+    return false;
+  const int last = footprint.channel + footprint.count - 1;
+  for (int c = footprint.channel; c <= last; ++c) {
+    if (universe.load[c - 1] > 1)
+      return true;
+  }
+  return false;
+}
+
+void DmxPatchIndex::Detach(const std::string &uuid, Entry &entry) {
+  auto uniIt = universes_.find(entry.footprint.universe);
+  if (uniIt == universes_.end())
+    return;
+  Universe &universe = uniIt->second;
+  AddLoad(universe, entry.footprint, -1);
+
+  // Swap-remove keeps the other members' slots valid except the moved one.
+  const std::string *moved = universe.members.back();
+  universe.members[entry.slot] = moved;
+  universe.members.pop_back();
+  if (*moved != uuid)
+    entries_.find(*moved)->second.slot = entry.slot;
+  if (universe.members.empty())
+    universes_.erase(uniIt);
+}
+
+void DmxPatchIndex::Set(const std::string &uuid, const Footprint &footprint) {
+  Footprint clipped = footprint;
+  if (clipped.universe < 1 || clipped.channel < 1 ||
+      clipped.channel > kUniverseSize || clipped.count < 1) {
+    Remove(uuid);
+    return;
+  }
+  clipped.count = std::min(clipped.count, kUniverseSize - clipped.channel + 1);
+
+  auto [it, inserted] = entries_.try_emplace(uuid);
+  Entry &entry = it->second;
+  if (!inserted) {
+    const Footprint &old = entry.footprint;
+    if (old.universe == clipped.universe && old.channel == clipped.channel &&
+        old.count == clipped.count)
+      return;
+    Detach(uuid, entry);
+  }
+
+  Universe &universe = universes_[clipped.universe];
+  entry.footprint = clipped;
+  entry.slot = universe.members.size();
+  universe.members.push_back(&it->first);
+  AddLoad(universe, clipped, 1);
+}
+
+void DmxPatchIndex::Remove(const std::string &uuid) {
+  auto it = entries_.find(uuid);
+  if (it == entries_.end())
+    return;
+  Detach(uuid, it->second);
+  entries_.erase(it);
+}
+
+void DmxPatchIndex::Clear() {
+  entries_.clear();
+  universes_.clear();
+  overloadedChannels_ = 0;
+}
+
+bool DmxPatchIndex::Contains(const std::string &uuid) const {
+  return entries_.count(uuid) > 0;
+}
+
+bool DmxPatchIndex::HasConflict(const std::string &uuid) const {
+  if (overloadedChannels_ == 0)
+    return false;
+  auto it = entries_.find(uuid);
+  if (it == entries_.end())
+    return false;
+  const Footprint &footprint = it->second.footprint;
+  return RangeOverloaded(universes_.at(footprint.universe), footprint);
+}
+
+std::vector<std::string> DmxPatchIndex::Overlapping(int universe, int channel,
+                                                    int count) const {
+  std::vector<std::string> result;
+  auto uniIt = universes_.find(universe);
+  if (uniIt == universes_.end() || count < 1)
+    return result;
+  const int last = channel + count - 1;
+  for (const std::string *uuid : uniIt->second.members) {
+    const Footprint &f = entries_.at(*uuid).footprint;
+    if (f.channel <= last && channel <= f.channel + f.count - 1)
+      result.push_back(*uuid);
+  }
+  return result;
+}
+
+std::vector<std::string> DmxPatchIndex::ConflictingUuids() const {
+  std::vector<std::string> result;
+  if (overloadedChannels_ == 0)
+    return result;
+  for (const auto &[number, universe] : universes_) {
+    if (universe.overloadedChannels == 0)
+      continue;
+    for (const std::string *uuid : universe.members) {
+      if (RangeOverloaded(universe, entries_.at(*uuid).footprint))
+        result.push_back(*uuid);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Index of the DMX footprints of a patch, used to find fixtures that share
+// channels. A universe only has 512 channels, so each universe keeps a
+// per-channel load count instead of an interval tree: moving a fixture costs
+// its channel count, and a patch without any overlap is recognised from a
+// single counter.
+class DmxPatchIndex {
+public:
+  static constexpr int kUniverseSize = 512;
+
+  struct Footprint {
+    int universe = 0;
+    int channel = 0; // first channel, 1-based
+    int count = 0;   // number of channels
+  };
+
+  // Adds the fixture or moves it to a new footprint. Footprints running past
+  // channel 512 are clipped; invalid ones remove the fixture from the index.
+  void Set(const std::string &uuid, const Footprint &footprint);
+  void Remove(const std::string &uuid);
+  void Clear();
+
+  size_t Size() const { return entries_.size(); }
+  bool Contains(const std::string &uuid) const;
+
+  // True when any two fixtures share a channel.
+  bool HasConflicts() const { return overloadedChannels_ > 0; }
+  // True when the fixture shares a channel with another fixture.
+  bool HasConflict(const std::string &uuid) const;
+  // Fixtures using any of `count` channels from `channel` in `universe`.
+  std::vector<std::string> Overlapping(int universe, int channel,
+                                       int count) const;
+  // Every fixture that shares at least one channel with another one.
+  std::vector<std::string> ConflictingUuids() const;
+
+private:
+  struct Entry {
+    Footprint footprint;
+    size_t slot = 0; // position in Universe::members
+  };
+
+  struct Universe {
+    std::array<uint16_t, kUniverseSize> load{};
+    int overloadedChannels = 0;
+    std::vector<const std::string *> members; // keys of entries_
+  };
+
+  void AddLoad(Universe &universe, const Footprint &footprint, int delta);
+  bool RangeOverloaded(const Universe &universe,
+                       const Footprint &footprint) const;
+  void Detach(const std::string &uuid, Entry &entry);
+
+  std::unordered_map<std::string, Entry> entries_;
+  std::unordered_map<int, Universe> universes_;
+  size_t overloadedChannels_ = 0;
+};
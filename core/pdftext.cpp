@@ -23,132 +23,277 @@
 #include <podofo/podofo.h>
 #include <algorithm>
 #include <cmath>
-#include <vector>
+#include <condition_variable>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "workerpool.h"
 
 using namespace PoDoFo;
 
-std::string ExtractPdfText(const std::string &path) {
-  try {
-    PdfMemDocument doc;
-    doc.Load(path.c_str());
-    std::string out;
+namespace {
+
 #if PODOFO_VERSION >= PODOFO_MAKE_VERSION(0, 10, 0)
-    auto &pages = doc.GetPages();
-    for (unsigned i = 0; i < pages.GetCount(); ++i) {
-      auto &page = pages.GetPageAt(i);
-      PdfTextExtractParams params;
-      params.Flags = PdfTextExtractFlags::ComputeBoundingBox;
-      std::vector<PdfTextEntry> entries;
-      page.ExtractTextTo(entries, params);
-      std::sort(entries.begin(), entries.end(),
-                [](const PdfTextEntry &a, const PdfTextEntry &b) {
-                  if (std::fabs(a.Y - b.Y) > 2.0)
-                    return a.Y > b.Y; // top to bottom
-                  return a.X < b.X;
-                });
-      double lastY = std::numeric_limits<double>::quiet_NaN();
-      double lastX = 0.0;
-      for (const auto &e : entries) {
-        double x = e.BoundingBox ? e.BoundingBox->GetLeft() : e.X;
-        double y = e.BoundingBox ? e.BoundingBox->GetBottom() : e.Y;
-        double right = e.BoundingBox ? e.BoundingBox->GetRight() : x + e.Length;
-        if (!std::isnan(lastY)) {
-          if (std::fabs(y - lastY) > 2.0) {
-            out += '\n';
-          } else if (x - lastX > 2.0) {
-            out += ' ';
-          }
-        }
-        out += e.Text;
-        lastY = y;
-        lastX = right;
+unsigned PageCount(PdfMemDocument &doc) { return doc.GetPages().GetCount(); }
+
+std::string ExtractPageText(PdfMemDocument &doc, unsigned index) {
+  std::string out;
+  auto &page = doc.GetPages().GetPageAt(index);
+  PdfTextExtractParams params;
+  params.Flags = PdfTextExtractFlags::ComputeBoundingBox;
+  std::vector<PdfTextEntry> entries;
+  page.ExtractTextTo(entries, params);
+  std::sort(entries.begin(), entries.end(),
+            [](const PdfTextEntry &a, const PdfTextEntry &b) {
+              if (std::fabs(a.Y - b.Y) > 2.0)
+                return a.Y > b.Y; // top to bottom
+              return a.X < b.X;
+            });
+  double lastY = std::numeric_limits<double>::quiet_NaN();
+  double lastX = 0.0;
+  for (const auto &e : entries) {
+    double x = e.BoundingBox ? e.BoundingBox->GetLeft() : e.X;
+    double y = e.BoundingBox ? e.BoundingBox->GetBottom() : e.Y;
+    double right = e.BoundingBox ? e.BoundingBox->GetRight() : x + e.Length;
+    if (!std::isnan(lastY)) {
+      if (std::fabs(y - lastY) > 2.0) {
+        out += '\n';
+      } else if (x - lastX > 2.0) {
+        out += ' ';
       }
-      out += '\n';
     }
+    out += e.Text;
+    lastY = y;
+    lastX = right;
+  }
+  return out;
+}
 #else
-    for (int i = 0; i < doc.GetPageCount(); ++i) {
-      PdfPage *page = doc.GetPage(i);
-      PdfContentsTokenizer tokenizer(page);
-      EPdfContentsType type;
-      const char *token = nullptr;
-      PdfVariant var;
-      std::vector<PdfVariant> stack;
-      PdfFont *curFont = nullptr;
-      double fontSize = 0.0;
-      double curX = 0.0;
-      double curY = 0.0;
-      double lastX = 0.0;
-      bool firstOnLine = true;
-      while (tokenizer.ReadNext(type, token, var)) {
-        if (type == ePdfContentsType_Variant) {
-          stack.push_back(var);
-        } else if (type == ePdfContentsType_Keyword) {
-          if (!strcmp(token, "BT")) {
-            curX = lastX = 0.0;
-            firstOnLine = true;
-          } else if (!strcmp(token, "ET")) {
-            out += '\n';
-          } else if (!strcmp(token, "Tf") && stack.size() >= 2) {
-            fontSize = stack.back().GetReal();
-            stack.pop_back();
-            PdfName fontName = stack.back().GetName();
-            stack.pop_back();
-            PdfObject *fontObj = page->GetFromResources(PdfName("Font"), fontName);
-            if (fontObj)
-              curFont = doc.GetFont(fontObj);
-          } else if ((!strcmp(token, "Td") || !strcmp(token, "TD")) &&
-                     stack.size() >= 2) {
-            double ty = stack.back().GetReal();
-            stack.pop_back();
-            double tx = stack.back().GetReal();
-            stack.pop_back();
-            curX += tx;
-            curY += ty;
-            if (ty != 0)
-              firstOnLine = true;
-          } else if ((strcmp(token, "Tj") == 0 || strcmp(token, "'") == 0 ||
-                      strcmp(token, "\"") == 0) && !stack.empty() && curFont) {
-            PdfString s = stack.back().GetString();
-            stack.pop_back();
+unsigned PageCount(PdfMemDocument &doc) {
+  return static_cast<unsigned>(doc.GetPageCount());
+}
+
+std::string ExtractPageText(PdfMemDocument &doc, unsigned index) {
+  std::string out;
+  PdfPage *page = doc.GetPage(static_cast<int>(index));
+  PdfContentsTokenizer tokenizer(page);
+  EPdfContentsType type;
+  const char *token = nullptr;
+  PdfVariant var;
+  std::vector<PdfVariant> stack;
+  PdfFont *curFont = nullptr;
+  double fontSize = 0.0;
+  double curX = 0.0;
+  double curY = 0.0;
+  double lastX = 0.0;
+  bool firstOnLine = true;
+  while (tokenizer.ReadNext(type, token, var)) {
+    if (type == ePdfContentsType_Variant) {
+      stack.push_back(var);
+    } else if (type == ePdfContentsType_Keyword) {
+      if (!strcmp(token, "BT")) {
+        curX = lastX = 0.0;
+        firstOnLine = true;
+      } else if (!strcmp(token, "ET")) {
+        out += '\n';
+      } else if (!strcmp(token, "Tf") && stack.size() >= 2) {
+        fontSize = stack.back().GetReal();
+        stack.pop_back();
+        PdfName fontName = stack.back().GetName();
+        stack.pop_back();
+        PdfObject *fontObj = page->GetFromResources(PdfName("Font"), fontName);
+        if (fontObj)
+          curFont = doc.GetFont(fontObj);
+      } else if ((!strcmp(token, "Td") || !strcmp(token, "TD")) &&
+                 stack.size() >= 2) {
+        double ty = stack.back().GetReal();
+        stack.pop_back();
+        double tx = stack.back().GetReal();
+        stack.pop_back();
+        curX += tx;
+        curY += ty;
+        if (ty != 0)
+          firstOnLine = true;
+      } else if ((strcmp(token, "Tj") == 0 || strcmp(token, "'") == 0 ||
+                  strcmp(token, "\"") == 0) && !stack.empty() && curFont) {
+        PdfString s = stack.back().GetString();
+        stack.pop_back();
+        if (!firstOnLine && curX - lastX > fontSize * 0.5)
+          out += ' ';
+        out += s.GetStringUtf8();
+        lastX = curX + curFont->GetFontMetrics()->StringWidth(s) * fontSize / 1000.0;
+        curX = lastX;
+        firstOnLine = false;
+        if (strcmp(token, "'") == 0 || strcmp(token, "\"") == 0) {
+          out += '\n';
+          firstOnLine = true;
+        }
+      } else if (strcmp(token, "TJ") == 0 && !stack.empty() && curFont) {
+        PdfArray arr = stack.back().GetArray();
+        stack.pop_back();
+        for (size_t j = 0; j < arr.GetSize(); ++j) {
+          if (arr[j].IsString()) {
+            PdfString s = arr[j].GetString();
             if (!firstOnLine && curX - lastX > fontSize * 0.5)
               out += ' ';
             out += s.GetStringUtf8();
             lastX = curX + curFont->GetFontMetrics()->StringWidth(s) * fontSize / 1000.0;
             curX = lastX;
             firstOnLine = false;
-            if (strcmp(token, "'") == 0 || strcmp(token, "\"") == 0) {
-              out += '\n';
-              firstOnLine = true;
-            }
-          } else if (strcmp(token, "TJ") == 0 && !stack.empty() && curFont) {
-            PdfArray arr = stack.back().GetArray();
-            stack.pop_back();
-            for (size_t j = 0; j < arr.GetSize(); ++j) {
-              if (arr[j].IsString()) {
-                PdfString s = arr[j].GetString();
-                if (!firstOnLine && curX - lastX > fontSize * 0.5)
-                  out += ' ';
-                out += s.GetStringUtf8();
-                lastX = curX + curFont->GetFontMetrics()->StringWidth(s) * fontSize / 1000.0;
-                curX = lastX;
-                firstOnLine = false;
-              } else if (arr[j].IsNumber()) {
-                curX += arr[j].GetReal() * fontSize / 1000.0;
-              }
-            }
+          } else if (arr[j].IsNumber()) {
+            curX += arr[j].GetReal() * fontSize / 1000.0;
           }
         }
       }
-      out += '\n';
     }
+  }
+  return out;
+}
 #endif
-    if (!out.empty() && out.back() == '\n')
-      out.pop_back();
-    return out;
+
+// Pages per document copy below which extra copies cost more than they save.
+constexpr unsigned kMinPagesPerWorker = 4;
+
+} // namespace
+
+std::string ExtractPdfText(const std::string &path) {
+  std::string out;
+  bool first = true;
+  ExtractPdfTextPages(path, [&](size_t, size_t, std::string text) {
+    if (!first)
+      out += '\n';
+    out += text;
+    first = false;
+  });
+  return out;
+}
+
+bool ExtractPdfTextPages(const std::string &path,
+                         const PdfPageTextCallback &onPage,
+                         const std::atomic<bool> *cancel) {
+  auto cancelled = [cancel]() {
+    return cancel && cancel->load(std::memory_order_relaxed);
+  };
+
+  // PoDoFo documents load objects lazily and cannot be shared between
+  // threads, so each worker opens its own copy of the file and extracts one
+  // contiguous range of pages. The calling thread claims ranges too, which
+  // keeps this safe when called from a pool task.
+  struct State {
+    std::string path;
+    unsigned pageCount = 0;
+    unsigned rangeSize = 1;
+    unsigned rangeCount = 1;
+    std::atomic<unsigned> nextRange{0};
+    std::atomic<bool> failed{false};
+    const std::atomic<bool> *cancel = nullptr;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> texts;
+    std::vector<bool> ready;
+  };
+  auto state = std::make_shared<State>();
+  state->path = path;
+  state->cancel = cancel;
+
+  auto document = std::make_unique<PdfMemDocument>();
+  try {
+    document->Load(path.c_str());
   } catch (const PdfError &e) {
     wxLogError("PoDoFo failed to extract text from '%s': %s", path.c_str(),
                e.what());
+    return false;
   }
-  return {};
+  state->pageCount = PageCount(*document);
+  if (state->pageCount == 0)
+    return !cancelled();
+
+  WorkerPool &pool = WorkerPool::Shared();
+  const unsigned workers = static_cast<unsigned>(std::max<size_t>(
+      1, std::min<size_t>(pool.ThreadCount() + 1,
+                          state->pageCount / kMinPagesPerWorker)));
+  state->rangeSize = (state->pageCount + workers - 1) / workers;
+  state->rangeCount =
+      (state->pageCount + state->rangeSize - 1) / state->rangeSize;
+  state->texts.resize(state->pageCount);
+  state->ready.assign(state->pageCount, false);
+
+  // Extracts claimed ranges until none is left. `doc` is reused when given,
+  // otherwise the file is opened once per thread. `afterPage` runs after
+  // every page.
+  auto drain = [](const std::shared_ptr<State> &st, PdfMemDocument *doc,
+                  const std::function<void()> &afterPage) {
+    std::unique_ptr<PdfMemDocument> own;
+    for (unsigned r = st->nextRange++; r < st->rangeCount;
+         r = st->nextRange++) {
+      const unsigned begin = r * st->rangeSize;
+      const unsigned end = std::min(st->pageCount, begin + st->rangeSize);
+      if (!doc && !st->failed) {
+        try {
+          own = std::make_unique<PdfMemDocument>();
+          own->Load(st->path.c_str());
+          doc = own.get();
+        } catch (const PdfError &e) {
+          wxLogError("PoDoFo failed to extract text from '%s': %s",
+                     st->path.c_str(), e.what());
+          st->failed = true;
+        }
+      }
+      for (unsigned i = begin; i < end; ++i) {
+        std::string text;
+        const bool skip =
+            st->failed ||
+            (st->cancel && st->cancel->load(std::memory_order_relaxed));
+        if (!skip) {
+          try {
+            text = ExtractPageText(*doc, i);
+          } catch (const PdfError &e) {
+            wxLogError("PoDoFo failed to extract text from '%s': %s",
+                       st->path.c_str(), e.what());
+            st->failed = true;
+          }
+        }
+        {
+          std::lock_guard<std::mutex> lock(st->mutex);
+          st->texts[i] = std::move(text);
+          st->ready[i] = true;
+        }
+        st->cv.notify_all();
+        if (afterPage)
+          afterPage();
+      }
+    }
+  };
+
+  const unsigned helpers = state->rangeCount - 1;
+  for (unsigned h = 0; h < helpers; ++h)
+    pool.Submit([state, drain]() { drain(state, nullptr, {}); });
+
+  // Pages are handed over in order: between its own pages the calling thread
+  // delivers whatever is ready, then it waits for the rest.
+  unsigned delivered = 0;
+  auto deliver = [&](bool wait) {
+    while (delivered < state->pageCount && !state->failed && !cancelled()) {
+      std::string text;
+      {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        if (wait)
+          state->cv.wait(lock, [&]() { return state->ready[delivered]; });
+        else if (!state->ready[delivered])
+          return;
+        text = std::move(state->texts[delivered]);
+      }
+      if (state->failed || cancelled())
+        return;
+      if (onPage)
+        onPage(delivered, state->pageCount, std::move(text));
+      ++delivered;
+    }
+  };
+  drain(state, document.get(), [&]() { deliver(false); });
+  deliver(true);
+  return delivered == state->pageCount && !state->failed && !cancelled();
 }
@@ -17,7 +17,23 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <string>
 
 std::string ExtractPdfText(const std::string &path);
 
+// Receives the text of one page together with the page count.
+using PdfPageTextCallback =
+    std::function<void(size_t pageIndex, size_t pageCount, std::string text)>;
+
+// Extracts the text of every page, several pages at a time on the shared
+// worker pool. `onPage` runs on the calling thread in page order as soon as
+// the next page is ready. Returns false when the file cannot be read or
+// `cancel` was set; pages already delivered stay delivered. Joining the
+// pages gives the same text as ExtractPdfText.
+bool ExtractPdfTextPages(const std::string &path,
+                         const PdfPageTextCallback &onPage,
+                         const std::atomic<bool> *cancel = nullptr);
+
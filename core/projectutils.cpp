@@ -178,6 +178,23 @@ std::optional<std::string> LoadLastProjectPath()
     return std::nullopt;
 }
 
+std::string GetAutosavePath(const std::string& projectPath)
+{
+    wxString dir = wxStandardPaths::Get().GetUserDataDir();
+    if (dir.empty())
+        return {};
+    fs::path p = fs::path(dir.ToStdString()) / "autosave";
+    std::error_code ec;
+    fs::create_directories(p, ec);
+    if (ec)
+        return {};
+    std::string stem = projectPath.empty()
+                           ? std::string("untitled")
+                           : fs::path(projectPath).stem().string();
+    p /= stem + ".autosave" + PROJECT_EXTENSION;
+    return p.string();
+}
+
 std::string GetDefaultLibraryPath(const std::string& subdir)
 {
     if (const char* envPath = std::getenv("PERASTAGE_LIBRARY_PATH")) {
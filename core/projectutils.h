@@ -28,6 +28,10 @@ namespace ProjectUtils {
     bool SaveLastProjectPath(const std::string& path);
     std::optional<std::string> LoadLastProjectPath();
 
+    // Where autosaves of the given project go (an untitled one when empty),
+    // in the user data directory so that read-only project folders work.
+    std::string GetAutosavePath(const std::string& projectPath);
+
     // Path containing the built-in library shipped with the executable.
     std::filesystem::path GetBaseLibraryPath(const std::string& subdir);
 
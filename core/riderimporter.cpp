@@ -27,7 +27,6 @@
 #include <iomanip>
 #include <limits>
 #include <numeric>
-#include <regex>
 #include <sstream>
 #include <string_view>
 #include <tuple>
@@ -43,6 +42,7 @@
 #include "gdtfdictionary.h"
 #include "gdtfloader.h"
 #include "layer.h"
+#include "riderlineparser.h"
 #include "truss.h"
 #include "trussdictionary.h"
 #include "trussloader.h"
@@ -50,24 +50,6 @@
 #include <filesystem>
 
 namespace {
-// Precompiled regexes used by RiderImporter. Keeping them static avoids paying
-// the compilation cost on every import call and makes keyword matching cheap
-// even when processing large riders.
-static const std::regex kTrussLineRe(
-    "^\\s*(?:[-*]\\s*)?(\\d+)\\s+(?:truss)\\s+([^\\n]*?)\\s+(\\d+(?:\\.\\d+)?)\\s*(?:m|metros?|meters?)\\b(?:\\s+para\\s+(.+))?",
-    std::regex::icase);
-static const std::regex kTrussRe(
-    "(?:truss)[^\\n]*?(\\d+(?:\\.\\d+)?)\\s*(?:m|metros?|meters?)\\b",
-    std::regex::icase);
-static const std::regex kFixtureLineRe("^\\s*(?:[-*]\\s*)?(\\d+)\\s+(.+)$",
-                                       std::regex::icase);
-static const std::regex kQuantityOnlyRe("^\\s*(?:[-*]\\s*)?(\\d+)\\s*$");
-static const std::regex kHangLineRe("^\\s*(LX\\d+|floor|efectos?)\\s*:?\\s*$",
-                                    std::regex::icase);
-static const std::regex kHangFindRe("(LX\\d+|floor|efectos?)",
-                                    std::regex::icase);
-static const std::regex kHangOnlyRe("^\\s*(LX\\d+|floor|efectos?)\\s*$",
-                                    std::regex::icase);
 std::string Trim(const std::string &s) {
   size_t start = s.find_first_not_of(" \t\r\n");
   if (start == std::string::npos)
@@ -76,7 +58,7 @@ std::string Trim(const std::string &s) {
   return s.substr(start, end - start + 1);
 }
 
-bool TryParseFloat(const std::string &text, float &out) {
+bool TryParseFloat(std::string_view text, float &out) {
   if (text.empty())
     return false;
 
@@ -244,15 +226,36 @@ std::vector<float> SplitTrussSymmetric(float total) {
 } // namespace
 
 std::string RiderImporter::LoadText(const std::string &path) {
+  return LoadText(path, nullptr, {});
+}
+
+std::string RiderImporter::LoadText(const std::string &path,
+                                    const std::atomic<bool> *cancel,
+                                    const ProgressCallback &progress) {
   if (path.size() < 4)
     return {};
   std::string ext = path.substr(path.size() - 4);
   for (auto &c : ext)
     c = static_cast<char>(std::tolower(c));
-  if (ext == ".txt")
-    return ReadTextFile(path);
-  if (ext == ".pdf")
-    return ExtractPdfText(path);
+  if (ext == ".txt") {
+    std::string text = ReadTextFile(path);
+    if (progress)
+      progress(1, 1);
+    return text;
+  }
+  if (ext == ".pdf") {
+    std::string text;
+    auto onPage = [&](size_t index, size_t count, std::string page) {
+      if (index > 0)
+        text += '\n';
+      text += page;
+      if (progress)
+        progress(index + 1, count);
+    };
+    if (!ExtractPdfTextPages(path, onPage, cancel))
+      return {};
+    return text;
+  }
   return {};
 }
 
@@ -346,30 +349,52 @@ bool RiderImporter::ImportText(const std::string &text) {
   int pendingQuantity = 0;
   bool havePending = false;
 
+  // Dictionary lookups and GDTF parsing only depend on the rider type, so
+  // resolve each type once instead of once per fixture.
+  struct ResolvedType {
+    std::string typeName;
+    std::string gdtfSpec;
+    std::string gdtfMode;
+  };
+  std::unordered_map<std::string, ResolvedType> resolvedTypes;
+  auto resolveType = [&](const std::string &part) -> const ResolvedType & {
+    auto it = resolvedTypes.find(part);
+    if (it != resolvedTypes.end())
+      return it->second;
+    ResolvedType resolved;
+    resolved.typeName = part;
+    if (auto dictEntry = GdtfDictionary::Get(part)) {
+      resolved.gdtfSpec = dictEntry->path;
+      resolved.gdtfMode = dictEntry->mode;
+      std::string parsed = Trim(GetGdtfFixtureName(resolved.gdtfSpec));
+      if (!parsed.empty())
+        resolved.typeName = parsed;
+    }
+    return resolvedTypes.emplace(part, std::move(resolved)).first->second;
+  };
+
   auto addFixtures = [&](int baseQuantity, const std::string &desc) {
     auto parts = SplitPlus(desc);
     for (const auto &partRaw : parts) {
-      std::smatch pm;
       std::string part = partRaw;
       int quantity = baseQuantity;
-      if (std::regex_match(partRaw, pm, kFixtureLineRe)) {
-        if (!TryParseInt(pm[1].str(), quantity))
+      std::string_view quantityText;
+      std::string_view description;
+      if (RiderLineParser::MatchFixtureLine(partRaw, quantityText,
+                                            description)) {
+        if (!TryParseInt(quantityText, quantity))
           quantity = baseQuantity;
-        part = Trim(pm[2]);
+        part = Trim(std::string(description));
       }
+      const ResolvedType &resolved = resolveType(part);
       int &counter = nameCounters[part];
       for (int i = 0; i < quantity; ++i) {
         Fixture f;
         f.uuid = GenerateUuid();
         f.instanceName = part + " " + std::to_string(++counter);
-        f.typeName = part;
-        if (auto dictEntry = GdtfDictionary::Get(f.typeName)) {
-          f.gdtfSpec = dictEntry->path;
-          f.gdtfMode = dictEntry->mode;
-          std::string parsed = Trim(GetGdtfFixtureName(f.gdtfSpec));
-          if (!parsed.empty())
-            f.typeName = parsed;
-        }
+        f.typeName = resolved.typeName;
+        f.gdtfSpec = resolved.gdtfSpec;
+        f.gdtfMode = resolved.gdtfMode;
         if (!seenTypes.count(f.typeName)) {
           typeOrder.push_back(f.typeName);
           seenTypes.insert(f.typeName);
@@ -392,8 +417,8 @@ bool RiderImporter::ImportText(const std::string &text) {
     }
   };
   while (std::getline(iss, line)) {
-    // Remove Windows carriage returns to allow regexes anchored with '$' to
-    // match lines extracted from external tools.
+    // Remove Windows carriage returns so end-anchored line shapes match lines
+    // extracted from external tools.
     line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
     if (ContainsCaseInsensitive(line, "sonido") ||
         ContainsCaseInsensitive(line, "audio") ||
@@ -425,11 +450,11 @@ bool RiderImporter::ImportText(const std::string &text) {
       continue;
     }
 
-    std::smatch m;
-    std::smatch hm;
-    if (std::regex_match(line, hm, kHangLineRe)) {
+    RiderLineParser::TrussLine trussLine;
+    std::string_view captures[2];
+    if (RiderLineParser::MatchHangLine(line, captures[0])) {
       havePending = false;
-      std::string captured = hm[1];
+      std::string captured(captures[0]);
       if (ContainsCaseInsensitive(captured, "efecto")) {
         currentHang = "FLOOR";
       } else {
@@ -449,32 +474,29 @@ bool RiderImporter::ImportText(const std::string &text) {
       if (!desc.empty())
         addFixtures(pendingQuantity, desc);
       havePending = false;
-    } else if (std::regex_match(line, m, kTrussLineRe)) {
+    } else if (RiderLineParser::MatchTrussLine(line, trussLine)) {
       int quantity = 0;
-      if (!TryParseInt(m[1].str(), quantity))
+      if (!TryParseInt(trussLine.quantity, quantity))
         continue;
-      std::string model = Trim(m[2]);
+      std::string model = Trim(std::string(trussLine.model));
       float length = 0.0f;
-      if (!TryParseFloat(m[3], length))
+      if (!TryParseFloat(trussLine.length, length))
         continue;
       length *= 1000.0f;
       float width = 400.0f;
       float height = 400.0f;
-      std::smatch dm;
-      if (std::regex_search(
-              model, dm,
-              std::regex("(\\d+(?:\\.\\d+)?)\\s*[xX]\\s*(\\d+(?:\\.\\d+)?)"))) {
+      if (RiderLineParser::FindDimensions(model, captures[0], captures[1])) {
         float parsed = 0.0f;
-        if (TryParseFloat(dm[1], parsed))
+        if (TryParseFloat(captures[0], parsed))
           width = parsed * 10.0f;
         parsed = 0.0f;
-        if (TryParseFloat(dm[2], parsed))
+        if (TryParseFloat(captures[1], parsed))
           height = parsed * 10.0f;
       }
       std::string hang = currentHang;
-      if (m.size() > 4 && m[4].matched) {
-        hang = Trim(m[4]);
-      } else if (std::regex_match(model, kHangOnlyRe)) {
+      if (trussLine.hasHang) {
+        hang = Trim(std::string(trussLine.hang));
+      } else if (RiderLineParser::MatchHangOnly(model, captures[0])) {
         hang = model;
         model.clear();
       }
@@ -572,14 +594,14 @@ bool RiderImporter::ImportText(const std::string &text) {
         for (int i = 0; i < quantity; ++i)
           addTrussPieces(hang);
       }
-    } else if (std::regex_search(line, m, kTrussRe)) {
+    } else if (RiderLineParser::FindTrussLength(line, captures[0])) {
       float length = 0.0f;
-      if (!TryParseFloat(m[1], length))
+      if (!TryParseFloat(captures[0], length))
         continue;
       length *= 1000.0f;
       std::string hang = currentHang;
-      if (std::regex_search(line, hm, kHangFindRe)) {
-        hang = hm[1];
+      if (RiderLineParser::FindHang(line, captures[0])) {
+        hang = std::string(captures[0]);
         std::transform(
             hang.begin(), hang.end(), hang.begin(),
             [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
@@ -653,14 +675,17 @@ bool RiderImporter::ImportText(const std::string &text) {
         addToLayer(t.layer, t.uuid);
         x += s;
       }
-    } else if (inFixtures && std::regex_match(line, m, kFixtureLineRe)) {
+    } else if (inFixtures &&
+               RiderLineParser::MatchFixtureLine(line, captures[0],
+                                                 captures[1])) {
       int baseQuantity = 0;
-      if (!TryParseInt(m[1].str(), baseQuantity))
+      if (!TryParseInt(captures[0], baseQuantity))
         continue;
-      std::string desc = Trim(m[2]);
+      std::string desc = Trim(std::string(captures[1]));
       addFixtures(baseQuantity, desc);
-    } else if (inFixtures && std::regex_match(line, m, kQuantityOnlyRe)) {
-      if (!TryParseInt(m[1].str(), pendingQuantity))
+    } else if (inFixtures &&
+               RiderLineParser::MatchQuantityOnly(line, captures[0])) {
+      if (!TryParseInt(captures[0], pendingQuantity))
         continue;
       havePending = true;
     }
@@ -17,15 +17,28 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <string>
 
 // Parses simple rider files (.txt/.pdf) to create dummy fixtures and trusses
 class RiderImporter {
 public:
+    // Reports how many pages of a rider have been read so far.
+    using ProgressCallback = std::function<void(size_t done, size_t total)>;
+
     // Import rider located at path. Returns true on success.
     static bool Import(const std::string& path);
     // Load rider file into text. Returns empty string on failure.
     static std::string LoadText(const std::string& path);
+    // Same as above, for use off the UI thread: PDF pages are extracted in
+    // parallel, `progress` runs on the calling thread after every page and
+    // setting `cancel` makes it return an empty string. Does not touch the
+    // scene, so the caller imports the text with ImportText afterwards.
+    static std::string LoadText(const std::string& path,
+                                const std::atomic<bool>* cancel,
+                                const ProgressCallback& progress);
     // Import from raw rider text. Returns true on success.
     static bool ImportText(const std::string& text);
 };
@@ -0,0 +1,308 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "riderlineparser.h"
+
+#include <array>
+#include <cstddef>
+
+namespace RiderLineParser {
+namespace {
+constexpr size_t kNoMatch = std::string_view::npos;
+
+// Character classes follow std::regex in the classic locale.
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' ||
+         c == '\r';
+}
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool IsWordChar(char c) {
+  return IsDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         c == '_';
+}
+
+// '.' in ECMAScript does not match line terminators.
+bool IsLineBreak(char c) { return c == '\n' || c == '\r'; }
+
+char ToLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// `word` must be lowercase.
+bool StartsWithNoCase(std::string_view text, size_t pos,
+                      std::string_view word) {
+  if (pos > text.size() || text.size() - pos < word.size())
+    return false;
+  for (size_t i = 0; i < word.size(); ++i) {
+    if (ToLower(text[pos + i]) != word[i])
+      return false;
+  }
+  return true;
+}
+
+size_t SkipSpaces(std::string_view text, size_t pos) {
+  while (pos < text.size() && IsSpace(text[pos]))
+    ++pos;
+  return pos;
+}
+
+size_t SkipDigits(std::string_view text, size_t pos) {
+  while (pos < text.size() && IsDigit(text[pos]))
+    ++pos;
+  return pos;
+}
+
+bool HasLineBreakFrom(std::string_view text, size_t pos) {
+  for (; pos < text.size(); ++pos) {
+    if (IsLineBreak(text[pos]))
+      return true;
+  }
+  return false;
+}
+
+// (LX\d+|floor|efectos?) at pos. Returns the end of the token or kNoMatch.
+size_t MatchHangToken(std::string_view text, size_t pos) {
+  if (StartsWithNoCase(text, pos, "lx")) {
+    size_t end = SkipDigits(text, pos + 2);
+    if (end > pos + 2)
+      return end;
+  }
+  if (StartsWithNoCase(text, pos, "floor"))
+    return pos + 5;
+  if (StartsWithNoCase(text, pos, "efecto")) {
+    size_t end = pos + 6;
+    if (end < text.size() && ToLower(text[end]) == 's')
+      ++end;
+    return end;
+  }
+  return kNoMatch;
+}
+
+// ^\s*(?:[-*]\s*)?(\d+). Returns the end of the digits or kNoMatch.
+size_t MatchCountPrefix(std::string_view line, std::string_view &quantity) {
+  size_t pos = SkipSpaces(line, 0);
+  if (pos < line.size() && (line[pos] == '-' || line[pos] == '*'))
+    pos = SkipSpaces(line, pos + 1);
+  size_t end = SkipDigits(line, pos);
+  if (end == pos)
+    return kNoMatch;
+  quantity = line.substr(pos, end - pos);
+  return end;
+}
+
+// \d+(?:\.\d+)? at pos. Returns the end of the number or kNoMatch.
+size_t MatchNumber(std::string_view text, size_t pos) {
+  size_t end = SkipDigits(text, pos);
+  if (end == pos)
+    return kNoMatch;
+  if (end < text.size() && text[end] == '.') {
+    size_t fraction = SkipDigits(text, end + 1);
+    if (fraction > end + 1)
+      end = fraction;
+  }
+  return end;
+}
+
+// Alternatives of (?:m|metros?|meters?) in the order the regex tries them.
+constexpr std::array<std::string_view, 5> kLengthUnits = {
+    "m", "metros", "metro", "meters", "meter"};
+
+// (\d+(?:\.\d+)?)\s*(?:m|metros?|meters?)\b at pos, calling `accept` with the
+// end of each unit alternative until it returns true.
+template <typename Accept>
+bool MatchLength(std::string_view text, size_t pos, std::string_view &length,
+                 Accept &&accept) {
+  size_t numberEnd = MatchNumber(text, pos);
+  if (numberEnd == kNoMatch)
+    return false;
+  size_t unitPos = SkipSpaces(text, numberEnd);
+  for (std::string_view unit : kLengthUnits) {
+    if (!StartsWithNoCase(text, unitPos, unit))
+      continue;
+    size_t unitEnd = unitPos + unit.size();
+    if (unitEnd < text.size() && IsWordChar(text[unitEnd]))
+      continue;
+    if (accept(unitEnd)) {
+      length = text.substr(pos, numberEnd - pos);
+      return true;
+    }
+  }
+  return false;
+}
+
+// (?:\s+para\s+(.+))?$ at pos.
+bool MatchTrussTail(std::string_view line, size_t pos, TrussLine &out) {
+  size_t keyword = SkipSpaces(line, pos);
+  if (keyword > pos && StartsWithNoCase(line, keyword, "para")) {
+    size_t afterKeyword = keyword + 4;
+    size_t rest = SkipSpaces(line, afterKeyword);
+    if (rest > afterKeyword) {
+      if (rest < line.size()) {
+        if (!HasLineBreakFrom(line, rest)) {
+          out.hang = line.substr(rest);
+          out.hasHang = true;
+          return true;
+        }
+      } else if (rest - afterKeyword >= 2 &&
+                 !IsLineBreak(line[line.size() - 1])) {
+        // \s+ gives its last character back so (.+) is not empty.
+        out.hang = line.substr(line.size() - 1);
+        out.hasHang = true;
+        return true;
+      }
+    }
+  }
+  out.hang = {};
+  out.hasHang = false;
+  return pos == line.size();
+}
+} // namespace
+
+bool MatchHangLine(std::string_view line, std::string_view &hang) {
+  size_t start = SkipSpaces(line, 0);
+  size_t end = MatchHangToken(line, start);
+  if (end == kNoMatch)
+    return false;
+  size_t pos = SkipSpaces(line, end);
+  if (pos < line.size() && line[pos] == ':')
+    pos = SkipSpaces(line, pos + 1);
+  if (pos != line.size())
+    return false;
+  hang = line.substr(start, end - start);
+  return true;
+}
+
+bool MatchHangOnly(std::string_view text, std::string_view &hang) {
+  size_t start = SkipSpaces(text, 0);
+  size_t end = MatchHangToken(text, start);
+  if (end == kNoMatch || SkipSpaces(text, end) != text.size())
+    return false;
+  hang = text.substr(start, end - start);
+  return true;
+}
+
+bool FindHang(std::string_view line, std::string_view &hang) {
+  for (size_t pos = 0; pos < line.size(); ++pos) {
+    size_t end = MatchHangToken(line, pos);
+    if (end != kNoMatch) {
+      hang = line.substr(pos, end - pos);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MatchTrussLine(std::string_view line, TrussLine &out) {
+  size_t pos = MatchCountPrefix(line, out.quantity);
+  if (pos == kNoMatch)
+    return false;
+  size_t keyword = SkipSpaces(line, pos);
+  if (keyword == pos || !StartsWithNoCase(line, keyword, "truss"))
+    return false;
+  size_t afterKeyword = keyword + 5;
+  size_t spaces = SkipSpaces(line, afterKeyword) - afterKeyword;
+  // \s+ is greedy and the model is lazy: try the longest separator first and,
+  // for each, the shortest model that lets the rest of the line match.
+  for (size_t taken = spaces; taken >= 1; --taken) {
+    size_t modelStart = afterKeyword + taken;
+    for (size_t modelEnd = modelStart; modelEnd < line.size(); ++modelEnd) {
+      if (modelEnd > modelStart && line[modelEnd - 1] == '\n')
+        break;
+      size_t number = SkipSpaces(line, modelEnd);
+      if (number == modelEnd)
+        continue;
+      bool matched = MatchLength(line, number, out.length, [&](size_t end) {
+        return MatchTrussTail(line, end, out);
+      });
+      if (matched) {
+        out.model = line.substr(modelStart, modelEnd - modelStart);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool FindTrussLength(std::string_view line, std::string_view &length) {
+  for (size_t start = 0; start < line.size(); ++start) {
+    if (!StartsWithNoCase(line, start, "truss"))
+      continue;
+    for (size_t pos = start + 5; pos < line.size(); ++pos) {
+      if (pos > start + 5 && line[pos - 1] == '\n')
+        break;
+      if (MatchLength(line, pos, length, [](size_t) { return true; }))
+        return true;
+    }
+  }
+  return false;
+}
+
+bool MatchFixtureLine(std::string_view line, std::string_view &quantity,
+                      std::string_view &description) {
+  std::string_view digits;
+  size_t pos = MatchCountPrefix(line, digits);
+  if (pos == kNoMatch)
+    return false;
+  size_t rest = SkipSpaces(line, pos);
+  if (rest == pos)
+    return false;
+  if (rest < line.size()) {
+    if (HasLineBreakFrom(line, rest))
+      return false;
+    description = line.substr(rest);
+  } else {
+    // Only whitespace follows: \s+ gives its last character back to (.+).
+    if (rest - pos < 2 || IsLineBreak(line[line.size() - 1]))
+      return false;
+    description = line.substr(line.size() - 1);
+  }
+  quantity = digits;
+  return true;
+}
+
+bool MatchQuantityOnly(std::string_view line, std::string_view &quantity) {
+  std::string_view digits;
+  size_t pos = MatchCountPrefix(line, digits);
+  if (pos == kNoMatch || SkipSpaces(line, pos) != line.size())
+    return false;
+  quantity = digits;
+  return true;
+}
+
+bool FindDimensions(std::string_view text, std::string_view &width,
+                    std::string_view &height) {
+  for (size_t start = 0; start < text.size(); ++start) {
+    size_t widthEnd = MatchNumber(text, start);
+    if (widthEnd == kNoMatch)
+      continue;
+    size_t pos = SkipSpaces(text, widthEnd);
+    if (pos >= text.size() || (text[pos] != 'x' && text[pos] != 'X'))
+      continue;
+    size_t heightStart = SkipSpaces(text, pos + 1);
+    size_t heightEnd = MatchNumber(text, heightStart);
+    if (heightEnd == kNoMatch)
+      continue;
+    width = text.substr(start, widthEnd - start);
+    height = text.substr(heightStart, heightEnd - heightStart);
+    return true;
+  }
+  return false;
+}
+
+} // namespace RiderLineParser
@@ -0,0 +1,64 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <string_view>
+
+// Single-pass matchers for the line shapes understood by RiderImporter. Each
+// function reproduces the ECMAScript regex quoted above it (including its
+// backtracking choices), but scans the line once and returns views into it
+// instead of allocating match results. Keyword comparisons are ASCII
+// case-insensitive.
+namespace RiderLineParser {
+
+struct TrussLine {
+  std::string_view quantity;
+  std::string_view model;
+  std::string_view length;
+  std::string_view hang; // text after "para", valid when hasHang is set
+  bool hasHang = false;
+};
+
+// ^\s*(LX\d+|floor|efectos?)\s*:?\s*$
+bool MatchHangLine(std::string_view line, std::string_view &hang);
+
+// ^\s*(LX\d+|floor|efectos?)\s*$
+bool MatchHangOnly(std::string_view text, std::string_view &hang);
+
+// First occurrence of (LX\d+|floor|efectos?) anywhere in the line.
+bool FindHang(std::string_view line, std::string_view &hang);
+
+// ^\s*(?:[-*]\s*)?(\d+)\s+truss\s+([^\n]*?)\s+(\d+(?:\.\d+)?)\s*
+//   (?:m|metros?|meters?)\b(?:\s+para\s+(.+))?   matched against the whole line
+bool MatchTrussLine(std::string_view line, TrussLine &out);
+
+// First occurrence of truss[^\n]*?(\d+(?:\.\d+)?)\s*(?:m|metros?|meters?)\b
+bool FindTrussLength(std::string_view line, std::string_view &length);
+
+// ^\s*(?:[-*]\s*)?(\d+)\s+(.+)$
+bool MatchFixtureLine(std::string_view line, std::string_view &quantity,
+                      std::string_view &description);
+
+// ^\s*(?:[-*]\s*)?(\d+)\s*$
+bool MatchQuantityOnly(std::string_view line, std::string_view &quantity);
+
+// First occurrence of (\d+(?:\.\d+)?)\s*[xX]\s*(\d+(?:\.\d+)?)
+bool FindDimensions(std::string_view text, std::string_view &width,
+                    std::string_view &height);
+
+} // namespace RiderLineParser
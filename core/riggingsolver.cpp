@@ -0,0 +1,283 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "riggingsolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Plan grid cell; about a truss section, so a fixture query sees only the
+// few trusses around it.
+constexpr double kCellMm = 2000.0;
+
+// Components after which a load may sit elsewhere or weigh differently.
+constexpr uint32_t kLoadComponents =
+    SceneComponent::Transform | SceneComponent::Properties |
+    SceneComponent::Added | SceneComponent::Removed;
+
+using Vec3 = std::array<double, 3>;
+
+Vec3 ToVec(const std::array<float, 3> &v) { return {v[0], v[1], v[2]}; }
+
+double Dot(const Vec3 &a, const Vec3 &b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+int64_t CellOf(double v) {
+  return static_cast<int64_t>(std::floor(v / kCellMm));
+}
+
+uint64_t CellKey(int64_t x, int64_t y) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+         static_cast<uint32_t>(y);
+}
+
+} // namespace
+
+void RiggingSolver::Clear() {
+  beams.clear();
+  grid.clear();
+  hoistUuids.clear();
+  hoistIndex.clear();
+  hoistLoads.clear();
+  fixtureLoads.clear();
+  unsupportedKg = 0.0;
+  built = false;
+}
+
+void RiggingSolver::Rebuild(const MvrScene &scene) {
+  Clear();
+
+  const double reach = std::max(kFixtureReachMm, kHoistReachMm);
+  beams.reserve(scene.trusses.size());
+  for (const auto &[uuid, truss] : scene.trusses) {
+    Beam beam;
+    beam.uuid = uuid;
+    beam.start = ToVec(truss.transform.o);
+    beam.axis = ToVec(truss.transform.u);
+    const double norm = std::sqrt(Dot(beam.axis, beam.axis));
+    beam.axis = norm > 1e-9 ? Vec3{beam.axis[0] / norm, beam.axis[1] / norm,
+                                   beam.axis[2] / norm}
+                            : Vec3{1.0, 0.0, 0.0};
+    beam.length =
+        truss.lengthMm > 0.0f ? truss.lengthMm : Truss::kDefaultLengthMm;
+
+    const int index = static_cast<int>(beams.size());
+    const double endX = beam.start[0] + beam.axis[0] * beam.length;
+    const double endY = beam.start[1] + beam.axis[1] * beam.length;
+    const int64_t x0 = CellOf(std::min(beam.start[0], endX) - reach);
+    const int64_t x1 = CellOf(std::max(beam.start[0], endX) + reach);
+    const int64_t y0 = CellOf(std::min(beam.start[1], endY) - reach);
+    const int64_t y1 = CellOf(std::max(beam.start[1], endY) + reach);
+    for (int64_t x = x0; x <= x1; ++x)
+      for (int64_t y = y0; y <= y1; ++y)
+        grid[CellKey(x, y)].push_back(index);
+    beams.push_back(std::move(beam));
+  }
+
+  hoistUuids.reserve(scene.supports.size());
+  hoistLoads.assign(scene.supports.size(), 0.0);
+  for (const auto &[uuid, support] : scene.supports) {
+    const int index = static_cast<int>(hoistUuids.size());
+    hoistUuids.push_back(uuid);
+    hoistIndex.emplace(uuid, index);
+    const Vec3 point = ToVec(support.transform.o);
+    const int beam = NearestBeam(point, kHoistReachMm, true);
+    if (beam < 0)
+      continue;
+    Beam &b = beams[beam];
+    const Vec3 offset{point[0] - b.start[0], point[1] - b.start[1],
+                      point[2] - b.start[2]};
+    b.hoists.emplace_back(std::clamp(Dot(offset, b.axis), 0.0, b.length),
+                          index);
+  }
+
+  // Truss weight: each stretch between hoists, and each overhang, is a
+  // resultant at its middle.
+  for (size_t i = 0; i < beams.size(); ++i) {
+    Beam &beam = beams[i];
+    std::sort(beam.hoists.begin(), beam.hoists.end());
+    const auto trussIt = scene.trusses.find(beam.uuid);
+    const double weight = trussIt->second.weightKg;
+    if (weight <= 0.0)
+      continue;
+    const double perMm = weight / beam.length;
+    std::vector<double> stops{0.0};
+    for (const auto &hoist : beam.hoists)
+      stops.push_back(hoist.first);
+    stops.push_back(beam.length);
+    for (size_t s = 1; s < stops.size(); ++s) {
+      const double span = stops[s] - stops[s - 1];
+      if (span > 0.0)
+        AddLoad(Distribute(static_cast<int>(i), (stops[s] + stops[s - 1]) / 2,
+                           perMm * span),
+                1.0);
+    }
+  }
+
+  fixtureLoads.reserve(scene.fixtures.size());
+  for (const auto &[uuid, fixture] : scene.fixtures)
+    AttachFixture(uuid, fixture);
+
+  built = true;
+}
+
+void RiggingSolver::Apply(const SceneChangeSet &changes,
+                          const MvrScene &scene) {
+  if (!built)
+    return;
+  if (changes.reset) {
+    Rebuild(scene);
+    return;
+  }
+
+  // Trusses and hoists change the spans every load is shared over.
+  for (const auto &change : changes.changes) {
+    if ((change.kind == SceneEntityKind::Truss ||
+         change.kind == SceneEntityKind::Support) &&
+        (change.components & kLoadComponents)) {
+      Rebuild(scene);
+      return;
+    }
+  }
+
+  for (const auto &change : changes.changes) {
+    if (change.kind != SceneEntityKind::Fixture ||
+        !(change.components & kLoadComponents))
+      continue;
+    DetachFixture(change.uuid);
+    if (auto it = scene.fixtures.find(change.uuid); it != scene.fixtures.end())
+      AttachFixture(change.uuid, it->second);
+  }
+}
+
+double RiggingSolver::HoistLoadKg(const std::string &supportUuid) const {
+  auto it = hoistIndex.find(supportUuid);
+  return it == hoistIndex.end() ? 0.0 : hoistLoads[it->second];
+}
+
+std::string RiggingSolver::TrussOf(const std::string &fixtureUuid) const {
+  auto it = fixtureLoads.find(fixtureUuid);
+  if (it == fixtureLoads.end() || it->second.beam < 0)
+    return {};
+  return beams[it->second.beam].uuid;
+}
+
+int RiggingSolver::NearestBeam(const std::array<double, 3> &point,
+                               double reach, bool planOnly) const {
+  auto cell = grid.find(CellKey(CellOf(point[0]), CellOf(point[1])));
+  if (cell == grid.end())
+    return -1;
+
+  // Plan-only searches still prefer the nearer truss in 3D on a tie, so a
+  // hoist above two stacked trusses takes the upper one.
+  int best = -1;
+  double bestPrimary = std::numeric_limits<double>::max();
+  double bestSecondary = std::numeric_limits<double>::max();
+  for (int index : cell->second) {
+    const Beam &beam = beams[index];
+    const Vec3 offset{point[0] - beam.start[0], point[1] - beam.start[1],
+                      point[2] - beam.start[2]};
+    const double along = std::clamp(Dot(offset, beam.axis), 0.0, beam.length);
+    const Vec3 gap{offset[0] - beam.axis[0] * along,
+                   offset[1] - beam.axis[1] * along,
+                   offset[2] - beam.axis[2] * along};
+    const double full = std::sqrt(Dot(gap, gap));
+    const double primary =
+        planOnly ? std::sqrt(gap[0] * gap[0] + gap[1] * gap[1]) : full;
+    if (primary > reach)
+      continue;
+    if (best >= 0) {
+      const bool tie = std::abs(primary - bestPrimary) <= 1.0;
+      const bool closer =
+          tie ? full < bestSecondary ||
+                    (full == bestSecondary && beam.uuid < beams[best].uuid)
+              : primary < bestPrimary;
+      if (!closer)
+        continue;
+    }
+    best = index;
+    bestPrimary = primary;
+    bestSecondary = full;
+  }
+  return best;
+}
+
+RiggingSolver::Load RiggingSolver::Distribute(int beam, double distance,
+                                              double weightKg) const {
+  Load load;
+  load.beam = beam;
+  const auto &hoists = beams[beam].hoists;
+  if (hoists.empty()) {
+    load.unsupportedKg = weightKg;
+    return load;
+  }
+  if (hoists.size() == 1) {
+    load.shares[0] = {hoists[0].second, weightKg};
+    return load;
+  }
+
+  // The span around the load, or the end span for an overhang; the lever
+  // rule then gives negative reactions (uplift) for overhanging loads.
+  auto next = std::upper_bound(
+      hoists.begin(), hoists.end(), distance,
+      [](double d, const std::pair<double, int> &h) { return d < h.first; });
+  const size_t j = std::clamp<size_t>(next - hoists.begin(), 1,
+                                      hoists.size() - 1);
+  const auto &[a, left] = hoists[j - 1];
+  const auto &[b, right] = hoists[j];
+  const double span = b - a;
+  const double rightShare =
+      span > 1e-6 ? weightKg * (distance - a) / span : weightKg / 2;
+  load.shares[0] = {left, weightKg - rightShare};
+  load.shares[1] = {right, rightShare};
+  return load;
+}
+
+void RiggingSolver::AddLoad(const Load &load, double sign) {
+  for (const auto &[hoist, kg] : load.shares)
+    if (hoist >= 0)
+      hoistLoads[hoist] += sign * kg;
+  unsupportedKg += sign * load.unsupportedKg;
+}
+
+void RiggingSolver::AttachFixture(const std::string &uuid,
+                                  const Fixture &fixture) {
+  const Vec3 point = ToVec(fixture.transform.o);
+  const int beam = NearestBeam(point, kFixtureReachMm, false);
+  Load load;
+  if (beam >= 0) {
+    const Beam &b = beams[beam];
+    const Vec3 offset{point[0] - b.start[0], point[1] - b.start[1],
+                      point[2] - b.start[2]};
+    load = Distribute(beam, std::clamp(Dot(offset, b.axis), 0.0, b.length),
+                      fixture.weightKg);
+    AddLoad(load, 1.0);
+  }
+  fixtureLoads[uuid] = load;
+}
+
+void RiggingSolver::DetachFixture(const std::string &uuid) {
+  auto it = fixtureLoads.find(uuid);
+  if (it == fixtureLoads.end())
+    return;
+  AddLoad(it->second, -1.0);
+  fixtureLoads.erase(it);
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "mvrscene.h"
+#include "scenechangejournal.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Hoist reactions computed from the scene: every fixture is hung from the
+// nearest truss, every hoist picks up the truss below it, and each truss is
+// treated as a chain of simply supported spans between its hoists, with
+// the end spans carrying any overhang. Fixtures are point loads at their
+// projection onto the truss axis and the truss weight is spread evenly
+// along its length.
+//
+// A fixture change only moves that fixture's load, so dragging fixtures
+// stays cheap on large rigs; truss and hoist changes rebuild the model.
+class RiggingSolver {
+public:
+  // How far a fixture may hang from a truss axis, and how far a hoist may
+  // sit from it in plan, to be attached to it.
+  static constexpr double kFixtureReachMm = 1000.0;
+  static constexpr double kHoistReachMm = 1000.0;
+
+  void Rebuild(const MvrScene &scene);
+  void Clear();
+  bool IsBuilt() const { return built; }
+
+  // Updates the solver for `changes`. Does nothing while it is not built.
+  void Apply(const SceneChangeSet &changes, const MvrScene &scene);
+
+  // Load carried by the hoist in kg, excluding its own weight. Negative
+  // values are uplift from an overhang. 0 for unknown hoists.
+  double HoistLoadKg(const std::string &supportUuid) const;
+  // Truss the fixture hangs from, or empty when none is in reach.
+  std::string TrussOf(const std::string &fixtureUuid) const;
+  // Weight on trusses that no hoist holds.
+  double UnsupportedKg() const { return unsupportedKg; }
+
+private:
+  struct Beam {
+    std::string uuid;
+    std::array<double, 3> start{};
+    std::array<double, 3> axis{}; // unit vector
+    double length = 0.0;
+    // Hoists by position along the axis: (distance from start, hoist).
+    std::vector<std::pair<double, int>> hoists;
+  };
+
+  // Where a load ended up, so it can be taken off again.
+  struct Load {
+    int beam = -1;
+    std::array<std::pair<int, double>, 2> shares{{{-1, 0.0}, {-1, 0.0}}};
+    double unsupportedKg = 0.0;
+  };
+
+  int NearestBeam(const std::array<double, 3> &point, double reach,
+                  bool planOnly) const;
+  Load Distribute(int beam, double distance, double weightKg) const;
+  void AddLoad(const Load &load, double sign);
+  void AttachFixture(const std::string &uuid, const Fixture &fixture);
+  void DetachFixture(const std::string &uuid);
+
+  std::vector<Beam> beams;
+  // Uniform plan grid over the truss bounds: cell -> beams within reach.
+  std::unordered_map<uint64_t, std::vector<int>> grid;
+  std::vector<std::string> hoistUuids;
+  std::unordered_map<std::string, int> hoistIndex;
+  // Updated in place as fixtures attach and detach. Adding and subtracting
+  // a load is not exact even in double, but the drift stays far below the
+  // displayed precision and Rebuild sums from scratch.
+  std::vector<double> hoistLoads;
+  std::unordered_map<std::string, Load> fixtureLoads;
+  double unsupportedKg = 0.0;
+  bool built = false;
+};
@@ -0,0 +1,144 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scenechangejournal.h"
+
+#include <algorithm>
+
+bool SceneChangeSet::Touches(SceneEntityKind kind,
+                             uint32_t components) const {
+  if (reset)
+    return true;
+  return std::any_of(changes.begin(), changes.end(),
+                     [&](const SceneChange &change) {
+                       return change.kind == kind &&
+                              (change.components & components) != 0;
+                     });
+}
+
+SceneChangeJournal::ListenerId
+SceneChangeJournal::Subscribe(Listener listener) {
+  ListenerId id = nextListenerId++;
+  listeners.emplace_back(id, std::move(listener));
+  return id;
+}
+
+void SceneChangeJournal::Unsubscribe(ListenerId id) {
+  listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                 [id](const auto &entry) {
+                                   return entry.first == id;
+                                 }),
+                  listeners.end());
+}
+
+void SceneChangeJournal::Publish(SceneEntityKind kind, const std::string &uuid,
+                                 uint32_t components) {
+  if (components == 0)
+    return;
+  const size_t k = static_cast<size_t>(kind);
+  ++revision;
+
+  auto &revisions = entityRevisions[k];
+  auto revIt = revisions.find(uuid);
+  const uint64_t oldRevision = revIt != revisions.end() ? revIt->second : 0;
+  if (components & SceneComponent::Removed) {
+    if (revIt != revisions.end())
+      revisions.erase(revIt);
+  } else if (revIt != revisions.end()) {
+    revIt->second = revision;
+  } else {
+    revisions.emplace(uuid, revision);
+  }
+
+  if (!pendingReset) {
+    auto [indexIt, inserted] = pendingIndex[k].emplace(uuid, pending.size());
+    if (inserted) {
+      pending.push_back({kind, uuid, components, oldRevision, revision});
+    } else {
+      SceneChange &merged = pending[indexIt->second];
+      merged.components |= components;
+      merged.newRevision = revision;
+    }
+  }
+
+  if (batchDepth == 0)
+    Flush();
+}
+
+void SceneChangeJournal::Publish(SceneEntityKind kind,
+                                 const std::vector<std::string> &uuids,
+                                 uint32_t components) {
+  if (uuids.empty() || components == 0)
+    return;
+  BeginBatch();
+  for (const auto &uuid : uuids)
+    Publish(kind, uuid, components);
+  EndBatch();
+}
+
+void SceneChangeJournal::PublishReset() {
+  ++revision;
+  for (auto &revisions : entityRevisions)
+    revisions.clear();
+  pendingReset = true;
+  pending.clear();
+  for (auto &index : pendingIndex)
+    index.clear();
+  if (batchDepth == 0)
+    Flush();
+}
+
+void SceneChangeJournal::BeginBatch() { ++batchDepth; }
+
+void SceneChangeJournal::EndBatch() {
+  if (batchDepth == 0)
+    return;
+  if (--batchDepth == 0)
+    Flush();
+}
+
+uint64_t SceneChangeJournal::GetEntityRevision(SceneEntityKind kind,
+                                               const std::string &uuid) const {
+  const auto &revisions = entityRevisions[static_cast<size_t>(kind)];
+  auto it = revisions.find(uuid);
+  return it != revisions.end() ? it->second : 0;
+}
+
+void SceneChangeJournal::Flush() {
+  if (!pendingReset && pending.empty())
+    return;
+
+  SceneChangeSet set;
+  set.reset = pendingReset;
+  set.changes.swap(pending);
+  set.revision = revision;
+  pendingReset = false;
+  for (auto &index : pendingIndex)
+    index.clear();
+
+  // Listeners may publish, subscribe or unsubscribe while being notified.
+  // Changes they publish are delivered as a separate set; listeners removed
+  // before their turn are skipped.
+  const auto snapshot = listeners;
+  for (const auto &[id, listener] : snapshot) {
+    const bool subscribed =
+        std::any_of(listeners.begin(), listeners.end(),
+                    [id = id](const auto &entry) { return entry.first == id; });
+    if (subscribed && listener)
+      listener(set);
+  }
+}
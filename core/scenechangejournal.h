@@ -0,0 +1,119 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+enum class SceneEntityKind : uint8_t { Fixture, Truss, Support, SceneObject };
+
+// Parts of an entity touched by a change. Values are combined with '|'.
+namespace SceneComponent {
+constexpr uint32_t Transform = 1u << 0;  // position or rotation
+constexpr uint32_t Patch = 1u << 1;      // fixture id, DMX address or mode
+constexpr uint32_t Properties = 1u << 2; // names, model, sizes, weights...
+constexpr uint32_t Placement = 1u << 3;  // layer or hang position
+constexpr uint32_t Added = 1u << 4;
+constexpr uint32_t Removed = 1u << 5;
+constexpr uint32_t All = Transform | Patch | Properties | Placement;
+} // namespace SceneComponent
+
+struct SceneChange {
+  SceneEntityKind kind = SceneEntityKind::Fixture;
+  std::string uuid;
+  uint32_t components = 0;
+  // Entity revision before and after the change; 0 means the entity had not
+  // been journaled yet.
+  uint64_t oldRevision = 0;
+  uint64_t newRevision = 0;
+};
+
+// What listeners receive: either the entities that changed, or a reset when
+// the whole scene was replaced (load, undo, redo) and every cache built from
+// it is stale.
+struct SceneChangeSet {
+  bool reset = false;
+  std::vector<SceneChange> changes;
+  uint64_t revision = 0;
+
+  bool Touches(SceneEntityKind kind,
+               uint32_t components = ~uint32_t{0}) const;
+};
+
+// Records which scene entities changed and tells subscribers about it, so
+// tables, summaries and caches can update just those entities instead of
+// rebuilding from the whole scene. Changes published inside a Batch are
+// merged per entity and delivered once when the outermost batch ends.
+// Not thread-safe; publish and subscribe from the UI thread.
+class SceneChangeJournal {
+public:
+  using Listener = std::function<void(const SceneChangeSet &)>;
+  using ListenerId = uint64_t;
+
+  class Batch {
+  public:
+    explicit Batch(SceneChangeJournal &journal) : journal(journal) {
+      journal.BeginBatch();
+    }
+    ~Batch() { journal.EndBatch(); }
+    Batch(const Batch &) = delete;
+    Batch &operator=(const Batch &) = delete;
+
+  private:
+    SceneChangeJournal &journal;
+  };
+
+  ListenerId Subscribe(Listener listener);
+  void Unsubscribe(ListenerId id);
+
+  void Publish(SceneEntityKind kind, const std::string &uuid,
+               uint32_t components);
+  void Publish(SceneEntityKind kind, const std::vector<std::string> &uuids,
+               uint32_t components);
+  void PublishReset();
+
+  void BeginBatch();
+  void EndBatch();
+
+  // Bumped once per published entity change or reset.
+  uint64_t GetRevision() const { return revision; }
+  // Revision of the last change to an entity, 0 if none since the last reset.
+  uint64_t GetEntityRevision(SceneEntityKind kind,
+                             const std::string &uuid) const;
+
+private:
+  static constexpr size_t kKindCount = 4;
+
+  void Flush();
+
+  std::array<std::unordered_map<std::string, uint64_t>, kKindCount>
+      entityRevisions;
+  std::vector<std::pair<ListenerId, Listener>> listeners;
+  ListenerId nextListenerId = 1;
+  uint64_t revision = 0;
+  int batchDepth = 0;
+
+  bool pendingReset = false;
+  std::vector<SceneChange> pending;
+  std::array<std::unordered_map<std::string, size_t>, kKindCount> pendingIndex;
+};
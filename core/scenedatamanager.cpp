@@ -18,6 +18,8 @@
 #include "scenedatamanager.h"
 #include "configmanager.h"
 
+#include <utility>
+
 SceneDataManager& SceneDataManager::Instance()
 {
     static SceneDataManager instance;
@@ -26,17 +28,17 @@ SceneDataManager& SceneDataManager::Instance()
 
 const std::unordered_map<std::string, Fixture>& SceneDataManager::GetFixtures() const
 {
-    return ConfigManager::Get().GetScene().fixtures;
+    return std::as_const(ConfigManager::Get()).GetScene().fixtures;
 }
 
 const std::unordered_map<std::string, Truss>& SceneDataManager::GetTrusses() const
 {
-    return ConfigManager::Get().GetScene().trusses;
+    return std::as_const(ConfigManager::Get()).GetScene().trusses;
 }
 
 const std::unordered_map<std::string, SceneObject>& SceneDataManager::GetSceneObjects() const
 {
-    return ConfigManager::Get().GetScene().sceneObjects;
+    return std::as_const(ConfigManager::Get()).GetScene().sceneObjects;
 }
 
 const std::unordered_map<std::string, SceneObject>& SceneDataManager::GetGroupObjects() const
@@ -0,0 +1,92 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "sceneedittransaction.h"
+
+#include "configmanager.h"
+
+#include <map>
+#include <utility>
+
+SceneEditTransaction::SceneEditTransaction(ConfigManager &cfg,
+                                           std::string description)
+    : cfg(cfg), description(std::move(description)) {}
+
+SceneEditTransaction::~SceneEditTransaction() { Commit(); }
+
+void SceneEditTransaction::SaveUndoState() {
+  if (undoSaved)
+    return;
+  cfg.PushUndoState(description);
+  undoSaved = true;
+}
+
+void SceneEditTransaction::Record(Pending &pending, const std::string &uuid,
+                                  uint32_t components) {
+  auto [it, inserted] = pending.components.try_emplace(uuid, components);
+  if (inserted)
+    pending.uuids.push_back(uuid);
+  else
+    it->second |= components;
+}
+
+Fixture *SceneEditTransaction::EditFixture(const std::string &uuid,
+                                           uint32_t components) {
+  auto &sceneFixtures = cfg.GetScene().fixtures;
+  auto it = sceneFixtures.find(uuid);
+  if (it == sceneFixtures.end())
+    return nullptr;
+  SaveUndoState();
+  Record(fixtures, uuid, components);
+  return &it->second;
+}
+
+Truss *SceneEditTransaction::EditTruss(const std::string &uuid,
+                                       uint32_t components) {
+  auto &sceneTrusses = cfg.GetScene().trusses;
+  auto it = sceneTrusses.find(uuid);
+  if (it == sceneTrusses.end())
+    return nullptr;
+  SaveUndoState();
+  Record(trusses, uuid, components);
+  return &it->second;
+}
+
+bool SceneEditTransaction::HasChanges() const {
+  return !fixtures.uuids.empty() || !trusses.uuids.empty();
+}
+
+void SceneEditTransaction::Publish(SceneEntityKind kind, Pending &pending) {
+  // NotifySceneChanged takes one component mask per call, so entities are
+  // grouped by mask; a command usually touches all of them the same way.
+  std::map<uint32_t, std::vector<std::string>> groups;
+  for (auto &uuid : pending.uuids) {
+    const uint32_t components = pending.components[uuid];
+    groups[components].push_back(std::move(uuid));
+  }
+  for (const auto &[components, uuids] : groups)
+    cfg.NotifySceneChanged(kind, uuids, components);
+  pending = Pending{};
+}
+
+void SceneEditTransaction::Commit() {
+  if (!HasChanges())
+    return;
+  SceneChangeJournal::Batch batch(cfg.GetSceneJournal());
+  Publish(SceneEntityKind::Fixture, fixtures);
+  Publish(SceneEntityKind::Truss, trusses);
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "scenechangejournal.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ConfigManager;
+struct Fixture;
+struct Truss;
+
+// Applies the edits of one user command as a single step: the undo state is
+// saved once, before the first edit, and every touched entity is reported
+// to the scene journal in one change set when the transaction commits, so
+// listeners refresh once per command rather than once per entity.
+class SceneEditTransaction {
+public:
+  SceneEditTransaction(ConfigManager &cfg, std::string description);
+  // Commits whatever was edited.
+  ~SceneEditTransaction();
+
+  SceneEditTransaction(const SceneEditTransaction &) = delete;
+  SceneEditTransaction &operator=(const SceneEditTransaction &) = delete;
+
+  // Returns the entity for editing, or nullptr when it does not exist.
+  // `components` says which parts of it the caller is about to change.
+  Fixture *EditFixture(const std::string &uuid, uint32_t components);
+  Truss *EditTruss(const std::string &uuid, uint32_t components);
+
+  // Saves the undo state now if no edit has done so yet. For commands that
+  // change only what the undo state also keeps, such as the selection.
+  void SaveUndoState();
+
+  bool HasChanges() const;
+
+  // Publishes the recorded changes. Later edits start a new change set but
+  // share the undo state already saved.
+  void Commit();
+
+private:
+  struct Pending {
+    std::vector<std::string> uuids;
+    std::unordered_map<std::string, uint32_t> components;
+  };
+
+  void Record(Pending &pending, const std::string &uuid, uint32_t components);
+  void Publish(SceneEntityKind kind, Pending &pending);
+
+  ConfigManager &cfg;
+  std::string description;
+  bool undoSaved = false;
+  Pending fixtures;
+  Pending trusses;
+};
@@ -0,0 +1,212 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "sceneentityindex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+// Components after which an entity may sit under a different key.
+constexpr uint32_t kKeyComponents = SceneComponent::Patch |
+                                    SceneComponent::Properties |
+                                    SceneComponent::Added |
+                                    SceneComponent::Removed;
+
+std::string Lowercase(std::string text) {
+  std::transform(text.begin(), text.end(), text.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return text;
+}
+
+} // namespace
+
+SceneEntityIndex::Table *SceneEntityIndex::TableFor(SceneEntityKind kind) {
+  switch (kind) {
+  case SceneEntityKind::Fixture:
+    return &fixtures;
+  case SceneEntityKind::Truss:
+    return &trusses;
+  default:
+    return nullptr;
+  }
+}
+
+const SceneEntityIndex::Table *
+SceneEntityIndex::TableFor(SceneEntityKind kind) const {
+  return const_cast<SceneEntityIndex *>(this)->TableFor(kind);
+}
+
+void SceneEntityIndex::Clear() {
+  fixtures = Table{};
+  trusses = Table{};
+  built = false;
+}
+
+void SceneEntityIndex::Rebuild(const MvrScene &scene) {
+  Clear();
+  auto fill = [](Table &table, const auto &entities, auto key) {
+    table.byId.reserve(entities.size());
+    table.byName.reserve(entities.size());
+    table.keys.reserve(entities.size());
+    for (const auto &[uuid, entity] : entities) {
+      auto [id, name] = key(entity);
+      name = Lowercase(std::move(name));
+      table.byId.emplace_back(id, uuid);
+      table.byName.emplace_back(name, uuid);
+      table.keys.emplace(uuid, std::make_pair(id, std::move(name)));
+    }
+    std::sort(table.byId.begin(), table.byId.end());
+    std::sort(table.byName.begin(), table.byName.end());
+  };
+  fill(fixtures, scene.fixtures, [](const Fixture &f) {
+    return std::make_pair(f.fixtureId, f.instanceName);
+  });
+  fill(trusses, scene.trusses, [](const Truss &t) {
+    return std::make_pair(t.unitNumber, t.name);
+  });
+  built = true;
+}
+
+void SceneEntityIndex::Insert(Table &table, const std::string &uuid, int id,
+                              std::string name) {
+  std::pair<int, std::string> idKey(id, uuid);
+  table.byId.insert(
+      std::lower_bound(table.byId.begin(), table.byId.end(), idKey),
+      std::move(idKey));
+  std::pair<std::string, std::string> nameKey(name, uuid);
+  table.byName.insert(
+      std::lower_bound(table.byName.begin(), table.byName.end(), nameKey),
+      std::move(nameKey));
+  table.keys[uuid] = {id, std::move(name)};
+}
+
+void SceneEntityIndex::Erase(Table &table, const std::string &uuid) {
+  auto it = table.keys.find(uuid);
+  if (it == table.keys.end())
+    return;
+  const auto &[id, name] = it->second;
+  auto idIt = std::lower_bound(table.byId.begin(), table.byId.end(),
+                               std::make_pair(id, uuid));
+  if (idIt != table.byId.end() && idIt->second == uuid)
+    table.byId.erase(idIt);
+  auto nameIt = std::lower_bound(table.byName.begin(), table.byName.end(),
+                                 std::make_pair(name, uuid));
+  if (nameIt != table.byName.end() && nameIt->second == uuid)
+    table.byName.erase(nameIt);
+  table.keys.erase(it);
+}
+
+void SceneEntityIndex::Reindex(SceneEntityKind kind, const std::string &uuid,
+                               const MvrScene &scene) {
+  Table *table = TableFor(kind);
+  if (!table)
+    return;
+  int id = 0;
+  std::string name;
+  bool exists = false;
+  if (kind == SceneEntityKind::Fixture) {
+    auto it = scene.fixtures.find(uuid);
+    if (it != scene.fixtures.end()) {
+      id = it->second.fixtureId;
+      name = Lowercase(it->second.instanceName);
+      exists = true;
+    }
+  } else {
+    auto it = scene.trusses.find(uuid);
+    if (it != scene.trusses.end()) {
+      id = it->second.unitNumber;
+      name = Lowercase(it->second.name);
+      exists = true;
+    }
+  }
+
+  auto keyIt = table->keys.find(uuid);
+  if (exists && keyIt != table->keys.end() && keyIt->second.first == id &&
+      keyIt->second.second == name)
+    return;
+  Erase(*table, uuid);
+  if (exists)
+    Insert(*table, uuid, id, std::move(name));
+}
+
+void SceneEntityIndex::Apply(const SceneChangeSet &changes,
+                             const MvrScene &scene) {
+  if (!built)
+    return;
+  if (changes.reset) {
+    Clear();
+    return;
+  }
+  // Every insert or erase shifts the sorted arrays, so past a quarter of
+  // the scene a full rebuild is cheaper.
+  size_t keyChanges = 0;
+  for (const auto &change : changes.changes) {
+    if (change.components & kKeyComponents)
+      ++keyChanges;
+  }
+  if (keyChanges == 0)
+    return;
+  if (keyChanges * 4 > fixtures.keys.size() + trusses.keys.size()) {
+    Rebuild(scene);
+    return;
+  }
+  for (const auto &change : changes.changes) {
+    if (change.components & kKeyComponents)
+      Reindex(change.kind, change.uuid, scene);
+  }
+}
+
+size_t SceneEntityIndex::Size(SceneEntityKind kind) const {
+  const Table *table = TableFor(kind);
+  return table ? table->keys.size() : 0;
+}
+
+std::vector<std::string> SceneEntityIndex::Range(SceneEntityKind kind,
+                                                 int first, int last) const {
+  std::vector<std::string> out;
+  const Table *table = TableFor(kind);
+  if (!table || first > last)
+    return out;
+  auto begin = std::lower_bound(
+      table->byId.begin(), table->byId.end(), first,
+      [](const auto &entry, int id) { return entry.first < id; });
+  auto end = std::upper_bound(
+      begin, table->byId.end(), last,
+      [](int id, const auto &entry) { return id < entry.first; });
+  out.reserve(static_cast<size_t>(end - begin));
+  for (auto it = begin; it != end; ++it)
+    out.push_back(it->second);
+  return out;
+}
+
+std::vector<std::string>
+SceneEntityIndex::FindByName(SceneEntityKind kind,
+                             const std::string &name) const {
+  std::vector<std::string> out;
+  const Table *table = TableFor(kind);
+  if (!table)
+    return out;
+  const std::string key = Lowercase(name);
+  auto it = std::lower_bound(
+      table->byName.begin(), table->byName.end(), key,
+      [](const auto &entry, const std::string &k) { return entry.first < k; });
+  for (; it != table->byName.end() && it->first == key; ++it)
+    out.push_back(it->second);
+  return out;
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "mvrscene.h"
+#include "scenechangejournal.h"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Sorted lookup of fixtures by fixture id and trusses by unit number, plus
+// a case-insensitive name lookup for both, so console selections such as
+// "f 1 thru 200" cost a binary search instead of a scan per id. The index
+// is built from the scene once and then kept current from the change sets
+// of the scene journal; a reset drops it until the next Rebuild.
+class SceneEntityIndex {
+public:
+  void Rebuild(const MvrScene &scene);
+  void Clear();
+  bool IsBuilt() const { return built; }
+
+  // Re-reads the entities of `changes` whose id or name may have changed.
+  // Does nothing while the index is not built.
+  void Apply(const SceneChangeSet &changes, const MvrScene &scene);
+
+  // Number of indexed entities; supports and scene objects are not indexed.
+  size_t Size(SceneEntityKind kind) const;
+
+  // Entities whose id lies in [first, last], ordered by id, then by UUID.
+  std::vector<std::string> Range(SceneEntityKind kind, int first,
+                                 int last) const;
+  // Entities named `name`, ignoring case, ordered by UUID.
+  std::vector<std::string> FindByName(SceneEntityKind kind,
+                                      const std::string &name) const;
+
+private:
+  struct Table {
+    std::vector<std::pair<int, std::string>> byId;           // id, uuid
+    std::vector<std::pair<std::string, std::string>> byName; // name, uuid
+    // Current key of every entity, needed to find it again on removal.
+    std::unordered_map<std::string, std::pair<int, std::string>> keys;
+  };
+
+  Table *TableFor(SceneEntityKind kind);
+  const Table *TableFor(SceneEntityKind kind) const;
+  static void Insert(Table &table, const std::string &uuid, int id,
+                     std::string name);
+  static void Erase(Table &table, const std::string &uuid);
+  void Reindex(SceneEntityKind kind, const std::string &uuid,
+               const MvrScene &scene);
+
+  Table fixtures;
+  Table trusses;
+  bool built = false;
+};
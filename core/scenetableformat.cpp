@@ -0,0 +1,83 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scenetableformat.h"
+
+#include <cstdio>
+
+namespace SceneTableFormat {
+
+const std::vector<std::string>& FixtureColumns() {
+  static const std::vector<std::string> columns = {
+      "Fixture ID", "Name",        "Type",      "Layer",
+      "Hang Pos",   "Universe",    "Channel",   "Mode",
+      "Ch Count",   "Model file",  "Pos X",     "Pos Y",
+      "Pos Z",      "Roll (X)",    "Pitch (Y)", "Yaw (Z)",
+      "Power (W)",  "Weight (kg)", "Color"};
+  return columns;
+}
+
+const std::vector<std::string>& TrussColumns() {
+  static const std::vector<std::string> columns = {
+      "Name",       "Layer",      "Model File",  "Hang Pos",
+      "Pos X",      "Pos Y",      "Pos Z",       "Roll (X)",
+      "Pitch (Y)",  "Yaw (Z)",    "Manufacturer", "Model",
+      "Length (m)", "Width (m)",  "Height (m)",  "Weight (kg)"};
+  return columns;
+}
+
+std::string Decimal(float value, int decimals) {
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%.*f", decimals, static_cast<double>(value));
+  return buf;
+}
+
+std::string Position(float mm) { return Decimal(mm / 1000.0f, 3); }
+
+std::string Angle(float degrees) {
+  return Decimal(degrees, 1) + "\xC2\xB0";
+}
+
+std::string Metres(float mm) { return Decimal(mm / 1000.0f, 2); }
+
+std::string OptionalMetres(float mm) {
+  return mm > 0.0f ? Metres(mm) : std::string();
+}
+
+std::string EscapeCsv(const std::string& text) {
+  if (text.find_first_of(",\"\r\n") == std::string::npos)
+    return text;
+  std::string out = "\"";
+  for (char c : text) {
+    if (c == '"')
+      out += '"';
+    out += c;
+  }
+  out += '"';
+  return out;
+}
+
+void WriteCsvRow(std::ostream& out, const std::vector<std::string>& cells) {
+  for (size_t i = 0; i < cells.size(); ++i) {
+    if (i)
+      out << ",";
+    out << EscapeCsv(cells[i]);
+  }
+  out << "\n";
+}
+
+} // namespace SceneTableFormat
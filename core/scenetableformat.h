@@ -0,0 +1,44 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Column headers and cell text of the fixture and truss tables. The tables
+// in the main window, their CSV export and the CSV files written by
+// perastage-cli all go through these, so the outputs stay comparable.
+namespace SceneTableFormat {
+    const std::vector<std::string>& FixtureColumns();
+    const std::vector<std::string>& TrussColumns();
+
+    // Millimetres shown as metres with three decimals, as positions are.
+    std::string Position(float mm);
+    // Degrees with one decimal and a degree sign.
+    std::string Angle(float degrees);
+    // Millimetres shown as metres with two decimals, as truss sizes are.
+    std::string Metres(float mm);
+    // Like Metres, but empty for sizes that were never set.
+    std::string OptionalMetres(float mm);
+    std::string Decimal(float value, int decimals);
+
+    // Quotes a cell when it holds a comma, quote or line break.
+    std::string EscapeCsv(const std::string& text);
+    void WriteCsvRow(std::ostream& out, const std::vector<std::string>& cells);
+}
@@ -17,35 +17,100 @@
  */
 #include "trussloader.h"
 #include "json.hpp"
-#include <wx/wfstream.h>
+#include <wx/mstream.h>
 #include <wx/zipstrm.h>
 #include <wx/filename.h>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
-#include <random>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using nlohmann::json;
 
-bool LoadTrussArchive(const std::string &archivePath, Truss &outTruss) {
-  namespace fs = std::filesystem;
-  wxFileInputStream input(archivePath);
+namespace {
+namespace fs = std::filesystem;
+
+// Everything LoadTrussArchive reports that only depends on archive content.
+struct CachedTrussArchive {
+  std::string symbolFile;
+  std::string name;
+  std::string manufacturer;
+  std::string model;
+  std::string crossSection;
+  float lengthMm = 0.0f;
+  float widthMm = 0.0f;
+  float heightMm = 0.0f;
+  float weightKg = 0.0f;
+};
+
+// Lets a repeated load of an unchanged file skip reading and hashing it.
+struct ArchiveStamp {
+  uintmax_t size = 0;
+  fs::file_time_type writeTime;
+  uint64_t contentHash = 0;
+};
+
+struct TrussArchiveCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, ArchiveStamp> stampsByPath;
+  std::unordered_map<uint64_t, CachedTrussArchive> archivesByHash;
+};
+
+TrussArchiveCache &Cache() {
+  static TrussArchiveCache cache;
+  return cache;
+}
+
+uint64_t HashContent(const std::vector<char> &data) {
+  // FNV-1a over the size and then the bytes, so archives of different
+  // lengths are mixed from the first step.
+  uint64_t hash = 1469598103934665603ull;
+  auto mix = [&hash](unsigned char byte) {
+    hash ^= byte;
+    hash *= 1099511628211ull;
+  };
+  uint64_t size = static_cast<uint64_t>(data.size());
+  for (int i = 0; i < 8; ++i, size >>= 8)
+    mix(static_cast<unsigned char>(size & 0xFF));
+  for (char c : data)
+    mix(static_cast<unsigned char>(c));
+  return hash;
+}
+
+std::string HashToHex(uint64_t hash) {
+  static const char hex[] = "0123456789abcdef";
+  std::string out(16, '0');
+  for (int i = 15; i >= 0; --i) {
+    out[static_cast<size_t>(i)] = hex[hash & 0xF];
+    hash >>= 4;
+  }
+  return out;
+}
+
+bool ReadFileBytes(const std::string &path, std::vector<char> &out) {
+  std::ifstream file(fs::u8path(path), std::ios::binary);
+  if (!file.is_open())
+    return false;
+  out.assign(std::istreambuf_iterator<char>(file),
+             std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+// Extracts the metadata and model of an archive held in memory into
+// `baseDir`. The directory is named after the content hash, so extracting
+// the same archive again rewrites the same files.
+bool ExtractTrussArchive(const std::vector<char> &data, const fs::path &baseDir,
+                         CachedTrussArchive &out) {
+  wxMemoryInputStream input(data.data(), data.size());
   if (!input.IsOk())
     return false;
-  outTruss.modelFile = archivePath;
   wxZipInputStream zip(input);
   std::unique_ptr<wxZipEntry> entry;
   std::string meta;
-  fs::path baseDir = fs::temp_directory_path();
-  std::string uniqueName = "perastage-truss-";
-  {
-    static const char hex[] = "0123456789abcdef";
-    std::random_device rd;
-    std::uniform_int_distribution<int> dist(0, 15);
-    for (int i = 0; i < 6; ++i)
-      uniqueName += hex[dist(rd)];
-  }
-  baseDir /= uniqueName;
   wxFileName::Mkdir(baseDir.string(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
   while ((entry.reset(zip.GetNextEntry())), entry) {
     std::string name = entry->GetName().ToStdString();
@@ -68,8 +133,8 @@ bool LoadTrussArchive(const std::string &archivePath, Truss &outTruss) {
       fs::path dest = baseDir / fs::path(name).filename();
       wxFileName::Mkdir(dest.parent_path().string(), wxS_DIR_DEFAULT,
                         wxPATH_MKDIR_FULL);
-      std::ofstream out(dest, std::ios::binary);
-      if (!out.is_open())
+      std::ofstream file(dest, std::ios::binary);
+      if (!file.is_open())
         return false;
       char buf[4096];
       while (true) {
@@ -77,25 +142,97 @@ bool LoadTrussArchive(const std::string &archivePath, Truss &outTruss) {
         size_t bytes = zip.LastRead();
         if (bytes == 0)
           break;
-        out.write(buf, bytes);
+        file.write(buf, bytes);
       }
-      out.close();
-      outTruss.symbolFile = dest.string();
+      file.close();
+      out.symbolFile = dest.string();
     }
   }
-  if (meta.empty() || outTruss.symbolFile.empty())
+  if (meta.empty() || out.symbolFile.empty())
     return false;
   json j = json::parse(meta, nullptr, false);
   if (j.is_discarded())
     return false;
-  outTruss.name = j.value("Name", "");
-  outTruss.manufacturer = j.value("Manufacturer", "");
-  outTruss.model = j.value("Model", "");
-  outTruss.lengthMm = j.value("Length_mm", 0.0f);
-  outTruss.widthMm = j.value("Width_mm", 0.0f);
-  outTruss.heightMm = j.value("Height_mm", 0.0f);
-  outTruss.weightKg = j.value("Weight_kg", 0.0f);
-  outTruss.crossSection = j.value("CrossSection", "");
+  out.name = j.value("Name", "");
+  out.manufacturer = j.value("Manufacturer", "");
+  out.model = j.value("Model", "");
+  out.lengthMm = j.value("Length_mm", 0.0f);
+  out.widthMm = j.value("Width_mm", 0.0f);
+  out.heightMm = j.value("Height_mm", 0.0f);
+  out.weightKg = j.value("Weight_kg", 0.0f);
+  out.crossSection = j.value("CrossSection", "");
+  return true;
+}
+
+void ApplyCachedArchive(const CachedTrussArchive &cached, Truss &outTruss) {
+  outTruss.symbolFile = cached.symbolFile;
+  outTruss.name = cached.name;
+  outTruss.manufacturer = cached.manufacturer;
+  outTruss.model = cached.model;
+  outTruss.lengthMm = cached.lengthMm;
+  outTruss.widthMm = cached.widthMm;
+  outTruss.heightMm = cached.heightMm;
+  outTruss.weightKg = cached.weightKg;
+  outTruss.crossSection = cached.crossSection;
+}
+} // namespace
+
+bool LoadTrussArchive(const std::string &archivePath, Truss &outTruss) {
+  std::error_code ec;
+  const fs::path path = fs::u8path(archivePath);
+  const uintmax_t size = fs::file_size(path, ec);
+  if (ec)
+    return false;
+  const fs::file_time_type writeTime = fs::last_write_time(path, ec);
+  if (ec)
+    return false;
+
+  TrussArchiveCache &cache = Cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+
+  // The extracted model lives in the temp directory, which may have been
+  // cleaned since it was cached; a missing file is extracted again.
+  auto extractedExists = [](const CachedTrussArchive &cached) {
+    std::error_code existsEc;
+    return fs::exists(fs::u8path(cached.symbolFile), existsEc);
+  };
+
+  auto stamp = cache.stampsByPath.find(archivePath);
+  if (stamp != cache.stampsByPath.end() && stamp->second.size == size &&
+      stamp->second.writeTime == writeTime) {
+    auto cached = cache.archivesByHash.find(stamp->second.contentHash);
+    if (cached != cache.archivesByHash.end() &&
+        extractedExists(cached->second)) {
+      outTruss.modelFile = archivePath;
+      ApplyCachedArchive(cached->second, outTruss);
+      return true;
+    }
+  }
+
+  std::vector<char> data;
+  if (!ReadFileBytes(archivePath, data))
+    return false;
+  const uint64_t hash = HashContent(data);
+  outTruss.modelFile = archivePath;
+
+  auto cached = cache.archivesByHash.find(hash);
+  if (cached == cache.archivesByHash.end() || !extractedExists(cached->second)) {
+    CachedTrussArchive extracted;
+    const fs::path baseDir =
+        fs::temp_directory_path() / ("perastage-truss-" + HashToHex(hash));
+    if (!ExtractTrussArchive(data, baseDir, extracted))
+      return false;
+    cached = cache.archivesByHash.insert_or_assign(hash, std::move(extracted))
+                 .first;
+  }
+  cache.stampsByPath[archivePath] = ArchiveStamp{size, writeTime, hash};
+  ApplyCachedArchive(cached->second, outTruss);
   return true;
 }
 
+void ClearTrussArchiveCache() {
+  TrussArchiveCache &cache = Cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.stampsByPath.clear();
+  cache.archivesByHash.clear();
+}
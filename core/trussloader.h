@@ -19,5 +19,13 @@
 #include <string>
 #include "truss.h"
 
-// Loads a .gtruss archive extracting metadata and model path
+// Loads a .gtruss archive extracting metadata and model path. Archives are
+// cached by content: every archive with the same bytes shares one extracted
+// model file, so the viewer loads and uploads its mesh only once no matter
+// how many truss pieces or archive copies refer to it.
 bool LoadTrussArchive(const std::string &archivePath, Truss &outTruss);
+
+// Forgets every cached archive, e.g. when the project is closed. Extracted
+// files stay on disk and are overwritten the next time the same archive is
+// loaded.
+void ClearTrussArchiveCache();
@@ -21,8 +21,9 @@
 #include <random>
 
 std::string GenerateUuid() {
-  static std::mt19937_64 rng{std::random_device{}()};
-  static std::uniform_int_distribution<int> dist(0, 15);
+  // Per thread, since exports run on worker threads too.
+  thread_local std::mt19937_64 rng{std::random_device{}()};
+  std::uniform_int_distribution<int> dist(0, 15);
   const char *v = "0123456789abcdef";
   int groups[] = {8, 4, 4, 4, 12};
   std::string out;
@@ -0,0 +1,129 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fixed-size pool of worker threads for CPU-bound background work such as
+// encoding and compressing export streams. Tasks run in submission order on
+// whichever worker is free.
+class WorkerPool {
+public:
+  // threadCount == 0 picks std::thread::hardware_concurrency().
+  explicit WorkerPool(size_t threadCount = 0);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  // Process-wide pool shared by exporters and importers.
+  static WorkerPool &Shared();
+
+  size_t ThreadCount() const { return threads_.size(); }
+
+  template <typename Fn>
+  auto Submit(Fn &&fn) -> std::future<std::invoke_result_t<std::decay_t<Fn>>> {
+    using Result = std::invoke_result_t<std::decay_t<Fn>>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<Fn>(fn));
+    std::future<Result> future = task->get_future();
+    Enqueue([task]() { (*task)(); });
+    return future;
+  }
+
+private:
+  void Enqueue(std::function<void()> task);
+  void Run();
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::queue<std::function<void()>> tasks_;
+  bool stopping_ = false;
+};
+
+// Calls fn(i) for every i in [0, count) using the pool and returns once all
+// calls finished. The calling thread takes part in the loop, so nested calls
+// from inside pool tasks cannot deadlock. The first exception thrown by fn is
+// rethrown on the calling thread after the remaining indices complete.
+template <typename Fn>
+void ParallelFor(size_t count, Fn &&fn,
+                 WorkerPool &pool = WorkerPool::Shared()) {
+  if (count == 0)
+    return;
+  if (count == 1 || pool.ThreadCount() == 0) {
+    for (size_t i = 0; i < count; ++i)
+      fn(i);
+    return;
+  }
+
+  struct State {
+    std::atomic<size_t> next{0};
+    size_t done = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<State>();
+  // Helpers that start after every index was claimed never touch fn, so the
+  // reference capture stays valid for all work that actually runs.
+  auto drain = [state, count, &fn]() {
+    size_t completed = 0;
+    std::exception_ptr error;
+    for (size_t i = state->next++; i < count; i = state->next++) {
+      try {
+        fn(i);
+      } catch (...) {
+        if (!error)
+          error = std::current_exception();
+      }
+      ++completed;
+    }
+    if (completed == 0)
+      return;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (error && !state->error)
+      state->error = error;
+    state->done += completed;
+    if (state->done == count)
+      state->cv.notify_all();
+  };
+
+  const size_t helpers = std::min(pool.ThreadCount(), count - 1);
+  for (size_t h = 0; h < helpers; ++h)
+    pool.Submit(drain);
+  drain();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cv.wait(lock, [&]() { return state->done == count; });
+  if (state->error)
+    std::rethrow_exception(state->error);
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "autopatchdialog.h"
+
+#include <algorithm>
+
+#include <wx/checkbox.h>
+#include <wx/scrolwin.h>
+#include <wx/sizer.h>
+#include <wx/spinctrl.h>
+#include <wx/stattext.h>
+
+namespace {
+constexpr int kMaxUniverse = 32767;
+} // namespace
+
+AutoPatchDialog::AutoPatchDialog(
+    wxWindow *parent, size_t selectedCount,
+    const std::vector<std::string> &positions,
+    const std::map<std::string, int> &positionUniverses)
+    : wxDialog(parent, wxID_ANY, "Auto patch (pack universes)",
+               wxDefaultPosition, wxDefaultSize,
+               wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER) {
+  wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+  lockSelectedCtrl = new wxCheckBox(
+      this, wxID_ANY,
+      wxString::Format("Keep the address of the %zu selected fixtures",
+                       selectedCount));
+  lockSelectedCtrl->SetValue(selectedCount > 0);
+  lockSelectedCtrl->Enable(selectedCount > 0);
+  mainSizer->Add(lockSelectedCtrl, 0, wxALL, 10);
+
+  mainSizer->Add(new wxStaticText(this, wxID_ANY,
+                                  "Preferred universe per hang position "
+                                  "(0 = first universe that fits):"),
+                 0, wxLEFT | wxRIGHT, 10);
+
+  if (positions.empty()) {
+    mainSizer->Add(
+        new wxStaticText(this, wxID_ANY, "No fixture has a hang position."), 0,
+        wxALL, 10);
+  } else {
+    wxScrolledWindow *scroll = new wxScrolledWindow(this, wxID_ANY);
+    scroll->SetScrollRate(0, 10);
+    wxFlexGridSizer *grid = new wxFlexGridSizer(2, 5, 10);
+    for (const auto &position : positions) {
+      grid->Add(
+          new wxStaticText(scroll, wxID_ANY, wxString::FromUTF8(position)), 0,
+          wxALIGN_CENTER_VERTICAL);
+      int universe = 0;
+      if (auto it = positionUniverses.find(position);
+          it != positionUniverses.end())
+        universe = it->second;
+      wxSpinCtrl *ctrl = new wxSpinCtrl(scroll, wxID_ANY, wxEmptyString,
+                                        wxDefaultPosition, wxSize(80, -1),
+                                        wxSP_ARROW_KEYS, 0, kMaxUniverse,
+                                        universe);
+      grid->Add(ctrl, 0);
+      universeCtrls.emplace_back(position, ctrl);
+    }
+    grid->AddGrowableCol(0, 1);
+    scroll->SetSizer(grid);
+    scroll->FitInside();
+    scroll->SetMinSize(
+        wxSize(grid->GetMinSize().x + 20,
+               std::min(grid->GetMinSize().y, FromDIP(300))));
+    mainSizer->Add(scroll, 1, wxEXPAND | wxALL, 10);
+  }
+
+  mainSizer->Add(CreateSeparatedButtonSizer(wxOK | wxCANCEL), 0,
+                 wxEXPAND | wxALL, 10);
+  SetSizerAndFit(mainSizer);
+}
+
+bool AutoPatchDialog::GetLockSelected() const {
+  return lockSelectedCtrl->IsEnabled() && lockSelectedCtrl->GetValue();
+}
+
+std::map<std::string, int> AutoPatchDialog::GetPositionUniverses() const {
+  std::map<std::string, int> result;
+  for (const auto &[position, ctrl] : universeCtrls) {
+    if (ctrl->GetValue() > 0)
+      result[position] = ctrl->GetValue();
+  }
+  return result;
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <wx/dialog.h>
+
+class wxCheckBox;
+class wxSpinCtrl;
+
+// Options for the packed auto patch: whether the selected fixtures keep
+// their address, and which universe each hang position should try first.
+class AutoPatchDialog : public wxDialog {
+public:
+  AutoPatchDialog(wxWindow *parent, size_t selectedCount,
+                  const std::vector<std::string> &positions,
+                  const std::map<std::string, int> &positionUniverses);
+
+  bool GetLockSelected() const;
+  // Positions left at "Any" are omitted.
+  std::map<std::string, int> GetPositionUniverses() const;
+
+private:
+  wxCheckBox *lockSelectedCtrl = nullptr;
+  std::vector<std::pair<std::string, wxSpinCtrl *>> universeCtrls;
+};
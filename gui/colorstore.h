@@ -17,11 +17,19 @@
  */
 #pragma once
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <wx/dataview.h>
 
 class ColorfulDataViewListStore : public wxDataViewListStore {
 public:
+  // Produces the value of one cell of a virtual row on demand. `source` is
+  // the row's position in the list passed to ResetRows(); it stays attached
+  // to the row when other rows are inserted or deleted.
+  using CellProvider =
+      std::function<void(size_t source, unsigned col, wxVariant &value)>;
+
   std::vector<wxDataViewItemAttr> rowAttrs;
   std::vector<std::vector<wxDataViewItemAttr>> cellAttrs;
   std::vector<bool> selectionRows;
@@ -68,6 +76,9 @@ public:
     rowAttrs.emplace_back();
     cellAttrs.emplace_back();
     selectionRows.push_back(false);
+    loadedCells.push_back(kAllCellsLoaded);
+    editedRows.push_back(true);
+    sourceRows.push_back(kNoSource);
   }
 
   void PrependItem(const wxVector<wxVariant> &values, wxUIntPtr data = 0) {
@@ -75,6 +86,9 @@ public:
     rowAttrs.insert(rowAttrs.begin(), wxDataViewItemAttr());
     cellAttrs.insert(cellAttrs.begin(), std::vector<wxDataViewItemAttr>());
     selectionRows.insert(selectionRows.begin(), false);
+    loadedCells.insert(loadedCells.begin(), kAllCellsLoaded);
+    editedRows.insert(editedRows.begin(), true);
+    sourceRows.insert(sourceRows.begin(), kNoSource);
   }
 
   void InsertItem(unsigned row, const wxVector<wxVariant> &values,
@@ -84,6 +98,9 @@ public:
     cellAttrs.insert(cellAttrs.begin() + row,
                      std::vector<wxDataViewItemAttr>());
     selectionRows.insert(selectionRows.begin() + row, false);
+    loadedCells.insert(loadedCells.begin() + row, kAllCellsLoaded);
+    editedRows.insert(editedRows.begin() + row, true);
+    sourceRows.insert(sourceRows.begin() + row, kNoSource);
   }
 
   void DeleteItem(unsigned row) {
@@ -94,6 +111,12 @@ public:
       cellAttrs.erase(cellAttrs.begin() + row);
     if (row < selectionRows.size())
       selectionRows.erase(selectionRows.begin() + row);
+    if (row < loadedCells.size())
+      loadedCells.erase(loadedCells.begin() + row);
+    if (row < editedRows.size())
+      editedRows.erase(editedRows.begin() + row);
+    if (row < sourceRows.size())
+      sourceRows.erase(sourceRows.begin() + row);
   }
 
   void DeleteAllItems() {
@@ -101,6 +124,75 @@ public:
     rowAttrs.clear();
     cellAttrs.clear();
     selectionRows.clear();
+    loadedCells.clear();
+    editedRows.clear();
+    sourceRows.clear();
+    cellProvider = nullptr;
+  }
+
+  // Replaces the contents with `data.size()` virtual rows in a single model
+  // reset. A cell is filled by `provider` the first time it is read (painted,
+  // sorted or inspected) and cached until RefreshRow(), so opening a large
+  // table only formats the rows that are actually shown. `data` becomes the
+  // item data of each row and its index is the row's source for `provider`.
+  void ResetRows(const std::vector<wxUIntPtr> &data, CellProvider provider) {
+    for (wxDataViewListStoreLine *line : m_data)
+      delete line;
+    m_data.clear();
+    m_data.reserve(data.size());
+    const size_t columnCount = GetColumnCount();
+    for (wxUIntPtr value : data) {
+      auto *line = new wxDataViewListStoreLine(value);
+      line->m_values.resize(columnCount);
+      m_data.push_back(line);
+    }
+    cellProvider = std::move(provider);
+    rowAttrs.assign(data.size(), wxDataViewItemAttr());
+    cellAttrs.assign(data.size(), std::vector<wxDataViewItemAttr>());
+    selectionRows.assign(data.size(), false);
+    loadedCells.assign(data.size(), 0);
+    editedRows.assign(data.size(), false);
+    sourceRows.resize(data.size());
+    for (size_t i = 0; i < sourceRows.size(); ++i)
+      sourceRows[i] = i;
+    Reset(static_cast<unsigned>(data.size()));
+  }
+
+  // Drops the cached cells of a virtual row so they are read again from the
+  // provider, and asks the control to repaint just that row. Edited rows keep
+  // their values unless `discardEdits` is set, e.g. once the edits were
+  // written back to the source.
+  void RefreshRow(unsigned row, bool discardEdits = false) {
+    if (row >= GetItemCount())
+      return;
+    if (cellProvider && row < loadedCells.size() &&
+        sourceRows[row] != kNoSource && (discardEdits || !editedRows[row])) {
+      loadedCells[row] = 0;
+      editedRows[row] = false;
+    }
+    RowChanged(row);
+  }
+
+  // True once any cell of the row was written through SetValueByRow (or the
+  // row was added with explicit values). Rows that were never edited still
+  // mirror their source and need no write-back.
+  bool IsRowEdited(unsigned row) const {
+    return row < editedRows.size() ? editedRows[row] : true;
+  }
+
+  void GetValueByRow(wxVariant &value, unsigned row,
+                     unsigned col) const override {
+    LoadCell(row, col);
+    wxDataViewListStore::GetValueByRow(value, row, col);
+  }
+
+  bool SetValueByRow(const wxVariant &value, unsigned row,
+                     unsigned col) override {
+    if (row < loadedCells.size() && col < 64)
+      loadedCells[row] |= uint64_t{1} << col;
+    if (row < editedRows.size())
+      editedRows[row] = true;
+    return wxDataViewListStore::SetValueByRow(value, row, col);
   }
 
   void SetRowBackgroundColour(unsigned row, const wxColour &colour) {
@@ -112,7 +204,7 @@ public:
   }
 
   void ClearRowBackground(unsigned row) {
-    if (row < rowAttrs.size()) {
+    if (row < rowAttrs.size() && rowAttrs[row].HasBackgroundColour()) {
       wxColour fg;
       bool hasFg = rowAttrs[row].HasColour();
       if (hasFg)
@@ -134,7 +226,7 @@ public:
   }
 
   void ClearRowTextColour(unsigned row) {
-    if (row < rowAttrs.size()) {
+    if (row < rowAttrs.size() && rowAttrs[row].HasColour()) {
       wxColour bg;
       bool hasBg = rowAttrs[row].HasBackgroundColour();
       if (hasBg)
@@ -158,7 +250,8 @@ public:
   }
 
   void ClearCellTextColour(unsigned row, unsigned col) {
-    if (row >= cellAttrs.size() || col >= cellAttrs[row].size())
+    if (row >= cellAttrs.size() || col >= cellAttrs[row].size() ||
+        cellAttrs[row][col].IsDefault())
       return;
     cellAttrs[row][col] = wxDataViewItemAttr();
     if (row < GetItemCount())
@@ -231,4 +324,29 @@ public:
     }
     return wxDataViewListStore::Compare(item1, item2, column, ascending);
   }
+
+private:
+  static constexpr uint64_t kAllCellsLoaded = ~uint64_t{0};
+  static constexpr size_t kNoSource = static_cast<size_t>(-1);
+
+  void LoadCell(unsigned row, unsigned col) const {
+    // The bookkeeping is only trusted while it matches the base store, which
+    // wxDataViewListCtrl can clear behind our back.
+    if (!cellProvider || loadedCells.size() != m_data.size() ||
+        row >= loadedCells.size() || col >= 64 || sourceRows[row] == kNoSource)
+      return;
+    const uint64_t bit = uint64_t{1} << col;
+    if (loadedCells[row] & bit)
+      return;
+    loadedCells[row] |= bit;
+    wxDataViewListStoreLine *line = m_data[row];
+    if (col < line->m_values.size())
+      cellProvider(sourceRows[row], col, line->m_values[col]);
+  }
+
+  CellProvider cellProvider;
+  // One bit per column (up to 64) of every virtual row.
+  mutable std::vector<uint64_t> loadedCells;
+  std::vector<bool> editedRows;
+  std::vector<size_t> sourceRows;
 };
@@ -21,6 +21,7 @@
 #include "fixturetablepanel.h"
 #include "mainwindow.h"
 #include "matrixutils.h"
+#include "sceneedittransaction.h"
 #include "sceneobjecttablepanel.h"
 #include "trusstablepanel.h"
 #include "viewer2dpanel.h"
@@ -30,6 +31,8 @@
 #include <cctype>
 #include <exception>
 #include <sstream>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 ConsolePanel::ConsolePanel(wxWindow *parent) : wxPanel(parent, wxID_ANY) {
@@ -60,6 +63,36 @@ ConsolePanel::ConsolePanel(wxWindow *parent) : wxPanel(parent, wxID_ANY) {
   sizer->Add(m_textCtrl, 1, wxEXPAND | wxALL, 5);
   sizer->Add(m_inputCtrl, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 5);
   SetSizer(sizer);
+
+  m_sceneListener =
+      GetDefaultGuiConfigServices().LegacyConfigManager().GetSceneJournal().Subscribe(
+          [this](const SceneChangeSet &changes) { OnSceneChanged(changes); });
+}
+
+ConsolePanel::~ConsolePanel() {
+  GetDefaultGuiConfigServices().LegacyConfigManager().GetSceneJournal().Unsubscribe(
+      m_sceneListener);
+}
+
+const SceneEntityIndex &ConsolePanel::EntityIndex() {
+  ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
+  const auto &scene = std::as_const(cfg).GetScene();
+  // Not every edit path reports to the journal. Any revision the index has
+  // not seen, or a count that no longer matches, means a full rebuild.
+  if (!m_entityIndex.IsBuilt() ||
+      m_entityIndexRevision != cfg.GetSceneRevision() ||
+      m_entityIndex.Size(SceneEntityKind::Fixture) != scene.fixtures.size() ||
+      m_entityIndex.Size(SceneEntityKind::Truss) != scene.trusses.size()) {
+    m_entityIndex.Rebuild(scene);
+    m_entityIndexRevision = cfg.GetSceneRevision();
+  }
+  return m_entityIndex;
+}
+
+void ConsolePanel::OnSceneChanged(const SceneChangeSet &changes) {
+  ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
+  m_entityIndex.Apply(changes, std::as_const(cfg).GetScene());
+  m_entityIndexRevision = cfg.GetSceneRevision();
 }
 
 void ConsolePanel::AppendMessage(const wxString &msg) {
@@ -101,6 +134,10 @@ ConsolePanel *ConsolePanel::Instance() { return s_instance; }
 
 void ConsolePanel::SetInstance(ConsolePanel *panel) { s_instance = panel; }
 
+void ConsolePanel::SetCancelHandler(std::function<void()> handler) {
+  m_cancelHandler = std::move(handler);
+}
+
 void ConsolePanel::OnScroll(wxScrollWinEvent &event) {
   if (!m_textCtrl) {
     event.Skip();
@@ -307,13 +344,39 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
 
     ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
 
+    if (lower == "cancel") {
+      if (m_cancelHandler)
+        m_cancelHandler();
+      else
+        AppendMessage("Nothing to cancel");
+      return;
+    }
+
+    // The whole command is one edit: one undo state, one change set and
+    // one refresh of the tables and viewers once every word has run.
+    SceneEditTransaction edit(cfg, "cli " + cmd);
+    bool syncFixtureTable = false;
+    bool syncTrussTable = false;
+    bool syncSceneObjectTable = false;
+    bool syncViewers = false;
+    std::vector<std::string> viewerSelection;
+    auto showSelection = [&](bool fixtures,
+                             const std::vector<std::string> &sel) {
+      (fixtures ? syncFixtureTable : syncTrussTable) = true;
+      syncViewers = true;
+      viewerSelection = sel;
+    };
+
     auto handleSelection = [&](bool fixtures, bool clearSel,
                                const std::vector<std::string> &tokens) {
-      auto &scene = cfg.GetScene();
+      const SceneEntityKind kind =
+          fixtures ? SceneEntityKind::Fixture : SceneEntityKind::Truss;
+      const SceneEntityIndex &index = EntityIndex();
       std::vector<std::string> current =
           clearSel ? std::vector<std::string>()
                    : (fixtures ? cfg.GetSelectedFixtures()
                                : cfg.GetSelectedTrusses());
+      std::unordered_set<std::string> selected(current.begin(), current.end());
       auto parseId = [&](const std::string &token, int &value) {
         if (token.empty()) {
           AppendMessage("Invalid selection id: empty token");
@@ -329,43 +392,22 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
         }
         return true;
       };
-      auto addId = [&](int id) {
-        std::string uid;
-        if (fixtures) {
-          for (const auto &[u, f] : scene.fixtures)
-            if (f.fixtureId == id) {
-              uid = u;
-              break;
-            }
-        } else {
-          for (const auto &[u, t] : scene.trusses)
-            if (t.unitNumber == id) {
-              uid = u;
-              break;
-            }
-        }
-        if (!uid.empty() &&
-            std::find(current.begin(), current.end(), uid) == current.end())
-          current.push_back(uid);
-      };
-      auto removeId = [&](int id) {
-        auto it = current.begin();
-        while (it != current.end()) {
-          int fid = -1;
-          if (fixtures) {
-            auto fit = scene.fixtures.find(*it);
-            if (fit != scene.fixtures.end())
-              fid = fit->second.fixtureId;
-          } else {
-            auto fit = scene.trusses.find(*it);
-            if (fit != scene.trusses.end())
-              fid = fit->second.unitNumber;
-          }
-          if (fid == id)
-            it = current.erase(it);
-          else
-            ++it;
+      auto apply = [&](char mode, const std::vector<std::string> &uuids) {
+        if (mode == '+') {
+          for (const auto &uid : uuids)
+            if (selected.insert(uid).second)
+              current.push_back(uid);
+          return;
         }
+        bool removed = false;
+        for (const auto &uid : uuids)
+          removed |= selected.erase(uid) > 0;
+        if (removed)
+          current.erase(std::remove_if(current.begin(), current.end(),
+                                       [&](const std::string &uid) {
+                                         return !selected.count(uid);
+                                       }),
+                        current.end());
       };
       std::vector<std::string> normalized = NormalizeRangeTokens(tokens);
       char mode = '+';
@@ -376,6 +418,15 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
           ++i;
           continue;
         }
+        // A word that is not a number may be a fixture or truss name.
+        if (!isNumberToken(tok)) {
+          std::vector<std::string> named = index.FindByName(kind, tok);
+          if (!named.empty()) {
+            apply(mode, named);
+            ++i;
+            continue;
+          }
+        }
         int a = 0;
         if (!parseId(tok, a))
           return;
@@ -386,36 +437,18 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
             return;
           if (a > b)
             std::swap(a, b);
-          for (int n = a; n <= b; ++n) {
-            if (mode == '+')
-              addId(n);
-            else
-              removeId(n);
-          }
+          apply(mode, index.Range(kind, a, b));
           i += 2;
         } else {
-          if (mode == '+')
-            addId(a);
-          else
-            removeId(a);
+          apply(mode, index.Range(kind, a, a));
           ++i;
         }
       }
-      if (fixtures) {
+      if (fixtures)
         cfg.SetSelectedFixtures(current);
-        if (FixtureTablePanel::Instance())
-          FixtureTablePanel::Instance()->SelectByUuid(current);
-      } else {
+      else
         cfg.SetSelectedTrusses(current);
-        if (TrussTablePanel::Instance())
-          TrussTablePanel::Instance()->SelectByUuid(current);
-      }
-      if (Viewer2DPanel::Instance())
-        Viewer2DPanel::Instance()->SetSelectedUuids(current);
-      if (Viewer3DPanel::Instance()) {
-        Viewer3DPanel::Instance()->SetSelectedFixtures(current);
-        Viewer3DPanel::Instance()->Refresh();
-      }
+      showSelection(fixtures, current);
     };
 
     auto applyPos = [&](const std::vector<std::string> &sel, bool fixtures,
@@ -423,7 +456,6 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
                         bool relative) {
       if (sel.empty() || vals.empty())
         return;
-      auto &scene = cfg.GetScene();
       size_t n = sel.size();
       float start = vals[0];
       float end = vals.size() > 1 ? vals[1] : vals[0];
@@ -432,23 +464,20 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
                       ? start + (end - start) * (float)i / (float)(n - 1)
                       : start;
         v *= 1000.0f;
+        Matrix *transform = nullptr;
         if (fixtures) {
-          auto it = scene.fixtures.find(sel[i]);
-          if (it != scene.fixtures.end()) {
-            if (relative)
-              it->second.transform.o[axis] += v;
-            else
-              it->second.transform.o[axis] = v;
-          }
+          if (Fixture *f = edit.EditFixture(sel[i], SceneComponent::Transform))
+            transform = &f->transform;
         } else {
-          auto it = scene.trusses.find(sel[i]);
-          if (it != scene.trusses.end()) {
-            if (relative)
-              it->second.transform.o[axis] += v;
-            else
-              it->second.transform.o[axis] = v;
-          }
+          if (Truss *t = edit.EditTruss(sel[i], SceneComponent::Transform))
+            transform = &t->transform;
         }
+        if (!transform)
+          continue;
+        if (relative)
+          transform->o[axis] += v;
+        else
+          transform->o[axis] = v;
       }
     };
 
@@ -457,45 +486,37 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
                         bool relative) {
       if (sel.empty() || vals.empty())
         return;
-      auto &scene = cfg.GetScene();
       size_t n = sel.size();
       float start = vals[0];
       float end = vals.size() > 1 ? vals[1] : vals[0];
+      int eAxis = 0;
+      switch (axis) {
+      case 0: eAxis = 2; break; // roll (X)
+      case 1: eAxis = 1; break; // pitch (Y)
+      default: eAxis = 0; break; // yaw (Z)
+      }
       for (size_t i = 0; i < n; i++) {
         float ang = (vals.size() > 1 && n > 1)
                         ? start + (end - start) * (float)i / (float)(n - 1)
                         : start;
-        int eAxis = 0;
-        switch (axis) {
-        case 0: eAxis = 2; break; // roll (X)
-        case 1: eAxis = 1; break; // pitch (Y)
-        default: eAxis = 0; break; // yaw (Z)
-        }
+        Matrix *transform = nullptr;
         if (fixtures) {
-          auto it = scene.fixtures.find(sel[i]);
-          if (it != scene.fixtures.end()) {
-            auto e = MatrixUtils::MatrixToEuler(it->second.transform);
-            if (relative)
-              e[eAxis] += ang;
-            else
-              e[eAxis] = ang;
-            Matrix m = MatrixUtils::EulerToMatrix(e[0], e[1], e[2]);
-            m.o = it->second.transform.o;
-            it->second.transform = m;
-          }
+          if (Fixture *f = edit.EditFixture(sel[i], SceneComponent::Transform))
+            transform = &f->transform;
         } else {
-          auto it = scene.trusses.find(sel[i]);
-          if (it != scene.trusses.end()) {
-            auto e = MatrixUtils::MatrixToEuler(it->second.transform);
-            if (relative)
-              e[eAxis] += ang;
-            else
-              e[eAxis] = ang;
-            Matrix m = MatrixUtils::EulerToMatrix(e[0], e[1], e[2]);
-            m.o = it->second.transform.o;
-            it->second.transform = m;
-          }
+          if (Truss *t = edit.EditTruss(sel[i], SceneComponent::Transform))
+            transform = &t->transform;
         }
+        if (!transform)
+          continue;
+        auto e = MatrixUtils::MatrixToEuler(*transform);
+        if (relative)
+          e[eAxis] += ang;
+        else
+          e[eAxis] = ang;
+        Matrix m = MatrixUtils::EulerToMatrix(e[0], e[1], e[2]);
+        m.o = transform->o;
+        *transform = m;
       }
     };
 
@@ -519,28 +540,6 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
       return vals;
     };
 
-    auto refreshSelectionAfterTransform =
-        [&](const std::vector<std::string> &sel, bool fixtures) {
-          if (fixtures) {
-            if (FixtureTablePanel::Instance()) {
-              FixtureTablePanel::Instance()->ReloadData();
-              FixtureTablePanel::Instance()->SelectByUuid(sel);
-            }
-          } else {
-            if (TrussTablePanel::Instance()) {
-              TrussTablePanel::Instance()->ReloadData();
-              TrussTablePanel::Instance()->SelectByUuid(sel);
-            }
-          }
-          if (Viewer3DPanel::Instance()) {
-            Viewer3DPanel::Instance()->SetSelectedFixtures(sel);
-            Viewer3DPanel::Instance()->UpdateScene();
-            Viewer3DPanel::Instance()->Refresh();
-          }
-          if (Viewer2DPanel::Instance())
-            Viewer2DPanel::Instance()->SetSelectedUuids(sel);
-        };
-
     auto isCmd = [](const std::string &tok, bool allowAxis,
                     bool allowRangeSeparator) {
       if (tok.empty())
@@ -564,6 +563,7 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
     while (ts >> tok)
       tokens.push_back(tok);
 
+    bool syntaxError = false;
     size_t i = 0;
     while (i < tokens.size()) {
       std::string word = tokens[i];
@@ -579,25 +579,15 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
         ++j;
 
       if (lw == "clear") {
-        cfg.PushUndoState("cli clear");
+        edit.SaveUndoState();
         cfg.SetSelectedFixtures({});
         cfg.SetSelectedTrusses({});
         cfg.SetSelectedSceneObjects({});
-        if (FixtureTablePanel::Instance())
-          FixtureTablePanel::Instance()->SelectByUuid({});
-        if (TrussTablePanel::Instance())
-          TrussTablePanel::Instance()->SelectByUuid({});
-        if (SceneObjectTablePanel::Instance())
-          SceneObjectTablePanel::Instance()->SelectByUuid({});
-        if (Viewer3DPanel::Instance()) {
-          Viewer3DPanel::Instance()->SetSelectedFixtures({});
-          Viewer3DPanel::Instance()->Refresh();
-        }
-        if (Viewer2DPanel::Instance())
-          Viewer2DPanel::Instance()->SetSelectedUuids({});
+        syncFixtureTable = syncTrussTable = syncSceneObjectTable = true;
+        syncViewers = true;
+        viewerSelection.clear();
       } else if (lw == "pos" || lw == "rot") {
         bool isRot = (lw == "rot");
-        cfg.PushUndoState(std::string("cli ") + lw);
         std::string rest;
         for (size_t k = i + 1; k < j; ++k) {
           if (k > i + 1)
@@ -642,9 +632,8 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
           else
             applyPos(sel, fixtures, axis, vals, rel);
         }
-        refreshSelectionAfterTransform(sel, fixtures);
+        showSelection(fixtures, sel);
       } else if (lw == "x" || lw == "y" || lw == "z") {
-        cfg.PushUndoState("cli pos");
         std::string rest;
         for (size_t k = i + 1; k < j; ++k) {
           if (k > i + 1)
@@ -659,11 +648,10 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
         bool rel = false;
         auto vals = parseVals(rest, rel);
         applyPos(sel, fixtures, axis, vals, rel);
-        refreshSelectionAfterTransform(sel, fixtures);
+        showSelection(fixtures, sel);
       } else if (!lw.empty() && (std::isdigit(lw[0]) || lw[0] == '-' ||
                                  lw[0] == '+') &&
                  word.find(',') != std::string::npos) {
-        cfg.PushUndoState("cli pos");
         std::vector<std::string> selFixtures = cfg.GetSelectedFixtures();
         std::vector<std::string> selTrusses = cfg.GetSelectedTrusses();
         bool fixtures = !selFixtures.empty();
@@ -674,7 +662,7 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
           auto vals = parseVals(parts[idx], rel);
           applyPos(sel, fixtures, (int)idx, vals, rel);
         }
-        refreshSelectionAfterTransform(sel, fixtures);
+        showSelection(fixtures, sel);
       } else if (!lw.empty() && lw[0] == 'f') {
         std::vector<std::string> sub(tokens.begin() + i + 1,
                                      tokens.begin() + j);
@@ -685,12 +673,34 @@ void ConsolePanel::ProcessCommand(const wxString &cmdWx) {
         handleSelection(false, true, sub);
       } else {
         AppendMessage("Syntax error");
-        return;
+        syntaxError = true;
+        break;
       }
       i = j;
     }
 
-    AppendMessage("OK");
+    // Words before a syntax error have run, so their edits are kept.
+    const bool edited = edit.HasChanges();
+    edit.Commit();
+
+    if (syncFixtureTable && FixtureTablePanel::Instance())
+      FixtureTablePanel::Instance()->SelectByUuid(cfg.GetSelectedFixtures());
+    if (syncTrussTable && TrussTablePanel::Instance())
+      TrussTablePanel::Instance()->SelectByUuid(cfg.GetSelectedTrusses());
+    if (syncSceneObjectTable && SceneObjectTablePanel::Instance())
+      SceneObjectTablePanel::Instance()->SelectByUuid({});
+    if (syncViewers && Viewer2DPanel::Instance())
+      Viewer2DPanel::Instance()->SetSelectedUuids(viewerSelection);
+    if ((syncViewers || edited) && Viewer3DPanel::Instance()) {
+      if (syncViewers)
+        Viewer3DPanel::Instance()->SetSelectedFixtures(viewerSelection);
+      if (edited)
+        Viewer3DPanel::Instance()->UpdateScene();
+      Viewer3DPanel::Instance()->Refresh();
+    }
+
+    if (!syntaxError)
+      AppendMessage("OK");
   } catch (const std::exception &e) {
     AppendMessage("Error: " + wxString::FromUTF8(e.what()));
   }
@@ -19,13 +19,19 @@
 
 #include <wx/wx.h>
 #include <wx/scrolwin.h>
+#include <cstddef>
+#include <functional>
 #include <vector>
 
+#include "scenechangejournal.h"
+#include "sceneentityindex.h"
+
 // Simple panel to display log messages in a console-like view
 class ConsolePanel : public wxPanel
 {
 public:
     explicit ConsolePanel(wxWindow* parent);
+    ~ConsolePanel() override;
 
     // Append a message to the console
     void AppendMessage(const wxString& msg);
@@ -34,6 +40,10 @@ public:
     static ConsolePanel* Instance();
     static void SetInstance(ConsolePanel* panel);
 
+    // Handler run by the "cancel" command, e.g. to stop a background
+    // import. Pass an empty function to clear it.
+    void SetCancelHandler(std::function<void()> handler);
+
 private:
     wxTextCtrl* m_textCtrl = nullptr;
     wxTextCtrl* m_inputCtrl = nullptr;
@@ -43,6 +53,14 @@ private:
     long m_lastLineStart = 0;
     std::vector<wxString> m_history;
     size_t m_historyIndex = 0;
+    std::function<void()> m_cancelHandler;
+    // Fixture and truss lookup for selection commands, kept current from
+    // the scene journal and rebuilt when the scene changed without it.
+    SceneEntityIndex m_entityIndex;
+    size_t m_entityIndexRevision = 0;
+    SceneChangeJournal::ListenerId m_sceneListener = 0;
+    const SceneEntityIndex& EntityIndex();
+    void OnSceneChanged(const SceneChangeSet& changes);
     void OnScroll(wxScrollWinEvent& event);
     void OnCommandEnter(wxCommandEvent& event);
     void OnInputFocus(wxFocusEvent& event);
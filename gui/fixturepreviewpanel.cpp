@@ -34,6 +34,8 @@
 
 #include <wx/wx.h>
 #include "fixturepreviewpanel.h"
+#include "gdtfthumbnails.h"
+#include "workerpool.h"
 #include <cfloat>
 #include <array>
 #include <algorithm>
@@ -168,6 +170,7 @@ FixturePreviewPanel::FixturePreviewPanel(wxWindow* parent)
 
 FixturePreviewPanel::~FixturePreviewPanel()
 {
+    ++*m_loadGeneration;
     delete m_glContext;
 }
 
@@ -191,20 +194,53 @@ void FixturePreviewPanel::InitGL()
 
 void FixturePreviewPanel::LoadFixture(const std::string& gdtfPath)
 {
-    m_objects.clear();
-    m_hasModel = false;
-    if(!gdtfPath.empty()){
-        m_hasModel = LoadGdtf(gdtfPath, m_objects);
+    // Mode changes in the edit dialog ask for the same file again.
+    if(m_hasRequest && gdtfPath == m_requestedPath)
+        return;
+    m_hasRequest = true;
+    m_requestedPath = gdtfPath;
+    const uint64_t generation = ++*m_loadGeneration;
+    if(gdtfPath.empty()){
+        ApplyModel({}, false);
+        return;
     }
+
+    // The previous model stays on screen until the new one is ready.
+    auto latest = m_loadGeneration;
+    FixturePreviewPanel* panel = this;
+    WorkerPool::Shared().Submit([panel, latest, generation, gdtfPath]() {
+        // Skip requests superseded while queued.
+        if(latest->load() != generation)
+            return;
+        auto objects = std::make_shared<std::vector<GdtfObject>>();
+        bool loaded = LoadGdtf(gdtfPath, *objects);
+        if(loaded)
+            CacheGdtfThumbnail(gdtfPath, *objects);
+        if(latest->load() != generation || !wxTheApp)
+            return;
+        // The destructor bumps the generation on the UI thread, so the
+        // panel is alive whenever the check below passes.
+        wxTheApp->CallAfter([panel, latest, generation, objects, loaded]() {
+            if(latest->load() != generation)
+                return;
+            panel->ApplyModel(std::move(*objects), loaded);
+        });
+    });
+}
+
+void FixturePreviewPanel::ApplyModel(std::vector<GdtfObject> objects, bool loaded)
+{
+    m_objects = std::move(objects);
+    m_hasModel = loaded;
     if(m_hasModel){
         m_bbMin[0]=m_bbMin[1]=m_bbMin[2]=FLT_MAX;
         m_bbMax[0]=m_bbMax[1]=m_bbMax[2]=-FLT_MAX;
         for(const auto& obj : m_objects){
-            for(size_t vi=0; vi+2<obj.mesh.vertices.size(); vi+=3){
+            for(size_t vi=0; vi+2<obj.mesh->vertices.size(); vi+=3){
                 std::array<float,3> p = {
-                    obj.mesh.vertices[vi]*RENDER_SCALE,
-                    obj.mesh.vertices[vi+1]*RENDER_SCALE,
-                    obj.mesh.vertices[vi+2]*RENDER_SCALE
+                    obj.mesh->vertices[vi]*RENDER_SCALE,
+                    obj.mesh->vertices[vi+1]*RENDER_SCALE,
+                    obj.mesh->vertices[vi+2]*RENDER_SCALE
                 };
                 p = TransformPoint(obj.transform, p);
                 for(int j=0;j<3;++j){
@@ -254,7 +290,7 @@ void FixturePreviewPanel::Render()
             float m[16];
             MatrixToArray(obj.transform,m);
             glMultMatrixf(m);
-            DrawMesh(obj.mesh, RENDER_SCALE);
+            DrawMesh(*obj.mesh, RENDER_SCALE);
             glPopMatrix();
         }
     } else {
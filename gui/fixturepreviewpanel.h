@@ -18,6 +18,9 @@
 #pragma once
 
 #include <wx/glcanvas.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include "viewer3dcamera.h"
@@ -29,8 +32,9 @@ public:
     explicit FixturePreviewPanel(wxWindow* parent);
     ~FixturePreviewPanel();
 
-    // Loads fixture model from a GDTF file. When loading fails a
-    // simple cube will be displayed instead.
+    // Loads fixture model from a GDTF file on a worker thread and shows it
+    // once loaded; a newer call supersedes one still loading. When loading
+    // fails a simple cube will be displayed instead.
     void LoadFixture(const std::string& gdtfPath);
 
 private:
@@ -44,6 +48,7 @@ private:
 
     void InitGL();
     void Render();
+    void ApplyModel(std::vector<GdtfObject> objects, bool loaded);
 
     wxGLContext* m_glContext = nullptr;
     bool m_glInitialized = false;
@@ -54,6 +59,13 @@ private:
     float m_bbMin[3];
     float m_bbMax[3];
 
+    std::string m_requestedPath;
+    bool m_hasRequest = false;
+    // Bumped for every request and on destruction; a worker result is only
+    // applied while its generation is still the latest.
+    std::shared_ptr<std::atomic<uint64_t>> m_loadGeneration =
+        std::make_shared<std::atomic<uint64_t>>(0);
+
     bool m_dragging = false;
     wxPoint m_lastMousePos;
 
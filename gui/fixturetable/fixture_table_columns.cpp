@@ -2,15 +2,15 @@
 
 #include "colorfulrenderers.h"
 #include "columnutils.h"
+#include "scenetableformat.h"
 
 namespace FixtureTableColumns {
 
 std::vector<wxString> DefaultLabels() {
-  return {"Fixture ID", "Name",        "Type",      "Layer",
-          "Hang Pos",   "Universe",    "Channel",   "Mode",
-          "Ch Count",   "Model file",  "Pos X",     "Pos Y",
-          "Pos Z",      "Roll (X)",    "Pitch (Y)", "Yaw (Z)",
-          "Power (W)",  "Weight (kg)", "Color"};
+  std::vector<wxString> labels;
+  for (const auto &column : SceneTableFormat::FixtureColumns())
+    labels.push_back(wxString::FromUTF8(column));
+  return labels;
 }
 
 void ConfigureColumns(wxDataViewListCtrl *table,
@@ -1,5 +1,6 @@
 #include "fixture_table_edit_service.h"
 
+#include "colorstore.h"
 #include "consolepanel.h"
 #include "gdtfloader.h"
 #include "matrixutils.h"
@@ -82,11 +83,17 @@ void UpdateSceneData(ISceneAdapter &adapter, wxDataViewListCtrl *table,
   auto &scene = adapter.GetScene();
 
   std::unordered_set<std::string> updatedSpecs;
+  std::vector<std::string> updatedUuids;
   size_t updatedCount = 0;
   wxString firstName, firstUuid;
 
+  // Rows that were never edited still mirror the scene.
+  const auto *store =
+      dynamic_cast<const ColorfulDataViewListStore *>(table->GetModel());
   size_t count = std::min((size_t)table->GetItemCount(), rowUuids.size());
   for (size_t i = 0; i < count; ++i) {
+    if (store && !store->IsRowEdited(static_cast<unsigned>(i)))
+      continue;
     auto it = scene.fixtures.find(rowUuids[i]);
     if (it == scene.fixtures.end())
       continue;
@@ -211,6 +218,7 @@ void UpdateSceneData(ISceneAdapter &adapter, wxDataViewListCtrl *table,
         SetGdtfModelColor(gdtfPath, it->second.color);
     }
 
+    updatedUuids.push_back(rowUuids[i]);
     if (ConsolePanel::Instance()) {
       ++updatedCount;
       if (updatedCount == 1) {
@@ -230,6 +238,8 @@ void UpdateSceneData(ISceneAdapter &adapter, wxDataViewListCtrl *table,
     if (!msg.empty())
       ConsolePanel::Instance()->AppendMessage(msg);
   }
+
+  adapter.NotifyFixturesChanged(updatedUuids);
 }
 
 } // namespace FixtureTableEditService
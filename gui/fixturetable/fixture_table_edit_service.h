@@ -15,6 +15,8 @@ public:
   virtual ~ISceneAdapter() = default;
   virtual void PushUndoState(const std::string &description) = 0;
   virtual MvrScene &GetScene() = 0;
+  // Called once with every fixture written back from the table.
+  virtual void NotifyFixturesChanged(const std::vector<std::string> &uuids) = 0;
 };
 
 std::vector<int> BuildOrderedRows(const std::vector<int> &selectedRows,
@@ -30,7 +30,7 @@
 #include "matrixutils.h"
 #include "patchmanager.h"
 #include "projectutils.h"
-#include "riggingpanel.h"
+#include "scenetableformat.h"
 #include "stringutils.h"
 #include "summarypanel.h"
 #include "viewer2dpanel.h"
@@ -38,8 +38,10 @@
 #include <algorithm>
 #include <cctype>
 #include <filesystem>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <wx/choicdlg.h>
 #include <wx/colordlg.h>
 #include <wx/dcmemory.h>
@@ -60,7 +62,150 @@ public:
   }
 
   MvrScene &GetScene() override { return GetDefaultGuiConfigServices().LegacyConfigManager().GetScene(); }
+
+  void NotifyFixturesChanged(const std::vector<std::string> &uuids) override {
+    GetDefaultGuiConfigServices().LegacyConfigManager().NotifySceneChanged(
+        SceneEntityKind::Fixture, uuids, SceneComponent::All);
+  }
 };
+
+// Per-reload caches shared by the cells of one table generation. Channel
+// counts need the GDTF archive and swatches need a bitmap, so both are
+// resolved once per distinct value instead of once per row.
+struct FixtureCellCache {
+  std::unordered_map<std::string, int> channelCounts;
+  std::unordered_map<std::string, wxBitmap> swatches;
+};
+
+std::string ResolveGdtfPath(const std::string &base, const std::string &spec) {
+  if (spec.empty())
+    return {};
+  fs::path p = base.empty() ? fs::path(spec) : fs::path(base) / spec;
+  return p.string();
+}
+
+wxString FormatAngle(float degrees) {
+  return wxString::FromUTF8(SceneTableFormat::Angle(degrees));
+}
+
+// Formats column `col` of the fixture table exactly as rows used to be
+// appended. A missing fixture yields an empty value of the column's type.
+wxVariant MakeFixtureCell(const Fixture *fixture, unsigned col,
+                          const std::string &basePath,
+                          FixtureCellCache &cache) {
+  if (!fixture) {
+    if (col == 0 || col == 5 || col == 6)
+      return wxVariant(0L);
+    if (col == 18) {
+      wxVariant var;
+      var << wxDataViewIconText();
+      return var;
+    }
+    return wxVariant(wxString());
+  }
+
+  auto addressPart = [&](int index) {
+    long universe = 0;
+    long channel = 0;
+    if (!fixture->address.empty()) {
+      wxStringTokenizer tk(wxString::FromUTF8(fixture->address), ".");
+      if (tk.HasMoreTokens())
+        tk.GetNextToken().ToLong(&universe);
+      if (tk.HasMoreTokens())
+        tk.GetNextToken().ToLong(&channel);
+    }
+    return index == 0 ? universe : channel;
+  };
+
+  switch (col) {
+  case 0:
+    return wxVariant(static_cast<long>(fixture->fixtureId));
+  case 1:
+    return wxVariant(wxString::FromUTF8(fixture->instanceName));
+  case 2: {
+    wxString type = wxString::FromUTF8(fixture->typeName);
+    if (type.empty())
+      type = wxFileName(wxString::FromUTF8(
+                            ResolveGdtfPath(basePath, fixture->gdtfSpec)))
+                 .GetName();
+    return wxVariant(type);
+  }
+  case 3:
+    return wxVariant(fixture->layer == DEFAULT_LAYER_NAME
+                         ? wxString()
+                         : wxString::FromUTF8(fixture->layer));
+  case 4:
+    return wxVariant(wxString::FromUTF8(fixture->positionName));
+  case 5:
+    return wxVariant(addressPart(0));
+  case 6:
+    return wxVariant(addressPart(1));
+  case 7:
+    return wxVariant(wxString::FromUTF8(fixture->gdtfMode));
+  case 8: {
+    const std::string fullPath = ResolveGdtfPath(basePath, fixture->gdtfSpec);
+    const std::string key = fullPath + '\x1F' + fixture->gdtfMode;
+    auto it = cache.channelCounts.find(key);
+    if (it == cache.channelCounts.end())
+      it = cache.channelCounts
+               .emplace(key,
+                        GetGdtfModeChannelCount(fullPath, fixture->gdtfMode))
+               .first;
+    return wxVariant(it->second >= 0 ? wxString::Format("%d", it->second)
+                                     : wxString());
+  }
+  case 9:
+    return wxVariant(
+        wxFileName(wxString::FromUTF8(
+                       ResolveGdtfPath(basePath, fixture->gdtfSpec)))
+            .GetFullName());
+  case 10:
+  case 11:
+  case 12: {
+    auto posArr = fixture->GetPosition();
+    return wxVariant(
+        wxString::FromUTF8(SceneTableFormat::Position(posArr[col - 10])));
+  }
+  case 13:
+  case 14:
+  case 15: {
+    // Roll, pitch and yaw map to Euler components 2, 1 and 0.
+    auto euler = MatrixUtils::MatrixToEuler(fixture->transform);
+    return wxVariant(FormatAngle(euler[15 - col]));
+  }
+  case 16:
+    return wxVariant(wxString::FromUTF8(
+        SceneTableFormat::Decimal(fixture->powerConsumptionW, 1)));
+  case 17:
+    return wxVariant(
+        wxString::FromUTF8(SceneTableFormat::Decimal(fixture->weightKg, 2)));
+  case 18: {
+    wxString color = wxString::FromUTF8(fixture->color);
+    wxVariant var;
+    if (color.IsEmpty()) {
+      var << wxDataViewIconText();
+      return var;
+    }
+    auto it = cache.swatches.find(fixture->color);
+    if (it == cache.swatches.end()) {
+      wxColour col(color);
+      wxBitmap bmp(16, 16);
+      {
+        wxMemoryDC dc(bmp);
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        dc.SetBrush(wxBrush(col));
+        dc.DrawRectangle(0, 0, 16, 16);
+        dc.SelectObject(wxNullBitmap);
+      }
+      it = cache.swatches.emplace(fixture->color, bmp).first;
+    }
+    var << wxDataViewIconText(color, it->second);
+    return var;
+  }
+  default:
+    return wxVariant(wxString());
+  }
+}
 } // namespace
 
 FixtureTablePanel::FixtureTablePanel(wxWindow *parent, IGuiConfigServices *services)
@@ -94,12 +239,17 @@ FixtureTablePanel::FixtureTablePanel(wxWindow *parent, IGuiConfigServices *servi
 
   InitializeTable();
   ReloadData();
+  sceneListener =
+      guiConfigServices->LegacyConfigManager().GetSceneJournal().Subscribe(
+          [this](const SceneChangeSet &changes) { OnSceneChanged(changes); });
 
   sizer->Add(table, 1, wxEXPAND | wxALL, 5);
   SetSizer(sizer);
 }
 
 FixtureTablePanel::~FixtureTablePanel() {
+  guiConfigServices->LegacyConfigManager().GetSceneJournal().Unsubscribe(
+      sceneListener);
   store = nullptr;
 }
 
@@ -108,126 +258,145 @@ void FixtureTablePanel::InitializeTable() {
   FixtureTableColumns::ConfigureColumns(table, columnLabels);
 }
 
+void FixtureTablePanel::RebuildRowIndex() {
+  rowIndex.clear();
+  rowIndex.reserve(rowUuids.size());
+  for (size_t i = 0; i < rowUuids.size(); ++i)
+    rowIndex.emplace(rowUuids[i], static_cast<int>(i));
+}
+
+int FixtureTablePanel::FindRow(const std::string &uuid) const {
+  auto it = rowIndex.find(uuid);
+  return it != rowIndex.end() ? it->second : -1;
+}
+
+void FixtureTablePanel::OnSceneChanged(const SceneChangeSet &changes) {
+  // Loading, undo and redo replace the whole scene and reload the table
+  // explicitly.
+  if (changes.reset || !changes.Touches(SceneEntityKind::Fixture))
+    return;
+
+  const MvrScene &scene = std::as_const(guiConfigServices->LegacyConfigManager()).GetScene();
+  std::vector<int> removedRows;
+  bool patchChanged = false;
+  for (const auto &change : changes.changes) {
+    if (change.kind != SceneEntityKind::Fixture)
+      continue;
+    int row = FindRow(change.uuid);
+    auto it = scene.fixtures.find(change.uuid);
+    if (it == scene.fixtures.end()) {
+      if (row >= 0)
+        removedRows.push_back(row);
+      if (patchIndex.Contains(change.uuid)) {
+        patchIndex.Remove(change.uuid);
+        patchChanged = true;
+      }
+      continue;
+    }
+    if (row < 0) {
+      // New fixtures need a place in the initial sort order.
+      std::vector<std::string> selection = GetSelectedUuids();
+      ReloadData();
+      SelectByUuid(selection);
+      return;
+    }
+    if (static_cast<size_t>(row) < gdtfPaths.size())
+      gdtfPaths[row] = wxString::FromUTF8(
+          ResolveGdtfPath(scene.basePath, it->second.gdtfSpec));
+    store->RefreshRow(static_cast<unsigned>(row), true);
+    if (change.components & SceneComponent::Patch) {
+      UpdatePatchFootprint(change.uuid, it->second, scene.basePath);
+      patchChanged = true;
+    }
+  }
+
+  if (!removedRows.empty()) {
+    std::vector<std::string> oldOrder = rowUuids;
+    std::vector<wxString> oldPaths = gdtfPaths;
+    std::vector<std::string> selection = GetSelectedUuids();
+    std::sort(removedRows.begin(), removedRows.end(), std::greater<int>());
+    for (int r : removedRows) {
+      store->DeleteItem(r);
+      for (auto itSel = selectionOrder.begin();
+           itSel != selectionOrder.end();) {
+        if (*itSel == r)
+          itSel = selectionOrder.erase(itSel);
+        else {
+          if (*itSel > r)
+            --(*itSel);
+          ++itSel;
+        }
+      }
+    }
+    ResyncRows(oldOrder, selection, &oldPaths);
+  }
+
+  if (patchChanged || !removedRows.empty())
+    HighlightDuplicateFixtureIds();
+}
+
 void FixtureTablePanel::ReloadData() {
-  store->DeleteAllItems();
   gdtfPaths.clear();
   rowUuids.clear();
 
-  const auto &fixtures = guiConfigServices->LegacyConfigManager().GetScene().fixtures;
-
-  std::vector<std::pair<std::string, const Fixture *>> sorted;
-  sorted.reserve(fixtures.size());
-  for (const auto &[uuid, fixture] : fixtures)
-    sorted.emplace_back(uuid, &fixture);
+  const MvrScene &scene = std::as_const(guiConfigServices->LegacyConfigManager()).GetScene();
 
-  std::sort(sorted.begin(), sorted.end(), [&](const auto &A, const auto &B) {
-    const Fixture *a = A.second;
-    const Fixture *b = B.second;
+  // Sort a permutation of precomputed keys; the cells themselves are
+  // formatted by the store when a row is first shown.
+  struct SortKey {
+    const std::string *uuid;
+    const Fixture *fixture;
+    FixtureTableParser::ParsedAddress address;
+  };
+  std::vector<SortKey> sorted;
+  sorted.reserve(scene.fixtures.size());
+  for (const auto &[uuid, fixture] : scene.fixtures)
+    sorted.push_back(
+        {&uuid, &fixture, FixtureTableParser::ParseAddress(fixture.address)});
+
+  std::sort(sorted.begin(), sorted.end(), [](const SortKey &A,
+                                             const SortKey &B) {
+    const Fixture *a = A.fixture;
+    const Fixture *b = B.fixture;
     if (a->fixtureId != b->fixtureId)
       return a->fixtureId < b->fixtureId;
     if (a->gdtfSpec != b->gdtfSpec)
       return StringUtils::NaturalLess(a->gdtfSpec, b->gdtfSpec);
-    auto addrA = FixtureTableParser::ParseAddress(a->address);
-    auto addrB = FixtureTableParser::ParseAddress(b->address);
-    if (addrA.universe != addrB.universe)
-      return addrA.universe < addrB.universe;
-    return addrA.channel < addrB.channel;
+    if (A.address.universe != B.address.universe)
+      return A.address.universe < B.address.universe;
+    return A.address.channel < B.address.channel;
   });
 
-  for (const auto &pair : sorted) {
-    const std::string &uuid = pair.first;
-    const Fixture *fixture = pair.second;
-    wxVector<wxVariant> row;
+  std::vector<wxUIntPtr> itemData;
+  itemData.reserve(sorted.size());
+  rowUuids.reserve(sorted.size());
+  gdtfPaths.reserve(sorted.size());
+  patchIndex.Clear();
+  patchChannelCounts.clear();
+  for (const auto &key : sorted) {
+    itemData.push_back(rowUuids.size());
+    rowUuids.push_back(*key.uuid);
+    gdtfPaths.push_back(wxString::FromUTF8(
+        ResolveGdtfPath(scene.basePath, key.fixture->gdtfSpec)));
+    UpdatePatchFootprint(*key.uuid, *key.fixture, scene.basePath);
+  }
 
-    wxString name = wxString::FromUTF8(fixture->instanceName);
-    long fixtureID = static_cast<long>(fixture->fixtureId);
-    wxString layer = fixture->layer == DEFAULT_LAYER_NAME
-                         ? wxString()
-                         : wxString::FromUTF8(fixture->layer);
-    long universe = 0;
-    long channel = 0;
-    if (!fixture->address.empty()) {
-      wxStringTokenizer tk(wxString::FromUTF8(fixture->address), ".");
-      if (tk.HasMoreTokens())
-        tk.GetNextToken().ToLong(&universe);
-      if (tk.HasMoreTokens())
-        tk.GetNextToken().ToLong(&channel);
+  auto sources = std::make_shared<const std::vector<std::string>>(rowUuids);
+  auto cache = std::make_shared<FixtureCellCache>();
+  IGuiConfigServices *services = guiConfigServices;
+  store->ResetRows(itemData, [services, sources, cache](size_t source,
+                                                        unsigned col,
+                                                        wxVariant &value) {
+    const MvrScene &current = std::as_const(services->LegacyConfigManager()).GetScene();
+    const Fixture *fixture = nullptr;
+    if (source < sources->size()) {
+      auto it = current.fixtures.find((*sources)[source]);
+      if (it != current.fixtures.end())
+        fixture = &it->second;
     }
-    std::string fullPath;
-    if (!fixture->gdtfSpec.empty()) {
-      const std::string &base = guiConfigServices->LegacyConfigManager().GetScene().basePath;
-      fs::path p = base.empty() ? fs::path(fixture->gdtfSpec)
-                                : fs::path(base) / fixture->gdtfSpec;
-      fullPath = p.string();
-    }
-    wxString gdtfFull = wxString::FromUTF8(fullPath);
-    gdtfPaths.push_back(gdtfFull);
-    wxString gdtf = wxFileName(gdtfFull).GetFullName();
-    wxString type = wxString::FromUTF8(fixture->typeName);
-    if (type.empty())
-      type = wxFileName(gdtfFull).GetName();
-    wxString mode = wxString::FromUTF8(fixture->gdtfMode);
-
-    int chCount = GetGdtfModeChannelCount(std::string(gdtfFull.ToUTF8()),
-                                          fixture->gdtfMode);
-    wxString chCountStr =
-        chCount >= 0 ? wxString::Format("%d", chCount) : wxString();
-
-    auto posArr = fixture->GetPosition();
-    wxString posX = wxString::Format("%.3f", posArr[0] / 1000.0f);
-    wxString posY = wxString::Format("%.3f", posArr[1] / 1000.0f);
-    wxString posZ = wxString::Format("%.3f", posArr[2] / 1000.0f);
-    wxString posName = wxString::FromUTF8(fixture->positionName);
-
-    auto euler = MatrixUtils::MatrixToEuler(fixture->transform);
-    wxString roll = wxString::Format("%.1f\u00B0", euler[2]);
-    wxString pitch = wxString::Format("%.1f\u00B0", euler[1]);
-    wxString yaw = wxString::Format("%.1f\u00B0", euler[0]);
-
-    row.push_back(fixtureID);
-    row.push_back(name);
-    row.push_back(type);
-    row.push_back(layer);
-    row.push_back(posName);
-    row.push_back(universe);
-    row.push_back(channel);
-    row.push_back(mode);
-    row.push_back(chCountStr);
-    row.push_back(gdtf);
-    row.push_back(posX);
-    row.push_back(posY);
-    row.push_back(posZ);
-    row.push_back(roll);
-    row.push_back(pitch);
-    row.push_back(yaw);
-    wxString power = wxString::Format("%.1f", fixture->powerConsumptionW);
-    wxString weight = wxString::Format("%.2f", fixture->weightKg);
-    row.push_back(power);
-    row.push_back(weight);
-    wxString color = wxString::FromUTF8(fixture->color);
-    if (!color.IsEmpty()) {
-      wxColour col(color);
-      wxBitmap bmp(16, 16);
-      {
-        wxMemoryDC dc(bmp);
-        dc.SetPen(*wxTRANSPARENT_PEN);
-        dc.SetBrush(wxBrush(col));
-        dc.DrawRectangle(0, 0, 16, 16);
-        dc.SelectObject(wxNullBitmap);
-      }
-      wxDataViewIconText iconText(color, bmp);
-      wxVariant var;
-      var << iconText;
-      row.push_back(var);
-    } else {
-      wxVariant var;
-      var << wxDataViewIconText();
-      row.push_back(var);
-    }
-
-    store->AppendItem(row, rowUuids.size());
-    rowUuids.push_back(uuid);
-  }
+    value = MakeFixtureCell(fixture, col, current.basePath, *cache);
+  });
+  RebuildRowIndex();
 
   if (Viewer3DPanel::Instance())
     Viewer3DPanel::Instance()->SetSelectedFixtures({});
@@ -767,6 +936,24 @@ void FixtureTablePanel::HighlightFixture(const std::string &uuid) {
   table->Refresh();
 }
 
+void FixtureTablePanel::UpdatePatchFootprint(const std::string &uuid,
+                                             const Fixture &fixture,
+                                             const std::string &basePath) {
+  FixtureTableParser::ParsedAddress address =
+      FixtureTableParser::ParseAddress(fixture.address);
+  const std::string fullPath = ResolveGdtfPath(basePath, fixture.gdtfSpec);
+  const std::string key = fullPath + '\x1F' + fixture.gdtfMode;
+  auto it = patchChannelCounts.find(key);
+  if (it == patchChannelCounts.end())
+    it = patchChannelCounts
+             .emplace(key, GetGdtfModeChannelCount(fullPath, fixture.gdtfMode))
+             .first;
+  // Fixtures without a known channel count still take their start address.
+  const int count = it->second > 0 ? it->second : 1;
+  patchIndex.Set(uuid, {static_cast<int>(address.universe),
+                        static_cast<int>(address.channel), count});
+}
+
 void FixtureTablePanel::HighlightPatchConflicts() {
   // Clear previous highlighting on Universe and Channel columns
   for (unsigned i = 0; i < table->GetItemCount(); ++i) {
@@ -774,49 +961,14 @@ void FixtureTablePanel::HighlightPatchConflicts() {
     store->ClearCellTextColour(i, 6);
   }
 
-  struct PatchInfo {
-    int start;
-    int end;
-    unsigned row;
-  };
-  std::unordered_map<int, std::vector<PatchInfo>> uniMap;
-
-  for (unsigned i = 0; i < table->GetItemCount(); ++i) {
-    wxVariant v;
-    table->GetValue(v, i, 5);
-    long uni = v.GetLong();
-    table->GetValue(v, i, 6);
-    long ch = v.GetLong();
-    table->GetValue(v, i, 8);
-    long count = 1;
-    if (!v.GetString().ToLong(&count))
-      count = 1;
-
-    if (uni <= 0 || ch <= 0 || count <= 0)
+  if (!patchIndex.HasConflicts())
+    return;
+  for (const std::string &uuid : patchIndex.ConflictingUuids()) {
+    int row = FindRow(uuid);
+    if (row < 0)
       continue;
-
-    PatchInfo info{static_cast<int>(ch), static_cast<int>(ch + count - 1), i};
-    uniMap[static_cast<int>(uni)].push_back(info);
-  }
-
-  for (auto &[uni, vec] : uniMap) {
-    std::sort(vec.begin(), vec.end(),
-              [](const PatchInfo &a, const PatchInfo &b) {
-                return a.start < b.start;
-              });
-
-    for (size_t i = 0; i < vec.size(); ++i) {
-      for (size_t j = i + 1; j < vec.size(); ++j) {
-        if (vec[j].start <= vec[i].end) {
-          store->SetCellTextColour(vec[i].row, 5, *wxRED);
-          store->SetCellTextColour(vec[i].row, 6, *wxRED);
-          store->SetCellTextColour(vec[j].row, 5, *wxRED);
-          store->SetCellTextColour(vec[j].row, 6, *wxRED);
-        } else {
-          break;
-        }
-      }
-    }
+    store->SetCellTextColour(row, 5, *wxRED);
+    store->SetCellTextColour(row, 6, *wxRED);
   }
 }
 
@@ -844,9 +996,8 @@ void FixtureTablePanel::SelectByUuid(const std::vector<std::string> &uuids) {
   selectionOrder.clear();
   std::vector<bool> selectedRows(table->GetItemCount(), false);
   for (const auto &u : uuids) {
-    auto pos = std::find(rowUuids.begin(), rowUuids.end(), u);
-    if (pos != rowUuids.end()) {
-      int row = static_cast<int>(pos - rowUuids.begin());
+    int row = FindRow(u);
+    if (row >= 0) {
       table->SelectRow(row);
       selectionOrder.push_back(row);
       if (row >= 0 && static_cast<size_t>(row) < selectedRows.size())
@@ -910,11 +1061,16 @@ void FixtureTablePanel::DeleteSelected() {
     Viewer2DPanel::Instance()->UpdateScene();
   }
 
-  if (SummaryPanel::Instance())
-    SummaryPanel::Instance()->ShowFixtureSummary();
-
   selectionOrder.clear();
   ResyncRows(oldOrder, {}, &oldPaths);
+
+  std::vector<std::string> removed;
+  removed.reserve(rows.size());
+  for (int r : rows)
+    if (static_cast<size_t>(r) < oldOrder.size())
+      removed.push_back(oldOrder[r]);
+  cfg.NotifySceneChanged(SceneEntityKind::Fixture, removed,
+                         SceneComponent::Removed);
 }
 
 void FixtureTablePanel::OnItemActivated(wxDataViewEvent &event) {
@@ -1034,7 +1190,7 @@ void FixtureTablePanel::UpdatePositionValues(
     return;
 
   ConfigManager &cfg = guiConfigServices->LegacyConfigManager();
-  auto &scene = cfg.GetScene();
+  const auto &scene = std::as_const(cfg).GetScene();
   wxWindowUpdateLocker locker(table);
 
   for (const auto &uuid : uuids) {
@@ -1042,16 +1198,20 @@ void FixtureTablePanel::UpdatePositionValues(
     if (it == scene.fixtures.end())
       continue;
 
+    int row = FindRow(uuid);
+    if (row < 0)
+      continue;
+    // Untouched rows simply re-read their cells from the scene.
+    if (!store->IsRowEdited(row)) {
+      store->RefreshRow(row);
+      continue;
+    }
+
     auto posArr = it->second.GetPosition();
     wxString posX = wxString::Format("%.3f", posArr[0] / 1000.0f);
     wxString posY = wxString::Format("%.3f", posArr[1] / 1000.0f);
     wxString posZ = wxString::Format("%.3f", posArr[2] / 1000.0f);
 
-    auto pos = std::find(rowUuids.begin(), rowUuids.end(), uuid);
-    if (pos == rowUuids.end())
-      continue;
-
-    int row = static_cast<int>(pos - rowUuids.begin());
     table->SetValue(wxVariant(posX), row, 10);
     table->SetValue(wxVariant(posY), row, 11);
     table->SetValue(wxVariant(posZ), row, 12);
@@ -1065,11 +1225,10 @@ void FixtureTablePanel::ApplyPositionValueUpdates(
 
   wxWindowUpdateLocker locker(table);
   for (const auto &update : updates) {
-    auto pos = std::find(rowUuids.begin(), rowUuids.end(), update.uuid);
-    if (pos == rowUuids.end())
+    int row = FindRow(update.uuid);
+    if (row < 0)
       continue;
 
-    int row = static_cast<int>(pos - rowUuids.begin());
     table->SetValue(wxVariant(wxString::FromUTF8(update.posX)), row, 10);
     table->SetValue(wxVariant(wxString::FromUTF8(update.posY)), row, 11);
     table->SetValue(wxVariant(wxString::FromUTF8(update.posZ)), row, 12);
@@ -1083,15 +1242,9 @@ void FixtureTablePanel::PropagateTypeValues(
 
 void FixtureTablePanel::UpdateSceneData() {
   ConfigManagerSceneAdapter adapter;
+  // The change notification refreshes the written rows and re-checks
+  // duplicate ids and patch conflicts.
   FixtureTableEditService::UpdateSceneData(adapter, table, rowUuids, gdtfPaths);
-
-  HighlightDuplicateFixtureIds();
-
-  if (RiggingPanel::Instance())
-    RiggingPanel::Instance()->RefreshData();
-
-  if (SummaryPanel::Instance() && IsActivePage())
-    SummaryPanel::Instance()->ShowFixtureSummary();
 }
 
 void FixtureTablePanel::ApplyModeForGdtf(const wxString &path,
@@ -1200,12 +1353,13 @@ void FixtureTablePanel::ResyncRows(
   }
   rowUuids.swap(newOrder);
   gdtfPaths.swap(newPaths);
+  RebuildRowIndex();
 
   table->UnselectAll();
   for (const auto &uuid : selectedUuids) {
-    auto pos = std::find(rowUuids.begin(), rowUuids.end(), uuid);
-    if (pos != rowUuids.end())
-      table->SelectRow(static_cast<int>(pos - rowUuids.begin()));
+    int row = FindRow(uuid);
+    if (row >= 0)
+      table->SelectRow(row);
   }
   UpdateSelectionHighlight();
 }
@@ -22,10 +22,14 @@
 #include <wx/time.h>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "colorstore.h"
+#include "dmxpatchindex.h"
 #include "positionvalueupdate.h"
+#include "scenechangejournal.h"
 
 class FixtureEditDialog; // forward declaration
+struct Fixture;
 class IGuiConfigServices;
 
 class FixtureTablePanel : public wxPanel
@@ -49,6 +53,10 @@ public:
 
     void UpdateSceneData();
 
+    // DMX footprints of the fixtures in the table, kept in sync with the
+    // scene so overlapping addresses can be queried after every edit.
+    const DmxPatchIndex& GetPatchIndex() const { return patchIndex; }
+
 private:
     friend class FixtureEditDialog; // allow dialog to access internals
 
@@ -57,13 +65,21 @@ private:
     std::vector<wxString> columnLabels;
     std::vector<wxString> gdtfPaths; // Stores full GDTF paths per row
     std::vector<std::string> rowUuids;
+    std::unordered_map<std::string, int> rowIndex; // uuid -> row in rowUuids
 
     bool dragSelecting = false;
     int startRow = -1;
     std::vector<int> selectionOrder;
     IGuiConfigServices *guiConfigServices = nullptr;
+    SceneChangeJournal::ListenerId sceneListener = 0;
+    DmxPatchIndex patchIndex;
+    // Channel count per GDTF path and mode, reset on every reload.
+    std::unordered_map<std::string, int> patchChannelCounts;
 
     void InitializeTable(); // Set up columns
+    void OnSceneChanged(const SceneChangeSet& changes);
+    void RebuildRowIndex();
+    int FindRow(const std::string& uuid) const;
     void OnContextMenu(wxDataViewEvent& event);
     void OnItemActivated(wxDataViewEvent& event);
     void OnColumnSorted(wxDataViewEvent& event);
@@ -80,4 +96,6 @@ private:
     void ApplyModeForGdtf(const wxString& path, const wxString& preferredMode = wxString());
     void HighlightDuplicateFixtureIds();
     void HighlightPatchConflicts();
+    void UpdatePatchFootprint(const std::string& uuid, const Fixture& fixture,
+                              const std::string& basePath);
 };
@@ -0,0 +1,66 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gdtfconflictdialog.h"
+
+#include <wx/dialog.h>
+#include <wx/radiobut.h>
+#include <wx/sizer.h>
+#include <wx/stattext.h>
+
+std::unordered_map<std::string, std::string>
+PromptGdtfConflicts(const std::vector<MvrImporter::GdtfConflict> &conflicts) {
+  std::unordered_map<std::string, std::string> chosen;
+  if (conflicts.empty())
+    return chosen;
+
+  wxDialog dlg(nullptr, wxID_ANY, "GDTF conflicts");
+  wxBoxSizer *topSizer = new wxBoxSizer(wxVERTICAL);
+  wxFlexGridSizer *grid = new wxFlexGridSizer(3, 5, 5);
+  grid->Add(new wxStaticText(&dlg, wxID_ANY, "Type"));
+  grid->Add(new wxStaticText(&dlg, wxID_ANY, "MVR"));
+  grid->Add(new wxStaticText(&dlg, wxID_ANY, "App"));
+
+  std::vector<wxRadioButton *> mvrBtns;
+  std::vector<wxRadioButton *> appBtns;
+  for (const auto &c : conflicts) {
+    grid->Add(
+        new wxStaticText(&dlg, wxID_ANY, wxString::FromUTF8(c.type.c_str())));
+    wxRadioButton *mvr = new wxRadioButton(
+        &dlg, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxRB_GROUP);
+    wxRadioButton *app = new wxRadioButton(&dlg, wxID_ANY, "");
+    mvr->SetValue(true);
+    grid->Add(mvr, 0, wxALIGN_CENTER);
+    grid->Add(app, 0, wxALIGN_CENTER);
+    mvrBtns.push_back(mvr);
+    appBtns.push_back(app);
+  }
+
+  topSizer->Add(grid, 1, wxALL, 10);
+  topSizer->Add(dlg.CreateSeparatedButtonSizer(wxOK | wxCANCEL), 0,
+                wxEXPAND | wxALL, 10);
+  dlg.SetSizerAndFit(topSizer);
+
+  if (dlg.ShowModal() != wxID_OK)
+    return chosen;
+
+  for (size_t i = 0; i < conflicts.size(); ++i) {
+    const auto &c = conflicts[i];
+    chosen[c.type] = mvrBtns[i]->GetValue() ? c.mvrPath : c.appPath;
+  }
+  return chosen;
+}
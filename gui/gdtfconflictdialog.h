@@ -0,0 +1,30 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mvrimporter.h"
+
+// Lets the user pick, per fixture type, whether the GDTF bundled in the MVR
+// or the one from the GDTF dictionary is used. Installed as the importer's
+// conflict prompt by the application at startup.
+std::unordered_map<std::string, std::string>
+PromptGdtfConflicts(const std::vector<MvrImporter::GdtfConflict> &conflicts);
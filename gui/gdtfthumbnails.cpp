@@ -0,0 +1,73 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gdtfthumbnails.h"
+
+#include <wx/image.h>
+#include <wx/stdpaths.h>
+
+#include <filesystem>
+
+GdtfThumbnailCache &SharedGdtfThumbnailCache() {
+  static GdtfThumbnailCache cache(
+      std::filesystem::path(
+          wxStandardPaths::Get().GetUserDataDir().ToStdString()) /
+      "thumbnails");
+  return cache;
+}
+
+GdtfThumbnail LoadGdtfThumbnail(const std::string &gdtfPath) {
+  GdtfThumbnailCache &cache = SharedGdtfThumbnailCache();
+  const std::string key = cache.KeyFor(gdtfPath);
+  GdtfThumbnail thumbnail;
+  if (key.empty() || cache.Find(key, thumbnail))
+    return thumbnail;
+  std::vector<GdtfObject> objects;
+  std::string error;
+  if (!LoadGdtf(gdtfPath, objects, &error))
+    return thumbnail;
+  thumbnail = RenderGdtfThumbnail(objects, kGdtfThumbnailSize);
+  cache.Store(key, thumbnail);
+  return thumbnail;
+}
+
+void CacheGdtfThumbnail(const std::string &gdtfPath,
+                        const std::vector<GdtfObject> &objects) {
+  GdtfThumbnailCache &cache = SharedGdtfThumbnailCache();
+  const std::string key = cache.KeyFor(gdtfPath);
+  GdtfThumbnail existing;
+  if (key.empty() || cache.Find(key, existing))
+    return;
+  cache.Store(key, RenderGdtfThumbnail(objects, kGdtfThumbnailSize));
+}
+
+wxBitmap GdtfThumbnailToBitmap(const GdtfThumbnail &thumbnail) {
+  if (!thumbnail.IsValid())
+    return wxBitmap();
+  wxImage image(thumbnail.width, thumbnail.height, false);
+  image.InitAlpha();
+  unsigned char *rgb = image.GetData();
+  unsigned char *alpha = image.GetAlpha();
+  const size_t pixels = static_cast<size_t>(thumbnail.width) * thumbnail.height;
+  for (size_t i = 0; i < pixels; ++i) {
+    rgb[i * 3] = thumbnail.rgba[i * 4];
+    rgb[i * 3 + 1] = thumbnail.rgba[i * 4 + 1];
+    rgb[i * 3 + 2] = thumbnail.rgba[i * 4 + 2];
+    alpha[i] = thumbnail.rgba[i * 4 + 3];
+  }
+  return wxBitmap(image);
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <wx/bitmap.h>
+
+#include <string>
+#include <vector>
+
+#include "gdtfthumbnail.h"
+
+// Size in pixels of the fixture type thumbnails shown in dialogs.
+inline constexpr int kGdtfThumbnailSize = 48;
+
+// Thumbnail cache kept in the user data directory, shared by all dialogs.
+// Make the first call on the UI thread.
+GdtfThumbnailCache &SharedGdtfThumbnailCache();
+
+// Returns the thumbnail of a GDTF file from the cache, loading and rendering
+// it first when needed. Loads the GDTF, so call it from a worker thread.
+GdtfThumbnail LoadGdtfThumbnail(const std::string &gdtfPath);
+
+// Caches the thumbnail of a GDTF whose objects are already loaded, unless
+// one exists. Safe on worker threads.
+void CacheGdtfThumbnail(const std::string &gdtfPath,
+                        const std::vector<GdtfObject> &objects);
+
+// Converts a thumbnail for wx controls; UI thread only.
+wxBitmap GdtfThumbnailToBitmap(const GdtfThumbnail &thumbnail);
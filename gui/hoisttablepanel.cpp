@@ -31,6 +31,8 @@
 #include "viewer3dpanel.h"
 #include <algorithm>
 #include <cctype>
+#include <memory>
+#include <utility>
 #include <wx/choicdlg.h>
 #include <wx/notebook.h>
 #include <wx/wupdlock.h> // freeze/thaw UI during batch edits
@@ -91,6 +93,50 @@ RangeParts SplitRangeParts(const wxString &value) {
       parts.push_back(part);
   return {parts, usedSeparator, trailingSeparator};
 }
+
+// Formats column `col` of the hoist table exactly as rows used to be appended.
+// Hoist IDs number the rows in their initial sort order.
+wxVariant MakeHoistCell(const Support *support, size_t source, unsigned col) {
+  if (col == 0)
+    return wxVariant(static_cast<long>(source + 1));
+  if (!support)
+    return wxVariant(wxString());
+
+  switch (col) {
+  case 1:
+    return wxVariant(wxString::FromUTF8(support->name));
+  case 2:
+    return wxVariant(wxString::FromUTF8(support->function));
+  case 3:
+    return wxVariant(wxString::FromUTF8(support->hoistFunction));
+  case 4:
+    return wxVariant(support->layer == DEFAULT_LAYER_NAME
+                         ? wxString()
+                         : wxString::FromUTF8(support->layer));
+  case 5:
+    return wxVariant(wxString::FromUTF8(support->positionName));
+  case 6:
+  case 7:
+  case 8:
+    return wxVariant(
+        wxString::Format("%.3f", support->transform.o[col - 6] / 1000.0f));
+  case 9:
+  case 10:
+  case 11: {
+    // Roll, pitch and yaw map to Euler components 2, 1 and 0.
+    auto euler = MatrixUtils::MatrixToEuler(support->transform);
+    return wxVariant(wxString::Format("%.1f\u00B0", euler[11 - col]));
+  }
+  case 12:
+    return wxVariant(wxString::Format("%.2f", support->chainLength));
+  case 13:
+    return wxVariant(wxString::Format("%.2f", support->capacityKg));
+  case 14:
+    return wxVariant(wxString::Format("%.2f", support->weightKg));
+  default:
+    return wxVariant(wxString());
+  }
+}
 } // namespace
 
 HoistTablePanel::HoistTablePanel(wxWindow *parent, IGuiConfigServices *services)
@@ -121,12 +167,19 @@ HoistTablePanel::HoistTablePanel(wxWindow *parent, IGuiConfigServices *services)
 
   InitializeTable();
   ReloadData();
+  sceneListener =
+      guiConfigServices->LegacyConfigManager().GetSceneJournal().Subscribe(
+          [this](const SceneChangeSet &changes) { OnSceneChanged(changes); });
 
   sizer->Add(table, 1, wxEXPAND | wxALL, 5);
   SetSizer(sizer);
 }
 
-HoistTablePanel::~HoistTablePanel() { store = nullptr; }
+HoistTablePanel::~HoistTablePanel() {
+  guiConfigServices->LegacyConfigManager().GetSceneJournal().Unsubscribe(
+      sceneListener);
+  store = nullptr;
+}
 
 void HoistTablePanel::InitializeTable() {
   columnLabels = {"Hoist ID",    "Name",       "Type",      "Function",
@@ -144,15 +197,64 @@ void HoistTablePanel::InitializeTable() {
   ColumnUtils::EnforceMinColumnWidth(table);
 }
 
+void HoistTablePanel::RebuildRowIndex() {
+  rowIndex.clear();
+  rowIndex.reserve(rowUuids.size());
+  for (size_t i = 0; i < rowUuids.size(); ++i)
+    rowIndex.emplace(rowUuids[i], static_cast<int>(i));
+}
+
+int HoistTablePanel::FindRow(const std::string &uuid) const {
+  auto it = rowIndex.find(uuid);
+  return it != rowIndex.end() ? it->second : -1;
+}
+
+void HoistTablePanel::OnSceneChanged(const SceneChangeSet &changes) {
+  // Loading, undo and redo replace the whole scene and reload the table
+  // explicitly.
+  if (changes.reset || !changes.Touches(SceneEntityKind::Support))
+    return;
+
+  const auto &supports =
+      std::as_const(guiConfigServices->LegacyConfigManager()).GetScene().supports;
+  std::vector<int> removedRows;
+  for (const auto &change : changes.changes) {
+    if (change.kind != SceneEntityKind::Support)
+      continue;
+    int row = FindRow(change.uuid);
+    if (supports.find(change.uuid) == supports.end()) {
+      if (row >= 0)
+        removedRows.push_back(row);
+      continue;
+    }
+    if (row < 0) {
+      // New hoists need a place in the initial sort order.
+      std::vector<std::string> selection = GetSelectedUuids();
+      ReloadData();
+      SelectByUuid(selection);
+      return;
+    }
+    store->RefreshRow(static_cast<unsigned>(row), true);
+  }
+
+  if (removedRows.empty())
+    return;
+  std::vector<std::string> oldOrder = rowUuids;
+  std::vector<std::string> selection = GetSelectedUuids();
+  std::sort(removedRows.begin(), removedRows.end(), std::greater<int>());
+  for (int r : removedRows)
+    table->DeleteItem(r);
+  ResyncRows(oldOrder, selection);
+}
+
 void HoistTablePanel::ReloadData() {
-  table->DeleteAllItems();
   rowUuids.clear();
   auto &supports = guiConfigServices->LegacyConfigManager().GetScene().supports;
 
-  std::vector<std::pair<std::string, Support *>> sorted;
+  std::vector<std::pair<const std::string *, Support *>> sorted;
   sorted.reserve(supports.size());
   for (auto &[uuid, support] : supports)
-    sorted.emplace_back(uuid, &support);
+    sorted.emplace_back(&uuid, &support);
 
   std::sort(sorted.begin(), sorted.end(), [](const auto &A, const auto &B) {
     const Support *a = A.second;
@@ -164,56 +266,32 @@ void HoistTablePanel::ReloadData() {
     return StringUtils::NaturalLess(a->name, b->name);
   });
 
-  int hoistId = 1;
+  std::vector<wxUIntPtr> itemData;
+  itemData.reserve(sorted.size());
+  rowUuids.reserve(sorted.size());
   for (const auto &pair : sorted) {
-    const std::string &uuid = pair.first;
     Support &support = *pair.second;
-    wxVector<wxVariant> row;
-
-    row.push_back(wxVariant(hoistId));
-    wxString name = wxString::FromUTF8(support.name);
-    wxString type = wxString::FromUTF8(support.function);
     support.hoistFunction = NormalizeHoistFunction(support.hoistFunction);
-    wxString hoistFunction = wxString::FromUTF8(support.hoistFunction);
-    wxString layer = support.layer == DEFAULT_LAYER_NAME
-                         ? wxString()
-                         : wxString::FromUTF8(support.layer);
-    wxString posName = wxString::FromUTF8(support.positionName);
-
-    auto posArr = support.transform.o;
-    wxString posX = wxString::Format("%.3f", posArr[0] / 1000.0f);
-    wxString posY = wxString::Format("%.3f", posArr[1] / 1000.0f);
-    wxString posZ = wxString::Format("%.3f", posArr[2] / 1000.0f);
-
-    auto euler = MatrixUtils::MatrixToEuler(support.transform);
-    wxString roll = wxString::Format("%.1f\u00B0", euler[2]);
-    wxString pitch = wxString::Format("%.1f\u00B0", euler[1]);
-    wxString yaw = wxString::Format("%.1f\u00B0", euler[0]);
-
-    wxString chainLen = wxString::Format("%.2f", support.chainLength);
-    wxString capacity = wxString::Format("%.2f", support.capacityKg);
-    wxString weight = wxString::Format("%.2f", support.weightKg);
-
-    row.push_back(name);
-    row.push_back(type);
-    row.push_back(hoistFunction);
-    row.push_back(layer);
-    row.push_back(posName);
-    row.push_back(posX);
-    row.push_back(posY);
-    row.push_back(posZ);
-    row.push_back(roll);
-    row.push_back(pitch);
-    row.push_back(yaw);
-    row.push_back(chainLen);
-    row.push_back(capacity);
-    row.push_back(weight);
-
-    store->AppendItem(row, rowUuids.size());
-    rowUuids.push_back(uuid);
-    ++hoistId;
+    itemData.push_back(rowUuids.size());
+    rowUuids.push_back(*pair.first);
   }
 
+  // Cells are formatted from the scene when a row is first shown.
+  auto sources = std::make_shared<const std::vector<std::string>>(rowUuids);
+  IGuiConfigServices *services = guiConfigServices;
+  store->ResetRows(itemData, [services, sources](size_t source, unsigned col,
+                                                 wxVariant &value) {
+    const auto &current = std::as_const(services->LegacyConfigManager()).GetScene().supports;
+    const Support *support = nullptr;
+    if (source < sources->size()) {
+      auto it = current.find((*sources)[source]);
+      if (it != current.end())
+        support = &it->second;
+    }
+    value = MakeHoistCell(support, source, col);
+  });
+  RebuildRowIndex();
+
   if (LayerPanel::Instance())
     LayerPanel::Instance()->ReloadLayers();
   if (SummaryPanel::Instance())
@@ -516,10 +594,15 @@ void HoistTablePanel::UpdateSceneData() {
   cfg.PushUndoState("edit support");
   auto &scene = cfg.GetScene();
   size_t count = std::min((size_t)table->GetItemCount(), rowUuids.size());
+  std::vector<std::string> updatedUuids;
   for (size_t i = 0; i < count; ++i) {
+    // Rows nobody edited still mirror the scene.
+    if (!store->IsRowEdited(i))
+      continue;
     auto it = scene.supports.find(rowUuids[i]);
     if (it == scene.supports.end())
       continue;
+    updatedUuids.push_back(rowUuids[i]);
 
     wxVariant v;
     table->GetValue(v, i, 1);
@@ -610,10 +693,9 @@ void HoistTablePanel::UpdateSceneData() {
     it->second.weightKg = static_cast<float>(weight);
   }
 
-  if (SummaryPanel::Instance())
-    SummaryPanel::Instance()->ShowHoistSummary();
-  if (RiggingPanel::Instance())
-    RiggingPanel::Instance()->RefreshData();
+  // Refreshes the written rows, the summary and the rigging totals.
+  cfg.NotifySceneChanged(SceneEntityKind::Support, updatedUuids,
+                         SceneComponent::All);
 }
 
 HoistTablePanel *HoistTablePanel::Instance() { return s_instance; }
@@ -659,9 +741,8 @@ void HoistTablePanel::SelectByUuid(const std::vector<std::string> &uuids) {
   table->UnselectAll();
   std::vector<bool> selectedRows(table->GetItemCount(), false);
   for (const auto &u : uuids) {
-    auto pos = std::find(rowUuids.begin(), rowUuids.end(), u);
-    if (pos != rowUuids.end()) {
-      int row = static_cast<int>(pos - rowUuids.begin());
+    int row = FindRow(u);
+    if (row >= 0) {
       table->SelectRow(row);
       if (row >= 0 && static_cast<size_t>(row) < selectedRows.size())
         selectedRows[row] = true;
@@ -689,18 +770,19 @@ void HoistTablePanel::DeleteSelected() {
   }
   std::sort(rows.begin(), rows.end(), std::greater<int>());
 
+  // Rows keep their old index as item data, so ResyncRows() rebuilds the
+  // uuid list from the order before the deletion.
+  std::vector<std::string> oldOrder = rowUuids;
+  std::vector<std::string> removed;
   auto &scene = cfg.GetScene();
   for (int r : rows) {
     if ((size_t)r < rowUuids.size()) {
       scene.supports.erase(rowUuids[r]);
-      rowUuids.erase(rowUuids.begin() + r);
+      removed.push_back(rowUuids[r]);
       table->DeleteItem(r);
     }
   }
 
-  if (SummaryPanel::Instance())
-    SummaryPanel::Instance()->ShowHoistSummary();
-
   if (Viewer3DPanel::Instance()) {
     Viewer3DPanel::Instance()->SetSelectedFixtures({});
     Viewer3DPanel::Instance()->UpdateScene();
@@ -710,8 +792,9 @@ void HoistTablePanel::DeleteSelected() {
     Viewer2DPanel::Instance()->UpdateScene();
   }
 
-  std::vector<std::string> order = rowUuids;
-  ResyncRows(order, {});
+  ResyncRows(oldOrder, {});
+  cfg.NotifySceneChanged(SceneEntityKind::Support, removed,
+                         SceneComponent::Removed);
 }
 
 void HoistTablePanel::ResyncRows(const std::vector<std::string> &oldOrder,
@@ -726,12 +809,13 @@ void HoistTablePanel::ResyncRows(const std::vector<std::string> &oldOrder,
     store->SetItemData(it, i);
   }
   rowUuids.swap(newOrder);
+  RebuildRowIndex();
 
   table->UnselectAll();
   for (const auto &uuid : selectedUuids) {
-    auto pos = std::find(rowUuids.begin(), rowUuids.end(), uuid);
-    if (pos != rowUuids.end())
-      table->SelectRow(static_cast<int>(pos - rowUuids.begin()));
+    int row = FindRow(uuid);
+    if (row >= 0)
+      table->SelectRow(row);
   }
   UpdateSelectionHighlight();
 }
@@ -20,8 +20,10 @@
 #include <wx/dataview.h>
 #include <wx/wx.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "colorstore.h"
+#include "scenechangejournal.h"
 
 class IGuiConfigServices;
 
@@ -49,11 +51,16 @@ private:
   wxDataViewListCtrl *table;
   std::vector<wxString> columnLabels;
   std::vector<std::string> rowUuids;
+  std::unordered_map<std::string, int> rowIndex; // uuid -> row in rowUuids
   bool dragSelecting = false;
   int startRow = -1;
   IGuiConfigServices *guiConfigServices = nullptr;
+  SceneChangeJournal::ListenerId sceneListener = 0;
 
   void InitializeTable();
+  void OnSceneChanged(const SceneChangeSet &changes);
+  void RebuildRowIndex();
+  int FindRow(const std::string &uuid) const;
   void OnSelectionChanged(wxDataViewEvent &evt);
   void OnContextMenu(wxDataViewEvent &event);
   void OnColumnSorted(wxDataViewEvent &event);
@@ -28,6 +28,7 @@
 #include <chrono>
 #include <algorithm>
 #include <functional>
+#include <utility>
 #include <wx/dcmemory.h>
 
 LayerPanel* LayerPanel::s_instance = nullptr;
@@ -120,7 +121,7 @@ void LayerPanel::ReloadLayers()
     list->DeleteAllItems();
 
     std::set<std::string> names;
-    auto& scene = (*configManager).GetScene();
+    const auto& scene = std::as_const(*configManager).GetScene();
     for (const auto& [uuid, layer] : scene.layers)
         names.insert(layer.name);
 
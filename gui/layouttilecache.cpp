@@ -0,0 +1,139 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "layouttilecache.h"
+
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+size_t LayoutTileCache::KeyHash::operator()(const Key &key) const {
+  size_t seed = std::hash<int>{}(key.viewId);
+  auto combine = [&seed](int value) {
+    seed ^= std::hash<int>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) +
+            (seed >> 2);
+  };
+  combine(key.level);
+  combine(key.column);
+  combine(key.row);
+  return seed;
+}
+
+LayoutTileCache::LayoutTileCache(size_t budgetBytes,
+                                 ReleaseTexture releaseTexture)
+    : budgetBytes_(budgetBytes), releaseTexture_(std::move(releaseTexture)) {}
+
+LayoutTileCache::~LayoutTileCache() { Clear(); }
+
+int LayoutTileCache::LevelForZoom(double zoom) {
+  if (!(zoom > 0.0))
+    return 0;
+  // The epsilon keeps exact level zooms (1.0, 2.0, ...) on their own level.
+  return static_cast<int>(
+      std::ceil(std::log2(zoom) * kLevelsPerDoubling - 1e-9));
+}
+
+double LayoutTileCache::ZoomForLevel(int level) {
+  return std::exp2(static_cast<double>(level) / kLevelsPerDoubling);
+}
+
+void LayoutTileCache::BeginFrame() { ++frame_; }
+
+const LayoutTileCache::Tile *LayoutTileCache::Find(const Key &key) {
+  auto it = index_.find(key);
+  if (it == index_.end())
+    return nullptr;
+  it->second->lastFrame = frame_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return &it->second->tile;
+}
+
+void LayoutTileCache::Insert(const Key &key, const Tile &tile) {
+  auto it = index_.find(key);
+  if (it != index_.end())
+    Erase(it->second);
+  entries_.push_front({key, tile, frame_});
+  index_[key] = entries_.begin();
+  usedBytes_ += TileBytes(tile);
+  ++levels_[key.viewId][key.level];
+  EvictOverBudget();
+}
+
+std::vector<int> LayoutTileCache::Levels(int viewId) const {
+  std::vector<int> out;
+  auto it = levels_.find(viewId);
+  if (it == levels_.end())
+    return out;
+  out.reserve(it->second.size());
+  for (const auto &[level, count] : it->second) {
+    (void)count;
+    out.push_back(level);
+  }
+  return out;
+}
+
+bool LayoutTileCache::HasTiles(int viewId) const {
+  return levels_.find(viewId) != levels_.end();
+}
+
+void LayoutTileCache::RemoveView(int viewId) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto next = std::next(it);
+    if (it->key.viewId == viewId)
+      Erase(it);
+    it = next;
+  }
+}
+
+void LayoutTileCache::Clear() {
+  while (!entries_.empty())
+    Erase(std::prev(entries_.end()));
+}
+
+size_t LayoutTileCache::TileBytes(const Tile &tile) {
+  if (tile.texture == 0 || tile.width <= 0 || tile.height <= 0)
+    return 0;
+  return static_cast<size_t>(tile.width) * static_cast<size_t>(tile.height) *
+         4;
+}
+
+void LayoutTileCache::Erase(EntryList::iterator it) {
+  if (it->tile.texture != 0 && releaseTexture_)
+    releaseTexture_(it->tile.texture);
+  usedBytes_ -= TileBytes(it->tile);
+  auto viewIt = levels_.find(it->key.viewId);
+  if (viewIt != levels_.end()) {
+    auto levelIt = viewIt->second.find(it->key.level);
+    if (levelIt != viewIt->second.end() && --levelIt->second == 0)
+      viewIt->second.erase(levelIt);
+    if (viewIt->second.empty())
+      levels_.erase(viewIt);
+  }
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+void LayoutTileCache::EvictOverBudget() {
+  // Entries used in the current frame sit at the front, so eviction stops
+  // at the first of them rather than dropping tiles that are on screen.
+  while (usedBytes_ > budgetBytes_ && !entries_.empty()) {
+    auto last = std::prev(entries_.end());
+    if (last->lastFrame == frame_)
+      break;
+    Erase(last);
+  }
+}
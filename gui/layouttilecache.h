@@ -0,0 +1,118 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Texture tiles of the 2D views shown by the layout viewer. Each view is
+// rendered at a few fixed zoom levels (two per doubling) and every level is
+// cut into square tiles, so only the part of a view that is on screen has to
+// be rendered and zooming can show a coarser level until the sharp one is
+// ready. Tiles are evicted least recently used first once the textures
+// exceed the memory budget.
+class LayoutTileCache {
+public:
+  static constexpr int kTileSize = 512;
+  static constexpr int kLevelsPerDoubling = 2;
+
+  struct Key {
+    int viewId = 0;
+    int level = 0;
+    int column = 0;
+    int row = 0;
+
+    bool operator==(const Key &other) const {
+      return viewId == other.viewId && level == other.level &&
+             column == other.column && row == other.row;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+
+  // A rendered tile; width and height are in pixels and may be smaller than
+  // kTileSize on the right and bottom edges of a view.
+  struct Tile {
+    unsigned int texture = 0;
+    int width = 0;
+    int height = 0;
+  };
+
+  using ReleaseTexture = std::function<void(unsigned int texture)>;
+
+  LayoutTileCache(size_t budgetBytes, ReleaseTexture releaseTexture);
+  ~LayoutTileCache();
+
+  LayoutTileCache(const LayoutTileCache &) = delete;
+  LayoutTileCache &operator=(const LayoutTileCache &) = delete;
+
+  // Smallest level whose zoom is at least `zoom`, so tiles are only ever
+  // scaled down on screen.
+  static int LevelForZoom(double zoom);
+  static double ZoomForLevel(int level);
+
+  // Starts a paint. Tiles looked up during the frame are not evicted by
+  // inserts made before the next BeginFrame.
+  void BeginFrame();
+
+  // Returns the tile and marks it as recently used, or null.
+  const Tile *Find(const Key &key);
+  // Stores a tile, replacing one with the same key, and evicts older tiles
+  // while the cache is over budget.
+  void Insert(const Key &key, const Tile &tile);
+
+  // Levels of a view that have at least one tile, ascending.
+  std::vector<int> Levels(int viewId) const;
+  bool HasTiles(int viewId) const;
+
+  void RemoveView(int viewId);
+  void Clear();
+
+  size_t UsedBytes() const { return usedBytes_; }
+  size_t Size() const { return entries_.size(); }
+  size_t BudgetBytes() const { return budgetBytes_; }
+
+private:
+  struct Entry {
+    Key key;
+    Tile tile;
+    uint64_t lastFrame = 0;
+  };
+  using EntryList = std::list<Entry>;
+
+  static size_t TileBytes(const Tile &tile);
+  void Erase(EntryList::iterator it);
+  void EvictOverBudget();
+
+  size_t budgetBytes_ = 0;
+  size_t usedBytes_ = 0;
+  uint64_t frame_ = 1;
+  ReleaseTexture releaseTexture_;
+  // Most recently used at the front.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+  // Tile count per level of each view.
+  std::unordered_map<int, std::map<int, size_t>> levels_;
+};
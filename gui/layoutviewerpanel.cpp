@@ -18,6 +18,7 @@
 #include "layoutviewerpanel.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <memory>
 #include <new>
@@ -49,7 +50,6 @@ namespace {
 constexpr double kMinZoom = 0.1;
 constexpr double kMaxZoom = 10.0;
 constexpr double kZoomStep = 1.1;
-constexpr int kZoomCacheStepsPerLevel = 2;
 constexpr int kFitMarginPx = 40;
 constexpr int kHandleSizePx = 10;
 constexpr int kHandleHalfPx = kHandleSizePx / 2;
@@ -142,7 +142,10 @@ wxDEFINE_EVENT(EVT_LAYOUT_VIEW_SELECTED, wxCommandEvent);
 LayoutViewerPanel::LayoutViewerPanel(wxWindow *parent)
     : wxGLCanvas(parent, wxID_ANY, nullptr, wxDefaultPosition,
                  wxDefaultSize,
-                 wxFULL_REPAINT_ON_RESIZE | wxWANTS_CHARS) {
+                 wxFULL_REPAINT_ON_RESIZE | wxWANTS_CHARS),
+      viewTiles_(kMaxRenderBytes, [this](unsigned int texture) {
+        releasedTileTextures_.push_back(texture);
+      }) {
   SetBackgroundStyle(wxBG_STYLE_CUSTOM);
   glContext_ = new wxGLContext(this);
   currentLayout.pageSetup.pageSize = print::PageSize::A4;
@@ -471,6 +474,8 @@ void LayoutViewerPanel::OnPaint(wxPaintEvent &) {
       return nullptr;
     };
 
+    viewTiles_.BeginFrame();
+    pendingTiles_.clear();
     const auto elements = BuildZOrderedElements();
     for (const auto &element : elements) {
       if (element.type == SelectedElementType::View2D) {
@@ -501,7 +506,7 @@ void LayoutViewerPanel::OnPaint(wxPaintEvent &) {
       if (!activeView) {
         activeElementHasTexture = false;
       } else {
-        activeElementHasTexture = hasTexture(viewCaches_, activeViewId);
+        activeElementHasTexture = viewTiles_.HasTiles(activeViewId);
       }
     } else if (selectedElementType == SelectedElementType::Legend) {
       const auto *legend = findLegendById(activeLegendId);
@@ -541,6 +546,9 @@ void LayoutViewerPanel::OnPaint(wxPaintEvent &) {
 
     glFlush();
     SwapBuffers();
+    FlushReleasedTileTextures();
+    if (!pendingTiles_.empty())
+      ScheduleTileRender();
   } catch (const std::exception &ex) {
     Logger::Instance().Log(
         std::string("LayoutViewerPanel::OnPaint exception: ") + ex.what());
@@ -1364,72 +1372,6 @@ void LayoutViewerPanel::RebuildCachedTexture() {
       legendSymbols = CaptureLegendSymbolSnapshot(capturePanel, cfg, true);
     }
     const double renderZoom = GetRenderZoom();
-    for (const auto &view : currentLayout.view2dViews) {
-      ViewCache &cache = GetViewCache(view.id);
-      if (!cache.renderDirty)
-        continue;
-      cache.renderDirty = false;
-      wxRect frameRect;
-      if (!cache.hasCapture || !cache.hasRenderState ||
-          !GetFrameRect(view.frame, frameRect)) {
-        ClearCachedTexture(cache);
-        cache.textureSize = wxSize(0, 0);
-        cache.renderZoom = 0.0;
-        continue;
-      }
-  
-      const wxSize renderSize = GetFrameSizeForZoom(view.frame, renderZoom);
-      if (renderSize.GetWidth() <= 0 || renderSize.GetHeight() <= 0) {
-        ClearCachedTexture(cache);
-        cache.textureSize = wxSize(0, 0);
-        cache.renderZoom = 0.0;
-        continue;
-      }
-  
-      offscreenRenderer->SetViewportSize(renderSize);
-      offscreenRenderer->PrepareForCapture();
-  
-      viewer2d::Viewer2DState renderState = cache.renderState;
-      if (renderZoom != 1.0) {
-        renderState.camera.zoom *= static_cast<float>(renderZoom);
-      }
-      renderState.camera.viewportWidth = renderSize.GetWidth();
-      renderState.camera.viewportHeight = renderSize.GetHeight();
-  
-      auto stateGuard = std::make_shared<viewer2d::ScopedViewer2DState>(
-          capturePanel, nullptr, cfg, renderState, nullptr, nullptr, false);
-  
-      std::vector<unsigned char> pixels;
-      int width = 0;
-      int height = 0;
-      if (!capturePanel->RenderToRGBA(pixels, width, height) || width <= 0 ||
-          height <= 0) {
-        ClearCachedTexture(cache);
-        cache.textureSize = wxSize(0, 0);
-        cache.renderZoom = 0.0;
-        continue;
-      }
-  
-      if (!InitGL()) {
-        clearLoadingState();
-        NotifyRenderReady();
-        return;
-      }
-      if (cache.texture == 0) {
-        glGenTextures(1, &cache.texture);
-      }
-      glBindTexture(GL_TEXTURE_2D, cache.texture);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-      glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
-                   GL_UNSIGNED_BYTE, pixels.data());
-      cache.textureSize = wxSize(width, height);
-      cache.renderZoom = renderZoom;
-    }
-  
     for (const auto &legend : currentLayout.legendViews) {
       LegendCache &cache = GetLegendCache(legend.id);
       if (cache.symbols != legendSymbols) {
@@ -1799,10 +1741,9 @@ void LayoutViewerPanel::RebuildCachedTexture() {
 }
 
 void LayoutViewerPanel::ClearCachedTexture() {
-  for (auto &entry : viewCaches_) {
-    ClearCachedTexture(entry.second);
-  }
   viewCaches_.clear();
+  viewTiles_.Clear();
+  FlushReleasedTileTextures();
   for (auto &entry : legendCaches_) {
     ClearCachedTexture(entry.second);
   }
@@ -1821,18 +1762,6 @@ void LayoutViewerPanel::ClearCachedTexture() {
   imageCaches_.clear();
 }
 
-void LayoutViewerPanel::ClearCachedTexture(ViewCache &cache) {
-  if (cache.texture == 0 || !glContext_)
-    return;
-  if (!IsShown()) {
-    cache.texture = 0;
-    return;
-  }
-  SetCurrent(*glContext_);
-  glDeleteTextures(1, &cache.texture);
-  cache.texture = 0;
-}
-
 void LayoutViewerPanel::ClearCachedTexture(LegendCache &cache) {
   if (cache.texture == 0 || !glContext_)
     return;
@@ -1889,9 +1818,8 @@ bool LayoutViewerPanel::HasDirtyRenderCaches() const {
     }
     return false;
   };
-  return hasDirty(viewCaches_) || hasDirty(legendCaches_) ||
-         hasDirty(eventTableCaches_) || hasDirty(textCaches_) ||
-         hasDirty(imageCaches_);
+  return hasDirty(legendCaches_) || hasDirty(eventTableCaches_) ||
+         hasDirty(textCaches_) || hasDirty(imageCaches_);
 }
 
 bool LayoutViewerPanel::NeedsRenderRebuild() const {
@@ -1957,25 +1885,6 @@ void LayoutViewerPanel::InvalidateRenderIfFrameChanged() {
     cacheDirty = true;
   };
 
-  for (const auto &view : currentLayout.view2dViews) {
-    ViewCache &cache = GetViewCache(view.id);
-    wxRect frameRect;
-    if (!GetFrameRect(view.frame, frameRect)) {
-      if (cache.texture != 0) {
-        markDirty(cache.renderDirty);
-        ClearCachedTexture(cache);
-        cache.textureSize = wxSize(0, 0);
-        cache.renderZoom = 0.0;
-      }
-      continue;
-    }
-    const wxSize renderSize = GetFrameSizeForZoom(view.frame, renderZoom);
-    if (cache.renderZoom == 0.0 || cache.renderZoom != renderZoom ||
-        renderSize != cache.textureSize) {
-      markDirty(cache.renderDirty);
-    }
-  }
-
   for (const auto &legend : currentLayout.legendViews) {
     LegendCache &cache = GetLegendCache(legend.id);
     wxRect frameRect;
@@ -2096,7 +2005,7 @@ bool LayoutViewerPanel::AreTexturesReady() const {
   };
 
   for (const auto &view : currentLayout.view2dViews) {
-    if (!hasTexture(viewCaches_, view.id))
+    if (!viewTiles_.HasTiles(view.id))
       return false;
   }
   for (const auto &legend : currentLayout.legendViews) {
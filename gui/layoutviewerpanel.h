@@ -25,6 +25,7 @@
 #include <wx/wx.h>
 #include "LayoutCollection.h"
 #include "canvas2d.h"
+#include "layouttilecache.h"
 #include "symbolcache.h"
 #include "viewer2dpanel.h"
 #include "viewer2dstate.h"
@@ -62,10 +63,6 @@ private:
     viewer2d::Viewer2DState renderState;
     bool hasRenderState = false;
     std::shared_ptr<const SymbolDefinitionSnapshot> symbols;
-    unsigned int texture = 0;
-    wxSize textureSize{0, 0};
-    double renderZoom = 0.0;
-    bool renderDirty = true;
   };
 
   struct LegendCache {
@@ -126,6 +123,8 @@ private:
   void OnSendToBack(wxCommandEvent &event);
 
   void DrawSelectionHandles(const wxRect &frameRect) const;
+  void DrawViewTiles(const layouts::Layout2DViewDefinition &view,
+                     const wxRect &frameRect);
   void DrawViewElement(const layouts::Layout2DViewDefinition &view,
                        Viewer2DPanel *capturePanel,
                        Viewer2DOffscreenRenderer *offscreenRenderer,
@@ -148,6 +147,16 @@ private:
   wxSize GetFrameSizeForZoom(const layouts::Layout2DViewFrame &frame,
                              double targetZoom) const;
   double GetRenderZoom() const;
+  wxSize GetViewLevelSize(const layouts::Layout2DViewFrame &frame,
+                          int level) const;
+  void ScheduleTileRender();
+  void RenderPendingTiles();
+  bool RenderViewTile(const layouts::Layout2DViewDefinition &view,
+                      const ViewCache &cache, const LayoutTileCache::Key &key,
+                      Viewer2DPanel *capturePanel,
+                      Viewer2DOffscreenRenderer *offscreenRenderer,
+                      LayoutTileCache::Tile &tile);
+  void FlushReleasedTileTextures();
   void UpdateFrame(const layouts::Layout2DViewFrame &frame,
                    bool updatePosition);
   void UpdateLegendFrame(const layouts::Layout2DViewFrame &frame,
@@ -161,7 +170,6 @@ private:
   bool InitGL();
   void RebuildCachedTexture();
   void ClearCachedTexture();
-  void ClearCachedTexture(ViewCache &cache);
   void ClearCachedTexture(LegendCache &cache);
   void ClearCachedTexture(EventTableCache &cache);
   void ClearCachedTexture(TextCache &cache);
@@ -277,6 +285,12 @@ private:
   unsigned int loadingTextTexture_ = 0;
   wxSize loadingTextTextureSize_{0, 0};
   std::unordered_map<int, ViewCache> viewCaches_;
+  // Textures evicted from viewTiles_, deleted once the context is current.
+  std::vector<unsigned int> releasedTileTextures_;
+  LayoutTileCache viewTiles_;
+  // Visible tiles missing at the current zoom, refilled on every paint.
+  std::vector<LayoutTileCache::Key> pendingTiles_;
+  bool tileRenderScheduled_ = false;
   std::unordered_map<int, LegendCache> legendCaches_;
   std::unordered_map<int, EventTableCache> eventTableCaches_;
   std::unordered_map<int, TextCache> textCaches_;
@@ -24,6 +24,7 @@
 #include <functional>
 #include <limits>
 #include <map>
+#include <utility>
 #include <vector>
 
 // Include GLEW or other OpenGL loader first if present
@@ -732,8 +733,8 @@ LayoutViewerPanel::BuildLegendItems() const {
   };
 
   std::map<std::string, LegendAggregate> aggregates;
-  const auto &fixtures = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().fixtures;
-  const std::string &basePath = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().basePath;
+  const auto &fixtures = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().fixtures;
+  const std::string &basePath = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().basePath;
   for (const auto &[uuid, fixture] : fixtures) {
     (void)uuid;
     std::string typeName = fixture.typeName;
@@ -18,7 +18,11 @@
 #include "layoutviewerpanel.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <vector>
+#include <wx/weakref.h>
 
 // Include GLEW or other OpenGL loader first if present
 #ifdef __APPLE__
@@ -28,13 +32,29 @@
 #  include <GL/gl.h>
 #  include <GL/glu.h>
 #endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
 
 #include "configmanager.h"
 #include "guiconfigservices.h"
 #include "LayoutManager.h"
+#include "mainwindow.h"
 #include "viewer2doffscreenrenderer.h"
 #include "viewer2dstate.h"
 
+namespace {
+// Largest edge of a view at one tile level. Only visible tiles are ever
+// rendered, so this can be far above the size of a whole-frame texture.
+constexpr int kMaxLevelDimension = 1 << 16;
+// Time spent rendering view tiles per idle slice before yielding to input.
+constexpr int kTileRenderSliceMs = 12;
+// Extra pixels rendered around each tile and cropped away. Culling and
+// label placement run per render, so without it objects and labels that
+// straddle a seam are dropped or placed differently on either side.
+constexpr int kTileRenderMargin = 128;
+} // namespace
+
 layouts::Layout2DViewDefinition *LayoutViewerPanel::GetEditableView() {
   if (currentLayout.view2dViews.empty())
     return nullptr;
@@ -112,11 +132,9 @@ void LayoutViewerPanel::OnDeleteView(wxCommandEvent &) {
       }
     }
   }
-  auto cacheIt = viewCaches_.find(viewId);
-  if (cacheIt != viewCaches_.end()) {
-    ClearCachedTexture(cacheIt->second);
-    viewCaches_.erase(cacheIt);
-  }
+  viewCaches_.erase(viewId);
+  viewTiles_.RemoveView(viewId);
+  FlushReleasedTileTextures();
   Refresh();
 }
 
@@ -208,11 +226,9 @@ void LayoutViewerPanel::DrawViewElement(
           cache.captureVersion = viewRenderVersion;
           cache.captureInProgress = false;
           captureInProgress = false;
-          cache.renderDirty = true;
-          renderDirty = true;
-          cache.textureSize = wxSize(0, 0);
-          cache.renderZoom = 0.0;
-          RequestRenderRebuild();
+          // Tiles of the previous capture are stale at every level.
+          viewTiles_.RemoveView(viewId);
+          FlushReleasedTileTextures();
           Refresh();
         });
   }
@@ -223,40 +239,18 @@ void LayoutViewerPanel::DrawViewElement(
   const int frameRight = frameRect.GetLeft() + frameRect.GetWidth();
   const int frameBottom = frameRect.GetTop() + frameRect.GetHeight();
 
-  const wxSize renderSize = GetFrameSizeForZoom(view.frame, cache.renderZoom);
-  if (cache.texture != 0 && renderSize.GetWidth() > 0 &&
-      renderSize.GetHeight() > 0 && cache.textureSize == renderSize) {
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, cache.texture);
-    glColor4ub(255, 255, 255, 255);
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 1.0f);
-    glVertex2f(static_cast<float>(frameRect.GetLeft()),
-               static_cast<float>(frameRect.GetTop()));
-    glTexCoord2f(1.0f, 1.0f);
-    glVertex2f(static_cast<float>(frameRight),
-               static_cast<float>(frameRect.GetTop()));
-    glTexCoord2f(1.0f, 0.0f);
-    glVertex2f(static_cast<float>(frameRight),
-               static_cast<float>(frameBottom));
-    glTexCoord2f(0.0f, 0.0f);
-    glVertex2f(static_cast<float>(frameRect.GetLeft()),
-               static_cast<float>(frameRect.GetBottom()));
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-  } else {
-    glColor4ub(240, 240, 240, 255);
-    glBegin(GL_QUADS);
-    glVertex2f(static_cast<float>(frameRect.GetLeft()),
-               static_cast<float>(frameRect.GetTop()));
-    glVertex2f(static_cast<float>(frameRect.GetRight()),
-               static_cast<float>(frameRect.GetTop()));
-    glVertex2f(static_cast<float>(frameRight),
-               static_cast<float>(frameBottom));
-    glVertex2f(static_cast<float>(frameRect.GetLeft()),
-               static_cast<float>(frameRect.GetBottom()));
-    glEnd();
-  }
+  glColor4ub(240, 240, 240, 255);
+  glBegin(GL_QUADS);
+  glVertex2f(static_cast<float>(frameRect.GetLeft()),
+             static_cast<float>(frameRect.GetTop()));
+  glVertex2f(static_cast<float>(frameRight),
+             static_cast<float>(frameRect.GetTop()));
+  glVertex2f(static_cast<float>(frameRight), static_cast<float>(frameBottom));
+  glVertex2f(static_cast<float>(frameRect.GetLeft()),
+             static_cast<float>(frameBottom));
+  glEnd();
+  if (cache.hasCapture && cache.hasRenderState)
+    DrawViewTiles(view, frameRect);
 
   if (view.id == activeViewId) {
     glColor4ub(60, 160, 240, 255);
@@ -279,3 +273,274 @@ void LayoutViewerPanel::DrawViewElement(
   if (view.id == activeViewId)
     DrawSelectionHandles(frameRect);
 }
+
+wxSize LayoutViewerPanel::GetViewLevelSize(
+    const layouts::Layout2DViewFrame &frame, int level) const {
+  if (frame.width <= 0 || frame.height <= 0)
+    return wxSize(0, 0);
+  const double levelZoom = LayoutTileCache::ZoomForLevel(level);
+  const double width = frame.width * levelZoom;
+  const double height = frame.height * levelZoom;
+  if (width > kMaxLevelDimension || height > kMaxLevelDimension)
+    return wxSize(0, 0);
+  const int levelWidth = static_cast<int>(std::lround(width));
+  const int levelHeight = static_cast<int>(std::lround(height));
+  if (levelWidth <= 0 || levelHeight <= 0)
+    return wxSize(0, 0);
+  return wxSize(levelWidth, levelHeight);
+}
+
+void LayoutViewerPanel::DrawViewTiles(
+    const layouts::Layout2DViewDefinition &view, const wxRect &frameRect) {
+  if (frameRect.GetWidth() <= 0 || frameRect.GetHeight() <= 0)
+    return;
+  const wxSize clientSize = GetClientSize();
+  const wxRect visible =
+      frameRect.Intersect(wxRect(0, 0, clientSize.GetWidth(),
+                                 clientSize.GetHeight()));
+  if (visible.IsEmpty())
+    return;
+
+  constexpr int kTile = LayoutTileCache::kTileSize;
+  // Draws the cached tiles of one level over the visible part of the frame;
+  // when `missing` is set, tiles that are not cached are added to it.
+  auto drawLevel = [&](int level, std::vector<LayoutTileCache::Key> *missing) {
+    const wxSize levelSize = GetViewLevelSize(view.frame, level);
+    if (levelSize.GetWidth() <= 0 || levelSize.GetHeight() <= 0)
+      return;
+    const double scaleX =
+        static_cast<double>(frameRect.GetWidth()) / levelSize.GetWidth();
+    const double scaleY =
+        static_cast<double>(frameRect.GetHeight()) / levelSize.GetHeight();
+    const int columns = (levelSize.GetWidth() + kTile - 1) / kTile;
+    const int rows = (levelSize.GetHeight() + kTile - 1) / kTile;
+    auto tileIndex = [](int screen, int origin, double scale, int count) {
+      const int index =
+          static_cast<int>(std::floor((screen - origin) / (kTile * scale)));
+      return std::clamp(index, 0, count - 1);
+    };
+    const int c0 = tileIndex(visible.GetLeft(), frameRect.GetLeft(), scaleX,
+                             columns);
+    const int c1 = tileIndex(visible.GetRight(), frameRect.GetLeft(), scaleX,
+                             columns);
+    const int r0 =
+        tileIndex(visible.GetTop(), frameRect.GetTop(), scaleY, rows);
+    const int r1 =
+        tileIndex(visible.GetBottom(), frameRect.GetTop(), scaleY, rows);
+
+    for (int row = r0; row <= r1; ++row) {
+      for (int column = c0; column <= c1; ++column) {
+        const LayoutTileCache::Key key{view.id, level, column, row};
+        const LayoutTileCache::Tile *tile = viewTiles_.Find(key);
+        if (!tile) {
+          if (missing)
+            missing->push_back(key);
+          continue;
+        }
+        const float left =
+            static_cast<float>(frameRect.GetLeft() + column * kTile * scaleX);
+        const float top =
+            static_cast<float>(frameRect.GetTop() + row * kTile * scaleY);
+        const float right = left + static_cast<float>(tile->width * scaleX);
+        const float bottom = top + static_cast<float>(tile->height * scaleY);
+        glBindTexture(GL_TEXTURE_2D, tile->texture);
+        glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 1.0f);
+        glVertex2f(left, top);
+        glTexCoord2f(1.0f, 1.0f);
+        glVertex2f(right, top);
+        glTexCoord2f(1.0f, 0.0f);
+        glVertex2f(right, bottom);
+        glTexCoord2f(0.0f, 0.0f);
+        glVertex2f(left, bottom);
+        glEnd();
+      }
+    }
+  };
+
+  const int target = LayoutTileCache::LevelForZoom(GetRenderZoom());
+  glEnable(GL_TEXTURE_2D);
+  glColor4ub(255, 255, 255, 255);
+  // Until the target level is complete, cached levels fill the gaps:
+  // blurrier coarse tiles first, then sharper ones left from zooming out.
+  const std::vector<int> levels = viewTiles_.Levels(view.id);
+  for (int level : levels) {
+    if (level < target && level >= target - 8)
+      drawLevel(level, nullptr);
+  }
+  for (auto it = levels.rbegin(); it != levels.rend(); ++it) {
+    if (*it > target && *it <= target + 2)
+      drawLevel(*it, nullptr);
+  }
+  drawLevel(target, &pendingTiles_);
+  glDisable(GL_TEXTURE_2D);
+}
+
+void LayoutViewerPanel::ScheduleTileRender() {
+  if (tileRenderScheduled_)
+    return;
+  tileRenderScheduled_ = true;
+  wxWeakRef<LayoutViewerPanel> weakThis(this);
+  CallAfter([weakThis]() {
+    if (!weakThis)
+      return;
+    LayoutViewerPanel *panel = weakThis.get();
+    if (!panel)
+      return;
+    panel->RenderPendingTiles();
+  });
+}
+
+void LayoutViewerPanel::RenderPendingTiles() {
+  tileRenderScheduled_ = false;
+  // A running capture refreshes the panel when it finishes, which requests
+  // the tiles again.
+  if (pendingTiles_.empty() || captureInProgress)
+    return;
+  if (!isReadyToRender_ || !glContext_ || !IsShownOnScreen())
+    return;
+  Viewer2DOffscreenRenderer *offscreenRenderer = nullptr;
+  Viewer2DPanel *capturePanel = nullptr;
+  if (auto *mw = MainWindow::Instance()) {
+    offscreenRenderer = mw->GetOffscreenRenderer();
+    capturePanel = offscreenRenderer ? offscreenRenderer->GetPanel() : nullptr;
+  }
+  if (!capturePanel || !offscreenRenderer)
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+  size_t processed = 0;
+  bool rendered = false;
+  bool failed = false;
+  for (; processed < pendingTiles_.size(); ++processed) {
+    if (processed > 0 &&
+        std::chrono::steady_clock::now() - start >=
+            std::chrono::milliseconds(kTileRenderSliceMs))
+      break;
+    const LayoutTileCache::Key key = pendingTiles_[processed];
+    const layouts::Layout2DViewDefinition *view = nullptr;
+    for (const auto &candidate : currentLayout.view2dViews) {
+      if (candidate.id == key.viewId) {
+        view = &candidate;
+        break;
+      }
+    }
+    auto cacheIt = viewCaches_.find(key.viewId);
+    if (!view || cacheIt == viewCaches_.end() ||
+        !cacheIt->second.hasCapture || !cacheIt->second.hasRenderState)
+      continue;
+    if (viewTiles_.Find(key))
+      continue;
+    LayoutTileCache::Tile tile;
+    if (!RenderViewTile(*view, cacheIt->second, key, capturePanel,
+                        offscreenRenderer, tile)) {
+      // Leave the rest for the next paint instead of retrying in a loop.
+      failed = true;
+      break;
+    }
+    viewTiles_.Insert(key, tile);
+    rendered = true;
+  }
+  pendingTiles_.erase(pendingTiles_.begin(),
+                      pendingTiles_.begin() +
+                          static_cast<std::ptrdiff_t>(processed));
+  FlushReleasedTileTextures();
+  if (rendered)
+    Refresh();
+  else if (!failed && !pendingTiles_.empty())
+    ScheduleTileRender();
+}
+
+bool LayoutViewerPanel::RenderViewTile(
+    const layouts::Layout2DViewDefinition &view, const ViewCache &cache,
+    const LayoutTileCache::Key &key, Viewer2DPanel *capturePanel,
+    Viewer2DOffscreenRenderer *offscreenRenderer,
+    LayoutTileCache::Tile &tile) {
+  const wxSize levelSize = GetViewLevelSize(view.frame, key.level);
+  constexpr int kTile = LayoutTileCache::kTileSize;
+  const int x0 = key.column * kTile;
+  const int y0 = key.row * kTile;
+  const int tileWidth = std::min(kTile, levelSize.GetWidth() - x0);
+  const int tileHeight = std::min(kTile, levelSize.GetHeight() - y0);
+  if (tileWidth <= 0 || tileHeight <= 0)
+    return false;
+
+  const int renderWidth = tileWidth + 2 * kTileRenderMargin;
+  const int renderHeight = tileHeight + 2 * kTileRenderMargin;
+  offscreenRenderer->SetViewportSize(wxSize(renderWidth, renderHeight));
+  offscreenRenderer->PrepareForCapture();
+
+  // The tile shows the part of the whole view rendered at the level zoom:
+  // same zoom, camera moved from the view centre to the tile centre.
+  viewer2d::Viewer2DState renderState = cache.renderState;
+  const double tileZoom =
+      renderState.camera.zoom * LayoutTileCache::ZoomForLevel(key.level);
+  if (!(tileZoom > 0.0))
+    return false;
+  const double dx = x0 + tileWidth * 0.5 - levelSize.GetWidth() * 0.5;
+  const double dy = y0 + tileHeight * 0.5 - levelSize.GetHeight() * 0.5;
+  renderState.camera.zoom = static_cast<float>(tileZoom);
+  renderState.camera.offsetPixelsX -= static_cast<float>(dx / tileZoom);
+  renderState.camera.offsetPixelsY += static_cast<float>(dy / tileZoom);
+  renderState.camera.viewportWidth = renderWidth;
+  renderState.camera.viewportHeight = renderHeight;
+
+  std::vector<unsigned char> pixels;
+  int width = 0;
+  int height = 0;
+  {
+    ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
+    viewer2d::ScopedViewer2DState stateGuard(capturePanel, nullptr, cfg,
+                                             renderState, nullptr, nullptr,
+                                             false);
+    if (!capturePanel->RenderToRGBA(pixels, width, height) ||
+        width < tileWidth || height < tileHeight)
+      return false;
+  }
+
+  // Keep the centre; the margin is the same on every side, so the crop does
+  // not depend on the row order of the read back pixels.
+  const int marginX = (width - tileWidth) / 2;
+  const int marginY = (height - tileHeight) / 2;
+  if (marginX > 0 || marginY > 0) {
+    std::vector<unsigned char> cropped(
+        static_cast<size_t>(tileWidth) * tileHeight * 4);
+    for (int row = 0; row < tileHeight; ++row) {
+      const auto src = pixels.begin() +
+                       (static_cast<std::ptrdiff_t>(row + marginY) * width +
+                        marginX) * 4;
+      std::copy(src, src + static_cast<std::ptrdiff_t>(tileWidth) * 4,
+                cropped.begin() +
+                    static_cast<std::ptrdiff_t>(row) * tileWidth * 4);
+    }
+    pixels.swap(cropped);
+    width = tileWidth;
+    height = tileHeight;
+  }
+
+  if (!InitGL())
+    return false;
+  tile.width = width;
+  tile.height = height;
+  glGenTextures(1, &tile.texture);
+  glBindTexture(GL_TEXTURE_2D, tile.texture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, pixels.data());
+  return true;
+}
+
+void LayoutViewerPanel::FlushReleasedTileTextures() {
+  // While hidden the context cannot be made current; keep the textures
+  // queued for the next paint. Destroying the context frees the rest.
+  if (releasedTileTextures_.empty() || !glContext_ || !IsShown())
+    return;
+  SetCurrent(*glContext_);
+  glDeleteTextures(static_cast<GLsizei>(releasedTileTextures_.size()),
+                   releasedTileTextures_.data());
+  releasedTileTextures_.clear();
+}
@@ -66,6 +66,7 @@ class wxZipStreamLink;
 using json = nlohmann::json;
 #include "addfixturedialog.h"
 #include "autopatcher.h"
+#include "autosaver.h"
 #include "configmanager.h"
 #include "guiconfigservices.h"
 #include "consolepanel.h"
@@ -120,6 +121,7 @@ using json = nlohmann::json;
 #include "viewer2drenderpanel.h"
 #include "viewer2dstate.h"
 #include "viewer3dpanel.h"
+#include "workerpool.h"
 #include "LayoutManager.h"
 #ifdef _WIN32
 #define popen _popen
@@ -186,6 +188,7 @@ EVT_MENU(ID_File_ImportMVR, MainWindow::OnImportMVR)
 EVT_MENU(ID_File_ExportMVR, MainWindow::OnExportMVR)
 EVT_MENU(ID_File_PrintViewer2D, MainWindow::OnPrintViewer2D)
 EVT_MENU(ID_File_PrintLayout, MainWindow::OnPrintLayout)
+EVT_MENU(ID_File_PrintAllLayouts, MainWindow::OnPrintAllLayouts)
 EVT_MENU(ID_File_PrintTable, MainWindow::OnPrintTable)
 EVT_MENU(ID_File_PrintMenu, MainWindow::OnPrintMenu)
 EVT_MENU(ID_File_ExportCSV, MainWindow::OnExportCSV)
@@ -220,6 +223,7 @@ EVT_MENU(ID_Tools_ExportFixture, MainWindow::OnExportFixture)
 EVT_MENU(ID_Tools_ExportTruss, MainWindow::OnExportTruss)
 EVT_MENU(ID_Tools_ExportSceneObject, MainWindow::OnExportSceneObject)
 EVT_MENU(ID_Tools_AutoPatch, MainWindow::OnAutoPatch)
+EVT_MENU(ID_Tools_AutoPatchPacked, MainWindow::OnAutoPatchPacked)
 EVT_MENU(ID_Tools_AutoColor, MainWindow::OnAutoColor)
 EVT_MENU(ID_Tools_ConvertToHoist, MainWindow::OnConvertToHoist)
 EVT_MENU(ID_Tools_ImportRiderText, MainWindow::OnImportRiderText)
@@ -282,10 +286,26 @@ MainWindow::MainWindow(const wxString &title, IGuiConfigServices *services)
   if (layoutPanel)
     layoutPanel->ReloadLayouts();
 
+  autosaver = std::make_unique<Autosaver>(
+      WorkerPool::Shared(), [](std::function<void()> fn) {
+        if (wxTheApp)
+          wxTheApp->CallAfter(std::move(fn));
+      });
+  autosaver->SetOnFinished([this](bool ok, size_t) {
+    if (!ok && consolePanel)
+      consolePanel->AppendMessage("Autosave failed.");
+  });
+  autosaveTimer.SetOwner(this);
+  Bind(wxEVT_TIMER, &MainWindow::OnAutosaveTimer, this,
+       autosaveTimer.GetId());
+  autosaveTimer.Start(5000);
+
   UpdateTitle();
 }
 
 MainWindow::~MainWindow() {
+  autosaveTimer.Stop();
+  autosaver.reset();
   SaveUserConfigWithViewport2DState();
   if (auiManager) {
     auiManager->UnInit();
@@ -428,6 +448,8 @@ void MainWindow::OnPaneClose(wxAuiManagerEvent &event) {
 bool MainWindow::LoadProjectFromPath(const std::string &path) {
   if (!GetDefaultGuiConfigServices().LegacyConfigManager().LoadProject(path))
     return false;
+  ClearTrussArchiveCache();
+  CancelRiderImport("Rider import cancelled: another project was loaded");
 
   Ensure3DViewport();
 
@@ -479,6 +501,8 @@ bool MainWindow::LoadProjectFromPath(const std::string &path) {
 
 void MainWindow::ResetProject() {
   GetDefaultGuiConfigServices().LegacyConfigManager().Reset();
+  ClearTrussArchiveCache();
+  CancelRiderImport("Rider import cancelled: the project was closed");
   GetDefaultGuiConfigServices().LegacyConfigManager().MarkSaved();
   currentProjectPath.clear();
   if (layoutPanel)
@@ -21,9 +21,13 @@
 #include "viewer2dstate.h"
 #include <wx/aui/aui.h>
 #include <wx/frame.h>
+#include <wx/timer.h>
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
 
 wxDECLARE_EVENT(EVT_PROJECT_LOADED, wxCommandEvent);
 
@@ -43,6 +47,7 @@ class LayoutPanel;
 class LayoutViewerPanel;
 class SummaryPanel;
 class RiggingPanel;
+class Autosaver;
 struct LayoutViewPreset;
 class MainWindowIoController;
 class IGuiConfigServices;
@@ -105,6 +110,22 @@ private:
   wxAuiToolBar *layoutViewsToolBar = nullptr;
   wxAuiToolBar *toolsToolBar = nullptr;
 
+  // Set while a rider file is read in the background. Setting the flag
+  // drops the result: the console "cancel" command, closing the window and
+  // loading another project all do so through CancelRiderImport.
+  std::shared_ptr<std::atomic<bool>> riderImportCancel;
+  void CancelRiderImport(const wxString &message);
+
+  // Preferred universe per hang position for the packed auto patch, kept
+  // between runs so the dialog reopens with the last choices.
+  std::map<std::string, int> autoPatchPositionUniverses;
+
+  // Writes a recovery copy of the project in the background while it has
+  // unsaved changes; the timer only checks whether one is due.
+  std::unique_ptr<Autosaver> autosaver;
+  wxTimer autosaveTimer;
+  void OnAutosaveTimer(wxTimerEvent &event);
+
   wxAcceleratorTable m_accel;
   std::unique_ptr<MainWindowIoController> ioController;
   std::unique_ptr<MainWindowLayoutController> layoutController;
@@ -124,10 +145,12 @@ private:
   void OnExportFixture(wxCommandEvent &event);     // Export fixture GDTF
   void OnExportSceneObject(wxCommandEvent &event); // Export scene object model
   void OnAutoPatch(wxCommandEvent &event);         // Auto patch fixtures
+  void OnAutoPatchPacked(wxCommandEvent &event);   // Pack into few universes
   void OnAutoColor(wxCommandEvent &event);         // Auto assign colors
   void OnConvertToHoist(wxCommandEvent &event);    // Convert fixtures to hoists
   void OnPrintViewer2D(wxCommandEvent &event); // Print 2D view to PDF
   void OnPrintLayout(wxCommandEvent &event);   // Print layout to PDF
+  void OnPrintAllLayouts(wxCommandEvent &event); // Print every layout to one PDF
   void OnPrintTable(wxCommandEvent &event);        // Print selected table
   void OnPrintMenu(wxCommandEvent &event);         // Show print options popup
   void OnExportCSV(wxCommandEvent &event);         // Export table to CSV
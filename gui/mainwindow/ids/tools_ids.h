@@ -9,5 +9,6 @@ inline constexpr int ID_Tools_ExportFixture = ID_Tools_ImportRiderText + 1;
 inline constexpr int ID_Tools_ExportTruss = ID_Tools_ExportFixture + 1;
 inline constexpr int ID_Tools_ExportSceneObject = ID_Tools_ExportTruss + 1;
 inline constexpr int ID_Tools_AutoPatch = ID_Tools_ExportSceneObject + 1;
-inline constexpr int ID_Tools_AutoColor = ID_Tools_AutoPatch + 1;
+inline constexpr int ID_Tools_AutoPatchPacked = ID_Tools_AutoPatch + 1;
+inline constexpr int ID_Tools_AutoColor = ID_Tools_AutoPatchPacked + 1;
 inline constexpr int ID_Tools_ConvertToHoist = ID_Tools_AutoColor + 1;
@@ -24,9 +24,12 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <tinyxml2.h>
+#include <wx/app.h>
+#include <wx/evtloop.h>
 #include <wx/log.h>
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
@@ -35,6 +38,7 @@
 
 using json = nlohmann::json;
 
+#include "autosaver.h"
 #include "configmanager.h"
 #include "guiconfigservices.h"
 #include "consolepanel.h"
@@ -55,6 +59,7 @@ using json = nlohmann::json;
 #include "viewer2dpanel.h"
 #include "viewer2drenderpanel.h"
 #include "viewer3dpanel.h"
+#include "workerpool.h"
 
 void MainWindow::OnLoad(wxCommandEvent &event) {
   if (!ConfirmSaveIfDirty("loading a project", "Open Project"))
@@ -97,6 +102,30 @@ void MainWindow::OnSave(wxCommandEvent &event) {
   }
 }
 
+void MainWindow::OnAutosaveTimer(wxTimerEvent &WXUNUSED(event)) {
+  if (!autosaver || !wxTheApp)
+    return;
+  // Code that opened a modal dialog may still hold references into the
+  // scene and edit through them once it returns, after a snapshot shared
+  // it; wait for the main loop.
+  if (wxEventLoopBase::GetActive() != wxTheApp->GetMainLoop())
+    return;
+  ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
+  autosaver->SetInterval(std::chrono::duration_cast<Autosaver::Clock::duration>(
+      std::chrono::duration<double>(cfg.GetFloat("autosave_interval_seconds"))));
+  const std::string projectPath = currentProjectPath;
+  autosaver->Tick(
+      cfg.GetSceneRevision(), cfg.IsDirty(), Autosaver::Clock::now(),
+      [&cfg, projectPath]() -> std::function<bool()> {
+        std::string path = ProjectUtils::GetAutosavePath(projectPath);
+        if (path.empty())
+          return [] { return false; };
+        return [snapshot = cfg.TakeProjectSnapshot(), path = std::move(path)] {
+          return ConfigManager::WriteProjectSnapshot(snapshot, path);
+        };
+      });
+}
+
 void MainWindow::OnSaveAs(wxCommandEvent &event) {
   wxString filter = wxString::Format("Perastage files (*%s)|*%s",
                                      ProjectUtils::PROJECT_EXTENSION,
@@ -129,8 +158,17 @@ void MainWindow::OnSaveAs(wxCommandEvent &event) {
   UpdateTitle();
 }
 
-// Import fixtures and trusses from a rider (.txt/.pdf)
+// Import fixtures and trusses from a rider (.txt/.pdf). The file is read on
+// the worker pool so long PDFs do not block the UI; the parsed text is then
+// applied to the scene on the UI thread.
 void MainWindow::OnImportRider(wxCommandEvent &event) {
+  if (riderImportCancel) {
+    if (consolePanel)
+      consolePanel->AppendMessage(
+          "A rider is already being imported. Type 'cancel' to stop it.");
+    return;
+  }
+
   wxString miscDir =
       wxString::FromUTF8(ProjectUtils::GetDefaultLibraryPath("misc"));
   wxFileDialog dlg(this, "Import Rider", miscDir, "",
@@ -140,15 +178,80 @@ void MainWindow::OnImportRider(wxCommandEvent &event) {
     return;
 
   std::string pathUtf8 = dlg.GetPath().ToStdString();
-  if (!RiderImporter::Import(pathUtf8)) {
-    wxMessageBox("Failed to import rider.", "Error", wxICON_ERROR);
-    if (consolePanel)
-      consolePanel->AppendMessage("Failed to import " + dlg.GetPath());
-  } else {
-    wxMessageBox("Rider imported successfully.", "Success", wxICON_INFORMATION);
-    if (consolePanel)
-      consolePanel->AppendMessage("Imported " + dlg.GetPath());
-    RefreshAfterSceneChange();
+  wxString pathDisplay = dlg.GetPath();
+  auto cancel = std::make_shared<std::atomic<bool>>(false);
+  riderImportCancel = cancel;
+  if (consolePanel) {
+    consolePanel->AppendMessage("Reading " + pathDisplay +
+                                " (type 'cancel' to stop)");
+    // Deferred so the handler is not replaced while the console runs it.
+    consolePanel->SetCancelHandler([this, pathDisplay]() {
+      CallAfter([this, pathDisplay]() {
+        CancelRiderImport("Cancelled import of " + pathDisplay);
+      });
+    });
+  }
+
+  MainWindow *window = this;
+  WorkerPool::Shared().Submit([window, pathUtf8, pathDisplay, cancel]() {
+    // The flag is set on the UI thread before the window goes away or
+    // another project is loaded, so the window is alive and the result
+    // still wanted whenever a check below passes.
+    size_t lastReported = 0;
+    auto progress = [&](size_t done, size_t total) {
+      // Report at most every tenth of the document so the console is not
+      // flooded on long riders.
+      if (total < 2 || (done != total && (done - lastReported) * 10 < total))
+        return;
+      lastReported = done;
+      if (cancel->load() || !wxTheApp)
+        return;
+      wxTheApp->CallAfter([window, cancel, done, total]() {
+        if (cancel->load() || !window->consolePanel)
+          return;
+        window->consolePanel->AppendMessage(
+            wxString::Format("Reading rider page %zu/%zu", done, total));
+      });
+    };
+    std::string text =
+        RiderImporter::LoadText(pathUtf8, cancel.get(), progress);
+    if (cancel->load() || !wxTheApp)
+      return;
+
+    wxTheApp->CallAfter(
+        [window, text = std::move(text), pathDisplay, cancel]() {
+          if (cancel->load())
+            return;
+          window->riderImportCancel.reset();
+          if (window->consolePanel)
+            window->consolePanel->SetCancelHandler({});
+          if (!RiderImporter::ImportText(text)) {
+            wxMessageBox("Failed to import rider.", "Error", wxICON_ERROR);
+            if (window->consolePanel)
+              window->consolePanel->AppendMessage("Failed to import " +
+                                                  pathDisplay);
+          } else {
+            wxMessageBox("Rider imported successfully.", "Success",
+                         wxICON_INFORMATION);
+            if (window->consolePanel)
+              window->consolePanel->AppendMessage("Imported " + pathDisplay);
+            window->RefreshAfterSceneChange();
+          }
+        });
+  });
+}
+
+// Stops a rider read in progress. Its result is dropped, so the scene is
+// left as it is now.
+void MainWindow::CancelRiderImport(const wxString &message) {
+  if (!riderImportCancel)
+    return;
+  riderImportCancel->store(true);
+  riderImportCancel.reset();
+  if (consolePanel) {
+    consolePanel->SetCancelHandler({});
+    if (!message.empty())
+      consolePanel->AppendMessage(message);
   }
 }
 
@@ -195,7 +298,7 @@ void MainWindow::OnExportMVR(wxCommandEvent &event) {
 }
 
 void MainWindow::OnExportTruss(wxCommandEvent &WXUNUSED(event)) {
-  const auto &trusses = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().trusses;
+  const auto &trusses = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().trusses;
   std::set<std::string> names;
   for (const auto &[uuid, t] : trusses)
     names.insert(t.name);
@@ -230,7 +333,7 @@ void MainWindow::OnExportTruss(wxCommandEvent &WXUNUSED(event)) {
 
   namespace fs = std::filesystem;
   std::string modelPath = chosen->symbolFile;
-  const auto &scene = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene();
+  const auto &scene = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene();
   if (fs::path(modelPath).is_relative() && !scene.basePath.empty())
     modelPath = (fs::path(scene.basePath) / modelPath).string();
   if (!fs::exists(modelPath)) {
@@ -334,7 +437,7 @@ void MainWindow::OnExportFixture(wxCommandEvent &WXUNUSED(event)) {
     }
     return true;
   };
-  const auto &fixtures = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().fixtures;
+  const auto &fixtures = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().fixtures;
   std::set<std::string> types;
   for (const auto &[uuid, f] : fixtures)
     if (!f.typeName.empty())
@@ -361,7 +464,7 @@ void MainWindow::OnExportFixture(wxCommandEvent &WXUNUSED(event)) {
     return;
 
   fs::path src = chosen->gdtfSpec;
-  const std::string &base = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().basePath;
+  const std::string &base = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().basePath;
   if (src.is_relative() && !base.empty())
     src = fs::path(base) / src;
   if (!fs::exists(src)) {
@@ -461,7 +564,7 @@ void MainWindow::OnExportFixture(wxCommandEvent &WXUNUSED(event)) {
 
 void MainWindow::OnExportSceneObject(wxCommandEvent &WXUNUSED(event)) {
   namespace fs = std::filesystem;
-  const auto &scene = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene();
+  const auto &scene = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene();
   const auto &objs = scene.sceneObjects;
   std::set<std::string> names;
   for (const auto &[uuid, obj] : objs)
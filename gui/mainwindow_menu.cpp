@@ -28,6 +28,7 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <wx/aboutdlg.h>
@@ -41,6 +42,7 @@
 #include <wx/stdpaths.h>
 
 #include "addfixturedialog.h"
+#include "autopatchdialog.h"
 #include "autopatcher.h"
 #include "configmanager.h"
 #include "guiconfigservices.h"
@@ -321,6 +323,7 @@ void MainWindow::CreateMenuBar() {
   fileMenu->Append(ID_File_ExportMVR, "Export MVR...");
   fileMenu->Append(ID_File_PrintViewer2D, "Print Viewer 2D...");
   fileMenu->Append(ID_File_PrintLayout, "Print Layout...");
+  fileMenu->Append(ID_File_PrintAllLayouts, "Print All Layouts...");
   fileMenu->Append(ID_File_PrintTable, "Print Table...");
   fileMenu->Append(ID_File_ExportCSV, "Export CSV...");
   fileMenu->AppendSeparator();
@@ -372,6 +375,7 @@ void MainWindow::CreateMenuBar() {
   toolsMenu->Append(ID_Tools_ExportTruss, "Export Truss...");
   toolsMenu->Append(ID_Tools_ExportSceneObject, "Export Scene Object...");
   toolsMenu->Append(ID_Tools_AutoPatch, "Auto patch");
+  toolsMenu->Append(ID_Tools_AutoPatchPacked, "Auto patch (pack universes)...");
   toolsMenu->Append(ID_Tools_AutoColor, "Auto color");
   toolsMenu->Append(ID_Tools_ConvertToHoist, "Convert to Hoist");
 
@@ -515,6 +519,60 @@ void MainWindow::OnAutoPatch(wxCommandEvent &WXUNUSED(event)) {
   RefreshAfterSceneChange();
 }
 
+void MainWindow::OnAutoPatchPacked(wxCommandEvent &WXUNUSED(event)) {
+  ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
+  const auto &scene = std::as_const(cfg).GetScene();
+
+  // Only selected fixtures that already have an address can be kept.
+  std::vector<std::string> lockable;
+  for (const auto &uuid : cfg.GetSelectedFixtures()) {
+    auto it = scene.fixtures.find(uuid);
+    if (it != scene.fixtures.end() && !it->second.address.empty())
+      lockable.push_back(uuid);
+  }
+  std::set<std::string> positionSet;
+  for (const auto &[uuid, fixture] : scene.fixtures)
+    if (!fixture.positionName.empty())
+      positionSet.insert(fixture.positionName);
+  const std::vector<std::string> positions(positionSet.begin(),
+                                           positionSet.end());
+
+  AutoPatchDialog dlg(this, lockable.size(), positions,
+                      autoPatchPositionUniverses);
+  if (dlg.ShowModal() != wxID_OK)
+    return;
+  // Choices for positions missing from this scene are kept for later ones.
+  for (const auto &position : positions)
+    autoPatchPositionUniverses.erase(position);
+  for (const auto &[position, universe] : dlg.GetPositionUniverses())
+    autoPatchPositionUniverses[position] = universe;
+
+  AutoPatcher::AutoPatchOptions options;
+  options.mode = AutoPatcher::AutoPatchMode::Packed;
+  if (dlg.GetLockSelected())
+    options.lockedUuids.insert(lockable.begin(), lockable.end());
+  options.positionUniverses = autoPatchPositionUniverses;
+
+  cfg.PushUndoState("auto patch");
+  AutoPatcher::AutoPatchReport report =
+      AutoPatcher::AutoPatch(cfg.GetScene(), options);
+  RefreshAfterSceneChange();
+  if (consolePanel) {
+    consolePanel->AppendMessage(wxString::Format(
+        "Auto patch: %zu fixtures in %zu universes (%.0f%% used)",
+        report.patched, report.universes.size(),
+        report.Utilization() * 100.0));
+    if (report.locked > 0)
+      consolePanel->AppendMessage(wxString::Format(
+          "Auto patch: kept the address of %zu fixtures", report.locked));
+    if (report.skipped > 0 || report.unplaced > 0)
+      consolePanel->AppendMessage(wxString::Format(
+          "Auto patch: %zu fixtures without a channel count, %zu larger than "
+          "a universe",
+          report.skipped, report.unplaced));
+  }
+}
+
 void MainWindow::OnAutoColor(wxCommandEvent &WXUNUSED(event)) {
   ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
   cfg.PushUndoState("auto color");
@@ -670,6 +728,7 @@ void MainWindow::OnCloseWindow(wxCloseEvent &event) {
 
   if (viewportPanel)
     viewportPanel->StopRefreshThread();
+  CancelRiderImport({});
 
   Destroy();
 }
@@ -928,12 +987,22 @@ void MainWindow::OnAddFixture(wxCommandEvent &WXUNUSED(event)) {
     for (const auto &[uuid, f] : scene.fixtures)
       if (!f.typeName.empty() && !f.gdtfSpec.empty())
         typeToSpec.try_emplace(f.typeName, f.gdtfSpec);
+    namespace fs = std::filesystem;
+    auto resolveSpec = [&](const std::string &spec) {
+      if (fs::path(spec).is_absolute())
+        return spec;
+      return (fs::path(scene.basePath) / spec).string();
+    };
     std::vector<std::string> types;
+    std::vector<std::string> typePaths;
     types.reserve(typeToSpec.size());
-    for (const auto &[name, spec] : typeToSpec)
+    typePaths.reserve(typeToSpec.size());
+    for (const auto &[name, spec] : typeToSpec) {
       types.push_back(name);
+      typePaths.push_back(resolveSpec(spec));
+    }
 
-    SelectFixtureTypeDialog chooseDlg(this, types);
+    SelectFixtureTypeDialog chooseDlg(this, types, typePaths);
     int dlgRes = chooseDlg.ShowModal();
     if (dlgRes == wxID_CANCEL)
       return;
@@ -954,12 +1023,7 @@ void MainWindow::OnAddFixture(wxCommandEvent &WXUNUSED(event)) {
       if (sel < 0 || sel >= static_cast<int>(types.size()))
         return;
       defaultName = types[sel];
-      std::string spec = typeToSpec[defaultName];
-      namespace fs = std::filesystem;
-      if (fs::path(spec).is_absolute())
-        gdtfPath = spec;
-      else
-        gdtfPath = (fs::path(scene.basePath) / spec).string();
+      gdtfPath = typePaths[sel];
     }
   } else {
     wxString fixDir =
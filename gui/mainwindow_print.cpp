@@ -20,9 +20,11 @@
 
 #include <cmath>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <wx/filename.h>
@@ -59,8 +61,8 @@ std::vector<LayoutLegendItem> BuildLayoutLegendItems() {
   };
 
   std::map<std::string, LegendAggregate> aggregates;
-  const auto &fixtures = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().fixtures;
-  const std::string &basePath = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().basePath;
+  const auto &fixtures = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().fixtures;
+  const std::string &basePath = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().basePath;
   for (const auto &[uuid, fixture] : fixtures) {
     (void)uuid;
     std::string typeName = fixture.typeName;
@@ -121,11 +123,212 @@ std::vector<LayoutLegendItem> BuildLayoutLegendItems() {
 
   return items;
 }
+
+// Captures every 2D view of the given layouts one after another and writes
+// them to a single PDF with one page per layout. Each layout keeps its own
+// orientation; frames are scaled from the layout page to the output paper.
+void StartLayoutPdfExport(MainWindow *window,
+                          std::vector<layouts::LayoutDefinition> layoutsToPrint,
+                          const print::Viewer2DPrintSettings &settings,
+                          const wxString &outputPathWx) {
+  Viewer2DOffscreenRenderer *offscreenRenderer = window->GetOffscreenRenderer();
+  Viewer2DPanel *capturePanel =
+      offscreenRenderer ? offscreenRenderer->GetPanel() : nullptr;
+  if (!capturePanel || layoutsToPrint.empty())
+    return;
+
+  ConfigManager *cfgPtr = &GetDefaultGuiConfigServices().LegacyConfigManager();
+  const bool useSimplifiedFootprints = !settings.detailedFootprints;
+  const bool includeGrid = settings.includeGrid;
+  const auto legendItems = BuildLayoutLegendItems();
+
+  struct PendingLayout {
+    std::vector<layouts::Layout2DViewDefinition> views;
+    double scaleX = 1.0;
+    double scaleY = 1.0;
+  };
+  std::vector<PendingLayout> pending;
+  pending.reserve(layoutsToPrint.size());
+  auto exportPages = std::make_shared<std::vector<LayoutPageExportData>>();
+  exportPages->reserve(layoutsToPrint.size());
+  for (const auto &layout : layoutsToPrint) {
+    print::PageSetup outputSetup = settings;
+    outputSetup.landscape = layout.pageSetup.landscape;
+    const double outputPageW = outputSetup.PageWidthPt();
+    const double outputPageH = outputSetup.PageHeightPt();
+    const double layoutPageW = layout.pageSetup.PageWidthPt();
+    const double layoutPageH = layout.pageSetup.PageHeightPt();
+    const double scaleX =
+        layoutPageW > 0.0 ? outputPageW / layoutPageW : 1.0;
+    const double scaleY =
+        layoutPageH > 0.0 ? outputPageH / layoutPageH : 1.0;
+
+    LayoutPageExportData page;
+    page.pageWidthPt = outputPageW;
+    page.pageHeightPt = outputPageH;
+    page.views.reserve(layout.view2dViews.size());
+    page.legends.reserve(layout.legendViews.size());
+    page.tables.reserve(layout.eventTables.size());
+    page.texts.reserve(layout.textViews.size());
+    for (const auto &legend : layout.legendViews) {
+      LayoutLegendExportData legendData;
+      legendData.items = legendItems;
+      legendData.zIndex = legend.zIndex;
+      layouts::Layout2DViewFrame frame = legend.frame;
+      frame.x = static_cast<int>(std::lround(frame.x * scaleX));
+      frame.y = static_cast<int>(std::lround(frame.y * scaleY));
+      frame.width = static_cast<int>(std::lround(frame.width * scaleX));
+      frame.height = static_cast<int>(std::lround(frame.height * scaleY));
+      legendData.frame = frame;
+      page.legends.push_back(std::move(legendData));
+    }
+    for (const auto &table : layout.eventTables) {
+      LayoutEventTableExportData tableData;
+      tableData.fields = table.fields;
+      tableData.zIndex = table.zIndex;
+      layouts::Layout2DViewFrame frame = table.frame;
+      frame.x = static_cast<int>(std::lround(frame.x * scaleX));
+      frame.y = static_cast<int>(std::lround(frame.y * scaleY));
+      frame.width = static_cast<int>(std::lround(frame.width * scaleX));
+      frame.height = static_cast<int>(std::lround(frame.height * scaleY));
+      tableData.frame = frame;
+      page.tables.push_back(std::move(tableData));
+    }
+    for (const auto &text : layout.textViews) {
+      page.texts.push_back(
+          layouttext::BuildLayoutTextExportData(text, scaleX, scaleY));
+    }
+    exportPages->push_back(std::move(page));
+    pending.push_back({layout.view2dViews, scaleX, scaleY});
+  }
+  const bool outputLandscape = layoutsToPrint.front().pageSetup.landscape;
+  const size_t pageCount = layoutsToPrint.size();
+
+  auto captureNext =
+      std::make_shared<std::function<void(size_t, size_t)>>();
+  *captureNext =
+      [window, captureNext, exportPages, pending, offscreenRenderer,
+       capturePanel, cfgPtr, useSimplifiedFootprints, includeGrid,
+       outputLandscape, pageCount,
+       outputPathWx](size_t pageIndex, size_t viewIndex) mutable {
+        if (pageIndex < pending.size() &&
+            viewIndex >= pending[pageIndex].views.size()) {
+          (*captureNext)(pageIndex + 1, 0);
+          return;
+        }
+        if (pageIndex >= pending.size()) {
+          Viewer2DPrintOptions opts;
+          opts.pageWidthPt = exportPages->front().pageWidthPt;
+          opts.pageHeightPt = exportPages->front().pageHeightPt;
+          opts.marginPt = 0.0;
+          opts.landscape = outputLandscape;
+          opts.printIncludeGrid = includeGrid;
+          opts.useSimplifiedFootprints = useSimplifiedFootprints;
+          std::filesystem::path outputPath(
+              std::filesystem::path(outputPathWx.ToStdWstring()));
+          wxString outputPathDisplay = outputPathWx;
+          auto pagesToExport = std::move(*exportPages);
+          if (capturePanel) {
+            auto legendSymbols =
+                CaptureLegendSymbolSnapshot(capturePanel, *cfgPtr, true);
+            for (auto &page : pagesToExport) {
+              for (auto &legend : page.legends)
+                legend.symbolSnapshot = legendSymbols;
+            }
+          }
+
+          std::thread([window, pages = std::move(pagesToExport), opts,
+                       outputPath, outputPathDisplay, pageCount]() {
+            Viewer2DExportResult res =
+                ExportLayoutsToPdf(pages, opts, outputPath);
+
+            wxTheApp->CallAfter([window, res, outputPathDisplay,
+                                 pageCount]() {
+              const wxString title =
+                  pageCount > 1 ? "Print All Layouts" : "Print Layout";
+              if (!res.success) {
+                wxString msg = "Failed to generate layout PDF: " +
+                               wxString::FromUTF8(res.message);
+                wxMessageBox(msg, title, wxOK | wxICON_ERROR, window);
+              } else {
+                wxMessageBox(wxString::Format(pageCount > 1
+                                                  ? "Layouts saved to %s"
+                                                  : "Layout saved to %s",
+                                              outputPathDisplay),
+                             title, wxOK | wxICON_INFORMATION, window);
+              }
+            });
+          }).detach();
+          return;
+        }
+
+        const auto &view = pending[pageIndex].views[viewIndex];
+        const double scaleX = pending[pageIndex].scaleX;
+        const double scaleY = pending[pageIndex].scaleY;
+        viewer2d::Viewer2DState layoutState =
+            viewer2d::FromLayoutDefinition(view);
+        viewer2d::ApplyEditorRenderOptions(layoutState, *cfgPtr);
+        layoutState.renderOptions.darkMode = false;
+
+        const int fallbackViewportWidth = view.camera.viewportWidth > 0
+                                              ? view.camera.viewportWidth
+                                              : view.frame.width;
+        const int fallbackViewportHeight = view.camera.viewportHeight > 0
+                                               ? view.camera.viewportHeight
+                                               : view.frame.height;
+        const int viewportWidth =
+            fallbackViewportWidth > 0 ? fallbackViewportWidth : 1600;
+        const int viewportHeight =
+            fallbackViewportHeight > 0 ? fallbackViewportHeight : 900;
+
+        if (offscreenRenderer && viewportWidth > 0 && viewportHeight > 0) {
+          offscreenRenderer->SetViewportSize(
+              wxSize(viewportWidth, viewportHeight));
+          offscreenRenderer->PrepareForCapture();
+        }
+
+        auto stateGuard = std::make_shared<viewer2d::ScopedViewer2DState>(
+            capturePanel, nullptr, *cfgPtr, layoutState, nullptr, nullptr,
+            false);
+        capturePanel->CaptureFrameNow(
+            [captureNext, exportPages, pageIndex, viewIndex, view,
+             viewportWidth, viewportHeight, capturePanel, scaleX, scaleY,
+             stateGuard](CommandBuffer buffer, Viewer2DViewState state) {
+              LayoutViewExportData data;
+              data.buffer = std::move(buffer);
+              data.viewState = state;
+              if (data.viewState.viewportWidth <= 0)
+                data.viewState.viewportWidth = viewportWidth;
+              if (data.viewState.viewportHeight <= 0)
+                data.viewState.viewportHeight = viewportHeight;
+              layouts::Layout2DViewFrame frame = view.frame;
+              frame.x =
+                  static_cast<int>(std::lround(frame.x * scaleX));
+              frame.y =
+                  static_cast<int>(std::lround(frame.y * scaleY));
+              frame.width =
+                  static_cast<int>(std::lround(frame.width * scaleX));
+              frame.height =
+                  static_cast<int>(std::lround(frame.height * scaleY));
+              data.frame = frame;
+              data.zIndex = view.zIndex;
+              if (capturePanel)
+                data.symbolSnapshot =
+                    capturePanel->GetBottomSymbolCacheSnapshot();
+              (*exportPages)[pageIndex].views.push_back(std::move(data));
+              (*captureNext)(pageIndex, viewIndex + 1);
+            },
+            useSimplifiedFootprints, includeGrid);
+      };
+
+  (*captureNext)(0, 0);
+}
 }
 
 void MainWindow::OnPrintMenu(wxCommandEvent &WXUNUSED(event)) {
   const wxArrayString choices = {
       "Layout",
+      "Todos los layouts",
       "Vista 2D",
       "Tabla",
   };
@@ -140,8 +343,10 @@ void MainWindow::OnPrintMenu(wxCommandEvent &WXUNUSED(event)) {
   if (selection == 0) {
     OnPrintLayout(printEvent);
   } else if (selection == 1) {
-    OnPrintViewer2D(printEvent);
+    OnPrintAllLayouts(printEvent);
   } else if (selection == 2) {
+    OnPrintViewer2D(printEvent);
+  } else if (selection == 3) {
     OnPrintTable(printEvent);
   }
 }
@@ -293,7 +498,6 @@ void MainWindow::OnPrintLayout(wxCommandEvent &WXUNUSED(event)) {
   }
 
   ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
-  ConfigManager *cfgPtr = &cfg;
   print::Viewer2DPrintSettings settings =
       print::Viewer2DPrintSettings::LoadFromConfig(cfg);
   settings.pageSize = layout->pageSetup.pageSize;
@@ -320,181 +524,54 @@ void MainWindow::OnPrintLayout(wxCommandEvent &WXUNUSED(event)) {
     return;
   }
 
-  print::PageSetup outputSetup = settings;
-  outputSetup.landscape = layout->pageSetup.landscape;
-  const double outputPageW = outputSetup.PageWidthPt();
-  const double outputPageH = outputSetup.PageHeightPt();
-  const bool outputLandscape = outputSetup.landscape;
-  const double layoutPageW = layout->pageSetup.PageWidthPt();
-  const double layoutPageH = layout->pageSetup.PageHeightPt();
-  const double scaleX =
-      layoutPageW > 0.0 ? outputPageW / layoutPageW : 1.0;
-  const double scaleY =
-      layoutPageH > 0.0 ? outputPageH / layoutPageH : 1.0;
+  StartLayoutPdfExport(this, {*layout}, settings, outputPathWx);
+}
 
-  const bool useSimplifiedFootprints = !settings.detailedFootprints;
-  const bool includeGrid = settings.includeGrid;
-  std::vector<layouts::Layout2DViewDefinition> layoutViews =
-      layout->view2dViews;
-  std::vector<LayoutLegendExportData> layoutLegends;
-  layoutLegends.reserve(layout->legendViews.size());
-  std::vector<LayoutEventTableExportData> layoutTables;
-  layoutTables.reserve(layout->eventTables.size());
-  std::vector<LayoutTextExportData> layoutTexts;
-  layoutTexts.reserve(layout->textViews.size());
-  const auto legendItems = BuildLayoutLegendItems();
-  for (const auto &legend : layout->legendViews) {
-    LayoutLegendExportData legendData;
-    legendData.items = legendItems;
-    legendData.zIndex = legend.zIndex;
-    layouts::Layout2DViewFrame frame = legend.frame;
-    frame.x = static_cast<int>(std::lround(frame.x * scaleX));
-    frame.y = static_cast<int>(std::lround(frame.y * scaleY));
-    frame.width = static_cast<int>(std::lround(frame.width * scaleX));
-    frame.height = static_cast<int>(std::lround(frame.height * scaleY));
-    legendData.frame = frame;
-    layoutLegends.push_back(std::move(legendData));
-  }
-  for (const auto &table : layout->eventTables) {
-    LayoutEventTableExportData tableData;
-    tableData.fields = table.fields;
-    tableData.zIndex = table.zIndex;
-    layouts::Layout2DViewFrame frame = table.frame;
-    frame.x = static_cast<int>(std::lround(frame.x * scaleX));
-    frame.y = static_cast<int>(std::lround(frame.y * scaleY));
-    frame.width = static_cast<int>(std::lround(frame.width * scaleX));
-    frame.height = static_cast<int>(std::lround(frame.height * scaleY));
-    tableData.frame = frame;
-    layoutTables.push_back(std::move(tableData));
+void MainWindow::OnPrintAllLayouts(wxCommandEvent &WXUNUSED(event)) {
+  std::vector<layouts::LayoutDefinition> printable;
+  for (const auto &entry : layouts::LayoutManager::Get().GetLayouts().Items()) {
+    if (!entry.view2dViews.empty())
+      printable.push_back(entry);
   }
-  for (const auto &text : layout->textViews) {
-    layoutTexts.push_back(
-        layouttext::BuildLayoutTextExportData(text, scaleX, scaleY));
+  if (printable.empty()) {
+    wxMessageBox("No layout has 2D views to print.", "Print All Layouts",
+                 wxOK | wxICON_INFORMATION, this);
+    return;
   }
-  auto exportViews = std::make_shared<std::vector<LayoutViewExportData>>();
-  exportViews->reserve(layoutViews.size());
-  auto exportLegends =
-      std::make_shared<std::vector<LayoutLegendExportData>>(
-          std::move(layoutLegends));
-  auto exportTables =
-      std::make_shared<std::vector<LayoutEventTableExportData>>(
-          std::move(layoutTables));
-  auto exportTexts =
-      std::make_shared<std::vector<LayoutTextExportData>>(
-          std::move(layoutTexts));
-
-  auto captureNext =
-      std::make_shared<std::function<void(size_t)>>();
-  *captureNext =
-      [this, captureNext, exportViews, layoutViews, offscreenRenderer,
-       capturePanel, cfgPtr, useSimplifiedFootprints, includeGrid, scaleX,
-       scaleY, outputPageW, outputPageH, outputLandscape, exportLegends,
-       exportTables, exportTexts, outputPathWx](size_t index) mutable {
-        if (index >= layoutViews.size()) {
-          Viewer2DPrintOptions opts;
-          opts.pageWidthPt = outputPageW;
-          opts.pageHeightPt = outputPageH;
-          opts.marginPt = 0.0;
-          opts.landscape = outputLandscape;
-          opts.printIncludeGrid = includeGrid;
-          opts.useSimplifiedFootprints = useSimplifiedFootprints;
-          std::filesystem::path outputPath(
-              std::filesystem::path(outputPathWx.ToStdWstring()));
-          wxString outputPathDisplay = outputPathWx;
-          auto viewsToExport = std::move(*exportViews);
-          auto legendsToExport = std::move(*exportLegends);
-          auto tablesToExport = std::move(*exportTables);
-          auto textsToExport = std::move(*exportTexts);
-          if (capturePanel) {
-            auto legendSymbols =
-                CaptureLegendSymbolSnapshot(capturePanel, *cfgPtr, true);
-            for (auto &legend : legendsToExport) {
-              legend.symbolSnapshot = legendSymbols;
-            }
-          }
-
-          std::thread([this, views = std::move(viewsToExport), opts,
-                       legends = std::move(legendsToExport),
-                       tables = std::move(tablesToExport),
-                       texts = std::move(textsToExport), outputPath,
-                       outputPathDisplay]() {
-            Viewer2DExportResult res =
-                ExportLayoutToPdf(views, legends, tables, texts, opts,
-                                  outputPath);
 
-            wxTheApp->CallAfter([this, res, outputPathDisplay]() {
-              if (!res.success) {
-                wxString msg = "Failed to generate layout PDF: " +
-                               wxString::FromUTF8(res.message);
-                wxMessageBox(msg, "Print Layout", wxOK | wxICON_ERROR, this);
-              } else {
-                wxMessageBox(wxString::Format("Layout saved to %s",
-                                              outputPathDisplay),
-                             "Print Layout", wxOK | wxICON_INFORMATION, this);
-              }
-            });
-          }).detach();
-          return;
-        }
+  Viewer2DOffscreenRenderer *offscreenRenderer = GetOffscreenRenderer();
+  if (!offscreenRenderer || !offscreenRenderer->GetPanel()) {
+    wxMessageBox("2D viewport is not available.", "Print All Layouts", wxOK,
+                 this);
+    return;
+  }
 
-        const auto &view = layoutViews[index];
-        viewer2d::Viewer2DState layoutState =
-            viewer2d::FromLayoutDefinition(view);
-        viewer2d::ApplyEditorRenderOptions(layoutState, *cfgPtr);
-        layoutState.renderOptions.darkMode = false;
+  ConfigManager &cfg = GetDefaultGuiConfigServices().LegacyConfigManager();
+  print::Viewer2DPrintSettings settings =
+      print::Viewer2DPrintSettings::LoadFromConfig(cfg);
+  settings.pageSize = printable.front().pageSetup.pageSize;
+  Viewer2DPrintDialog settingsDialog(this, settings, false);
+  if (settingsDialog.ShowModal() != wxID_OK)
+    return;
 
-        const int fallbackViewportWidth = view.camera.viewportWidth > 0
-                                              ? view.camera.viewportWidth
-                                              : view.frame.width;
-        const int fallbackViewportHeight = view.camera.viewportHeight > 0
-                                               ? view.camera.viewportHeight
-                                               : view.frame.height;
-        const int viewportWidth =
-            fallbackViewportWidth > 0 ? fallbackViewportWidth : 1600;
-        const int viewportHeight =
-            fallbackViewportHeight > 0 ? fallbackViewportHeight : 900;
+  settings = settingsDialog.GetSettings();
+  settings.SaveToConfig(cfg);
 
-        if (offscreenRenderer && viewportWidth > 0 && viewportHeight > 0) {
-          offscreenRenderer->SetViewportSize(
-              wxSize(viewportWidth, viewportHeight));
-          offscreenRenderer->PrepareForCapture();
-        }
+  wxFileDialog dlg(this, "Save layouts as", "", "layouts.pdf",
+                   "PDF files (*.pdf)|*.pdf",
+                   wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+  if (dlg.ShowModal() != wxID_OK)
+    return;
 
-        auto stateGuard = std::make_shared<viewer2d::ScopedViewer2DState>(
-            capturePanel, nullptr, *cfgPtr, layoutState, nullptr, nullptr,
-            false);
-        capturePanel->CaptureFrameNow(
-            [captureNext, exportViews, view, viewportWidth, viewportHeight,
-             capturePanel, scaleX, scaleY,
-             stateGuard](CommandBuffer buffer, Viewer2DViewState state) {
-              LayoutViewExportData data;
-              data.buffer = std::move(buffer);
-              data.viewState = state;
-              if (data.viewState.viewportWidth <= 0)
-                data.viewState.viewportWidth = viewportWidth;
-              if (data.viewState.viewportHeight <= 0)
-                data.viewState.viewportHeight = viewportHeight;
-              layouts::Layout2DViewFrame frame = view.frame;
-              frame.x =
-                  static_cast<int>(std::lround(frame.x * scaleX));
-              frame.y =
-                  static_cast<int>(std::lround(frame.y * scaleY));
-              frame.width =
-                  static_cast<int>(std::lround(frame.width * scaleX));
-              frame.height =
-                  static_cast<int>(std::lround(frame.height * scaleY));
-              data.frame = frame;
-              data.zIndex = view.zIndex;
-              if (capturePanel)
-                data.symbolSnapshot =
-                    capturePanel->GetBottomSymbolCacheSnapshot();
-              exportViews->push_back(std::move(data));
-              (*captureNext)(exportViews->size());
-            },
-            useSimplifiedFootprints, includeGrid);
-      };
+  wxString outputPathWx = dlg.GetPath();
+  outputPathWx.Trim(true).Trim(false);
+  if (outputPathWx.empty()) {
+    wxMessageBox("Please choose a destination file for the layouts.",
+                 "Print All Layouts", wxOK | wxICON_WARNING, this);
+    return;
+  }
 
-  (*captureNext)(0);
+  StartLayoutPdfExport(this, std::move(printable), settings, outputPathWx);
 }
 
 void MainWindow::OnPrintTable(wxCommandEvent &WXUNUSED(event)) {
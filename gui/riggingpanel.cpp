@@ -17,9 +17,12 @@
  */
 #include "riggingpanel.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 #include "colorstore.h"
 #include "columnutils.h"
@@ -32,6 +35,25 @@ constexpr const char *UNASSIGNED_POSITION = "Unassigned";
 float CeilToNearestTens(float value) {
   return std::ceil(value / 10.0f) * 10.0f;
 }
+
+template <typename Entity> std::string PositionOf(const Entity &entity) {
+  return entity.positionName.empty() ? UNASSIGNED_POSITION
+                                     : entity.positionName;
+}
+
+// Index into RiggingPanel's per-group tables, or -1 for kinds it ignores.
+int GroupOf(SceneEntityKind kind) {
+  switch (kind) {
+  case SceneEntityKind::Fixture:
+    return 0;
+  case SceneEntityKind::Truss:
+    return 1;
+  case SceneEntityKind::Support:
+    return 2;
+  default:
+    return -1;
+  }
+}
 }
 
 static RiggingPanel *s_instance = nullptr;
@@ -65,12 +87,27 @@ RiggingPanel::RiggingPanel(wxWindow *parent) : wxPanel(parent, wxID_ANY) {
   table->AppendTextColumn("Total Weight +5% (kg)", wxDATAVIEW_CELL_INERT,
                           wxCOL_WIDTH_AUTOSIZE, wxALIGN_RIGHT,
                           wxDATAVIEW_COL_RESIZABLE);
+  table->AppendTextColumn("Max Hoist Load (kg)", wxDATAVIEW_CELL_INERT,
+                          wxCOL_WIDTH_AUTOSIZE, wxALIGN_RIGHT,
+                          wxDATAVIEW_COL_RESIZABLE);
 
   ColumnUtils::EnforceMinColumnWidth(table);
 
   auto *sizer = new wxBoxSizer(wxVERTICAL);
   sizer->Add(table, 1, wxEXPAND | wxALL, 5);
   SetSizer(sizer);
+
+  sceneListener = GetDefaultGuiConfigServices()
+                      .LegacyConfigManager()
+                      .GetSceneJournal()
+                      .Subscribe([this](const SceneChangeSet &changes) {
+                        OnSceneChanged(changes);
+                      });
+}
+
+RiggingPanel::~RiggingPanel() {
+  GetDefaultGuiConfigServices().LegacyConfigManager().GetSceneJournal().Unsubscribe(
+      sceneListener);
 }
 
 RiggingPanel *RiggingPanel::Instance() { return s_instance; }
@@ -88,80 +125,158 @@ void AutoSizeColumns(wxDataViewListCtrl *table) {
 }
 } // namespace
 
+void RiggingPanel::AddContribution(size_t group, const std::string &uuid,
+                                   Contribution contribution) {
+  auto &entry = totals[contribution.position];
+  entry.counts[group]++;
+  entry.weights[group] += contribution.weightKg;
+  if (contribution.weightKg <= 0.0f)
+    entry.zeroWeights[group]++;
+  contributions[group][uuid] = std::move(contribution);
+}
+
+void RiggingPanel::RemoveContribution(size_t group, const std::string &uuid) {
+  auto it = contributions[group].find(uuid);
+  if (it == contributions[group].end())
+    return;
+  auto totalIt = totals.find(it->second.position);
+  if (totalIt != totals.end()) {
+    Totals &entry = totalIt->second;
+    entry.counts[group]--;
+    entry.weights[group] -= it->second.weightKg;
+    if (it->second.weightKg <= 0.0f)
+      entry.zeroWeights[group]--;
+    if (entry.counts[group] <= 0) {
+      entry.counts[group] = 0;
+      entry.weights[group] = 0.0;
+      entry.zeroWeights[group] = 0;
+    }
+    bool empty = true;
+    for (int count : entry.counts)
+      empty = empty && count == 0;
+    if (empty)
+      totals.erase(totalIt);
+  }
+  contributions[group].erase(it);
+}
+
 void RiggingPanel::RefreshData() {
   if (!table || !store)
     return;
 
-  struct Totals {
-    int fixtures = 0;
-    int trusses = 0;
-    int hoists = 0;
-    float fixtureWeight = 0.0f;
-    float trussWeight = 0.0f;
-    float hoistWeight = 0.0f;
-    bool hasZeroWeightFixture = false;
-    bool hasZeroWeightTruss = false;
-    bool hasZeroWeightHoist = false;
-  };
+  for (auto &group : contributions)
+    group.clear();
+  totals.clear();
 
-  std::map<std::string, Totals> rows;
-  const auto &scene = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene();
-  for (const auto &[uuid, fixture] : scene.fixtures) {
-    std::string pos = fixture.positionName.empty() ? UNASSIGNED_POSITION
-                                                   : fixture.positionName;
-    auto &entry = rows[pos];
-    entry.fixtures++;
-    entry.fixtureWeight += fixture.weightKg;
-    if (fixture.weightKg <= 0.0f)
-      entry.hasZeroWeightFixture = true;
-  }
+  const auto &scene = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene();
+  contributions[0].reserve(scene.fixtures.size());
+  for (const auto &[uuid, fixture] : scene.fixtures)
+    AddContribution(0, uuid, {PositionOf(fixture), fixture.weightKg});
+  contributions[1].reserve(scene.trusses.size());
+  for (const auto &[uuid, truss] : scene.trusses)
+    AddContribution(1, uuid, {PositionOf(truss), truss.weightKg});
+  contributions[2].reserve(scene.supports.size());
+  for (const auto &[uuid, support] : scene.supports)
+    AddContribution(2, uuid, {PositionOf(support), support.weightKg});
+  solver.Rebuild(scene);
+
+  ShowTotals();
+}
 
-  for (const auto &[uuid, truss] : scene.trusses) {
-    std::string pos = truss.positionName.empty() ? UNASSIGNED_POSITION
-                                                 : truss.positionName;
-    auto &entry = rows[pos];
-    entry.trusses++;
-    entry.trussWeight += truss.weightKg;
-    if (truss.weightKg <= 0.0f)
-      entry.hasZeroWeightTruss = true;
+void RiggingPanel::OnSceneChanged(const SceneChangeSet &changes) {
+  if (changes.reset) {
+    RefreshData();
+    return;
   }
 
-  for (const auto &[uuid, support] : scene.supports) {
-    std::string pos = support.positionName.empty() ? UNASSIGNED_POSITION
-                                                   : support.positionName;
-    auto &entry = rows[pos];
-    entry.hoists++;
-    entry.hoistWeight += support.weightKg;
-    if (support.weightKg <= 0.0f)
-      entry.hasZeroWeightHoist = true;
+  // Move only the changed items between positions.
+  const auto &scene = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene();
+  solver.Apply(changes, scene);
+  bool changed = false;
+  for (const auto &change : changes.changes) {
+    int group = GroupOf(change.kind);
+    if (group < 0)
+      continue;
+    changed = true;
+    RemoveContribution(group, change.uuid);
+    switch (change.kind) {
+    case SceneEntityKind::Fixture:
+      if (auto it = scene.fixtures.find(change.uuid); it != scene.fixtures.end())
+        AddContribution(group, change.uuid,
+                        {PositionOf(it->second), it->second.weightKg});
+      break;
+    case SceneEntityKind::Truss:
+      if (auto it = scene.trusses.find(change.uuid); it != scene.trusses.end())
+        AddContribution(group, change.uuid,
+                        {PositionOf(it->second), it->second.weightKg});
+      break;
+    case SceneEntityKind::Support:
+      if (auto it = scene.supports.find(change.uuid); it != scene.supports.end())
+        AddContribution(group, change.uuid,
+                        {PositionOf(it->second), it->second.weightKg});
+      break;
+    default:
+      break;
+    }
   }
+  if (changed)
+    ShowTotals();
+}
+
+void RiggingPanel::ShowTotals() {
+  if (!table || !store)
+    return;
 
   // Ensure both the view and the custom store start from a clean state so
   // text colours get recalculated on every refresh.
   store->DeleteAllItems();
   table->DeleteAllItems();
-  for (const auto &[position, totals] : rows) {
-    float totalWeight =
-        totals.fixtureWeight + totals.trussWeight + totals.hoistWeight;
+
+  struct HoistLoads {
+    double maxKg = 0.0;
+    bool overloaded = false;
+  };
+  std::unordered_map<std::string, HoistLoads> hoistLoads;
+  const auto &supports =
+      std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene().supports;
+  for (const auto &[uuid, contribution] : contributions[2]) {
+    const double load = solver.HoistLoadKg(uuid);
+    auto [it, inserted] = hoistLoads.try_emplace(contribution.position);
+    it->second.maxKg = inserted ? load : std::max(it->second.maxKg, load);
+    if (auto support = supports.find(uuid);
+        support != supports.end() && support->second.capacityKg > 0.0f &&
+        load > support->second.capacityKg)
+      it->second.overloaded = true;
+  }
+
+  for (const auto &[position, entry] : totals) {
+    const float fixtureWeight = static_cast<float>(entry.weights[0]);
+    const float trussWeight = static_cast<float>(entry.weights[1]);
+    const float hoistWeight = static_cast<float>(entry.weights[2]);
+    float totalWeight = fixtureWeight + trussWeight + hoistWeight;
     float roundedTotalWeight = CeilToNearestTens(totalWeight);
     float roundedFivePercentIncrease =
         CeilToNearestTens(roundedTotalWeight * 1.05f);
     wxVector<wxVariant> row;
     row.push_back(wxString::FromUTF8(position));
-    row.push_back(wxString::Format("%d", totals.fixtures));
-    row.push_back(wxString::Format("%d", totals.trusses));
-    row.push_back(wxString::Format("%d", totals.hoists));
-    row.push_back(wxString::Format("%.2f", totals.fixtureWeight));
-    row.push_back(wxString::Format("%.2f", totals.trussWeight));
-    row.push_back(wxString::Format("%.2f", totals.hoistWeight));
+    row.push_back(wxString::Format("%d", entry.counts[0]));
+    row.push_back(wxString::Format("%d", entry.counts[1]));
+    row.push_back(wxString::Format("%d", entry.counts[2]));
+    row.push_back(wxString::Format("%.2f", fixtureWeight));
+    row.push_back(wxString::Format("%.2f", trussWeight));
+    row.push_back(wxString::Format("%.2f", hoistWeight));
     row.push_back(wxString::Format("%.2f", totalWeight));
     row.push_back(wxString::Format("%.2f", roundedFivePercentIncrease));
+    auto hoistIt = hoistLoads.find(position);
+    row.push_back(hoistIt == hoistLoads.end()
+                      ? wxString()
+                      : wxString::Format("%.2f", hoistIt->second.maxKg));
     unsigned int rowIndex = table->GetItemCount();
     table->AppendItem(row);
 
-    const bool fixtureWeightZero = totals.hasZeroWeightFixture;
-    const bool trussWeightZero = totals.hasZeroWeightTruss;
-    const bool hoistWeightZero = totals.hasZeroWeightHoist;
+    const bool fixtureWeightZero = entry.zeroWeights[0] > 0;
+    const bool trussWeightZero = entry.zeroWeights[1] > 0;
+    const bool hoistWeightZero = entry.zeroWeights[2] > 0;
 
     if (fixtureWeightZero)
       store->SetCellTextColour(rowIndex, 4, *wxRED);
@@ -174,6 +289,8 @@ void RiggingPanel::RefreshData() {
       store->SetCellTextColour(rowIndex, 7, *wxRED);
       store->SetCellTextColour(rowIndex, 8, *wxRED);
     }
+    if (hoistIt != hoistLoads.end() && hoistIt->second.overloaded)
+      store->SetCellTextColour(rowIndex, 9, *wxRED);
   }
 
   AutoSizeColumns(table);
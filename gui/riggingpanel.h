@@ -20,12 +20,21 @@
 #include <wx/dataview.h>
 #include <wx/wx.h>
 
+#include <array>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "riggingsolver.h"
+#include "scenechangejournal.h"
+
 class ColorfulDataViewListStore;
 
 // Panel that summarizes rigging information grouped by position
 class RiggingPanel : public wxPanel {
 public:
   explicit RiggingPanel(wxWindow *parent);
+  ~RiggingPanel();
 
   void RefreshData();
 
@@ -33,6 +42,36 @@ public:
   static void SetInstance(RiggingPanel *panel);
 
 private:
+  // Fixtures, trusses and hoists, in that order.
+  static constexpr size_t kGroupCount = 3;
+
+  struct Contribution {
+    std::string position;
+    float weightKg = 0.0f;
+  };
+
+  // Weights are summed in double so that subtracting a removed item gives
+  // back the previous total.
+  struct Totals {
+    std::array<int, kGroupCount> counts{};
+    std::array<double, kGroupCount> weights{};
+    std::array<int, kGroupCount> zeroWeights{};
+  };
+
   wxDataViewListCtrl *table = nullptr;
   ColorfulDataViewListStore *store = nullptr;
+  SceneChangeJournal::ListenerId sceneListener = 0;
+
+  std::array<std::unordered_map<std::string, Contribution>, kGroupCount>
+      contributions;
+  std::map<std::string, Totals> totals;
+  // Hoist reactions from fixture and truss positions, for the hoist load
+  // column.
+  RiggingSolver solver;
+
+  void OnSceneChanged(const SceneChangeSet &changes);
+  void AddContribution(size_t group, const std::string &uuid,
+                       Contribution contribution);
+  void RemoveContribution(size_t group, const std::string &uuid);
+  void ShowTotals();
 };
@@ -28,6 +28,8 @@
 #include "viewer3dpanel.h"
 #include <algorithm>
 #include <cctype>
+#include <memory>
+#include <utility>
 #include <wx/notebook.h>
 #include <wx/choicdlg.h>
 #include <wx/wupdlock.h> // freeze/thaw UI during batch edits
@@ -94,6 +96,39 @@ RangeParts SplitRangeParts(const wxString& value)
             parts.push_back(part);
     return {parts, usedSeparator, trailingSeparator};
 }
+
+// Formats column `col` of the scene object table exactly as rows used to be
+// appended.
+wxVariant MakeSceneObjectCell(const SceneObject* obj, unsigned col)
+{
+    if (!obj)
+        return wxVariant(wxString());
+
+    switch (col) {
+    case 0:
+        return wxVariant(wxString::FromUTF8(obj->name));
+    case 1:
+        return wxVariant(obj->layer == DEFAULT_LAYER_NAME
+                             ? wxString()
+                             : wxString::FromUTF8(obj->layer));
+    case 2:
+        return wxVariant(wxString::FromUTF8(obj->modelFile));
+    case 3:
+    case 4:
+    case 5:
+        return wxVariant(
+            wxString::Format("%.3f", obj->transform.o[col - 3] / 1000.0f));
+    case 6:
+    case 7:
+    case 8: {
+        // Roll, pitch and yaw map to Euler components 2, 1 and 0.
+        auto euler = MatrixUtils::MatrixToEuler(obj->transform);
+        return wxVariant(wxString::Format("%.1f\u00B0", euler[8 - col]));
+    }
+    default:
+        return wxVariant(wxString());
+    }
+}
 } // namespace
 
 SceneObjectTablePanel::SceneObjectTablePanel(wxWindow* parent, IGuiConfigServices* services)
@@ -125,6 +160,9 @@ SceneObjectTablePanel::SceneObjectTablePanel(wxWindow* parent, IGuiConfigService
 
     InitializeTable();
     ReloadData();
+    sceneListener =
+        guiConfigServices->LegacyConfigManager().GetSceneJournal().Subscribe(
+            [this](const SceneChangeSet& changes) { OnSceneChanged(changes); });
 
     sizer->Add(table, 1, wxEXPAND | wxALL, 5);
     SetSizer(sizer);
@@ -132,6 +170,8 @@ SceneObjectTablePanel::SceneObjectTablePanel(wxWindow* parent, IGuiConfigService
 
 SceneObjectTablePanel::~SceneObjectTablePanel()
 {
+    guiConfigServices->LegacyConfigManager().GetSceneJournal().Unsubscribe(
+        sceneListener);
     store = nullptr;
 }
 
@@ -152,56 +192,105 @@ void SceneObjectTablePanel::InitializeTable()
     ColumnUtils::EnforceMinColumnWidth(table);
 }
 
+void SceneObjectTablePanel::RebuildRowIndex()
+{
+    rowIndex.clear();
+    rowIndex.reserve(rowUuids.size());
+    for (size_t i = 0; i < rowUuids.size(); ++i)
+        rowIndex.emplace(rowUuids[i], static_cast<int>(i));
+}
+
+int SceneObjectTablePanel::FindRow(const std::string& uuid) const
+{
+    auto it = rowIndex.find(uuid);
+    return it != rowIndex.end() ? it->second : -1;
+}
+
+void SceneObjectTablePanel::OnSceneChanged(const SceneChangeSet& changes)
+{
+    // Loading, undo and redo replace the whole scene and reload the table
+    // explicitly.
+    if (changes.reset || !changes.Touches(SceneEntityKind::SceneObject))
+        return;
+
+    const auto& objs =
+        std::as_const(guiConfigServices->LegacyConfigManager()).GetScene().sceneObjects;
+    std::vector<int> removedRows;
+    for (const auto& change : changes.changes)
+    {
+        if (change.kind != SceneEntityKind::SceneObject)
+            continue;
+        int row = FindRow(change.uuid);
+        if (objs.find(change.uuid) == objs.end()) {
+            if (row >= 0)
+                removedRows.push_back(row);
+            continue;
+        }
+        if (row < 0) {
+            // New objects need a place in the initial sort order.
+            std::vector<std::string> selection = GetSelectedUuids();
+            ReloadData();
+            SelectByUuid(selection);
+            return;
+        }
+        store->RefreshRow(static_cast<unsigned>(row), true);
+    }
+
+    if (removedRows.empty())
+        return;
+    std::vector<std::string> oldOrder = rowUuids;
+    std::vector<std::string> selection = GetSelectedUuids();
+    std::sort(removedRows.begin(), removedRows.end(), std::greater<int>());
+    for (int r : removedRows)
+        table->DeleteItem(r);
+    ResyncRows(oldOrder, selection);
+}
+
 void SceneObjectTablePanel::ReloadData()
 {
-    table->DeleteAllItems();
     rowUuids.clear();
-    const auto& objs = guiConfigServices->LegacyConfigManager().GetScene().sceneObjects;
+    const auto& objs = std::as_const(guiConfigServices->LegacyConfigManager()).GetScene().sceneObjects;
 
-    // Copy objects into a sortable vector
-    std::vector<std::pair<std::string, SceneObject>> sortedObjs(objs.begin(), objs.end());
+    // Sort pointers into the scene rather than copies of every object
+    std::vector<std::pair<const std::string*, const SceneObject*>> sortedObjs;
+    sortedObjs.reserve(objs.size());
+    for (const auto& [uuid, obj] : objs)
+        sortedObjs.emplace_back(&uuid, &obj);
 
     // Sort by layer and then by name using natural sort for numeric suffixes
     std::sort(sortedObjs.begin(), sortedObjs.end(),
         [](const auto &a, const auto &b) {
-            if (a.second.layer == b.second.layer)
-                return StringUtils::NaturalLess(a.second.name, b.second.name);
-            return StringUtils::NaturalLess(a.second.layer, b.second.layer);
+            if (a.second->layer == b.second->layer)
+                return StringUtils::NaturalLess(a.second->name, b.second->name);
+            return StringUtils::NaturalLess(a.second->layer, b.second->layer);
         });
 
-    for (const auto& [uuid, obj] : sortedObjs)
+    std::vector<wxUIntPtr> itemData;
+    itemData.reserve(sortedObjs.size());
+    rowUuids.reserve(sortedObjs.size());
+    for (const auto& pair : sortedObjs)
     {
-        wxVector<wxVariant> row;
-
-        wxString name = wxString::FromUTF8(obj.name);
-        wxString layer = obj.layer == DEFAULT_LAYER_NAME ? wxString()
-                                                          : wxString::FromUTF8(obj.layer);
-        wxString model = wxString::FromUTF8(obj.modelFile);
-
-        auto posArr = obj.transform.o;
-        wxString posX = wxString::Format("%.3f", posArr[0] / 1000.0f);
-        wxString posY = wxString::Format("%.3f", posArr[1] / 1000.0f);
-        wxString posZ = wxString::Format("%.3f", posArr[2] / 1000.0f);
-
-        auto euler = MatrixUtils::MatrixToEuler(obj.transform);
-        wxString roll = wxString::Format("%.1f\u00B0", euler[2]);
-        wxString pitch = wxString::Format("%.1f\u00B0", euler[1]);
-        wxString yaw = wxString::Format("%.1f\u00B0", euler[0]);
-
-        row.push_back(name);
-        row.push_back(layer);
-        row.push_back(model);
-        row.push_back(posX);
-        row.push_back(posY);
-        row.push_back(posZ);
-        row.push_back(roll);
-        row.push_back(pitch);
-        row.push_back(yaw);
-
-        store->AppendItem(row, rowUuids.size());
-        rowUuids.push_back(uuid);
+        itemData.push_back(rowUuids.size());
+        rowUuids.push_back(*pair.first);
     }
 
+    // Cells are formatted from the scene when a row is first shown.
+    auto sources = std::make_shared<const std::vector<std::string>>(rowUuids);
+    IGuiConfigServices* services = guiConfigServices;
+    store->ResetRows(itemData, [services, sources](size_t source, unsigned col,
+                                                   wxVariant& value) {
+        const auto& current =
+            std::as_const(services->LegacyConfigManager()).GetScene().sceneObjects;
+        const SceneObject* obj = nullptr;
+        if (source < sources->size()) {
+            auto it = current.find((*sources)[source]);
+            if (it != current.end())
+                obj = &it->second;
+        }
+        value = MakeSceneObjectCell(obj, col);
+    });
+    RebuildRowIndex();
+
     // Let wxDataViewListCtrl manage column headers and sorting
     if (LayerPanel::Instance())
         LayerPanel::Instance()->ReloadLayers();
@@ -502,7 +591,7 @@ void SceneObjectTablePanel::UpdatePositionValues(
         return;
 
     ConfigManager& cfg = guiConfigServices->LegacyConfigManager();
-    auto& scene = cfg.GetScene();
+    const auto& scene = std::as_const(cfg).GetScene();
     wxWindowUpdateLocker locker(table);
 
     for (const auto& uuid : uuids) {
@@ -510,16 +599,20 @@ void SceneObjectTablePanel::UpdatePositionValues(
         if (it == scene.sceneObjects.end())
             continue;
 
+        int row = FindRow(uuid);
+        if (row < 0)
+            continue;
+        // Untouched rows simply re-read their cells from the scene.
+        if (!store->IsRowEdited(row)) {
+            store->RefreshRow(row);
+            continue;
+        }
+
         auto posArr = it->second.transform.o;
         wxString posX = wxString::Format("%.3f", posArr[0] / 1000.0f);
         wxString posY = wxString::Format("%.3f", posArr[1] / 1000.0f);
         wxString posZ = wxString::Format("%.3f", posArr[2] / 1000.0f);
 
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), uuid);
-        if (pos == rowUuids.end())
-            continue;
-
-        int row = static_cast<int>(pos - rowUuids.begin());
         table->SetValue(wxVariant(posX), row, 3);
         table->SetValue(wxVariant(posY), row, 4);
         table->SetValue(wxVariant(posZ), row, 5);
@@ -533,11 +626,10 @@ void SceneObjectTablePanel::ApplyPositionValueUpdates(
 
     wxWindowUpdateLocker locker(table);
     for (const auto& update : updates) {
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), update.uuid);
-        if (pos == rowUuids.end())
+        int row = FindRow(update.uuid);
+        if (row < 0)
             continue;
 
-        int row = static_cast<int>(pos - rowUuids.begin());
         table->SetValue(wxVariant(wxString::FromUTF8(update.posX)), row, 3);
         table->SetValue(wxVariant(wxString::FromUTF8(update.posY)), row, 4);
         table->SetValue(wxVariant(wxString::FromUTF8(update.posZ)), row, 5);
@@ -550,11 +642,16 @@ void SceneObjectTablePanel::UpdateSceneData()
     cfg.PushUndoState("edit scene object");
     auto& scene = cfg.GetScene();
     size_t count = std::min((size_t)table->GetItemCount(), rowUuids.size());
+    std::vector<std::string> updatedUuids;
     for (size_t i = 0; i < count; ++i)
     {
+        // Rows nobody edited still mirror the scene.
+        if (!store->IsRowEdited(i))
+            continue;
         auto it = scene.sceneObjects.find(rowUuids[i]);
         if (it == scene.sceneObjects.end())
             continue;
+        updatedUuids.push_back(rowUuids[i]);
 
         wxVariant v;
         table->GetValue(v, i, 1);
@@ -606,8 +703,9 @@ void SceneObjectTablePanel::UpdateSceneData()
         }
     }
 
-    if (SummaryPanel::Instance() && IsActivePage())
-        SummaryPanel::Instance()->ShowSceneObjectSummary();
+    // Refreshes the written rows and the summary.
+    cfg.NotifySceneChanged(SceneEntityKind::SceneObject, updatedUuids,
+                           SceneComponent::All);
 }
 
 SceneObjectTablePanel* SceneObjectTablePanel::Instance()
@@ -662,9 +760,8 @@ void SceneObjectTablePanel::SelectByUuid(const std::vector<std::string>& uuids)
     table->UnselectAll();
     std::vector<bool> selectedRows(table->GetItemCount(), false);
     for (const auto& u : uuids) {
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), u);
-        if (pos != rowUuids.end()) {
-            int row = static_cast<int>(pos - rowUuids.begin());
+        int row = FindRow(u);
+        if (row >= 0) {
             table->SelectRow(row);
             if (row >= 0 && static_cast<size_t>(row) < selectedRows.size())
                 selectedRows[row] = true;
@@ -693,11 +790,15 @@ void SceneObjectTablePanel::DeleteSelected()
     }
     std::sort(rows.begin(), rows.end(), std::greater<int>());
 
+    // Rows keep their old index as item data, so ResyncRows() rebuilds the
+    // uuid list from the order before the deletion.
+    std::vector<std::string> oldOrder = rowUuids;
+    std::vector<std::string> removed;
     auto& scene = guiConfigServices->LegacyConfigManager().GetScene();
     for (int r : rows) {
         if ((size_t)r < rowUuids.size()) {
             scene.sceneObjects.erase(rowUuids[r]);
-            rowUuids.erase(rowUuids.begin() + r);
+            removed.push_back(rowUuids[r]);
             table->DeleteItem(r);
         }
     }
@@ -712,11 +813,9 @@ void SceneObjectTablePanel::DeleteSelected()
         Viewer2DPanel::Instance()->UpdateScene();
     }
 
-    if (SummaryPanel::Instance())
-        SummaryPanel::Instance()->ShowSceneObjectSummary();
-
-    std::vector<std::string> order = rowUuids;
-    ResyncRows(order, {});
+    ResyncRows(oldOrder, {});
+    cfg.NotifySceneChanged(SceneEntityKind::SceneObject, removed,
+                           SceneComponent::Removed);
 }
 
 void SceneObjectTablePanel::ResyncRows(const std::vector<std::string>& oldOrder,
@@ -733,13 +832,14 @@ void SceneObjectTablePanel::ResyncRows(const std::vector<std::string>& oldOrder,
         store->SetItemData(it, i);
     }
     rowUuids.swap(newOrder);
+    RebuildRowIndex();
 
     table->UnselectAll();
     for (const auto& uuid : selectedUuids)
     {
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), uuid);
-        if (pos != rowUuids.end())
-            table->SelectRow(static_cast<int>(pos - rowUuids.begin()));
+        int row = FindRow(uuid);
+        if (row >= 0)
+            table->SelectRow(row);
     }
     UpdateSelectionHighlight();
 }
@@ -16,19 +16,32 @@
  * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
  */
 #include "selectfixturetypedialog.h"
+#include "gdtfthumbnails.h"
+#include "workerpool.h"
+#include <algorithm>
 
-SelectFixtureTypeDialog::SelectFixtureTypeDialog(wxWindow* parent, const std::vector<std::string>& types)
+SelectFixtureTypeDialog::SelectFixtureTypeDialog(wxWindow* parent, const std::vector<std::string>& types,
+                                                 const std::vector<std::string>& gdtfPaths)
     : wxDialog(parent, wxID_ANY, "Select Fixture Type", wxDefaultPosition, wxDefaultSize)
 {
     wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
     sizer->Add(new wxStaticText(this, wxID_ANY, "Choose a fixture type:"), 0, wxALL, 5);
 
-    wxArrayString items;
-    for (const auto& t : types)
-        items.push_back(wxString::FromUTF8(t));
-    listCtrl = new wxListBox(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, items);
-    if (listCtrl->GetCount() > 0)
-        listCtrl->SetSelection(0);
+    listCtrl = new wxListView(this, wxID_ANY, wxDefaultPosition, wxSize(-1, 300),
+                              wxLC_REPORT | wxLC_NO_HEADER | wxLC_SINGLE_SEL);
+    images = new wxImageList(kGdtfThumbnailSize, kGdtfThumbnailSize, true);
+    // Placeholder shown until a thumbnail is ready.
+    wxImage blank(kGdtfThumbnailSize, kGdtfThumbnailSize, true);
+    blank.InitAlpha();
+    std::fill_n(blank.GetAlpha(), kGdtfThumbnailSize * kGdtfThumbnailSize, 0);
+    images->Add(wxBitmap(blank));
+    listCtrl->AssignImageList(images, wxIMAGE_LIST_SMALL);
+    listCtrl->AppendColumn("");
+    for (size_t i = 0; i < types.size(); ++i)
+        listCtrl->InsertItem(static_cast<long>(i), wxString::FromUTF8(types[i]), 0);
+    listCtrl->SetColumnWidth(0, 340);
+    if (listCtrl->GetItemCount() > 0)
+        listCtrl->Select(0);
     sizer->Add(listCtrl, 1, wxALL | wxEXPAND, 5);
 
     wxBoxSizer* btnSizer = new wxBoxSizer(wxHORIZONTAL);
@@ -42,11 +55,48 @@ SelectFixtureTypeDialog::SelectFixtureTypeDialog(wxWindow* parent, const std::ve
 
     SetSizerAndFit(sizer);
     SetSize(wxSize(400, GetSize().GetHeight()));
+
+    RequestThumbnails(gdtfPaths);
+}
+
+SelectFixtureTypeDialog::~SelectFixtureTypeDialog()
+{
+    *alive = false;
+}
+
+// Thumbnails come from the persistent cache, or are rendered on the worker
+// pool the first time a type is seen, so the list opens without waiting for
+// any GDTF to load.
+void SelectFixtureTypeDialog::RequestThumbnails(const std::vector<std::string>& gdtfPaths)
+{
+    SharedGdtfThumbnailCache();
+    for (size_t i = 0; i < gdtfPaths.size() && i < static_cast<size_t>(listCtrl->GetItemCount()); ++i) {
+        if (gdtfPaths[i].empty())
+            continue;
+        auto flag = alive;
+        SelectFixtureTypeDialog* dialog = this;
+        const long item = static_cast<long>(i);
+        WorkerPool::Shared().Submit([dialog, flag, item, path = gdtfPaths[i]]() {
+            if (!*flag)
+                return;
+            auto thumbnail = std::make_shared<GdtfThumbnail>(LoadGdtfThumbnail(path));
+            if (!thumbnail->IsValid() || !*flag || !wxTheApp)
+                return;
+            // The flag is cleared on the UI thread before the dialog goes
+            // away, so it is alive whenever the check below passes.
+            wxTheApp->CallAfter([dialog, flag, item, thumbnail]() {
+                if (!*flag)
+                    return;
+                int image = dialog->images->Add(GdtfThumbnailToBitmap(*thumbnail));
+                dialog->listCtrl->SetItemImage(item, image);
+            });
+        });
+    }
 }
 
 int SelectFixtureTypeDialog::GetSelection() const
 {
-    return listCtrl->GetSelection();
+    return static_cast<int>(listCtrl->GetFirstSelected());
 }
 
 void SelectFixtureTypeDialog::OnOpen(wxCommandEvent&)
@@ -17,14 +17,28 @@
  */
 #pragma once
 #include <wx/wx.h>
+#include <wx/imaglist.h>
+#include <wx/listctrl.h>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <string>
 
 class SelectFixtureTypeDialog : public wxDialog {
 public:
-    SelectFixtureTypeDialog(wxWindow* parent, const std::vector<std::string>& types);
+    // `gdtfPaths` holds the GDTF file of each type, in the same order; its
+    // thumbnail is shown next to the name once available.
+    SelectFixtureTypeDialog(wxWindow* parent, const std::vector<std::string>& types,
+                            const std::vector<std::string>& gdtfPaths);
+    ~SelectFixtureTypeDialog() override;
     int GetSelection() const;
 private:
     void OnOpen(wxCommandEvent& evt);
-    wxListBox* listCtrl = nullptr;
+    void RequestThumbnails(const std::vector<std::string>& gdtfPaths);
+    wxListView* listCtrl = nullptr;
+    wxImageList* images = nullptr; // owned by listCtrl
+    // Cleared on destruction so pending thumbnail work is skipped and its
+    // results dropped.
+    std::shared_ptr<std::atomic<bool>> alive =
+        std::make_shared<std::atomic<bool>>(true);
 };
@@ -20,9 +20,30 @@
 #include "configmanager.h"
 #include "guiconfigservices.h"
 #include <map>
+#include <utility>
 
 static SummaryPanel* s_instance = nullptr;
 
+namespace {
+// Summary row an entity is counted under.
+std::string SummaryKey(const Fixture& fixture) { return fixture.typeName; }
+std::string SummaryKey(const Truss& truss) { return truss.model; }
+std::string SummaryKey(const Support& support)
+{
+    return support.function.empty() ? "Hoist" : support.function;
+}
+std::string SummaryKey(const SceneObject& obj) { return obj.name; }
+
+template <typename Map>
+std::optional<std::string> FindSummaryKey(const Map& entities, const std::string& uuid)
+{
+    auto it = entities.find(uuid);
+    if (it == entities.end())
+        return std::nullopt;
+    return SummaryKey(it->second);
+}
+} // namespace
+
 SummaryPanel::SummaryPanel(wxWindow* parent)
     : wxPanel(parent, wxID_ANY)
 {
@@ -33,6 +54,14 @@ SummaryPanel::SummaryPanel(wxWindow* parent)
     wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
     sizer->Add(table, 1, wxEXPAND | wxALL, 5);
     SetSizer(sizer);
+
+    sceneListener = GetDefaultGuiConfigServices().LegacyConfigManager().GetSceneJournal().Subscribe(
+        [this](const SceneChangeSet& changes) { OnSceneChanged(changes); });
+}
+
+SummaryPanel::~SummaryPanel()
+{
+    GetDefaultGuiConfigServices().LegacyConfigManager().GetSceneJournal().Unsubscribe(sceneListener);
 }
 
 SummaryPanel* SummaryPanel::Instance()
@@ -58,52 +87,89 @@ void SummaryPanel::ShowSummary(const std::vector<std::pair<std::string,int>>& it
     }
 }
 
-void SummaryPanel::ShowFixtureSummary()
+void SummaryPanel::ShowCounts()
+{
+    std::vector<std::pair<std::string, int>> items(counts.begin(), counts.end());
+    ShowSummary(items);
+}
+
+void SummaryPanel::ShowKindSummary(SceneEntityKind kind)
 {
     if (!table) return;
 
-    table->DeleteAllItems();
+    activeKind = kind;
+    keyByUuid.clear();
+    counts.clear();
+    const MvrScene& scene = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene();
+    auto tally = [this](const auto& entities) {
+        keyByUuid.reserve(entities.size());
+        for (const auto& [uuid, entity] : entities) {
+            std::string key = SummaryKey(entity);
+            counts[key]++;
+            keyByUuid.emplace(uuid, std::move(key));
+        }
+    };
+    switch (kind) {
+    case SceneEntityKind::Fixture: tally(scene.fixtures); break;
+    case SceneEntityKind::Truss: tally(scene.trusses); break;
+    case SceneEntityKind::Support: tally(scene.supports); break;
+    case SceneEntityKind::SceneObject: tally(scene.sceneObjects); break;
+    }
+    ShowCounts();
+}
 
-    std::map<std::string, int> fixtureCounts;
-    const auto& fixtures = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().fixtures;
-    for (const auto& [uuid, fix] : fixtures)
-        fixtureCounts[fix.typeName]++;
-    std::vector<std::pair<std::string, int>> fixtureItems(fixtureCounts.begin(), fixtureCounts.end());
+void SummaryPanel::OnSceneChanged(const SceneChangeSet& changes)
+{
+    if (!activeKind || !changes.Touches(*activeKind))
+        return;
+    if (changes.reset) {
+        ShowKindSummary(*activeKind);
+        return;
+    }
 
-    ShowSummary(fixtureItems);
+    // Move only the changed entities between tallies.
+    const MvrScene& scene = std::as_const(GetDefaultGuiConfigServices().LegacyConfigManager()).GetScene();
+    for (const auto& change : changes.changes) {
+        if (change.kind != *activeKind)
+            continue;
+        auto known = keyByUuid.find(change.uuid);
+        if (known != keyByUuid.end()) {
+            auto count = counts.find(known->second);
+            if (count != counts.end() && --count->second <= 0)
+                counts.erase(count);
+            keyByUuid.erase(known);
+        }
+        std::optional<std::string> key;
+        switch (change.kind) {
+        case SceneEntityKind::Fixture: key = FindSummaryKey(scene.fixtures, change.uuid); break;
+        case SceneEntityKind::Truss: key = FindSummaryKey(scene.trusses, change.uuid); break;
+        case SceneEntityKind::Support: key = FindSummaryKey(scene.supports, change.uuid); break;
+        case SceneEntityKind::SceneObject: key = FindSummaryKey(scene.sceneObjects, change.uuid); break;
+        }
+        if (key) {
+            counts[*key]++;
+            keyByUuid.emplace(change.uuid, std::move(*key));
+        }
+    }
+    ShowCounts();
+}
+
+void SummaryPanel::ShowFixtureSummary()
+{
+    ShowKindSummary(SceneEntityKind::Fixture);
 }
 
 void SummaryPanel::ShowTrussSummary()
 {
-    std::map<std::string,int> counts;
-    const auto& trusses = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().trusses;
-    for (const auto& [uuid, truss] : trusses)
-        counts[truss.model]++;
-    std::vector<std::pair<std::string,int>> items(counts.begin(), counts.end());
-    ShowSummary(items);
+    ShowKindSummary(SceneEntityKind::Truss);
 }
 
 void SummaryPanel::ShowHoistSummary()
 {
-    if (!table) return;
-
-    std::map<std::string, int> hoistCounts;
-    const auto& supports = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().supports;
-    for (const auto& [uuid, support] : supports) {
-        std::string type = support.function.empty() ? "Hoist" : support.function;
-        hoistCounts[type]++;
-    }
-    std::vector<std::pair<std::string, int>> hoistItems(hoistCounts.begin(), hoistCounts.end());
-
-    ShowSummary(hoistItems);
+    ShowKindSummary(SceneEntityKind::Support);
 }
 
 void SummaryPanel::ShowSceneObjectSummary()
 {
-    std::map<std::string,int> counts;
-    const auto& objs = GetDefaultGuiConfigServices().LegacyConfigManager().GetScene().sceneObjects;
-    for (const auto& [uuid, obj] : objs)
-        counts[obj.name]++;
-    std::vector<std::pair<std::string,int>> items(counts.begin(), counts.end());
-    ShowSummary(items);
+    ShowKindSummary(SceneEntityKind::SceneObject);
 }
@@ -19,11 +19,17 @@
 
 #include <wx/wx.h>
 #include <wx/dataview.h>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "scenechangejournal.h"
 
 // Panel that shows a summary count of items by type/model/name
 class SummaryPanel : public wxPanel {
 public:
     explicit SummaryPanel(wxWindow* parent);
+    ~SummaryPanel();
 
     void ShowFixtureSummary();
     void ShowTrussSummary();
@@ -35,5 +41,16 @@ public:
 
 private:
     wxDataViewListCtrl* table = nullptr;
+    SceneChangeJournal::ListenerId sceneListener = 0;
+
+    // Tallies of the kind currently shown, kept up to date from scene
+    // change notifications.
+    std::optional<SceneEntityKind> activeKind;
+    std::unordered_map<std::string, std::string> keyByUuid;
+    std::map<std::string, int> counts;
+
+    void ShowKindSummary(SceneEntityKind kind);
+    void OnSceneChanged(const SceneChangeSet& changes);
+    void ShowCounts();
     void ShowSummary(const std::vector<std::pair<std::string,int>>& items);
 };
@@ -18,6 +18,7 @@
 #include "tableprinter.h"
 #include "columnselectiondialog.h"
 #include "configmanager.h"
+#include "scenetableformat.h"
 #include <wx/dataview.h>
 #include <wx/html/htmprint.h>
 #include <wx/filedlg.h>
@@ -173,34 +174,21 @@ void ExportCSV(wxWindow* parent, wxDataViewListCtrl* table, TableType type,
         return;
     }
 
-    auto EscapeCSV = [](const wxString& text)
-    {
-        wxString s(text);
-        s.Replace("\"", "\"\"");
-        if (s.Contains(",") || s.Contains("\"") || s.Contains("\n") || s.Contains("\r"))
-            s = "\"" + s + "\"";
-        return std::string(s.ToUTF8());
-    };
-
-    for (size_t i = 0; i < selCols.size(); ++i)
-    {
-        if (i)
-            file << ",";
-        file << EscapeCSV(table->GetColumn(selCols[i])->GetTitle());
-    }
-    file << "\n";
+    std::vector<std::string> cells;
+    for (int c : selCols)
+        cells.push_back(std::string(table->GetColumn(c)->GetTitle().ToUTF8()));
+    SceneTableFormat::WriteCsvRow(file, cells);
 
     for (unsigned int r = 0; r < table->GetItemCount(); ++r)
     {
-        for (size_t i = 0; i < selCols.size(); ++i)
+        cells.clear();
+        for (int c : selCols)
         {
-            if (i)
-                file << ",";
             wxVariant val;
-            table->GetValue(val, r, selCols[i]);
-            file << EscapeCSV(val.GetString());
+            table->GetValue(val, r, c);
+            cells.push_back(std::string(val.GetString().ToUTF8()));
         }
-        file << "\n";
+        SceneTableFormat::WriteCsvRow(file, cells);
     }
 
     file.close();
@@ -24,7 +24,7 @@
 #include "layerpanel.h"
 #include "matrixutils.h"
 #include "projectutils.h"
-#include "riggingpanel.h"
+#include "scenetableformat.h"
 #include "stringutils.h"
 #include "summarypanel.h"
 #include "trussdictionary.h"
@@ -33,9 +33,11 @@
 #include "viewer3dpanel.h"
 #include <cctype>
 #include <filesystem>
+#include <utility>
 #include <wx/filedlg.h>
 #include <wx/filename.h>
 #include <algorithm>
+#include <memory>
 #include <unordered_map>
 #include <wx/notebook.h>
 #include <wx/choicdlg.h>
@@ -104,6 +106,80 @@ RangeParts SplitRangeParts(const wxString& value)
             parts.push_back(part);
     return {parts, usedSeparator, trailingSeparator};
 }
+
+std::string ResolveScenePath(const std::string& base, const std::string& file)
+{
+    if (file.empty())
+        return {};
+    fs::path p = base.empty() ? fs::path(file) : fs::path(base) / file;
+    return p.string();
+}
+
+// The table shows the .gtruss archive when there is one and the geometry
+// file otherwise.
+std::string ResolveTrussDisplayPath(const std::string& base, const Truss& truss)
+{
+    return ResolveScenePath(base, !truss.modelFile.empty() ? truss.modelFile
+                                                           : truss.symbolFile);
+}
+
+wxString FormatOptionalMetres(float mm)
+{
+    return wxString::FromUTF8(SceneTableFormat::OptionalMetres(mm));
+}
+
+// Formats column `col` of the truss table exactly as rows used to be appended.
+wxVariant MakeTrussCell(const Truss* truss, unsigned col,
+                        const std::string& basePath)
+{
+    if (!truss)
+        return wxVariant(wxString());
+
+    switch (col) {
+    case 0:
+        return wxVariant(wxString::FromUTF8(truss->name));
+    case 1:
+        return wxVariant(truss->layer == DEFAULT_LAYER_NAME
+                             ? wxString()
+                             : wxString::FromUTF8(truss->layer));
+    case 2:
+        return wxVariant(
+            wxFileName(wxString::FromUTF8(
+                           ResolveTrussDisplayPath(basePath, *truss)))
+                .GetFullName());
+    case 3:
+        return wxVariant(wxString::FromUTF8(truss->positionName));
+    case 4:
+    case 5:
+    case 6:
+        return wxVariant(wxString::FromUTF8(
+            SceneTableFormat::Position(truss->transform.o[col - 4])));
+    case 7:
+    case 8:
+    case 9: {
+        // Roll, pitch and yaw map to Euler components 2, 1 and 0.
+        auto euler = MatrixUtils::MatrixToEuler(truss->transform);
+        return wxVariant(
+            wxString::FromUTF8(SceneTableFormat::Angle(euler[9 - col])));
+    }
+    case 10:
+        return wxVariant(wxString::FromUTF8(truss->manufacturer));
+    case 11:
+        return wxVariant(wxString::FromUTF8(truss->model));
+    case 12:
+        return wxVariant(
+            wxString::FromUTF8(SceneTableFormat::Metres(truss->lengthMm)));
+    case 13:
+        return wxVariant(FormatOptionalMetres(truss->widthMm));
+    case 14:
+        return wxVariant(FormatOptionalMetres(truss->heightMm));
+    case 15:
+        return wxVariant(
+            wxString::FromUTF8(SceneTableFormat::Decimal(truss->weightKg, 2)));
+    default:
+        return wxVariant(wxString());
+    }
+}
 } // namespace
 
 TrussTablePanel::TrussTablePanel(wxWindow* parent, IGuiConfigServices* services)
@@ -135,6 +211,9 @@ TrussTablePanel::TrussTablePanel(wxWindow* parent, IGuiConfigServices* services)
 
     InitializeTable();
     ReloadData();
+    sceneListener =
+        guiConfigServices->LegacyConfigManager().GetSceneJournal().Subscribe(
+            [this](const SceneChangeSet& changes) { OnSceneChanged(changes); });
 
     sizer->Add(table, 1, wxEXPAND | wxALL, 5);
     SetSizer(sizer);
@@ -142,16 +221,16 @@ TrussTablePanel::TrussTablePanel(wxWindow* parent, IGuiConfigServices* services)
 
 TrussTablePanel::~TrussTablePanel()
 {
+    guiConfigServices->LegacyConfigManager().GetSceneJournal().Unsubscribe(
+        sceneListener);
     store = nullptr;
 }
 
 void TrussTablePanel::InitializeTable()
 {
-    columnLabels = {"Name", "Layer", "Model File", "Hang Pos",
-                    "Pos X", "Pos Y", "Pos Z",
-                    "Roll (X)", "Pitch (Y)", "Yaw (Z)",
-                    "Manufacturer", "Model",
-                    "Length (m)", "Width (m)", "Height (m)", "Weight (kg)"};
+    columnLabels.clear();
+    for (const auto& column : SceneTableFormat::TrussColumns())
+        columnLabels.push_back(wxString::FromUTF8(column));
     std::vector<int> widths = {150, 100, 180, 120,
                                80, 80, 80,
                                80, 80, 80,
@@ -166,18 +245,79 @@ void TrussTablePanel::InitializeTable()
     ColumnUtils::EnforceMinColumnWidth(table);
 }
 
+void TrussTablePanel::RebuildRowIndex()
+{
+    rowIndex.clear();
+    rowIndex.reserve(rowUuids.size());
+    for (size_t i = 0; i < rowUuids.size(); ++i)
+        rowIndex.emplace(rowUuids[i], static_cast<int>(i));
+}
+
+int TrussTablePanel::FindRow(const std::string& uuid) const
+{
+    auto it = rowIndex.find(uuid);
+    return it != rowIndex.end() ? it->second : -1;
+}
+
+void TrussTablePanel::OnSceneChanged(const SceneChangeSet& changes)
+{
+    // Loading, undo and redo replace the whole scene and reload the table
+    // explicitly.
+    if (changes.reset || !changes.Touches(SceneEntityKind::Truss))
+        return;
+
+    const MvrScene& scene = std::as_const(guiConfigServices->LegacyConfigManager()).GetScene();
+    std::vector<int> removedRows;
+    for (const auto& change : changes.changes)
+    {
+        if (change.kind != SceneEntityKind::Truss)
+            continue;
+        int row = FindRow(change.uuid);
+        auto it = scene.trusses.find(change.uuid);
+        if (it == scene.trusses.end()) {
+            if (row >= 0)
+                removedRows.push_back(row);
+            continue;
+        }
+        if (row < 0) {
+            // New trusses need a place in the initial sort order.
+            std::vector<std::string> selection = GetSelectedUuids();
+            ReloadData();
+            SelectByUuid(selection);
+            return;
+        }
+        if (static_cast<size_t>(row) < modelPaths.size())
+            modelPaths[row] = wxString::FromUTF8(
+                ResolveTrussDisplayPath(scene.basePath, it->second));
+        if (static_cast<size_t>(row) < symbolPaths.size())
+            symbolPaths[row] = wxString::FromUTF8(
+                ResolveScenePath(scene.basePath, it->second.symbolFile));
+        store->RefreshRow(static_cast<unsigned>(row), true);
+    }
+
+    if (removedRows.empty())
+        return;
+    std::vector<std::string> oldOrder = rowUuids;
+    std::vector<std::string> selection = GetSelectedUuids();
+    std::sort(removedRows.begin(), removedRows.end(), std::greater<int>());
+    // ResyncRows() maps the surviving rows back through their item data,
+    // which still indexes the old order and paths.
+    for (int r : removedRows)
+        table->DeleteItem(r);
+    ResyncRows(oldOrder, selection);
+}
+
 void TrussTablePanel::ReloadData()
 {
-    table->DeleteAllItems();
     rowUuids.clear();
     modelPaths.clear();
     symbolPaths.clear();
-    const auto& trusses = guiConfigServices->LegacyConfigManager().GetScene().trusses;
+    const MvrScene& scene = std::as_const(guiConfigServices->LegacyConfigManager()).GetScene();
 
-    std::vector<std::pair<std::string, const Truss*>> sorted;
-    sorted.reserve(trusses.size());
-    for (const auto& [uuid, truss] : trusses)
-        sorted.emplace_back(uuid, &truss);
+    std::vector<std::pair<const std::string*, const Truss*>> sorted;
+    sorted.reserve(scene.trusses.size());
+    for (const auto& [uuid, truss] : scene.trusses)
+        sorted.emplace_back(&uuid, &truss);
 
     std::sort(sorted.begin(), sorted.end(), [](const auto &A, const auto &B) {
       const Truss *a = A.second;
@@ -189,79 +329,38 @@ void TrussTablePanel::ReloadData()
       return StringUtils::NaturalLess(a->name, b->name);
     });
 
+    std::vector<wxUIntPtr> itemData;
+    itemData.reserve(sorted.size());
+    rowUuids.reserve(sorted.size());
+    modelPaths.reserve(sorted.size());
+    symbolPaths.reserve(sorted.size());
     for (const auto& pair : sorted)
     {
-        const std::string& uuid = pair.first;
         const Truss& truss = *pair.second;
-        wxVector<wxVariant> row;
-
-        wxString name = wxString::FromUTF8(truss.name);
-        wxString layer = truss.layer == DEFAULT_LAYER_NAME ? wxString()
-                                                            : wxString::FromUTF8(truss.layer);
-        std::string displayPath;
-        std::string symbolFullPath;
-        const std::string &base = guiConfigServices->LegacyConfigManager().GetScene().basePath;
-        if (!truss.modelFile.empty()) {
-            fs::path p = base.empty() ? fs::path(truss.modelFile)
-                                     : fs::path(base) / truss.modelFile;
-            displayPath = p.string();
-        } else if (!truss.symbolFile.empty()) {
-            fs::path p = base.empty() ? fs::path(truss.symbolFile)
-                                     : fs::path(base) / truss.symbolFile;
-            displayPath = p.string();
-        }
-        if (!truss.symbolFile.empty()) {
-            fs::path p = base.empty() ? fs::path(truss.symbolFile)
-                                     : fs::path(base) / truss.symbolFile;
-            symbolFullPath = p.string();
-        }
-        wxString modelFull = wxString::FromUTF8(displayPath);
-        modelPaths.push_back(modelFull);
-        symbolPaths.push_back(wxString::FromUTF8(symbolFullPath));
-        wxString model = wxFileName(modelFull).GetFullName();
-
-        auto posArr = truss.transform.o;
-        wxString posX = wxString::Format("%.3f", posArr[0] / 1000.0f);
-        wxString posY = wxString::Format("%.3f", posArr[1] / 1000.0f);
-        wxString posZ = wxString::Format("%.3f", posArr[2] / 1000.0f);
-
-        auto euler = MatrixUtils::MatrixToEuler(truss.transform);
-        wxString roll = wxString::Format("%.1f\u00B0", euler[2]);
-        wxString pitch = wxString::Format("%.1f\u00B0", euler[1]);
-        wxString yaw = wxString::Format("%.1f\u00B0", euler[0]);
-
-        row.push_back(name);
-        row.push_back(layer);
-        row.push_back(model);
-        wxString posName = wxString::FromUTF8(truss.positionName);
-        row.push_back(posName);
-        row.push_back(posX);
-        row.push_back(posY);
-        row.push_back(posZ);
-        row.push_back(roll);
-        row.push_back(pitch);
-        row.push_back(yaw);
-        wxString manuf = wxString::FromUTF8(truss.manufacturer);
-        wxString modelName = wxString::FromUTF8(truss.model);
-        wxString len = wxString::Format("%.2f", truss.lengthMm / 1000.0f);
-        wxString wid = truss.widthMm > 0.0f
-                           ? wxString::Format("%.2f", truss.widthMm / 1000.0f)
-                           : wxString();
-        wxString hei = truss.heightMm > 0.0f
-                            ? wxString::Format("%.2f", truss.heightMm / 1000.0f)
-                            : wxString();
-        wxString weight = wxString::Format("%.2f", truss.weightKg);
-        row.push_back(manuf);
-        row.push_back(modelName);
-        row.push_back(len);
-        row.push_back(wid);
-        row.push_back(hei);
-        row.push_back(weight);
-
-        store->AppendItem(row, rowUuids.size());
-        rowUuids.push_back(uuid);
+        itemData.push_back(rowUuids.size());
+        rowUuids.push_back(*pair.first);
+        modelPaths.push_back(wxString::FromUTF8(
+            ResolveTrussDisplayPath(scene.basePath, truss)));
+        symbolPaths.push_back(wxString::FromUTF8(
+            ResolveScenePath(scene.basePath, truss.symbolFile)));
     }
 
+    // Cells are formatted from the scene when a row is first shown.
+    auto sources = std::make_shared<const std::vector<std::string>>(rowUuids);
+    IGuiConfigServices* services = guiConfigServices;
+    store->ResetRows(itemData, [services, sources](size_t source, unsigned col,
+                                                   wxVariant& value) {
+        const MvrScene& current = std::as_const(services->LegacyConfigManager()).GetScene();
+        const Truss* truss = nullptr;
+        if (source < sources->size()) {
+            auto it = current.trusses.find((*sources)[source]);
+            if (it != current.trusses.end())
+                truss = &it->second;
+        }
+        value = MakeTrussCell(truss, col, current.basePath);
+    });
+    RebuildRowIndex();
+
     // Let wxDataViewListCtrl manage column headers and sorting
     if (LayerPanel::Instance())
         LayerPanel::Instance()->ReloadLayers();
@@ -669,7 +768,7 @@ void TrussTablePanel::UpdatePositionValues(
         return;
 
     ConfigManager& cfg = guiConfigServices->LegacyConfigManager();
-    auto& scene = cfg.GetScene();
+    const auto& scene = std::as_const(cfg).GetScene();
     wxWindowUpdateLocker locker(table);
 
     for (const auto& uuid : uuids) {
@@ -677,16 +776,20 @@ void TrussTablePanel::UpdatePositionValues(
         if (it == scene.trusses.end())
             continue;
 
+        int row = FindRow(uuid);
+        if (row < 0)
+            continue;
+        // Untouched rows simply re-read their cells from the scene.
+        if (!store->IsRowEdited(row)) {
+            store->RefreshRow(row);
+            continue;
+        }
+
         auto posArr = it->second.transform.o;
         wxString posX = wxString::Format("%.3f", posArr[0] / 1000.0f);
         wxString posY = wxString::Format("%.3f", posArr[1] / 1000.0f);
         wxString posZ = wxString::Format("%.3f", posArr[2] / 1000.0f);
 
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), uuid);
-        if (pos == rowUuids.end())
-            continue;
-
-        int row = static_cast<int>(pos - rowUuids.begin());
         table->SetValue(wxVariant(posX), row, 4);
         table->SetValue(wxVariant(posY), row, 5);
         table->SetValue(wxVariant(posZ), row, 6);
@@ -700,11 +803,10 @@ void TrussTablePanel::ApplyPositionValueUpdates(
 
     wxWindowUpdateLocker locker(table);
     for (const auto& update : updates) {
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), update.uuid);
-        if (pos == rowUuids.end())
+        int row = FindRow(update.uuid);
+        if (row < 0)
             continue;
 
-        int row = static_cast<int>(pos - rowUuids.begin());
         table->SetValue(wxVariant(wxString::FromUTF8(update.posX)), row, 4);
         table->SetValue(wxVariant(wxString::FromUTF8(update.posY)), row, 5);
         table->SetValue(wxVariant(wxString::FromUTF8(update.posZ)), row, 6);
@@ -725,6 +827,7 @@ void TrussTablePanel::UpdateSceneData()
         float weight;
     };
     std::unordered_map<std::string, Dim> dims;
+    std::vector<std::string> updatedUuids;
 
     auto makeKey = [](const std::string& n,
                       const std::string& m,
@@ -739,7 +842,20 @@ void TrussTablePanel::UpdateSceneData()
         if (it == scene.trusses.end())
             continue;
 
+        // Rows nobody edited still mirror the scene; they only seed the
+        // canonical dimensions of their group.
+        if (!store->IsRowEdited(i)) {
+            std::string key = makeKey(it->second.name,
+                                      it->second.manufacturer,
+                                      it->second.model);
+            if (!dims.count(key))
+                dims[key] = {it->second.lengthMm, it->second.widthMm,
+                             it->second.heightMm, it->second.weightKg};
+            continue;
+        }
+
         Truss old = it->second;
+        updatedUuids.push_back(rowUuids[i]);
         wxVariant v;
 
         table->GetValue(v, i, 0);
@@ -896,14 +1012,14 @@ void TrussTablePanel::UpdateSceneData()
             table->SetValue(wxVariant(widStr), i, 13);
             table->SetValue(wxVariant(heiStr), i, 14);
             table->SetValue(wxVariant(weiStr), i, 15);
+            // The journal merges repeated uuids into one change.
+            updatedUuids.push_back(rowUuids[i]);
         }
     }
 
-    if (SummaryPanel::Instance() && IsActivePage())
-        SummaryPanel::Instance()->ShowTrussSummary();
-
-    if (RiggingPanel::Instance())
-        RiggingPanel::Instance()->RefreshData();
+    // Refreshes the written rows, the summary and the rigging totals.
+    cfg.NotifySceneChanged(SceneEntityKind::Truss, updatedUuids,
+                           SceneComponent::All);
 }
 
 TrussTablePanel* TrussTablePanel::Instance()
@@ -958,9 +1074,8 @@ void TrussTablePanel::SelectByUuid(const std::vector<std::string>& uuids) {
     table->UnselectAll();
     std::vector<bool> selectedRows(table->GetItemCount(), false);
     for (const auto& u : uuids) {
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), u);
-        if (pos != rowUuids.end()) {
-            int row = static_cast<int>(pos - rowUuids.begin());
+        int row = FindRow(u);
+        if (row >= 0) {
             table->SelectRow(row);
             if (row >= 0 && static_cast<size_t>(row) < selectedRows.size())
                 selectedRows[row] = true;
@@ -989,15 +1104,15 @@ void TrussTablePanel::DeleteSelected()
     }
     std::sort(rows.begin(), rows.end(), std::greater<int>());
 
+    // Rows keep their old index as item data, so ResyncRows() rebuilds the
+    // uuid and path lists from the order before the deletion.
+    std::vector<std::string> oldOrder = rowUuids;
+    std::vector<std::string> removed;
     auto& scene = guiConfigServices->LegacyConfigManager().GetScene();
     for (int r : rows) {
         if ((size_t)r < rowUuids.size()) {
             scene.trusses.erase(rowUuids[r]);
-            rowUuids.erase(rowUuids.begin() + r);
-            if ((size_t)r < modelPaths.size())
-                modelPaths.erase(modelPaths.begin() + r);
-            if ((size_t)r < symbolPaths.size())
-                symbolPaths.erase(symbolPaths.begin() + r);
+            removed.push_back(rowUuids[r]);
             table->DeleteItem(r);
         }
     }
@@ -1012,11 +1127,9 @@ void TrussTablePanel::DeleteSelected()
         Viewer2DPanel::Instance()->UpdateScene();
     }
 
-    if (SummaryPanel::Instance())
-        SummaryPanel::Instance()->ShowTrussSummary();
-
-    std::vector<std::string> order = rowUuids;
-    ResyncRows(order, {});
+    ResyncRows(oldOrder, {});
+    cfg.NotifySceneChanged(SceneEntityKind::Truss, removed,
+                           SceneComponent::Removed);
 }
 
 void TrussTablePanel::ResyncRows(const std::vector<std::string>& oldOrder,
@@ -1042,13 +1155,14 @@ void TrussTablePanel::ResyncRows(const std::vector<std::string>& oldOrder,
     rowUuids.swap(newOrder);
     modelPaths.swap(newPaths);
     symbolPaths.swap(newSymPaths);
+    RebuildRowIndex();
 
     table->UnselectAll();
     for (const auto& uuid : selectedUuids)
     {
-        auto pos = std::find(rowUuids.begin(), rowUuids.end(), uuid);
-        if (pos != rowUuids.end())
-            table->SelectRow(static_cast<int>(pos - rowUuids.begin()));
+        int row = FindRow(uuid);
+        if (row >= 0)
+            table->SelectRow(row);
     }
     UpdateSelectionHighlight();
 }
@@ -22,8 +22,10 @@
 #include <wx/time.h>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "colorstore.h"
 #include "positionvalueupdate.h"
+#include "scenechangejournal.h"
 
 class IGuiConfigServices;
 
@@ -55,10 +57,15 @@ private:
     std::vector<std::string> rowUuids;
     std::vector<wxString> modelPaths;  // Displayed model file paths (.gtruss if any)
     std::vector<wxString> symbolPaths; // Resolved geometry file paths
+    std::unordered_map<std::string, int> rowIndex; // uuid -> row in rowUuids
     bool dragSelecting = false;
     int startRow = -1;
     IGuiConfigServices *guiConfigServices = nullptr;
+    SceneChangeJournal::ListenerId sceneListener = 0;
     void InitializeTable(); // Set up columns
+    void OnSceneChanged(const SceneChangeSet& changes);
+    void RebuildRowIndex();
+    int FindRow(const std::string& uuid) const;
     void OnSelectionChanged(wxDataViewEvent& evt);
     void OnContextMenu(wxDataViewEvent& event);
     void OnColumnSorted(wxDataViewEvent& event);
@@ -16,8 +16,10 @@
  * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
  */
 #include "configmanager.h"
+#include "gdtfconflictdialog.h"
 #include "logger.h"
 #include "mainwindow.h"
+#include "mvrimporter.h"
 #include "projectutils.h"
 #include "splashscreen.h"
 #include <filesystem>
@@ -62,6 +64,9 @@ bool MyApp::OnInit() {
   // Initialize logging system (overwrites log file each launch)
   Logger::Instance();
 
+  // Let MVR imports ask which GDTF to keep when the dictionary disagrees
+  MvrImporter::SetConflictPrompt(PromptGdtfConflicts);
+
   SplashScreen::SetMessage("Creating main window...");
   MainWindow *mainWindow = new MainWindow("Perastage");
   mainWindow->Show(true);
@@ -34,6 +34,9 @@ struct Truss {
     // Metadata fields
     std::string manufacturer;
     std::string model;
+    // Length assumed by the viewer and the rigging solver when a truss
+    // has none.
+    static constexpr float kDefaultLengthMm = 300.0f;
     float lengthMm = 0.0f;
     float widthMm = 0.0f;
     float heightMm = 0.0f;
@@ -41,6 +41,7 @@ class wxZipStreamLink;
 #include <sstream>
 #include <unordered_set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -580,7 +581,11 @@ static std::string CreatePatchedGdtf(const std::string &gdtfPath,
 }
 
 bool MvrExporter::ExportToFile(const std::string &filePath) {
-  const auto &scene = ConfigManager::Get().GetScene();
+  return ExportToFile(std::as_const(ConfigManager::Get()).GetScene(), filePath);
+}
+
+bool MvrExporter::ExportToFile(const MvrScene &scene,
+                               const std::string &filePath) {
   auto positions = scene.positions;
 
   std::unordered_map<std::string, std::string> positionByName;
@@ -19,6 +19,8 @@
 
 #include <string>
 
+class MvrScene;
+
 // Convert a 1-based universe and channel into the MVR absolute DMX address.
 int ComputeAbsoluteDmx(int universe1Based, int address1Based);
 
@@ -28,4 +30,7 @@ class MvrExporter
 public:
     // Serialize the scene and write a .mvr archive at the given path
     bool ExportToFile(const std::string& filePath);
+    // Same for a given scene, such as a snapshot being saved on a worker
+    // thread; reads nothing else from ConfigManager.
+    bool ExportToFile(const MvrScene& scene, const std::string& filePath);
 };
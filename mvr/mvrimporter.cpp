@@ -26,6 +26,7 @@
 #include "consolepanel.h"
 #include "logger.h"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <charconv>
 #include <chrono>
@@ -49,7 +50,7 @@
 
 // wxWidgets zip support
 #include <wx/wfstream.h>
-#include <wx/wx.h>
+#include <wx/app.h>
 class wxZipStreamLink;
 #include <wx/filename.h>
 #include <wx/zipstrm.h>
@@ -133,8 +134,12 @@ static std::string CieToHex(const std::string &cie) {
 // Helper to log errors both to stderr and the application's console panel.
 // Log a message to both the log file and the application's console panel.
 // Console updates are queued to the GUI thread to avoid blocking.
+// Checked for every log line, possibly from the import worker thread, so
+// the preference is read once when an import starts.
+static std::atomic<bool> g_detailedMvrImportLog{false};
+
 static bool IsDetailedMvrImportLogEnabled() {
-  return ConfigManager::Get().GetFloat("mvr_import_detailed_log") >= 0.5f;
+  return g_detailedMvrImportLog.load(std::memory_order_relaxed);
 }
 
 static void LogMessage(Logger::Level level, const std::string &msg) {
@@ -165,58 +170,24 @@ static void LogMessage(const std::string &msg) {
   LogMessage(Logger::Level::Info, msg);
 }
 
-struct GdtfConflict {
-  std::string type;
-  std::string mvrPath;
-  std::string appPath;
-};
-
-static std::unordered_map<std::string, std::string>
-PromptGdtfConflicts(const std::vector<GdtfConflict> &conflicts) {
-  std::unordered_map<std::string, std::string> chosen;
-  if (conflicts.empty())
-    return chosen;
-
-  wxDialog dlg(nullptr, wxID_ANY, "GDTF conflicts");
-  wxBoxSizer *topSizer = new wxBoxSizer(wxVERTICAL);
-  wxFlexGridSizer *grid = new wxFlexGridSizer(3, 5, 5);
-  grid->Add(new wxStaticText(&dlg, wxID_ANY, "Type"));
-  grid->Add(new wxStaticText(&dlg, wxID_ANY, "MVR"));
-  grid->Add(new wxStaticText(&dlg, wxID_ANY, "App"));
-
-  std::vector<wxRadioButton *> mvrBtns;
-  std::vector<wxRadioButton *> appBtns;
-  for (const auto &c : conflicts) {
-    grid->Add(
-        new wxStaticText(&dlg, wxID_ANY, wxString::FromUTF8(c.type.c_str())));
-    wxRadioButton *mvr = new wxRadioButton(
-        &dlg, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxRB_GROUP);
-    wxRadioButton *app = new wxRadioButton(&dlg, wxID_ANY, "");
-    mvr->SetValue(true);
-    grid->Add(mvr, 0, wxALIGN_CENTER);
-    grid->Add(app, 0, wxALIGN_CENTER);
-    mvrBtns.push_back(mvr);
-    appBtns.push_back(app);
-  }
-
-  topSizer->Add(grid, 1, wxALL, 10);
-  topSizer->Add(dlg.CreateSeparatedButtonSizer(wxOK | wxCANCEL), 0,
-                wxEXPAND | wxALL, 10);
-  dlg.SetSizerAndFit(topSizer);
-
-  if (dlg.ShowModal() != wxID_OK)
-    return chosen;
+static MvrImporter::ConflictPrompt &ConflictPromptHook() {
+  static MvrImporter::ConflictPrompt prompt;
+  return prompt;
+}
 
-  for (size_t i = 0; i < conflicts.size(); ++i) {
-    const auto &c = conflicts[i];
-    chosen[c.type] = mvrBtns[i]->GetValue() ? c.mvrPath : c.appPath;
-  }
-  return chosen;
+void MvrImporter::SetConflictPrompt(ConflictPrompt prompt) {
+  ConflictPromptHook() = std::move(prompt);
 }
 
 bool MvrImporter::ImportFromFile(const std::string &filePath,
                                  bool promptConflicts,
                                  bool applyDictionary) {
+  const ConfigManager &cfg = ConfigManager::Get();
+  g_detailedMvrImportLog.store(
+      cfg.GetFloatSnapshot()->Get(cfg.ResolveFloat("mvr_import_detailed_log")) >=
+          0.5f,
+      std::memory_order_relaxed);
+
   // Treat the incoming path as UTF-8 to preserve any non-ASCII characters
   fs::path path = fs::u8path(filePath);
 
@@ -1055,7 +1026,7 @@ bool MvrImporter::ParseSceneXml(const std::string &sceneXmlPath,
   // dictionary only if requested. This occurs before rendering so user choices
   // are applied to the final scene data.
   if (applyDictionary) {
-    std::vector<GdtfConflict> gdtfConflicts;
+    std::vector<MvrImporter::GdtfConflict> gdtfConflicts;
     std::unordered_set<std::string> conflictTypes;
     for (const auto &[uid, f] : scene.fixtures) {
       if (auto dictEntry = GdtfDictionary::Get(f.typeName)) {
@@ -1066,7 +1037,9 @@ bool MvrImporter::ParseSceneXml(const std::string &sceneXmlPath,
     }
     if (!gdtfConflicts.empty()) {
       if (promptConflicts) {
-        auto choices = PromptGdtfConflicts(gdtfConflicts);
+        std::unordered_map<std::string, std::string> choices;
+        if (const auto &prompt = ConflictPromptHook())
+          choices = prompt(gdtfConflicts);
         for (auto &[uid, f] : scene.fixtures) {
           auto typeKey = f.typeName;
           auto it = choices.find(typeKey);
@@ -17,12 +17,31 @@
  */
 #pragma once
 
+#include <functional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // Responsible for importing .mvr files into the application's internal data model
 class MvrImporter
 {
 public:
+    // A fixture type that both the MVR file and the GDTF dictionary provide
+    struct GdtfConflict {
+        std::string type;
+        std::string mvrPath;
+        std::string appPath;
+    };
+
+    // Asks which file to use for each conflicting type and returns
+    // type -> chosen path. Types left out keep the file from the MVR.
+    using ConflictPrompt = std::function<std::unordered_map<std::string, std::string>(
+        const std::vector<GdtfConflict>&)>;
+
+    // Installed by the GUI at startup. Without a prompt, conflicts keep the
+    // files from the MVR, so the importer itself needs no GUI toolkit.
+    static void SetConflictPrompt(ConflictPrompt prompt);
+
     // Imports and parses a .mvr file and stores the data into ConfigManager
     // Set promptConflicts=false to skip showing the dictionary conflict dialog
     // Set applyDictionary=true to resolve GDTF conflicts using the dictionary
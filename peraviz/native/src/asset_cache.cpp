@@ -1,12 +1,16 @@
 #include "asset_cache.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
-#include <cstdint>
 #include <fstream>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 
-#include <wx/filename.h>
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
 
@@ -28,6 +32,19 @@ std::string normalize_archive_path(const std::string &raw) {
     return out;
 }
 
+// Rejects names that would land outside the cache directory.
+bool is_safe_relative_path(const std::string &path) {
+    size_t start = 0;
+    while (start <= path.size()) {
+        const size_t end = std::min(path.find('/', start), path.size());
+        if (path.compare(start, end - start, "..") == 0 && end - start == 2) {
+            return false;
+        }
+        start = end + 1;
+    }
+    return path.find(':') == std::string::npos;
+}
+
 std::string hash_file_contents(const std::filesystem::path &path) {
     std::ifstream input(path, std::ios::binary);
     if (!input) {
@@ -49,6 +66,113 @@ std::string hash_file_contents(const std::filesystem::path &path) {
     return ss.str();
 }
 
+
+// Hashing a large show on every load would cost as much as extracting it,
+// so the hash is remembered while the file's size and time stay the same.
+std::string archive_hash(const std::filesystem::path &path) {
+    struct Stamp {
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type::rep mtime = 0;
+        std::string hash;
+    };
+    static std::mutex mutex;
+    static std::unordered_map<std::string, Stamp> hashes;
+
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return hash_file_contents(path);
+    }
+    const auto mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) {
+        return hash_file_contents(path);
+    }
+
+    const std::string key = path.u8string();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = hashes.find(key);
+        if (it != hashes.end() && it->second.size == size && it->second.mtime == mtime) {
+            return it->second.hash;
+        }
+    }
+
+    std::string hash = hash_file_contents(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    hashes[key] = Stamp{size, mtime, hash};
+    return hash;
+}
+
+using EntryIndex = std::unordered_map<std::string, std::unique_ptr<wxZipEntry>>;
+
+// Reads the central directory: lower-cased entry name -> entry, which
+// OpenEntry can seek to directly.
+void read_entry_index(wxZipInputStream &zip, EntryIndex &index) {
+    std::unique_ptr<wxZipEntry> entry;
+    while ((entry.reset(zip.GetNextEntry())), entry) {
+        if (entry->IsDir()) {
+            continue;
+        }
+        const std::string name = normalize_archive_path(entry->GetName().ToUTF8().data());
+        if (name.empty() || !is_safe_relative_path(name)) {
+            continue;
+        }
+        index.emplace(to_lower_ascii(name), std::move(entry));
+    }
+}
+
+std::string entry_relative_path(const wxZipEntry &entry) {
+    return normalize_archive_path(entry.GetName().ToUTF8().data());
+}
+
+// Writes the entry next to its final path and renames it into place, so a
+// file under the final name is always complete.
+bool extract_entry(wxZipInputStream &zip, wxZipEntry &entry, const std::filesystem::path &out_path,
+                   std::uint64_t &size) {
+    if (!zip.OpenEntry(entry)) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(out_path.parent_path(), ec);
+    std::filesystem::path temp_path = out_path;
+    temp_path += ".part" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    size = 0;
+    {
+        std::ofstream output(temp_path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            return false;
+        }
+        char buffer[8192];
+        while (!zip.Eof()) {
+            zip.Read(buffer, sizeof(buffer));
+            const size_t bytes = zip.LastRead();
+            if (bytes == 0) {
+                break;
+            }
+            output.write(buffer, static_cast<std::streamsize>(bytes));
+            size += bytes;
+        }
+        if (!output || zip.GetLastError() == wxSTREAM_READ_ERROR) {
+            output.close();
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp_path, out_path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return std::filesystem::file_size(out_path, ec) == size && !ec;
+    }
+    return true;
+}
+
+constexpr const char *kManifestName = "manifest.txt";
+constexpr const char *kManifestHeader = "peraviz-cache 1";
+constexpr const char *kManifestComplete = "complete";
+
 } // namespace
 
 namespace peraviz {
@@ -57,74 +181,215 @@ ZipAssetCache::ZipAssetCache(std::string source_path)
     : source_path_(std::filesystem::u8path(source_path)) {
     const std::filesystem::path base = std::filesystem::temp_directory_path() / "peraviz_cache";
     const std::string source_name = source_path_.filename().u8string();
-    const std::string cache_key = source_name + "_" + hash_file_contents(source_path_);
+    const std::string cache_key = source_name + "_" + archive_hash(source_path_);
     cache_dir_ = base / cache_key;
     std::error_code ec;
     std::filesystem::create_directories(cache_dir_, ec);
+    load_manifest();
 }
 
+ZipAssetCache::~ZipAssetCache() = default;
+
 const std::filesystem::path &ZipAssetCache::cache_dir() const {
     return cache_dir_;
 }
 
 int ZipAssetCache::extracted_assets() const {
-    return static_cast<int>(extracted_.size());
+    return extracted_;
 }
 
-std::string ZipAssetCache::ensure_extracted(const std::string &archive_relative_path) {
-    if (archive_relative_path.empty()) {
-        return {};
+void ZipAssetCache::load_manifest() {
+    std::ifstream input(cache_dir_ / kManifestName);
+    std::string line;
+    if (!input || !std::getline(input, line) || line != kManifestHeader) {
+        return;
     }
 
-    const std::string normalized = normalize_archive_path(archive_relative_path);
-    if (normalized.empty()) {
-        return {};
+    while (std::getline(input, line)) {
+        if (line == kManifestComplete) {
+            complete_ = true;
+            continue;
+        }
+        const size_t tab = line.find('\t');
+        if (tab == std::string::npos || tab + 1 >= line.size()) {
+            continue;
+        }
+        CachedEntry entry;
+        try {
+            entry.size = std::stoull(line.substr(0, tab));
+        } catch (...) {
+            continue;
+        }
+        entry.relative_path = line.substr(tab + 1);
+        if (!is_safe_relative_path(entry.relative_path)) {
+            continue;
+        }
+        manifest_[to_lower_ascii(entry.relative_path)] = std::move(entry);
     }
+}
 
-    const std::filesystem::path out_path = cache_dir_ / std::filesystem::u8path(normalized);
+void ZipAssetCache::append_manifest(const CachedEntry &entry) const {
+    const std::filesystem::path path = cache_dir_ / kManifestName;
     std::error_code ec;
-    std::filesystem::create_directories(out_path.parent_path(), ec);
-    if (std::filesystem::exists(out_path)) {
-        return out_path.u8string();
+    const bool exists = std::filesystem::exists(path, ec);
+    std::ofstream output(path, std::ios::app);
+    if (!exists) {
+        output << kManifestHeader << '\n';
+    }
+    output << entry.size << '\t' << entry.relative_path << '\n';
+}
+
+void ZipAssetCache::save_manifest() const {
+    const std::filesystem::path path = cache_dir_ / kManifestName;
+    std::filesystem::path temp_path = path;
+    temp_path += ".part" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream output(temp_path, std::ios::trunc);
+        output << kManifestHeader << '\n';
+        for (const auto &[key, entry] : manifest_) {
+            output << entry.size << '\t' << entry.relative_path << '\n';
+        }
+        if (complete_) {
+            output << kManifestComplete << '\n';
+        }
     }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+    }
+}
 
-    wxFileInputStream input(wxString::FromUTF8(source_path_.u8string().c_str()));
-    if (!input.IsOk()) {
+std::string ZipAssetCache::cached_path(const std::string &key) const {
+    auto it = manifest_.find(key);
+    if (it == manifest_.end()) {
+        return {};
+    }
+    const std::filesystem::path path = cache_dir_ / std::filesystem::u8path(it->second.relative_path);
+    std::error_code ec;
+    if (std::filesystem::file_size(path, ec) != it->second.size || ec) {
         return {};
     }
+    return path.u8string();
+}
 
-    const std::string target_lower = to_lower_ascii(normalized);
-    wxZipInputStream zip(input);
-    std::unique_ptr<wxZipEntry> entry;
-    while ((entry.reset(zip.GetNextEntry())), entry) {
-        const std::string entry_name = normalize_archive_path(entry->GetName().ToUTF8().data());
-        if (to_lower_ascii(entry_name) != target_lower) {
-            continue;
-        }
+bool ZipAssetCache::open_index() {
+    if (index_loaded_) {
+        return zip_ != nullptr;
+    }
+    index_loaded_ = true;
 
-        wxFileName file_name(wxString::FromUTF8(out_path.u8string().c_str()));
-        file_name.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    input_ = std::make_unique<wxFileInputStream>(wxString::FromUTF8(source_path_.u8string().c_str()));
+    if (!input_->IsOk()) {
+        input_.reset();
+        return false;
+    }
+    zip_ = std::make_unique<wxZipInputStream>(*input_);
+    read_entry_index(*zip_, index_);
+    return true;
+}
+
+void ZipAssetCache::extract_all() {
+    if (complete_ || !open_index()) {
+        return;
+    }
 
-        wxFileOutputStream output(wxString::FromUTF8(out_path.u8string().c_str()));
-        if (!output.IsOk()) {
-            return {};
+    std::vector<std::string> pending;
+    for (const auto &[key, entry] : index_) {
+        if (cached_path(key).empty()) {
+            pending.push_back(key);
         }
+    }
 
-        char buffer[8192];
-        while (!zip.Eof()) {
-            zip.Read(buffer, sizeof(buffer));
-            const size_t bytes = zip.LastRead();
-            if (bytes == 0) {
-                break;
+    // Each worker reads the archive through its own stream, since a zip
+    // stream has one current entry, and claims the next pending entry.
+    std::vector<CachedEntry> results(pending.size());
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        wxFileInputStream input(wxString::FromUTF8(source_path_.u8string().c_str()));
+        if (!input.IsOk()) {
+            return;
+        }
+        wxZipInputStream zip(input);
+        EntryIndex index;
+        read_entry_index(zip, index);
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            auto it = index.find(pending[i]);
+            if (it == index.end()) {
+                continue;
+            }
+            const std::string relative = entry_relative_path(*it->second);
+            std::uint64_t size = 0;
+            if (extract_entry(zip, *it->second, cache_dir_ / std::filesystem::u8path(relative), size)) {
+                results[i] = CachedEntry{relative, size};
             }
-            output.Write(buffer, bytes);
         }
+    };
+
+    if (!pending.empty()) {
+        const size_t hardware = std::max(1U, std::thread::hardware_concurrency());
+        const size_t worker_count = std::min(hardware, pending.size());
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count - 1);
+        for (size_t i = 1; i < worker_count; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    bool all_extracted = true;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (results[i].relative_path.empty()) {
+            all_extracted = false;
+            continue;
+        }
+        manifest_[pending[i]] = std::move(results[i]);
+        ++extracted_;
+    }
+    complete_ = all_extracted;
+    save_manifest();
+}
+
+std::string ZipAssetCache::ensure_extracted(const std::string &archive_relative_path) {
+    if (archive_relative_path.empty()) {
+        return {};
+    }
 
-        extracted_.insert(normalized);
-        return out_path.u8string();
+    const std::string normalized = normalize_archive_path(archive_relative_path);
+    if (normalized.empty()) {
+        return {};
+    }
+
+    const std::string key = to_lower_ascii(normalized);
+    std::string path = cached_path(key);
+    if (!path.empty()) {
+        return path;
+    }
+    if (complete_ && manifest_.find(key) == manifest_.end()) {
+        return {};
+    }
+
+    if (!open_index()) {
+        return {};
+    }
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return {};
+    }
+
+    CachedEntry entry{entry_relative_path(*it->second), 0};
+    const std::filesystem::path out_path = cache_dir_ / std::filesystem::u8path(entry.relative_path);
+    if (!extract_entry(*zip_, *it->second, out_path, entry.size)) {
+        return {};
     }
 
-    return {};
+    append_manifest(entry);
+    manifest_[key] = std::move(entry);
+    ++extracted_;
+    return out_path.u8string();
 }
 
 } // namespace peraviz
@@ -1,24 +1,66 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
-#include <set>
+#include <memory>
 #include <string>
+#include <unordered_map>
+
+class wxFileInputStream;
+class wxZipEntry;
+class wxZipInputStream;
 
 namespace peraviz {
 
+// Extracts entries of a ZIP archive (MVR or GDTF) into a cache directory
+// keyed by the archive's content hash. A manifest in that directory lists
+// the entries already on disk, so opening the same archive again finds its
+// files without reading the archive at all.
 class ZipAssetCache {
 public:
     explicit ZipAssetCache(std::string source_path);
+    ~ZipAssetCache();
+
+    ZipAssetCache(const ZipAssetCache &) = delete;
+    ZipAssetCache &operator=(const ZipAssetCache &) = delete;
 
     const std::filesystem::path &cache_dir() const;
+    // Entries written by this instance; entries found in the cache from an
+    // earlier load do not count.
     int extracted_assets() const;
 
+    // Extracts every entry not yet cached, several entries at a time. Does
+    // not open the archive once a previous call completed for it.
+    void extract_all();
+
+    // Path of the extracted entry, matched case-insensitively, or empty when
+    // the archive has no such entry.
     std::string ensure_extracted(const std::string &archive_relative_path);
 
 private:
+    struct CachedEntry {
+        std::string relative_path;
+        std::uint64_t size = 0;
+    };
+
+    void load_manifest();
+    void append_manifest(const CachedEntry &entry) const;
+    void save_manifest() const;
+    std::string cached_path(const std::string &key) const;
+    bool open_index();
+
     std::filesystem::path source_path_;
     std::filesystem::path cache_dir_;
-    std::set<std::string> extracted_;
+    // Lower-cased entry name -> file in cache_dir_.
+    std::unordered_map<std::string, CachedEntry> manifest_;
+    bool complete_ = false;
+    int extracted_ = 0;
+
+    // Central directory of the archive, read on the first cache miss.
+    std::unique_ptr<wxFileInputStream> input_;
+    std::unique_ptr<wxZipInputStream> zip_;
+    std::unordered_map<std::string, std::unique_ptr<wxZipEntry>> index_;
+    bool index_loaded_ = false;
 };
 
 } // namespace peraviz
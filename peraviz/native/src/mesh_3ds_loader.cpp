@@ -2,26 +2,25 @@
 
 #include <godot_cpp/variant/vector3.hpp>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
 
+using peraviz::MeshData;
+
 struct Chunk {
     uint16_t id = 0;
     uint32_t length = 0;
 };
 
-struct MeshData {
-    std::vector<float> vertices;
-    std::vector<uint32_t> indices;
-    std::vector<float> normals;
-};
-
 bool read_chunk(std::ifstream &file, Chunk &chunk) {
     if (!file.read(reinterpret_cast<char *>(&chunk.id), sizeof(chunk.id))) {
         return false;
@@ -218,35 +217,83 @@ bool load_3ds(const std::string &path, MeshData &mesh) {
 
 namespace peraviz {
 
-bool load_3ds_mesh_data(const godot::String &path,
-                        godot::PackedVector3Array &out_vertices,
-                        godot::PackedVector3Array &out_normals,
-                        godot::PackedInt32Array &out_indices,
-                        godot::String &out_error) {
-    MeshData mesh;
-    const std::string utf8_path(path.utf8().get_data());
-    if (!load_3ds(utf8_path, mesh)) {
-        out_error = godot::String("Failed to parse 3DS mesh");
+bool load_3ds_mesh(const std::string &path, MeshData &out_mesh) {
+    out_mesh = MeshData{};
+    if (!load_3ds(path, out_mesh)) {
+        out_mesh = MeshData{};
         return false;
     }
+    return true;
+}
+
+std::vector<MeshData> load_3ds_meshes(const std::vector<std::string> &paths) {
+    std::vector<MeshData> out(paths.size());
+    if (paths.empty()) {
+        return out;
+    }
+
+    // Files are independent, so each worker claims the next unparsed one.
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i = next++; i < paths.size(); i = next++) {
+            load_3ds_mesh(paths[i], out[i]);
+        }
+    };
+
+    const size_t hardware = std::max(1U, std::thread::hardware_concurrency());
+    const size_t worker_count = std::min(hardware, paths.size());
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count - 1);
+    for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    return out;
+}
 
+void to_godot_arrays(const MeshData &mesh,
+                     godot::PackedVector3Array &out_vertices,
+                     godot::PackedVector3Array &out_normals,
+                     godot::PackedInt32Array &out_indices) {
+    // Written through ptrw() once per array; set() checks bounds and
+    // copy-on-write for every element.
     out_vertices.resize(static_cast<int64_t>(mesh.vertices.size() / 3));
+    godot::Vector3 *vertices = out_vertices.ptrw();
     for (int64_t i = 0; i < out_vertices.size(); ++i) {
-        out_vertices.set(i, godot::Vector3(mesh.vertices[i * 3], mesh.vertices[i * 3 + 1],
-                                           mesh.vertices[i * 3 + 2]));
+        vertices[i] = godot::Vector3(mesh.vertices[i * 3], mesh.vertices[i * 3 + 1],
+                                     mesh.vertices[i * 3 + 2]);
     }
 
     out_normals.resize(static_cast<int64_t>(mesh.normals.size() / 3));
+    godot::Vector3 *normals = out_normals.ptrw();
     for (int64_t i = 0; i < out_normals.size(); ++i) {
-        out_normals.set(i, godot::Vector3(mesh.normals[i * 3], mesh.normals[i * 3 + 1],
-                                          mesh.normals[i * 3 + 2]));
+        normals[i] = godot::Vector3(mesh.normals[i * 3], mesh.normals[i * 3 + 1],
+                                    mesh.normals[i * 3 + 2]);
     }
 
     out_indices.resize(static_cast<int64_t>(mesh.indices.size()));
+    int32_t *indices = out_indices.ptrw();
     for (int64_t i = 0; i < out_indices.size(); ++i) {
-        out_indices.set(i, static_cast<int32_t>(mesh.indices[i]));
+        indices[i] = static_cast<int32_t>(mesh.indices[i]);
+    }
+}
+
+bool load_3ds_mesh_data(const godot::String &path,
+                        godot::PackedVector3Array &out_vertices,
+                        godot::PackedVector3Array &out_normals,
+                        godot::PackedInt32Array &out_indices,
+                        godot::String &out_error) {
+    MeshData mesh;
+    const std::string utf8_path(path.utf8().get_data());
+    if (!load_3ds_mesh(utf8_path, mesh)) {
+        out_error = godot::String("Failed to parse 3DS mesh");
+        return false;
     }
 
+    to_godot_arrays(mesh, out_vertices, out_normals, out_indices);
     return true;
 }
 
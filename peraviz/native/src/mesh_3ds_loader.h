@@ -4,8 +4,33 @@
 #include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/variant/string.hpp>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace peraviz {
 
+// Triangle mesh read from a 3DS file. vertices and normals hold x,y,z
+// triples; indices hold three vertex indices per triangle.
+struct MeshData {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<float> normals;
+};
+
+// Plain C++ parser without Godot types, so it may run on any thread.
+bool load_3ds_mesh(const std::string &path, MeshData &out_mesh);
+
+// Loads every path on a pool of threads. out[i] belongs to paths[i] and is
+// left empty when that file could not be parsed.
+std::vector<MeshData> load_3ds_meshes(const std::vector<std::string> &paths);
+
+// Copies a mesh into the arrays expected by ArrayMesh.
+void to_godot_arrays(const MeshData &mesh,
+                     godot::PackedVector3Array &out_vertices,
+                     godot::PackedVector3Array &out_normals,
+                     godot::PackedInt32Array &out_indices);
+
 bool load_3ds_mesh_data(const godot::String &path,
                         godot::PackedVector3Array &out_vertices,
                         godot::PackedVector3Array &out_normals,
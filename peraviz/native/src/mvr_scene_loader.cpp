@@ -10,8 +10,10 @@
 #include <cctype>
 #include <cmath>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 
@@ -94,6 +96,16 @@ std::string lower_ascii(std::string text) {
     return text;
 }
 
+std::string read_cached_file(const std::string &path) {
+    if (path.empty()) {
+        return {};
+    }
+    std::ifstream input(std::filesystem::u8path(path), std::ios::binary);
+    std::ostringstream contents;
+    contents << input.rdbuf();
+    return contents.str();
+}
+
 std::string read_xml_from_mvr(const std::string &path) {
     wxFileInputStream input(wxString::FromUTF8(path.c_str()));
     if (!input.IsOk()) {
@@ -313,8 +325,15 @@ SceneModel load_mvr(const std::string &path) {
 
     ZipAssetCache mvr_cache(path);
     model.cache_path = mvr_cache.cache_dir().u8string();
+    // Nearly every entry of a show is a model or a GDTF the scene uses;
+    // extracting them up front lets the workers run in parallel, and a show
+    // opened before is served from the cache without reading the archive.
+    mvr_cache.extract_all();
 
-    const std::string xml_content = read_xml_from_mvr(path);
+    std::string xml_content = read_cached_file(mvr_cache.ensure_extracted("GeneralSceneDescription.xml"));
+    if (xml_content.empty()) {
+        xml_content = read_xml_from_mvr(path);
+    }
     if (xml_content.empty()) {
         return model;
     }
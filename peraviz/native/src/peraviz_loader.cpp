@@ -6,17 +6,48 @@
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/vector3.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace godot {
 
 void PeravizLoader::_bind_methods() {
     ClassDB::bind_method(D_METHOD("load_mvr", "path"), &PeravizLoader::load_mvr);
+    ClassDB::bind_method(D_METHOD("load_mvr_packed", "path"), &PeravizLoader::load_mvr_packed);
     ClassDB::bind_method(D_METHOD("load_3ds_mesh_data", "path"), &PeravizLoader::load_3ds_mesh_data);
+
+    BIND_CONSTANT(NODE_FIXTURE);
+    BIND_CONSTANT(NODE_AXIS);
+    BIND_CONSTANT(NODE_EMITTER);
+    BIND_CONSTANT(NODE_HAS_BASIS);
+}
+
+namespace {
+
+Vector3 to_vector3(const peraviz::Vec3 &v) {
+    return Vector3(v.x, v.y, v.z);
+}
+
+bool is_3ds_path(const std::string &path) {
+    if (path.size() < 4) {
+        return false;
+    }
+    std::string extension = path.substr(path.size() - 4);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".3ds";
 }
 
+} // namespace
+
 Array PeravizLoader::load_mvr(const String &path) const {
     const peraviz::SceneModel model = peraviz::load_mvr(std::string(path.utf8().get_data()));
 
@@ -60,6 +91,150 @@ Array PeravizLoader::load_mvr(const String &path) const {
     return out;
 }
 
+Dictionary PeravizLoader::load_mvr_packed(const String &path) const {
+    const peraviz::SceneModel model = peraviz::load_mvr(std::string(path.utf8().get_data()));
+    const int64_t count = static_cast<int64_t>(model.nodes.size());
+
+    PackedStringArray node_ids;
+    PackedStringArray names;
+    PackedStringArray types;
+    PackedInt32Array parent_indices;
+    PackedInt32Array flags;
+    PackedInt32Array asset_indices;
+    PackedVector3Array positions;
+    PackedVector3Array rotations;
+    PackedVector3Array scales;
+    PackedVector3Array basis_x;
+    PackedVector3Array basis_y;
+    PackedVector3Array basis_z;
+    node_ids.resize(count);
+    names.resize(count);
+    types.resize(count);
+    parent_indices.resize(count);
+    flags.resize(count);
+    asset_indices.resize(count);
+    positions.resize(count);
+    rotations.resize(count);
+    scales.resize(count);
+    basis_x.resize(count);
+    basis_y.resize(count);
+    basis_z.resize(count);
+
+    std::unordered_map<std::string, int32_t> node_index;
+    node_index.reserve(model.nodes.size());
+    for (size_t i = 0; i < model.nodes.size(); ++i) {
+        node_index.emplace(model.nodes[i].node_id, static_cast<int32_t>(i));
+    }
+
+    // Assets in order of first use; nodes refer to them by index.
+    std::vector<std::string> assets;
+    std::unordered_map<std::string, int32_t> asset_index;
+
+    int32_t *parent_out = parent_indices.ptrw();
+    int32_t *flags_out = flags.ptrw();
+    int32_t *asset_out = asset_indices.ptrw();
+    Vector3 *position_out = positions.ptrw();
+    Vector3 *rotation_out = rotations.ptrw();
+    Vector3 *scale_out = scales.ptrw();
+    Vector3 *basis_x_out = basis_x.ptrw();
+    Vector3 *basis_y_out = basis_y.ptrw();
+    Vector3 *basis_z_out = basis_z.ptrw();
+    for (int64_t i = 0; i < count; ++i) {
+        const peraviz::SceneNode &node = model.nodes[static_cast<size_t>(i)];
+        const peraviz::SceneTransform &t = node.local_transform;
+        node_ids.set(i, String::utf8(node.node_id.c_str()));
+        names.set(i, String::utf8(node.name.c_str()));
+        types.set(i, String(node.type.c_str()));
+
+        auto parent = node.parent_id.empty() ? node_index.end() : node_index.find(node.parent_id);
+        parent_out[i] = parent == node_index.end() ? -1 : parent->second;
+
+        int32_t node_flags = 0;
+        node_flags |= node.is_fixture ? NODE_FIXTURE : 0;
+        node_flags |= node.is_axis ? NODE_AXIS : 0;
+        node_flags |= node.is_emitter ? NODE_EMITTER : 0;
+        node_flags |= t.has_basis ? NODE_HAS_BASIS : 0;
+        flags_out[i] = node_flags;
+
+        asset_out[i] = -1;
+        if (!node.asset_path.empty()) {
+            auto [it, inserted] =
+                asset_index.emplace(node.asset_path, static_cast<int32_t>(assets.size()));
+            if (inserted) {
+                assets.push_back(node.asset_path);
+            }
+            asset_out[i] = it->second;
+        }
+
+        position_out[i] = to_vector3(t.position);
+        rotation_out[i] = to_vector3(t.rotation_degrees);
+        scale_out[i] = to_vector3(t.scale);
+        basis_x_out[i] = to_vector3(t.basis_x);
+        basis_y_out[i] = to_vector3(t.basis_y);
+        basis_z_out[i] = to_vector3(t.basis_z);
+    }
+
+    std::vector<std::string> mesh_paths;
+    std::vector<size_t> mesh_assets;
+    for (size_t i = 0; i < assets.size(); ++i) {
+        if (is_3ds_path(assets[i])) {
+            mesh_paths.push_back(assets[i]);
+            mesh_assets.push_back(i);
+        }
+    }
+    const std::vector<peraviz::MeshData> parsed = peraviz::load_3ds_meshes(mesh_paths);
+
+    // One entry per asset: mesh arrays for parsed 3DS files, an empty
+    // Dictionary for assets the script loads itself or that failed.
+    PackedStringArray asset_paths;
+    asset_paths.resize(static_cast<int64_t>(assets.size()));
+    Array meshes;
+    meshes.resize(static_cast<int64_t>(assets.size()));
+    for (size_t i = 0; i < assets.size(); ++i) {
+        asset_paths.set(static_cast<int64_t>(i), String::utf8(assets[i].c_str()));
+        meshes[static_cast<int64_t>(i)] = Dictionary();
+    }
+    int loaded_meshes = 0;
+    for (size_t i = 0; i < parsed.size(); ++i) {
+        if (parsed[i].vertices.empty()) {
+            continue;
+        }
+        PackedVector3Array vertices;
+        PackedVector3Array normals;
+        PackedInt32Array indices;
+        peraviz::to_godot_arrays(parsed[i], vertices, normals, indices);
+        Dictionary mesh;
+        mesh["vertices"] = vertices;
+        mesh["normals"] = normals;
+        mesh["indices"] = indices;
+        meshes[static_cast<int64_t>(mesh_assets[i])] = mesh;
+        ++loaded_meshes;
+    }
+
+    UtilityFunctions::print("[PeravizNative] load_mvr_packed nodes=", count,
+                            " assets=", static_cast<int64_t>(assets.size()),
+                            " meshes_3ds=", loaded_meshes,
+                            " cache=", String(model.cache_path.c_str()));
+
+    Dictionary out;
+    out["count"] = count;
+    out["node_id"] = node_ids;
+    out["name"] = names;
+    out["type"] = types;
+    out["parent_index"] = parent_indices;
+    out["flags"] = flags;
+    out["asset_index"] = asset_indices;
+    out["position"] = positions;
+    out["rotation"] = rotations;
+    out["scale"] = scales;
+    out["basis_x"] = basis_x;
+    out["basis_y"] = basis_y;
+    out["basis_z"] = basis_z;
+    out["assets"] = asset_paths;
+    out["meshes"] = meshes;
+    return out;
+}
+
 Dictionary PeravizLoader::load_3ds_mesh_data(const String &path) const {
     PackedVector3Array vertices;
     PackedVector3Array normals;
@@ -15,7 +15,19 @@ protected:
     static void _bind_methods();
 
 public:
+    // Bits of the "flags" column returned by load_mvr_packed.
+    enum NodeFlag {
+        NODE_FIXTURE = 1,
+        NODE_AXIS = 2,
+        NODE_EMITTER = 4,
+        NODE_HAS_BASIS = 8,
+    };
+
     Array load_mvr(const String &path) const;
+    // Same scene as load_mvr, as one Packed*Array per field plus a table of
+    // the unique assets. 3DS assets come with their mesh arrays, parsed in
+    // parallel, so every asset is built once however many nodes use it.
+    Dictionary load_mvr_packed(const String &path) const;
     Dictionary load_3ds_mesh_data(const String &path) const;
 };
 
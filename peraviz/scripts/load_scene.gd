@@ -23,104 +23,119 @@ func _on_load_pressed() -> void:
 func _on_file_selected(path: String) -> void:
 	_clear_scene()
 	var native_path: String = ProjectSettings.globalize_path(path)
-	var nodes: Array = _loader.load_mvr(native_path)
-	print("[Peraviz] Loaded render nodes: ", nodes.size())
+	var scene: Dictionary = _loader.load_mvr_packed(native_path)
+	var count: int = int(scene.get("count", 0))
+	print("[Peraviz] Loaded render nodes: ", count)
 	_has_loaded_bounds = false
 
-	_build_node_tree(nodes)
+	_build_asset_table(scene)
+	_build_node_tree(scene)
 	_focus_loaded_scene()
-	status_label.text = "Nodes: %d (press F to focus)" % nodes.size()
+	status_label.text = "Nodes: %d (press F to focus)" % count
 
 func _unhandled_input(event: InputEvent) -> void:
 	if event is InputEventKey and event.pressed and not event.echo and event.keycode == KEY_F:
 		_focus_loaded_scene()
 		get_viewport().set_input_as_handled()
 
-func _build_node_tree(nodes: Array) -> void:
+# Builds every unique asset once: an ArrayMesh shared by all instances of a
+# native 3DS mesh, or a template node duplicated for each instance.
+func _build_asset_table(scene: Dictionary) -> void:
+	var assets: PackedStringArray = scene.get("assets", PackedStringArray())
+	var meshes: Array = scene.get("meshes", [])
+	_asset_cache.clear()
+	for i in assets.size():
+		var asset: Variant = null
+		if i < meshes.size():
+			asset = _build_array_mesh(meshes[i])
+		if asset == null:
+			asset = _load_3d_asset(assets[i])
+		if asset == null:
+			print("[Peraviz] Asset fallback for missing/invalid model: ", assets[i])
+		_asset_cache[i] = asset
+
+func _build_node_tree(scene: Dictionary) -> void:
+	var count: int = int(scene.get("count", 0))
+	var node_ids: PackedStringArray = scene.get("node_id", PackedStringArray())
+	var parent_indices: PackedInt32Array = scene.get("parent_index", PackedInt32Array())
+
+	var nodes: Array[Node3D] = []
+	nodes.resize(count)
 	_node_index.clear()
-	for item in nodes:
-		if item is Dictionary:
-			var node_id: String = str(item.get("node_id", ""))
-			if node_id.is_empty():
-				continue
-			_node_index[node_id] = _create_scene_node(item)
-
-	for item in nodes:
-		if item is Dictionary:
-			var node_id: String = str(item.get("node_id", ""))
-			var parent_id: String = str(item.get("parent_id", ""))
-			var node: Node3D = _node_index.get(node_id)
-			if node == null:
-				continue
-			var parent_node: Node3D = proxies_root
-			if not parent_id.is_empty() and _node_index.has(parent_id):
-				parent_node = _node_index[parent_id]
-			parent_node.add_child(node)
-			_expand_loaded_bounds_from_node(node)
-
-func _create_scene_node(data: Dictionary) -> Node3D:
-	var item_type: String = str(data.get("type", "scene_object"))
-	var is_fixture: bool = bool(data.get("is_fixture", false))
-	var is_axis: bool = bool(data.get("is_axis", false))
-	var is_emitter: bool = bool(data.get("is_emitter", false))
-	var node_name: String = str(data.get("name", item_type))
+	for i in count:
+		var node: Node3D = _create_scene_node(scene, i)
+		nodes[i] = node
+		_node_index[node_ids[i]] = node
+
+	for i in count:
+		var parent_node: Node3D = proxies_root
+		var parent_index: int = parent_indices[i]
+		if parent_index >= 0 and parent_index != i:
+			parent_node = nodes[parent_index]
+		parent_node.add_child(nodes[i])
+		_expand_loaded_bounds_from_node(nodes[i])
+
+func _create_scene_node(scene: Dictionary, i: int) -> Node3D:
+	var flags: int = scene["flags"][i]
+	var item_type: String = scene["type"][i]
+	var node_name: String = scene["name"][i]
+	var is_fixture: bool = (flags & PeravizLoader.NODE_FIXTURE) != 0
+	var has_basis: bool = (flags & PeravizLoader.NODE_HAS_BASIS) != 0
 
 	var root := Node3D.new()
 	root.name = "%s_%s" % [item_type, node_name]
-	var position: Vector3 = data.get("pos", Vector3.ZERO)
-	if bool(data.get("has_basis", false)):
-		var basis_x: Vector3 = data.get("basis_x", Vector3.RIGHT)
-		var basis_y: Vector3 = data.get("basis_y", Vector3.UP)
-		var basis_z: Vector3 = data.get("basis_z", Vector3.BACK)
+	var position: Vector3 = scene["position"][i]
+	var scale: Vector3 = scene["scale"][i]
+	var basis_x: Vector3 = scene["basis_x"][i]
+	var basis_y: Vector3 = scene["basis_y"][i]
+	var basis_z: Vector3 = scene["basis_z"][i]
+	if has_basis:
 		root.transform = Transform3D(Basis(basis_x, basis_y, basis_z), position)
 	else:
 		root.position = position
-		root.rotation_degrees = data.get("rot", Vector3.ZERO)
-		root.scale = data.get("scale", Vector3.ONE)
+		root.rotation_degrees = scene["rotation"][i]
+		root.scale = scale
 
-	if is_axis:
+	if (flags & PeravizLoader.NODE_AXIS) != 0:
 		var pivot := Node3D.new()
 		pivot.name = "AxisPivot"
 		root.add_child(pivot)
 
-	if is_emitter:
+	if (flags & PeravizLoader.NODE_EMITTER) != 0:
 		var emitter := Node3D.new()
 		emitter.name = "EmitterMarker"
 		root.add_child(emitter)
 
-	var visual_scale_hint: float = _extract_visual_scale_hint(data)
-	var model_node: Node3D = _build_visual_node(data, is_fixture, visual_scale_hint)
+	var visual_scale_hint: float = _extract_visual_scale_hint(has_basis, scale, basis_x, basis_y, basis_z)
+	var asset_index: int = scene["asset_index"][i]
+	var model_node: Node3D = _build_visual_node(asset_index, is_fixture, visual_scale_hint)
 	if model_node != null:
 		root.add_child(model_node)
 
 	return root
 
-func _build_visual_node(data: Dictionary, is_fixture: bool, visual_scale_hint: float) -> Node3D:
-	var asset_path: String = str(data.get("asset_path", ""))
-	if not asset_path.is_empty():
-		var loaded: Variant = _load_3d_asset(asset_path)
-		if loaded is Node3D:
-			return loaded
-		print("[Peraviz] Asset fallback for missing/invalid model: ", asset_path)
+func _build_visual_node(asset_index: int, is_fixture: bool, visual_scale_hint: float) -> Node3D:
+	var asset: Variant = _asset_cache.get(asset_index)
+	if asset is Mesh:
+		var mesh_instance := MeshInstance3D.new()
+		mesh_instance.mesh = asset
+		return mesh_instance
+	if asset is Node3D:
+		return asset.duplicate(DUPLICATE_USE_INSTANTIATION)
 
 	return _create_dummy_mesh(is_fixture, visual_scale_hint)
 
-func _extract_visual_scale_hint(data: Dictionary) -> float:
-	if bool(data.get("has_basis", false)):
-		var basis_x: Vector3 = data.get("basis_x", Vector3.RIGHT)
-		var basis_y: Vector3 = data.get("basis_y", Vector3.UP)
-		var basis_z: Vector3 = data.get("basis_z", Vector3.BACK)
+func _extract_visual_scale_hint(has_basis: bool, scale: Vector3, basis_x: Vector3, basis_y: Vector3, basis_z: Vector3) -> float:
+	if has_basis:
 		var average_basis_length: float = (basis_x.length() + basis_y.length() + basis_z.length()) / 3.0
 		return max(average_basis_length, 0.0001)
 
-	var scale: Vector3 = data.get("scale", Vector3.ONE)
 	var average_scale: float = (abs(scale.x) + abs(scale.y) + abs(scale.z)) / 3.0
 	return max(average_scale, 0.0001)
 
-func _load_3d_asset(asset_path: String) -> Variant:
-	if _asset_cache.has(asset_path):
-		return _asset_cache[asset_path]
-
+# Loads assets the native side does not parse. Returns a template node that
+# callers duplicate, or null.
+func _load_3d_asset(asset_path: String) -> Node3D:
 	var extension: String = asset_path.get_extension().to_lower()
 	var loaded_node: Node3D = null
 
@@ -132,26 +147,16 @@ func _load_3d_asset(asset_path: String) -> Variant:
 			var generated: Node = gltf.generate_scene(state)
 			if generated is Node3D:
 				loaded_node = generated
-	elif extension == "3ds":
-		loaded_node = _build_3ds_node(asset_path)
-	else:
+	elif extension != "3ds":
 		var resource: Resource = load(asset_path)
 		if resource is PackedScene:
 			var packed_instance: Node = resource.instantiate()
 			if packed_instance is Node3D:
 				loaded_node = packed_instance
 
-	_asset_cache[asset_path] = loaded_node
-	if loaded_node == null:
-		return null
-	return loaded_node.duplicate(DUPLICATE_USE_INSTANTIATION)
-
-
-func _build_3ds_node(asset_path: String) -> Node3D:
-	var mesh_data: Dictionary = _loader.load_3ds_mesh_data(asset_path)
-	if not bool(mesh_data.get("ok", false)):
-		return null
+	return loaded_node
 
+func _build_array_mesh(mesh_data: Dictionary) -> ArrayMesh:
 	var vertices: PackedVector3Array = mesh_data.get("vertices", PackedVector3Array())
 	var normals: PackedVector3Array = mesh_data.get("normals", PackedVector3Array())
 	var indices: PackedInt32Array = mesh_data.get("indices", PackedInt32Array())
@@ -166,10 +171,7 @@ func _build_3ds_node(asset_path: String) -> Node3D:
 
 	var array_mesh := ArrayMesh.new()
 	array_mesh.add_surface_from_arrays(Mesh.PRIMITIVE_TRIANGLES, arrays)
-
-	var mesh_instance := MeshInstance3D.new()
-	mesh_instance.mesh = array_mesh
-	return mesh_instance
+	return array_mesh
 
 func _create_dummy_mesh(is_fixture: bool, visual_scale_hint: float) -> Node3D:
 	var mesh_instance := MeshInstance3D.new()
@@ -196,6 +198,9 @@ func _clear_scene() -> void:
 	for child in proxies_root.get_children():
 		child.queue_free()
 	_node_index.clear()
+	for asset in _asset_cache.values():
+		if asset is Node:
+			asset.free()
 	_asset_cache.clear()
 	_has_loaded_bounds = false
 
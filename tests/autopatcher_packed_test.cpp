@@ -0,0 +1,137 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "autopatcher.h"
+#include "fixture.h"
+#include "mvrscene.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+static std::atomic<int> g_lookups{0};
+
+// Stub GDTF channel count lookup
+int GetGdtfModeChannelCount(const std::string &, const std::string &mode) {
+  ++g_lookups;
+  return mode.empty() ? 1 : std::stoi(mode);
+}
+
+static void AddFixture(MvrScene &scene, const std::string &uuid,
+                       const std::string &type, const std::string &mode,
+                       const std::string &hang, float x, float y) {
+  Fixture f;
+  f.uuid = uuid;
+  f.typeName = type;
+  f.gdtfSpec = type + ".gdtf";
+  f.gdtfMode = mode;
+  f.positionName = hang;
+  f.transform.o[0] = x;
+  f.transform.o[1] = y;
+  scene.fixtures[f.uuid] = f;
+}
+
+int main() {
+  using namespace AutoPatcher;
+
+  // Sequential patching of 300, 250, 200 and 250 channel groups needs three
+  // universes; packing the largest groups first needs two.
+  {
+    MvrScene scene;
+    AddFixture(scene, "a", "Spot", "300", "Front", 0.0f, 0.0f);
+    AddFixture(scene, "b", "Wash", "250", "Mid", 0.0f, 1.0f);
+    AddFixture(scene, "c", "Beam", "200", "Back", 0.0f, 2.0f);
+    AddFixture(scene, "d", "Par", "250", "Floor", 0.0f, 3.0f);
+
+    AutoPatchOptions options;
+    AutoPatchReport sequential = AutoPatch(scene, options);
+    assert(sequential.universes.size() == 3);
+
+    options.mode = AutoPatchMode::Packed;
+    AutoPatchReport packed = AutoPatch(scene, options);
+    assert(packed.patched == 4);
+    assert(packed.universes.size() == 2);
+    assert(scene.fixtures["a"].address == "1.1");
+    assert(scene.fixtures["b"].address == "2.1");
+    assert(scene.fixtures["d"].address == "2.251");
+    assert(scene.fixtures["c"].address == "1.301");
+    assert(packed.Utilization() > 0.97 && packed.Utilization() < 0.98);
+  }
+
+  // Locked fixtures keep their address and nothing is patched over them;
+  // position preferences pick the universe of a group.
+  {
+    MvrScene scene;
+    AddFixture(scene, "locked", "Spot", "20", "Front", 0.0f, 0.0f);
+    scene.fixtures["locked"].address = "1.1";
+    AddFixture(scene, "w1", "Wash", "10", "Front", 1.0f, 0.0f);
+    AddFixture(scene, "w2", "Wash", "10", "Front", 2.0f, 0.0f);
+    AddFixture(scene, "p1", "Par", "5", "Floor", 0.0f, 1.0f);
+
+    AutoPatchOptions options;
+    options.lockedUuids.insert("locked");
+    AutoPatchReport report = AutoPatch(scene, options);
+    assert(report.locked == 1);
+    assert(scene.fixtures["locked"].address == "1.1");
+    assert(scene.fixtures["w1"].address == "1.21");
+    assert(scene.fixtures["w2"].address == "1.31");
+
+    options.mode = AutoPatchMode::Packed;
+    options.positionUniverses["Floor"] = 5;
+    report = AutoPatch(scene, options);
+    assert(scene.fixtures["locked"].address == "1.1");
+    assert(scene.fixtures["w1"].address == "1.21");
+    assert(scene.fixtures["p1"].address == "5.1");
+    assert(report.universes.size() == 2);
+    assert(report.universes[0].lockedChannels == 20);
+    assert(report.universes[0].usedChannels == 40);
+  }
+
+  // A festival sized patch resolves each GDTF file and mode only once.
+  {
+    MvrScene scene;
+    const char *types[] = {"Spot", "Wash", "Beam", "Strobe"};
+    const char *modes[] = {"27", "14", "19", "4"};
+    for (int i = 0; i < 10000; ++i) {
+      const int t = i % 4;
+      AddFixture(scene, "f" + std::to_string(i), types[t], modes[t],
+                 "Truss " + std::to_string(i / 200), float(i % 200),
+                 float(i / 200));
+    }
+
+    g_lookups = 0;
+    AutoPatchOptions options;
+    options.mode = AutoPatchMode::Packed;
+    auto start = std::chrono::steady_clock::now();
+    AutoPatchReport report = AutoPatch(scene, options);
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    std::cout << "10000 fixtures packed in " << ms << " ms into "
+              << report.universes.size() << " universes\n";
+    assert(g_lookups == 4);
+    assert(report.patched == 10000);
+    assert(report.Utilization() > 0.85);
+
+    options.mode = AutoPatchMode::Sequential;
+    AutoPatchReport sequential = AutoPatch(scene, options);
+    assert(report.universes.size() <= sequential.universes.size());
+  }
+
+  return 0;
+}
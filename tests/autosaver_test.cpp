@@ -0,0 +1,169 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "autosaver.h"
+#include "workerpool.h"
+
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+// Stands in for the UI thread's event queue.
+class UiQueue {
+public:
+  void Post(std::function<void()> fn) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(std::move(fn));
+    cv.notify_all();
+  }
+
+  // Runs posted functions until `done` holds.
+  template <typename Pred> void PumpUntil(Pred done) {
+    while (!done()) {
+      std::function<void()> fn;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return !queue.empty(); });
+        fn = std::move(queue.front());
+        queue.pop_front();
+      }
+      fn();
+    }
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::function<void()>> queue;
+};
+
+} // namespace
+
+int main() {
+  using namespace std::chrono_literals;
+  WorkerPool pool(2);
+  UiQueue ui;
+  auto post = [&ui](std::function<void()> fn) { ui.Post(std::move(fn)); };
+
+  Autosaver saver(pool, post);
+  saver.SetInterval(60s);
+  int finished = 0;
+  saver.SetOnFinished([&](bool ok, size_t) {
+    assert(ok);
+    ++finished;
+  });
+
+  int prepared = 0;
+  int written = 0;
+  auto prepare = [&]() -> std::function<bool()> {
+    ++prepared;
+    return [&written]() {
+      ++written;
+      return true;
+    };
+  };
+
+  const auto t0 = Autosaver::Clock::time_point{} + 1h;
+
+  // Nothing to save while the project is clean.
+  assert(!saver.Tick(3, false, t0, prepare));
+  assert(saver.SavedRevision() == 3);
+  assert(prepared == 0);
+
+  // The first change is saved right away.
+  assert(saver.Tick(4, true, t0, prepare));
+  assert(saver.IsSaving());
+  assert(!saver.Tick(5, true, t0 + 90s, prepare));
+  ui.PumpUntil([&] { return finished == 1; });
+  assert(!saver.IsSaving());
+  assert(saver.SavedRevision() == 4);
+  assert(written == 1);
+
+  // Unchanged revisions are not saved again; new ones wait for the interval.
+  assert(!saver.Tick(4, true, t0 + 120s, prepare));
+  assert(!saver.Tick(5, true, t0 + 30s, prepare));
+  assert(saver.Tick(5, true, t0 + 60s, prepare));
+  ui.PumpUntil([&] { return finished == 2; });
+  assert(saver.SavedRevision() == 5);
+  assert(prepared == 2);
+
+  // A manual save makes the project clean again.
+  assert(!saver.Tick(9, false, t0 + 200s, prepare));
+  assert(saver.SavedRevision() == 9);
+
+  // A failed save is retried at the next interval.
+  bool fail = true;
+  int failures = 0;
+  saver.SetOnFinished([&](bool ok, size_t) { failures += ok ? 0 : 1; });
+  auto failing = [&]() -> std::function<bool()> {
+    return [&fail]() { return !fail; };
+  };
+  assert(saver.Tick(10, true, t0 + 300s, failing));
+  ui.PumpUntil([&] { return !saver.IsSaving(); });
+  assert(failures == 1);
+  assert(saver.SavedRevision() == 9);
+  assert(!saver.Tick(10, true, t0 + 310s, failing));
+  fail = false;
+  assert(saver.Tick(10, true, t0 + 360s, failing));
+  ui.PumpUntil([&] { return !saver.IsSaving(); });
+  assert(saver.SavedRevision() == 10);
+
+  // Turned off, nothing is saved.
+  saver.SetInterval(0s);
+  assert(!saver.Tick(11, true, t0 + 1h, prepare));
+
+  // The work's captures are released on the UI thread, and a saver
+  // destroyed mid-save drops the result.
+  struct Snapshot {
+    std::thread::id *releasedOn;
+    ~Snapshot() { *releasedOn = std::this_thread::get_id(); }
+  };
+  std::thread::id releasedOn;
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  bool called = false;
+  {
+    Autosaver shortLived(pool, post);
+    shortLived.SetOnFinished([&](bool, size_t) { called = true; });
+    auto snapshot = std::shared_ptr<Snapshot>(new Snapshot{&releasedOn});
+    assert(shortLived.Tick(1, true, t0, [&]() -> std::function<bool()> {
+      return [snapshot, opened]() {
+        opened.wait();
+        return true;
+      };
+    }));
+    snapshot.reset();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  gate.set_value();
+  ui.PumpUntil([&] { return releasedOn != std::thread::id{}; });
+  assert(releasedOn == std::this_thread::get_id());
+  assert(!called);
+
+  std::cout << "autosaver test "
+            << std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << " ms\n";
+  return 0;
+}
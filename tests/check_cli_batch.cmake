@@ -0,0 +1,70 @@
+# Runs perastage-cli over the print benchmark rig and checks what it wrote:
+# every export file must exist and not be empty, and the JSON report must
+# list each stage as successful.
+#
+# Expects CLI, INPUT, RIDER and OUT_DIR to be passed with -D.
+cmake_minimum_required(VERSION 3.21)
+
+foreach(_var CLI INPUT RIDER OUT_DIR)
+    if(NOT DEFINED ${_var})
+        message(FATAL_ERROR "${_var} is not set")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE "${OUT_DIR}")
+
+execute_process(
+    COMMAND "${CLI}"
+            --rider "${RIDER}"
+            --autopatch-packed
+            --position-universe LX1=3
+            --export-mvr "${OUT_DIR}/scene.mvr"
+            --export-csv "${OUT_DIR}"
+            --export-pdf "${OUT_DIR}/layouts.pdf"
+            --report "${OUT_DIR}/report.json"
+            "${INPUT}"
+    RESULT_VARIABLE _result)
+if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "perastage-cli exited with ${_result}")
+endif()
+
+foreach(_file scene.mvr fixtures.csv trusses.csv layouts.pdf report.json)
+    if(NOT EXISTS "${OUT_DIR}/${_file}")
+        message(FATAL_ERROR "${_file} was not written")
+    endif()
+    file(SIZE "${OUT_DIR}/${_file}" _size)
+    if(_size EQUAL 0)
+        message(FATAL_ERROR "${_file} is empty")
+    endif()
+endforeach()
+
+file(READ "${OUT_DIR}/report.json" _report)
+string(JSON _ok GET "${_report}" ok)
+if(NOT _ok)
+    message(FATAL_ERROR "report.json is not ok")
+endif()
+
+string(JSON _count LENGTH "${_report}" stages)
+set(_seen "")
+math(EXPR _last "${_count} - 1")
+foreach(_index RANGE ${_last})
+    string(JSON _stage GET "${_report}" stages ${_index} stage)
+    string(JSON _stage_ok GET "${_report}" stages ${_index} ok)
+    if(NOT _stage_ok)
+        message(FATAL_ERROR "stage ${_stage} failed")
+    endif()
+    list(APPEND _seen "${_stage}")
+endforeach()
+
+foreach(_stage load rider autopatch export-mvr export-csv export-pdf)
+    if(NOT _stage IN_LIST _seen)
+        message(FATAL_ERROR "stage ${_stage} missing from report.json")
+    endif()
+endforeach()
+
+# The fixture table has one row per fixture in the rig, after the header.
+file(STRINGS "${OUT_DIR}/fixtures.csv" _rows)
+list(LENGTH _rows _row_count)
+if(_row_count LESS 2)
+    message(FATAL_ERROR "fixtures.csv has no fixture rows")
+endif()
@@ -0,0 +1,102 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "dmxpatchindex.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static std::vector<std::string> Sorted(std::vector<std::string> v) {
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+int main() {
+  DmxPatchIndex index;
+  index.Set("a", {1, 1, 10});
+  index.Set("b", {1, 11, 10});
+  index.Set("c", {2, 1, 10});
+  assert(index.Size() == 3);
+  assert(!index.HasConflicts());
+  assert(index.ConflictingUuids().empty());
+
+  // Moving b onto the last channel of a creates a conflict.
+  index.Set("b", {1, 10, 10});
+  assert(index.HasConflicts());
+  assert(index.HasConflict("a") && index.HasConflict("b"));
+  assert(!index.HasConflict("c"));
+  assert(Sorted(index.ConflictingUuids()) ==
+         (std::vector<std::string>{"a", "b"}));
+  assert(Sorted(index.Overlapping(1, 5, 6)) ==
+         (std::vector<std::string>{"a", "b"}));
+  assert(index.Overlapping(1, 20, 5).empty());
+
+  // A mode change that shrinks a resolves it.
+  index.Set("a", {1, 1, 9});
+  assert(!index.HasConflicts());
+
+  // Removing one side of a conflict resolves it too.
+  index.Set("d", {2, 5, 1});
+  assert(Sorted(index.ConflictingUuids()) ==
+         (std::vector<std::string>{"c", "d"}));
+  index.Remove("c");
+  assert(!index.HasConflicts());
+  assert(!index.Contains("c"));
+
+  // Footprints are clipped at the end of the universe and invalid ones are
+  // dropped.
+  index.Set("e", {3, 500, 40});
+  assert(index.Overlapping(3, 512, 1) == std::vector<std::string>{"e"});
+  index.Set("e", {0, 1, 1});
+  assert(!index.Contains("e"));
+
+  // A full 64 universe patch: each edit moves one fixture onto another one,
+  // re-checks the whole patch and moves it back.
+  index.Clear();
+  std::vector<std::string> uuids;
+  std::vector<DmxPatchIndex::Footprint> footprints;
+  for (int u = 1; u <= 64; ++u) {
+    for (int ch = 1; ch + 15 <= 512; ch += 16) {
+      uuids.push_back("f" + std::to_string(u) + "." + std::to_string(ch));
+      footprints.push_back({u, ch, 16});
+      index.Set(uuids.back(), footprints.back());
+    }
+  }
+  assert(!index.HasConflicts());
+
+  const int iterations = 10000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    const size_t moved = static_cast<size_t>(i) % uuids.size();
+    const size_t target = (moved * 7 + 1) % uuids.size();
+    DmxPatchIndex::Footprint onto = footprints[target];
+    onto.channel += 8;
+    index.Set(uuids[moved], onto);
+    assert(index.ConflictingUuids().size() >= 2);
+    index.Set(uuids[moved], footprints[moved]);
+    assert(!index.HasConflicts());
+  }
+  const double us = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - start)
+                        .count() /
+                    iterations;
+  std::cout << "64 universe patch re-checked in " << us << " us per edit\n";
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gdtfthumbnail.h"
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Axis-aligned box of 200 mm around the origin.
+std::shared_ptr<const Mesh> MakeBox()
+{
+    auto mesh = std::make_shared<Mesh>();
+    const float h = 100.0f;
+    for (int i = 0; i < 8; ++i) {
+        mesh->vertices.push_back(i & 1 ? h : -h);
+        mesh->vertices.push_back(i & 2 ? h : -h);
+        mesh->vertices.push_back(i & 4 ? h : -h);
+    }
+    mesh->indices = {0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1,
+                     2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3};
+    return mesh;
+}
+
+uint8_t Alpha(const GdtfThumbnail& t, int x, int y)
+{
+    return t.rgba[(static_cast<size_t>(y) * t.width + x) * 4 + 3];
+}
+
+void WriteFile(const fs::path& path, const std::string& contents)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+} // namespace
+
+int main()
+{
+    GdtfObject box;
+    box.mesh = MakeBox();
+    box.transform = Matrix{};
+    std::vector<GdtfObject> objects = {box};
+
+    // The model fills the middle of the image and leaves the corners clear.
+    GdtfThumbnail thumb = RenderGdtfThumbnail(objects, 48);
+    assert(thumb.IsValid());
+    assert(thumb.width == 48 && thumb.height == 48);
+    assert(Alpha(thumb, 24, 24) == 255);
+    assert(thumb.rgba[(24 * 48 + 24) * 4] > 0);
+    assert(Alpha(thumb, 0, 0) == 0);
+    assert(Alpha(thumb, 47, 47) == 0);
+
+    // Nothing to draw, or an unusable size, gives no thumbnail.
+    assert(!RenderGdtfThumbnail({}, 48).IsValid());
+    assert(!RenderGdtfThumbnail(objects, 0).IsValid());
+
+    const fs::path dir = fs::temp_directory_path() / "perastage_thumbnail_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const fs::path gdtf = dir / "spot.gdtf";
+    WriteFile(gdtf, "first contents");
+
+    std::string key;
+    {
+        GdtfThumbnailCache cache(dir / "cache");
+        key = cache.KeyFor(gdtf.string());
+        assert(!key.empty());
+        assert(cache.KeyFor(gdtf.string()) == key);
+        GdtfThumbnail found;
+        assert(!cache.Find(key, found));
+        cache.Store(key, thumb);
+        assert(cache.Find(key, found));
+        assert(found.rgba == thumb.rgba);
+    }
+
+    // A new cache, as after a restart, reads the thumbnail from disk, and a
+    // copy of the file under another name shares it.
+    {
+        GdtfThumbnailCache cache(dir / "cache");
+        const fs::path copy = dir / "renamed.gdtf";
+        fs::copy_file(gdtf, copy);
+        assert(cache.KeyFor(copy.string()) == key);
+        GdtfThumbnail found;
+        assert(cache.Find(key, found));
+        assert(found.width == 48 && found.rgba == thumb.rgba);
+
+        // Changed contents give a new key.
+        WriteFile(gdtf, "second, longer contents");
+        const std::string changed = cache.KeyFor(gdtf.string());
+        assert(!changed.empty() && changed != key);
+        assert(!cache.Find(changed, found));
+        assert(cache.KeyFor((dir / "missing.gdtf").string()).empty());
+    }
+
+    // A damaged file is ignored.
+    {
+        WriteFile(dir / "cache" / (key + ".thumb"), "PSTH");
+        GdtfThumbnailCache cache(dir / "cache");
+        GdtfThumbnail found;
+        assert(!cache.Find(key, found));
+    }
+
+    // A heavy model: 20 boxes of 12 triangles each, side by side.
+    std::vector<GdtfObject> rig;
+    for (int i = 0; i < 20; ++i) {
+        GdtfObject part = box;
+        part.transform.o[0] = i * 0.25f;
+        rig.push_back(part);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 50; ++i)
+        assert(RenderGdtfThumbnail(rig, 64).IsValid());
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count() /
+                      50;
+    std::cout << "64 px thumbnail rendered in " << ms << " ms\n";
+
+    fs::remove_all(dir);
+    return 0;
+}
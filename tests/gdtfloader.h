@@ -16,11 +16,12 @@
  * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
  */
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include "mesh.h"
 #include "types.h"
-struct GdtfObject { Mesh mesh; Matrix transform; };
+struct GdtfObject { std::shared_ptr<const Mesh> mesh; Matrix transform; bool isLens = false; };
 bool LoadGdtf(const std::string&, std::vector<GdtfObject>&, std::string* outError = nullptr);
 int GetGdtfModeChannelCount(const std::string&, const std::string&);
 std::string GetGdtfFixtureName(const std::string& gdtfPath);
@@ -29,7 +29,7 @@ class wxZipStreamLink;
 #include <wx/zipstrm.h>
 
 namespace {
-std::string MakeGdtf(const std::string& primitiveType)
+std::string MakeGdtf(const std::string& primitiveType, int geometryCount = 1)
 {
     wxFileName tempName(wxFileName::CreateTempFileName("gdtf_primitive_"));
     const std::string outPath = tempName.GetFullPath().ToStdString() + ".gdtf";
@@ -48,8 +48,10 @@ std::string MakeGdtf(const std::string& primitiveType)
         "<Model Name=\"Body\" File=\"\" PrimitiveType=\"" + primitiveType + "\" "
         "Length=\"1.0\" Width=\"1.0\" Height=\"1.0\"/>"
         "</Models>"
-        "<Geometries>"
-        "<Geometry Name=\"Root\" Model=\"Body\"/>"
+        "<Geometries>";
+    for (int i = 0; i < geometryCount; ++i)
+        xml += "<Geometry Name=\"Cell" + std::to_string(i) + "\" Model=\"Body\"/>";
+    xml +=
         "</Geometries>"
         "</FixtureType>"
         "</GDTF>";
@@ -86,5 +88,18 @@ int main()
         std::filesystem::remove(gdtfPath, ec);
     }
 
+    {
+        // Parts using the same model share one mesh.
+        const std::string gdtfPath = MakeGdtf("Cube", 100);
+        std::vector<GdtfObject> objects;
+        const bool ok = LoadGdtf(gdtfPath, objects);
+        assert(ok);
+        assert(objects.size() == 100);
+        for (const auto& obj : objects)
+            assert(obj.mesh && obj.mesh == objects.front().mesh);
+        std::error_code ec;
+        std::filesystem::remove(gdtfPath, ec);
+    }
+
     return 0;
 }
@@ -15,12 +15,13 @@
  * You should have received a copy of the GNU General Public License
  * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
  */
+#include <memory>
 #include <string>
 #include <vector>
 #include "types.h"
 #include "mesh.h"
 
-struct GdtfObject { Mesh mesh; Matrix transform; };
+struct GdtfObject { std::shared_ptr<const Mesh> mesh; Matrix transform; bool isLens = false; };
 
 bool LoadGdtf(const std::string&, std::vector<GdtfObject>&, std::string*) {
     return false;
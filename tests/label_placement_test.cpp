@@ -0,0 +1,121 @@
+#include "label_placement.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Engine = LabelPlacementEngine;
+
+bool BoxesOverlap(const Engine::Request &a, const Engine::Placement &pa,
+                  const Engine::Request &b, const Engine::Placement &pb) {
+  const float ax = a.anchorX + pa.offsetX;
+  const float ay = a.anchorY + pa.offsetY;
+  const float bx = b.anchorX + pb.offsetX;
+  const float by = b.anchorY + pb.offsetY;
+  return std::abs(ax - bx) * 2.0f < a.width + b.width &&
+         std::abs(ay - by) * 2.0f < a.height + b.height;
+}
+
+void CheckNoOverlaps(const std::vector<Engine::Request> &requests,
+                     const std::vector<Engine::Placement> &placements) {
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (!placements[i].placed)
+      continue;
+    for (size_t j = i + 1; j < requests.size(); ++j) {
+      if (placements[j].placed)
+        assert(!BoxesOverlap(requests[i], placements[i], requests[j],
+                             placements[j]));
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  Engine engine;
+  Engine::Options options;
+  options.viewportWidth = 800;
+  options.viewportHeight = 600;
+
+  // A lone label stays centred on its anchor.
+  std::vector<Engine::Placement> placements;
+  std::vector<Engine::Request> requests = {{400.0f, 300.0f, 60.0f, 20.0f, 0.0f}};
+  engine.Place(requests, options, placements);
+  assert(placements.size() == 1);
+  assert(placements[0].placed);
+  assert(placements[0].offsetX == 0.0f && placements[0].offsetY == 0.0f);
+
+  // Two labels on the same anchor: the higher priority keeps the centre and
+  // the other moves next to it.
+  requests = {{400.0f, 300.0f, 60.0f, 20.0f, 1.0f},
+              {400.0f, 300.0f, 60.0f, 20.0f, 5.0f}};
+  engine.Place(requests, options, placements);
+  assert(placements[0].placed && placements[1].placed);
+  assert(placements[1].offsetX == 0.0f && placements[1].offsetY == 0.0f);
+  assert(placements[0].offsetX != 0.0f || placements[0].offsetY != 0.0f);
+  CheckNoOverlaps(requests, placements);
+
+  // Labels that cannot fit anywhere are dropped, lowest priority first.
+  requests.assign(12, {400.0f, 300.0f, 60.0f, 20.0f, 0.0f});
+  requests[7].priority = 10.0f;
+  engine.Place(requests, options, placements);
+  assert(placements[7].placed && placements[7].offsetX == 0.0f &&
+         placements[7].offsetY == 0.0f);
+  size_t placedCount = 0;
+  for (const auto &p : placements)
+    placedCount += p.placed ? 1 : 0;
+  assert(placedCount == 9);
+  CheckNoOverlaps(requests, placements);
+
+  // maxPlaced caps the number of labels.
+  options.maxPlaced = 3;
+  engine.Place(requests, options, placements);
+  placedCount = 0;
+  for (const auto &p : placements)
+    placedCount += p.placed ? 1 : 0;
+  assert(placedCount == 3);
+  assert(placements[7].placed);
+  options.maxPlaced = 0;
+
+  // Labels entirely off screen are not placed.
+  requests = {{-500.0f, 300.0f, 60.0f, 20.0f, 0.0f}};
+  engine.Place(requests, options, placements);
+  assert(!placements[0].placed);
+
+  // A dense plot: no overlaps, and the same input gives the same layout.
+  options.viewportWidth = 1920;
+  options.viewportHeight = 1080;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> xs(0.0f, 1920.0f);
+  std::uniform_real_distribution<float> ys(0.0f, 1080.0f);
+  std::uniform_real_distribution<float> ws(30.0f, 90.0f);
+  std::uniform_real_distribution<float> prio(0.0f, 100.0f);
+  requests.clear();
+  for (int i = 0; i < 5000; ++i)
+    requests.push_back({xs(rng), ys(rng), ws(rng), 28.0f, prio(rng)});
+
+  const int iterations = 20;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    engine.Place(requests, options, placements);
+  const double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count() /
+                    iterations;
+  std::cout << "5000 labels placed in " << ms << " ms\n";
+
+  CheckNoOverlaps(requests, placements);
+  std::vector<Engine::Placement> again;
+  engine.Place(requests, options, again);
+  for (size_t i = 0; i < placements.size(); ++i) {
+    assert(again[i].placed == placements[i].placed);
+    assert(again[i].offsetX == placements[i].offsetX);
+    assert(again[i].offsetY == placements[i].offsetY);
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "layouttilecache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+int main() {
+  // Two levels per doubling, and a level is never below the zoom it serves.
+  assert(LayoutTileCache::LevelForZoom(1.0) == 0);
+  assert(LayoutTileCache::LevelForZoom(2.0) == 2);
+  assert(LayoutTileCache::LevelForZoom(0.5) == -2);
+  assert(LayoutTileCache::LevelForZoom(1.2) == 1);
+  assert(LayoutTileCache::LevelForZoom(0.0) == 0);
+  for (double zoom = 0.1; zoom <= 10.0; zoom *= 1.1) {
+    const int level = LayoutTileCache::LevelForZoom(zoom);
+    assert(LayoutTileCache::ZoomForLevel(level) >= zoom - 1e-9);
+    assert(LayoutTileCache::ZoomForLevel(level - 1) < zoom);
+  }
+  assert(std::abs(LayoutTileCache::ZoomForLevel(1) - std::sqrt(2.0)) < 1e-12);
+
+  // A full tile costs 1 MiB; the budget below holds three of them.
+  constexpr size_t kTileBytes = LayoutTileCache::kTileSize *
+                                LayoutTileCache::kTileSize * 4;
+  std::vector<unsigned int> released;
+  LayoutTileCache cache(3 * kTileBytes, [&](unsigned int texture) {
+    released.push_back(texture);
+  });
+  const LayoutTileCache::Tile full{0, LayoutTileCache::kTileSize,
+                                   LayoutTileCache::kTileSize};
+  auto tile = [&](unsigned int texture) {
+    LayoutTileCache::Tile t = full;
+    t.texture = texture;
+    return t;
+  };
+
+  cache.BeginFrame();
+  cache.Insert({1, 0, 0, 0}, tile(10));
+  cache.Insert({1, 0, 1, 0}, tile(11));
+  cache.Insert({1, 2, 0, 0}, tile(12));
+  assert(cache.Size() == 3);
+  assert(cache.UsedBytes() == 3 * kTileBytes);
+  assert((cache.Levels(1) == std::vector<int>{0, 2}));
+  assert(cache.HasTiles(1) && !cache.HasTiles(2));
+
+  // Over budget, the least recently used tile of an earlier frame goes.
+  cache.BeginFrame();
+  assert(cache.Find({1, 0, 0, 0})->texture == 10);
+  cache.Insert({1, 0, 0, 1}, tile(13));
+  assert(released == std::vector<unsigned int>{11});
+  assert(!cache.Find({1, 0, 1, 0}));
+  assert(cache.UsedBytes() == 3 * kTileBytes);
+
+  // Tiles used in the current frame stay even when that exceeds the budget.
+  cache.BeginFrame();
+  cache.Find({1, 0, 0, 0});
+  cache.Find({1, 2, 0, 0});
+  cache.Find({1, 0, 0, 1});
+  cache.Insert({2, -1, 0, 0}, tile(14));
+  assert(cache.Size() == 4);
+  assert(released.size() == 1);
+  // They become evictable on the next frame.
+  cache.BeginFrame();
+  cache.Insert({2, -1, 1, 0}, tile(15));
+  assert(cache.Size() == 3);
+  assert(released.size() == 3);
+
+  // Replacing a tile releases the old texture; edge tiles cost their size.
+  cache.Insert({2, -1, 1, 0}, {16, 100, 50});
+  assert(released.back() == 15);
+  assert(cache.Find({2, -1, 1, 0})->texture == 16);
+
+  // Removing a view releases all of its levels.
+  cache.RemoveView(2);
+  assert(!cache.HasTiles(2));
+  assert(cache.Levels(2).empty());
+  assert(std::find(released.begin(), released.end(), 14) != released.end());
+  assert(std::find(released.begin(), released.end(), 16) != released.end());
+
+  cache.Clear();
+  assert(cache.Size() == 0);
+  assert(cache.UsedBytes() == 0);
+  assert(!cache.HasTiles(1));
+  return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "pdf_content_buffer.h"
+#include "pdf_content_renderer.h"
+#include "pdf_objects.h"
+#include "pdf_writer.h"
+
+namespace {
+using namespace layout_pdf_internal;
+
+void Record(CommandBuffer &buffer, CanvasCommand command,
+            const std::string &source, bool hasStroke, bool hasFill) {
+  buffer.commands.push_back(std::move(command));
+  buffer.sources.push_back(source);
+  buffer.metadata.push_back({hasStroke, hasFill});
+}
+
+// Builds a buffer shaped like a top-view capture of a large rig: truss runs
+// drawn as outlined rectangles with lacing, one footprint plus symbol
+// instance per fixture and a two-line label for each of them.
+CommandBuffer BuildLargeRigBuffer(size_t fixtureCount) {
+  CommandBuffer buffer;
+  const size_t trussCount = std::max<size_t>(1, fixtureCount / 8);
+  CanvasStroke trussStroke{{0.1f, 0.1f, 0.1f, 1.0f}, 0.02f};
+  CanvasFill trussFill{{0.85f, 0.85f, 0.85f, 1.0f}};
+  for (size_t t = 0; t < trussCount; ++t) {
+    const std::string source = "truss:" + std::to_string(t);
+    const float x = static_cast<float>(t % 12) * 2.0f;
+    const float y = static_cast<float>(t / 12) * 1.5f;
+    RectangleCommand rect{x, y, 2.0f, 0.3f, trussStroke, trussFill, true};
+    Record(buffer, rect, source, true, true);
+    for (int i = 0; i < 4; ++i) {
+      const float lx = x + static_cast<float>(i) * 0.5f;
+      Record(buffer, LineCommand{lx, y, lx + 0.5f, y + 0.3f, trussStroke},
+             source, true, false);
+    }
+  }
+
+  CanvasStroke fixtureStroke{{0.0f, 0.0f, 0.0f, 1.0f}, 0.01f};
+  CanvasFill fixtureFill{{0.95f, 0.6f, 0.2f, 1.0f}};
+  CanvasTextStyle labelStyle;
+  labelStyle.fontFamily = "sans";
+  labelStyle.fontSize = 0.18f;
+  labelStyle.hAlign = CanvasTextStyle::HorizontalAlign::Center;
+  for (size_t f = 0; f < fixtureCount; ++f) {
+    const std::string source = "fixture:" + std::to_string(f);
+    const float x = static_cast<float>(f % 96) * 0.25f + 0.123f;
+    const float y = static_cast<float>(f / 96) * 1.5f + 0.457f;
+    Record(buffer, SaveCommand{}, source, false, false);
+    Record(buffer, TransformCommand{{1.0f, 0.0f, 0.0f}}, source, false, false);
+    PolygonCommand footprint;
+    footprint.points = {x - 0.1f, y - 0.1f, x + 0.1f, y - 0.1f,
+                        x + 0.12f, y + 0.05f, x,       y + 0.15f,
+                        x - 0.12f, y + 0.05f};
+    footprint.stroke = fixtureStroke;
+    footprint.fill = fixtureFill;
+    footprint.hasFill = true;
+    Record(buffer, footprint, source, true, true);
+    Record(buffer, CircleCommand{x, y, 0.06f, fixtureStroke, fixtureFill, true},
+           source, true, true);
+    SymbolInstanceCommand instance;
+    instance.symbolId = static_cast<uint32_t>(f % 24);
+    instance.transform.tx = x;
+    instance.transform.ty = y;
+    Record(buffer, instance, source, false, false);
+    Record(buffer,
+           TextCommand{x, y - 0.2f, std::to_string(101 + f) + "\nU1.", labelStyle},
+           source, false, false);
+    Record(buffer, RestoreCommand{}, source, false, false);
+  }
+  return buffer;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t fixtureCount =
+      argc >= 2 ? static_cast<size_t>(std::max(1, std::atoi(argv[1]))) : 5000;
+  const int iterations = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 5;
+
+  const CommandBuffer buffer = BuildLargeRigBuffer(fixtureCount);
+  std::unordered_map<uint32_t, std::string> symbolNames;
+  for (uint32_t id = 0; id < 24; ++id)
+    symbolNames.emplace(id, "S" + std::to_string(id));
+
+  Mapping mapping{};
+  mapping.scale = 28.35;
+  mapping.offsetX = 36.0;
+  mapping.offsetY = 36.0;
+  mapping.flipY = false;
+  RenderOptions options{};
+  options.symbolIdNames = &symbolNames;
+  options.strokeScale = 0.75 / mapping.scale;
+  const FloatFormatter formatter(3);
+
+  size_t streamBytes = 0;
+  double bestEncodeMs = 0.0;
+  double bestDeflateMs = 0.0;
+  double bestStreamMs = 0.0;
+  size_t compressedBytes = 0;
+  const std::filesystem::path streamPath =
+      std::filesystem::temp_directory_path() / "perastage_pdf_stream_benchmark.pdf";
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    PdfContentBuffer content;
+    RenderCommandsToStream(content, buffer.commands, buffer.metadata,
+                           buffer.sources, mapping, formatter, options);
+    const auto encoded = std::chrono::steady_clock::now();
+    std::string compressed;
+    std::string error;
+    if (!PdfDeflater::Compress(content.View(), compressed, error)) {
+      std::cerr << "Deflate failed: " << error << std::endl;
+      return 1;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // Same stream deflated chunk by chunk straight into a file, as the
+    // exporters do.
+    PdfWriter writer;
+    if (!writer.Open(streamPath, error)) {
+      std::cerr << error << std::endl;
+      return 1;
+    }
+    writer.WriteStream({}, content.View(), true);
+    const size_t catalogId = writer.WriteObject("<< /Type /Catalog >>");
+    if (!writer.Finish(catalogId, error)) {
+      std::cerr << "Streamed write failed: " << error << std::endl;
+      return 1;
+    }
+    const auto streamed = std::chrono::steady_clock::now();
+    std::filesystem::remove(streamPath);
+
+    const double encodeMs =
+        std::chrono::duration<double, std::milli>(encoded - start).count();
+    const double deflateMs =
+        std::chrono::duration<double, std::milli>(end - encoded).count();
+    if (i == 0 || encodeMs < bestEncodeMs)
+      bestEncodeMs = encodeMs;
+    const double streamMs =
+        std::chrono::duration<double, std::milli>(streamed - end).count();
+    if (i == 0 || deflateMs < bestDeflateMs)
+      bestDeflateMs = deflateMs;
+    if (i == 0 || streamMs < bestStreamMs)
+      bestStreamMs = streamMs;
+    streamBytes = content.Size();
+    compressedBytes = compressed.size();
+  }
+
+  if (streamBytes == 0) {
+    std::cerr << "Content stream is empty" << std::endl;
+    return 1;
+  }
+
+  auto throughput = [](size_t bytes, double ms) {
+    return ms > 0.0 ? (static_cast<double>(bytes) / (1024.0 * 1024.0)) /
+                          (ms / 1000.0)
+                    : 0.0;
+  };
+
+  std::cout << "Fixtures: " << fixtureCount << '\n'
+            << "Commands: " << buffer.commands.size() << '\n'
+            << "Iterations: " << iterations << '\n'
+            << "Content stream bytes: " << streamBytes << '\n'
+            << "Compressed bytes: " << compressedBytes << '\n'
+            << "Best encode time (ms): " << bestEncodeMs << '\n'
+            << "Encode throughput (MB/s): "
+            << throughput(streamBytes, bestEncodeMs) << '\n'
+            << "Best deflate time (ms): " << bestDeflateMs << '\n'
+            << "Deflate throughput (MB/s): "
+            << throughput(streamBytes, bestDeflateMs) << '\n'
+            << "Best streamed write time (ms): " << bestStreamMs << '\n'
+            << "Streamed write throughput (MB/s): "
+            << throughput(streamBytes, bestStreamMs) << std::endl;
+  return 0;
+}
@@ -52,6 +52,25 @@ int main(int argc, char **argv) {
                 << "Actual:\n" << actual << std::endl;
       return 1;
     }
+
+    // Pages delivered one by one must join to the same text, in order.
+    std::string paged;
+    size_t nextPage = 0;
+    bool ordered = true;
+    bool ok = ExtractPdfTextPages(
+        pdf, [&](size_t pageIndex, size_t, std::string text) {
+          if (pageIndex != nextPage++)
+            ordered = false;
+          if (pageIndex > 0)
+            paged += '\n';
+          paged += text;
+        });
+    while (!paged.empty() && (paged.back() == '\n' || paged.back() == '\f'))
+      paged.pop_back();
+    if (!ok || !ordered || paged != actual) {
+      std::cerr << "Paged extraction differs for " << pdf << std::endl;
+      return 1;
+    }
   }
   return 0;
 }
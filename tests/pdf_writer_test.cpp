@@ -2,10 +2,13 @@
 #include "pdf_objects.h"
 #include "pdf_writer.h"
 
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <string>
+
+#include <zlib.h>
 
 int main() {
   const std::filesystem::path outPath =
@@ -32,6 +35,124 @@ int main() {
 
   std::filesystem::remove(outPath);
 
+  // Streaming writer: reserved ids are filled in out of order, compressed
+  // streams carry an indirect /Length and every xref entry must point at the
+  // object it names.
+  {
+    std::string content;
+    for (int i = 0; i < 20000; ++i)
+      content += std::to_string(i) + " 0 m " + std::to_string(i) + " 10 l S\n";
+
+    size_t contentId = 0;
+    size_t pageId = 0;
+    {
+      PdfWriter writer;
+      if (!writer.Open(outPath, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+      }
+      contentId = writer.WriteStream({}, content, true);
+      pageId = writer.ReserveObject();
+      const size_t pagesId = writer.ReserveObject();
+      const size_t catalogId = writer.WriteObject(
+          "<< /Type /Catalog /Pages " + std::to_string(pagesId) + " 0 R >>");
+      writer.WriteObject(pagesId, "<< /Type /Pages /Kids [" +
+                                      std::to_string(pageId) +
+                                      " 0 R] /Count 1 >>");
+      writer.WriteObject(pageId, "<< /Type /Page /Parent " +
+                                     std::to_string(pagesId) +
+                                     " 0 R /MediaBox [0 0 100 100] /Contents " +
+                                     std::to_string(contentId) + " 0 R >>");
+      if (!writer.Finish(catalogId, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+      }
+    }
+
+    std::ifstream streamed(outPath, std::ios::binary);
+    std::string pdf((std::istreambuf_iterator<char>(streamed)),
+                    std::istreambuf_iterator<char>());
+    streamed.close();
+    std::filesystem::remove(outPath);
+
+    const size_t startxref = pdf.rfind("startxref\n");
+    if (startxref == std::string::npos) {
+      std::cerr << "Missing startxref" << std::endl;
+      return 1;
+    }
+    const size_t xrefPos =
+        std::strtoull(pdf.c_str() + startxref + 10, nullptr, 10);
+    if (xrefPos >= pdf.size() || pdf.compare(xrefPos, 5, "xref\n") != 0) {
+      std::cerr << "startxref does not point at the xref table" << std::endl;
+      return 1;
+    }
+    const size_t countPos = pdf.find("0 ", xrefPos + 5) + 2;
+    const size_t objectCount = std::strtoull(pdf.c_str() + countPos, nullptr, 10);
+    const size_t firstEntry = pdf.find('\n', countPos) + 1 + 20;
+    for (size_t id = 1; id < objectCount; ++id) {
+      const size_t offset = std::strtoull(
+          pdf.c_str() + firstEntry + (id - 1) * 20, nullptr, 10);
+      const std::string header = std::to_string(id) + " 0 obj\n";
+      if (pdf.compare(offset, header.size(), header) != 0) {
+        std::cerr << "xref entry " << id << " is misplaced" << std::endl;
+        return 1;
+      }
+    }
+
+    const std::string contentHeader = std::to_string(contentId) + " 0 obj\n";
+    const size_t contentPos = pdf.find(contentHeader);
+    const size_t lengthRef = pdf.find("/Length ", contentPos) + 8;
+    const size_t lengthId = std::strtoull(pdf.c_str() + lengthRef, nullptr, 10);
+    const std::string lengthHeader = std::to_string(lengthId) + " 0 obj\n";
+    const size_t lengthPos = pdf.find(lengthHeader);
+    if (contentPos == std::string::npos || lengthPos == std::string::npos) {
+      std::cerr << "Missing content stream or its length object" << std::endl;
+      return 1;
+    }
+    const size_t compressedSize = std::strtoull(
+        pdf.c_str() + lengthPos + lengthHeader.size(), nullptr, 10);
+    const size_t dataPos = pdf.find("stream\n", contentPos) + 7;
+    std::string inflated(content.size(), '\0');
+    uLongf inflatedSize = inflated.size();
+    if (uncompress(reinterpret_cast<Bytef *>(inflated.data()), &inflatedSize,
+                   reinterpret_cast<const Bytef *>(pdf.data() + dataPos),
+                   compressedSize) != Z_OK ||
+        inflatedSize != content.size() || inflated != content ||
+        pdf.compare(dataPos + compressedSize, 10, "\nendstream") != 0) {
+      std::cerr << "Streamed content does not round-trip" << std::endl;
+      return 1;
+    }
+  }
+
+  // A writer that is never finished must leave an existing file as it was
+  // and must not leave its partial file behind.
+  {
+    std::filesystem::path partPath = outPath;
+    partPath += ".part";
+    std::ofstream(outPath, std::ios::binary) << "previous export";
+    {
+      PdfWriter writer;
+      if (!writer.Open(outPath, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+      }
+      writer.WriteObject("<< /Type /Catalog >>");
+    }
+    std::ifstream previous(outPath, std::ios::binary);
+    std::string kept((std::istreambuf_iterator<char>(previous)),
+                     std::istreambuf_iterator<char>());
+    if (kept != "previous export") {
+      std::cerr << "Abandoned writer changed the existing file" << std::endl;
+      return 1;
+    }
+    if (std::filesystem::exists(partPath)) {
+      std::cerr << "Abandoned writer left a partial file" << std::endl;
+      return 1;
+    }
+    previous.close();
+    std::filesystem::remove(outPath);
+  }
+
   // Non-regression check: draw command serialization remains stable after
   // splitting layout_pdf_exporter internals into dedicated modules.
   {
@@ -52,17 +173,32 @@ int main() {
     line.stroke.width = 1.0f;
     line.stroke.color = {0.0f, 0.0f, 0.0f};
 
-    std::ostringstream content;
+    layout_pdf_internal::PdfContentBuffer content;
     layout_pdf_internal::EmitCommandStroke(content, cache, fmt, mapping,
                                            transform, CanvasCommand{line},
                                            options);
     const std::string expected =
         "1 j\n1 J\n0.000 0.000 0.000 RG\n1.000 w\n"
         "0.000 0.000 m\n10.000 10.000 l\nS\n";
-    if (content.str() != expected) {
+    if (content.View() != expected) {
       std::cerr << "Unexpected serialized draw command output" << std::endl;
       return 1;
     }
   }
+
+  // Locale-independent number formatting must match the previous
+  // std::fixed/setprecision output byte for byte.
+  {
+    layout_pdf_internal::FloatFormatter fmt(3);
+    layout_pdf_internal::PdfContentBuffer out;
+    out << fmt.Format(-0.0004) << ' ' << fmt.Format(1234.5675) << ' '
+        << fmt.Format(0.1) << ' ' << fmt.Format(-12.25) << ' '
+        << static_cast<size_t>(42) << ' ' << -7;
+    const std::string expected = "-0.000 1234.568 0.100 -12.250 42 -7";
+    if (out.View() != expected) {
+      std::cerr << "Unexpected number formatting: " << out.View() << std::endl;
+      return 1;
+    }
+  }
   return 0;
 }
@@ -1,2 +1,6 @@
-#include <string>
+#include "pdftext.h"
 std::string ExtractPdfText(const std::string &) { return {}; }
+bool ExtractPdfTextPages(const std::string &, const PdfPageTextCallback &,
+                         const std::atomic<bool> *) {
+  return false;
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+// Measures what the render loop pays to read its preferences each frame:
+// the old name lookup that copied and re-parsed the stored string, the
+// current by-name lookup, pre-resolved handles and a per-frame snapshot.
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "configservices.h"
+
+namespace {
+
+// Preferences the 3D and 2D viewers read while drawing a frame.
+const std::vector<std::string> kFrameKeys = {
+    "render_culling_enabled",       "render_culling_min_pixels_3d",
+    "render_culling_min_pixels_2d", "label_optimizations_enabled",
+    "label_show_name",              "label_show_id",
+    "label_show_dmx",               "label_show_name_top",
+    "label_show_id_top",            "label_show_dmx_top",
+    "label_font_size_name",         "label_font_size_id",
+    "label_font_size_dmx",          "label_offset_distance_top",
+    "label_offset_angle_top",       "label_max_fixtures",
+    "label_max_trusses",            "label_max_objects",
+    "viewer3d_fast_interaction_mode", "viewer3d_adaptive_line_profile",
+    "viewer3d_skip_outlines_when_moving",
+    "viewer3d_skip_capture_when_moving", "view2d_dark_mode",
+    "grid_show",                    "grid_style",
+    "grid_color_r",                 "grid_color_g",
+    "grid_color_b",                 "grid_draw_above"};
+
+// What GetFloat did before handles existed: copy the stored string out of
+// the map and parse it again on every call.
+float LegacyGetFloat(const UserPreferencesStore &store,
+                     const std::string &name) {
+  auto value = store.GetValue(name);
+  float parsed = 0.0f;
+  if (value) {
+    auto result =
+        std::from_chars(value->data(), value->data() + value->size(), parsed);
+    if (result.ec == std::errc{})
+      return parsed;
+  }
+  return 0.0f;
+}
+
+template <typename Fn> double BestFrameNs(int frames, int rounds, Fn &&frame) {
+  double best = 0.0;
+  for (int r = 0; r < rounds; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i)
+      frame();
+    const auto end = std::chrono::steady_clock::now();
+    const double ns =
+        std::chrono::duration<double, std::nano>(end - start).count() / frames;
+    if (r == 0 || ns < best)
+      best = ns;
+  }
+  return best;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int frames = argc >= 2 ? std::max(1, std::atoi(argv[1])) : 100000;
+  const int rounds = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 5;
+
+  UserPreferencesStore store;
+  // Same order of magnitude as the variables ConfigManager registers.
+  for (int i = 0; i < 50; ++i)
+    store.RegisterVariable("other_setting_" + std::to_string(i), "float", 0.0f,
+                           0.0f, 100.0f);
+  for (size_t i = 0; i < kFrameKeys.size(); ++i)
+    store.RegisterVariable(kFrameKeys[i], "float", static_cast<float>(i) * 0.5f,
+                           0.0f, 1000.0f);
+  store.ApplyDefaults();
+
+  std::vector<UserPreferencesStore::FloatHandle> handles;
+  for (const auto &key : kFrameKeys) {
+    handles.push_back(store.ResolveFloat(key));
+    assert(handles.back().IsValid());
+  }
+
+  // All read paths have to agree before their timings mean anything.
+  auto snapshot = store.GetFloatSnapshot();
+  for (size_t i = 0; i < kFrameKeys.size(); ++i) {
+    const float expected = LegacyGetFloat(store, kFrameKeys[i]);
+    if (store.GetFloat(kFrameKeys[i]) != expected ||
+        store.GetFloat(handles[i]) != expected ||
+        snapshot->Get(handles[i]) != expected) {
+      std::cerr << "Read paths disagree for " << kFrameKeys[i] << std::endl;
+      return 1;
+    }
+  }
+  const uint64_t revision = store.GetFloatRevision();
+  store.SetFloat("grid_style", 2.0f);
+  if (store.GetFloatRevision() == revision ||
+      store.GetFloatSnapshot()->Get(store.ResolveFloat("grid_style")) != 2.0f ||
+      snapshot->Get(store.ResolveFloat("grid_style")) == 2.0f) {
+    std::cerr << "Snapshot was not republished on change" << std::endl;
+    return 1;
+  }
+
+  volatile float sink = 0.0f;
+  const double legacyNs = BestFrameNs(frames, rounds, [&] {
+    float sum = 0.0f;
+    for (const auto &key : kFrameKeys)
+      sum += LegacyGetFloat(store, key);
+    sink = sum;
+  });
+  const double byNameNs = BestFrameNs(frames, rounds, [&] {
+    float sum = 0.0f;
+    for (const auto &key : kFrameKeys)
+      sum += store.GetFloat(key);
+    sink = sum;
+  });
+  const double handleNs = BestFrameNs(frames, rounds, [&] {
+    float sum = 0.0f;
+    for (const auto handle : handles)
+      sum += store.GetFloat(handle);
+    sink = sum;
+  });
+  const double snapshotNs = BestFrameNs(frames, rounds, [&] {
+    const auto frameSnapshot = store.GetFloatSnapshot();
+    float sum = 0.0f;
+    for (const auto handle : handles)
+      sum += frameSnapshot->Get(handle);
+    sink = sum;
+  });
+  (void)sink;
+
+  std::cout << "Preferences read per frame: " << kFrameKeys.size() << '\n'
+            << "Frames: " << frames << " x " << rounds << " rounds\n"
+            << "Legacy string lookup (ns/frame): " << legacyNs << '\n'
+            << "GetFloat by name (ns/frame): " << byNameNs << '\n'
+            << "GetFloat by handle (ns/frame): " << handleNs << '\n'
+            << "Snapshot per frame (ns/frame): " << snapshotNs << std::endl;
+  return 0;
+}
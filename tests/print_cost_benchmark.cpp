@@ -0,0 +1,393 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+// Print cost benchmark. Loads MVR scenes, records top, front and side views
+// with Viewer2DHeadlessRenderer, runs them through the PDF exporter and
+// prints one JSON report with the cost of every view. The headless renderer
+// records the same commands as a layout export without an OpenGL context,
+// so the benchmark measures the real print path from scene to PDF file.
+// Fixture labels are not part of a headless capture.
+//
+// Usage: print_cost_benchmark [--iterations N] [--budget-ms N]
+//                             [--output report.json] scene.mvr...
+//
+// Timings are the median of the iterations. A view whose median export time
+// exceeds --budget-ms fails the run, which is how CTest catches print
+// performance regressions.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <json.hpp>
+#include <wx/init.h>
+
+#include "configmanager.h"
+#include "fixture.h"
+#include "mvrimporter.h"
+#include "pdf_content_buffer.h"
+#include "pdf_content_renderer.h"
+#include "pdf_objects.h"
+#include "print_diagnostics.h"
+#include "truss.h"
+#include "viewer2dcommandrenderer.h"
+#include "viewer2dheadlessrenderer.h"
+#include "viewer2dpdfexporter.h"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+using namespace layout_pdf_internal;
+
+constexpr int kViewportWidth = 1600;
+constexpr int kViewportHeight = 1000;
+constexpr float kFixtureSize = 0.3f;
+// Same stroke conversion as the exporter: one screen pixel at 96 dpi.
+constexpr double kPdfPointsPerPixel = 72.0 / 96.0;
+
+std::optional<std::size_t> ReadStatusFieldKb(const std::string &key) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind(key, 0) == 0) {
+      std::istringstream ss(line.substr(key.size()));
+      std::size_t value = 0;
+      ss >> value;
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+std::size_t ReadPeakRssKb() {
+  return ReadStatusFieldKb("VmHWM:\t").value_or(0);
+}
+
+struct Point2 {
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+// Projects a point in scene millimetres onto the 2D plane of a view, in
+// metres, following the axes the capture records in.
+Point2 Project(Viewer2DView view, float x, float y, float z) {
+  switch (view) {
+  case Viewer2DView::Front:
+    return {x / 1000.0f, z / 1000.0f};
+  case Viewer2DView::Side:
+    return {-y / 1000.0f, z / 1000.0f};
+  default:
+    return {x / 1000.0f, y / 1000.0f};
+  }
+}
+
+struct Bounds2 {
+  float minX = std::numeric_limits<float>::max();
+  float minY = std::numeric_limits<float>::max();
+  float maxX = std::numeric_limits<float>::lowest();
+  float maxY = std::numeric_limits<float>::lowest();
+
+  void Add(const Point2 &p) {
+    minX = std::min(minX, p.x);
+    minY = std::min(minY, p.y);
+    maxX = std::max(maxX, p.x);
+    maxY = std::max(maxY, p.y);
+  }
+  bool Valid() const { return minX <= maxX && minY <= maxY; }
+};
+
+// Extent of the trusses and fixtures in the plane of `view`, used to fit the
+// camera before the view is recorded.
+Bounds2 SceneBounds(const MvrScene &scene, Viewer2DView view) {
+  Bounds2 bounds;
+  for (const auto &[uuid, truss] : scene.trusses) {
+    const Matrix &m = truss.transform;
+    const float len = truss.lengthMm > 0.0f ? truss.lengthMm : 3000.0f;
+    const float wid = truss.widthMm > 0.0f ? truss.widthMm : 400.0f;
+    const float hei = truss.heightMm > 0.0f ? truss.heightMm : 400.0f;
+    for (int corner = 0; corner < 8; ++corner) {
+      const float a = (corner & 1) ? len : 0.0f;
+      const float b = (corner & 2) ? wid * 0.5f : -wid * 0.5f;
+      const float c = (corner & 4) ? hei * 0.5f : -hei * 0.5f;
+      bounds.Add(Project(view, m.o[0] + m.u[0] * a + m.v[0] * b + m.w[0] * c,
+                         m.o[1] + m.u[1] * a + m.v[1] * b + m.w[1] * c,
+                         m.o[2] + m.u[2] * a + m.v[2] * b + m.w[2] * c));
+    }
+  }
+  for (const auto &[uuid, fixture] : scene.fixtures) {
+    const Point2 p = Project(view, fixture.transform.o[0],
+                             fixture.transform.o[1], fixture.transform.o[2]);
+    bounds.Add({p.x - kFixtureSize, p.y - kFixtureSize});
+    bounds.Add({p.x + kFixtureSize, p.y + kFixtureSize});
+  }
+  return bounds;
+}
+
+// Centres the view on the scene and zooms until it fits the viewport, as
+// "fit to scene" does in the 2D viewer.
+viewer2d::Viewer2DState FitViewState(const Bounds2 &bounds, Viewer2DView view) {
+  viewer2d::Viewer2DState state;
+  auto &camera = state.camera;
+  camera.viewportWidth = kViewportWidth;
+  camera.viewportHeight = kViewportHeight;
+  camera.view = static_cast<int>(view);
+  const double width = std::max(1.0f, bounds.maxX - bounds.minX) * 1.1;
+  const double height = std::max(1.0f, bounds.maxY - bounds.minY) * 1.1;
+  const double ppm = std::min(kViewportWidth / width, kViewportHeight / height);
+  camera.zoom = static_cast<float>(ppm / viewer2d::kViewer2DPixelsPerMeter);
+  camera.offsetPixelsX = static_cast<float>(
+      -(bounds.minX + bounds.maxX) * 0.5 * viewer2d::kViewer2DPixelsPerMeter);
+  camera.offsetPixelsY = static_cast<float>(
+      -(bounds.minY + bounds.maxY) * 0.5 * viewer2d::kViewer2DPixelsPerMeter);
+  return state;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start,
+                 std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Median of the samples; the mean of the middle two for an even count. Less
+// sensitive to one slow iteration on a busy runner than the mean, and unlike
+// the minimum it still moves when most iterations get slower.
+double Median(std::vector<double> samples) {
+  if (samples.empty())
+    return 0.0;
+  const size_t mid = samples.size() / 2;
+  std::nth_element(samples.begin(), samples.begin() + mid, samples.end());
+  const double upper = samples[mid];
+  if (samples.size() % 2 != 0)
+    return upper;
+  const double lower =
+      *std::max_element(samples.begin(), samples.begin() + mid);
+  return (lower + upper) * 0.5;
+}
+
+const char *ViewName(Viewer2DView view) {
+  switch (view) {
+  case Viewer2DView::Front:
+    return "front";
+  case Viewer2DView::Side:
+    return "side";
+  default:
+    return "top";
+  }
+}
+
+json CostModelToJson(const PrintCostModel &model) {
+  json contributors = json::array();
+  for (const auto &entry : model.topContributors)
+    contributors.push_back({{"source", entry.source},
+                            {"polygons", entry.polygons},
+                            {"vertices", entry.vertices}});
+  return {{"totalCommands", model.totalCommands},
+          {"commandCounts", model.commandCounts},
+          {"polygonHistogram",
+           {{"triangles", model.triangles},
+            {"quads", model.quads},
+            {"complex", model.complexPolygons}}},
+          {"topContributors", contributors},
+          {"estimatedBytes", model.estimatedBytes}};
+}
+
+// Runs one view through the print path `iterations` times and reports the
+// median timings. Returns std::nullopt with `error` set when the export fails.
+std::optional<json> BenchmarkView(Viewer2DHeadlessRenderer &renderer,
+                                  const MvrScene &scene, Viewer2DView view,
+                                  int iterations, const fs::path &pdfPath,
+                                  std::string &error) {
+  const Bounds2 bounds = SceneBounds(scene, view);
+  if (!bounds.Valid()) {
+    error = "scene has no trusses or fixtures";
+    return std::nullopt;
+  }
+  const viewer2d::Viewer2DState viewerState = FitViewState(bounds, view);
+
+  std::vector<double> captureMs;
+  std::vector<double> encodeMs;
+  std::vector<double> exportMs;
+  CommandBuffer buffer;
+  Viewer2DViewState state;
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    state = renderer.Capture(viewerState, buffer);
+    captureMs.push_back(ElapsedMs(start, std::chrono::steady_clock::now()));
+  }
+  if (buffer.commands.empty()) {
+    error = "view recorded no commands";
+    return std::nullopt;
+  }
+
+  const Viewer2DPrintOptions options;
+  viewer2d::Viewer2DRenderMapping viewMapping;
+  if (!viewer2d::BuildViewMapping(state, options.pageWidthPt,
+                                  options.pageHeightPt, options.marginPt,
+                                  viewMapping)) {
+    error = "view mapping is invalid";
+    return std::nullopt;
+  }
+  const Mapping mapping{viewMapping.minX,     viewMapping.minY,
+                        viewMapping.scale,    viewMapping.offsetX,
+                        viewMapping.offsetY,  viewMapping.drawHeight,
+                        false};
+  RenderOptions renderOptions{};
+  renderOptions.strokeScale = kPdfPointsPerPixel / viewMapping.scale;
+  const FloatFormatter formatter(options.floatPrecision);
+
+  size_t streamBytes = 0;
+  size_t compressedBytes = 0;
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    PdfContentBuffer content;
+    RenderCommandsToStream(content, buffer.commands, buffer.metadata,
+                           buffer.sources, mapping, formatter, renderOptions);
+    std::string compressed;
+    if (!PdfDeflater::Compress(content.View(), compressed, error))
+      return std::nullopt;
+    encodeMs.push_back(ElapsedMs(start, std::chrono::steady_clock::now()));
+    streamBytes = content.Size();
+    compressedBytes = compressed.size();
+  }
+
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    Viewer2DExportResult result =
+        ExportViewer2DToPdf(buffer, state, options, pdfPath);
+    const double ms = ElapsedMs(start, std::chrono::steady_clock::now());
+    if (!result.success) {
+      error = result.message;
+      return std::nullopt;
+    }
+    exportMs.push_back(ms);
+  }
+  std::error_code ec;
+  const auto pdfBytes = fs::file_size(pdfPath, ec);
+  fs::remove(pdfPath, ec);
+
+  const PrintCostModel model = ComputePrintCostModel(buffer);
+  return json{{"view", ViewName(view)},
+              {"captureMs", Median(captureMs)},
+              {"encodeMs", Median(encodeMs)},
+              {"exportMs", Median(exportMs)},
+              {"costModel", CostModelToJson(model)},
+              {"streamBytes", streamBytes},
+              {"compressedBytes", compressedBytes},
+              {"compressionRatio",
+               compressedBytes > 0 ? static_cast<double>(streamBytes) /
+                                         static_cast<double>(compressedBytes)
+                                   : 0.0},
+              {"pdfBytes", ec ? 0 : static_cast<std::uintmax_t>(pdfBytes)}};
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  wxInitializer initializer;
+  if (!initializer.IsOk()) {
+    std::cerr << "wxWidgets failed to initialize" << std::endl;
+    return 1;
+  }
+
+  int iterations = 3;
+  double budgetMs = 0.0;
+  std::string outputPath;
+  std::vector<std::string> scenes;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--iterations" && i + 1 < argc)
+      iterations = std::max(1, std::atoi(argv[++i]));
+    else if (arg == "--budget-ms" && i + 1 < argc)
+      budgetMs = std::atof(argv[++i]);
+    else if (arg == "--output" && i + 1 < argc)
+      outputPath = argv[++i];
+    else
+      scenes.push_back(arg);
+  }
+  if (scenes.empty()) {
+    std::cerr << "Usage: print_cost_benchmark [--iterations N] "
+                 "[--budget-ms N] [--output report.json] scene.mvr..."
+              << std::endl;
+    return 1;
+  }
+
+  const fs::path pdfPath =
+      fs::temp_directory_path() / "perastage_print_cost_benchmark.pdf";
+  json report = {{"iterations", iterations},
+                 {"budgetMs", budgetMs},
+                 {"scenes", json::array()}};
+  bool ok = true;
+  for (const auto &scenePath : scenes) {
+    ConfigManager &cfg = ConfigManager::Get();
+    cfg.Reset();
+    MvrImporter importer;
+    const auto start = std::chrono::steady_clock::now();
+    if (!importer.ImportFromFile(scenePath, false, false)) {
+      std::cerr << "Failed to import " << scenePath << std::endl;
+      return 1;
+    }
+    const double importMs = ElapsedMs(start, std::chrono::steady_clock::now());
+    const MvrScene &scene = cfg.GetScene();
+
+    json sceneReport = {{"scene", fs::path(scenePath).filename().string()},
+                        {"fixtures", scene.fixtures.size()},
+                        {"trusses", scene.trusses.size()},
+                        {"importMs", importMs},
+                        {"views", json::array()}};
+    Viewer2DHeadlessRenderer renderer;
+    for (Viewer2DView view :
+         {Viewer2DView::Top, Viewer2DView::Front, Viewer2DView::Side}) {
+      std::string error;
+      auto viewReport =
+          BenchmarkView(renderer, scene, view, iterations, pdfPath, error);
+      if (!viewReport) {
+        std::cerr << scenePath << " (" << ViewName(view)
+                  << "): " << error << std::endl;
+        return 1;
+      }
+      const double exportMs = (*viewReport)["exportMs"].get<double>();
+      if (budgetMs > 0.0 && exportMs > budgetMs) {
+        std::cerr << scenePath << " (" << ViewName(view) << "): export took "
+                  << exportMs << " ms, budget is " << budgetMs << " ms"
+                  << std::endl;
+        ok = false;
+      }
+      sceneReport["views"].push_back(std::move(*viewReport));
+    }
+    report["scenes"].push_back(std::move(sceneReport));
+  }
+  report["peakRssKb"] = ReadPeakRssKb();
+
+  const std::string text = report.dump(2);
+  std::cout << text << std::endl;
+  if (!outputPath.empty()) {
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    out << text << '\n';
+    if (!out) {
+      std::cerr << "Unable to write " << outputPath << std::endl;
+      return 1;
+    }
+  }
+  return ok ? 0 : 1;
+}
@@ -1,6 +1,8 @@
 #include "configservices.h"
 
 #include <cassert>
+#include <memory>
+#include <utility>
 
 int main() {
   ProjectSession session;
@@ -15,6 +17,21 @@ int main() {
   session.GetScene().fixtures[f.uuid] = f;
   assert(session.GetScene().fixtures.size() == 1);
 
+  // Without a snapshot the scene is edited in place; with one, the edit
+  // goes to a copy and the snapshot keeps the old contents.
+  const MvrScene *before = &session.GetScene();
+  assert(&session.GetScene() == before);
+  {
+    std::shared_ptr<const MvrScene> snapshot = session.Snapshot();
+    assert(snapshot.get() == before);
+    session.GetScene().fixtures.clear();
+    assert(&std::as_const(session).GetScene() != before);
+    assert(snapshot->fixtures.size() == 1);
+    assert(session.GetScene().fixtures.empty());
+  }
+  const MvrScene *after = &session.GetScene();
+  assert(&session.GetScene() == after);
+
   session.ResetDirty();
   assert(!session.IsDirty());
   return 0;
@@ -21,12 +21,15 @@
 #include <iostream>
 #include <numeric>
 #include <optional>
+#include <random>
+#include <regex>
 #include <string>
 #include <sstream>
 #include <vector>
 #include <wx/init.h>
 
 #include "riderimporter.h"
+#include "riderlineparser.h"
 #include "configmanager.h"
 #include "fixture.h"
 #include "truss.h"
@@ -87,6 +90,173 @@ IterationResult RunOnce(const std::string &path, std::size_t baselinePeak) {
 
   return result;
 }
+
+// Builds a deterministic rider mixing every line shape the importer knows.
+std::string BuildSyntheticRider(std::size_t lineCount) {
+  static const char *const kTemplates[] = {
+      "ILUMINACION",
+      "LX1",
+      "lx2:",
+      "Floor",
+      "Efectos",
+      "2 truss 30x30 12m para LX1",
+      "1 TRUSS 40 X 40 8.5 metros",
+      "1 truss LX3 10 m",
+      "Truss de 6 m en LX4",
+      "- 6 Robe Spiider + 4 Clay Paky Sharpy",
+      "* 2 Martin MAC Aura",
+      "12",
+      "Robe Pointe",
+      "8 Par LED RGBW",
+      "RIGGING",
+      "Notas generales del montaje",
+  };
+  constexpr std::size_t kTemplateCount =
+      sizeof(kTemplates) / sizeof(kTemplates[0]);
+  std::mt19937 rng(42);
+  std::string text;
+  text.reserve(lineCount * 24);
+  for (std::size_t i = 0; i < lineCount; ++i) {
+    // Start in the lighting section and re-enter it every 500 lines so the
+    // fixture shapes are exercised throughout.
+    std::size_t pick = (i % 500 == 0) ? 0 : rng() % kTemplateCount;
+    text += kTemplates[pick];
+    text += '\n';
+  }
+  return text;
+}
+
+std::vector<std::string> SplitLines(const std::string &text) {
+  std::vector<std::string> lines;
+  std::istringstream ss(text);
+  std::string line;
+  while (std::getline(ss, line))
+    lines.push_back(line);
+  return lines;
+}
+
+// Classification of a rider line in the importer's dispatch order, with the
+// captured fields joined so both tokenizers can be compared line by line.
+std::string ClassifyWithRegex(const std::string &line) {
+  // The expressions RiderImporter used before its hand-written tokenizer.
+  static const std::regex trussLineRe(
+      "^\\s*(?:[-*]\\s*)?(\\d+)\\s+(?:truss)\\s+([^\\n]*?)\\s+(\\d+(?:\\.\\d+)?)\\s*(?:m|metros?|meters?)\\b(?:\\s+para\\s+(.+))?",
+      std::regex::icase);
+  static const std::regex trussRe(
+      "(?:truss)[^\\n]*?(\\d+(?:\\.\\d+)?)\\s*(?:m|metros?|meters?)\\b",
+      std::regex::icase);
+  static const std::regex fixtureLineRe("^\\s*(?:[-*]\\s*)?(\\d+)\\s+(.+)$",
+                                        std::regex::icase);
+  static const std::regex quantityOnlyRe("^\\s*(?:[-*]\\s*)?(\\d+)\\s*$");
+  static const std::regex hangLineRe(
+      "^\\s*(LX\\d+|floor|efectos?)\\s*:?\\s*$", std::regex::icase);
+  static const std::regex hangFindRe("(LX\\d+|floor|efectos?)",
+                                     std::regex::icase);
+  static const std::regex hangOnlyRe("^\\s*(LX\\d+|floor|efectos?)\\s*$",
+                                     std::regex::icase);
+
+  std::smatch m;
+  std::smatch hm;
+  if (std::regex_match(line, hm, hangLineRe))
+    return "hang|" + hm[1].str();
+  if (std::regex_match(line, m, trussLineRe)) {
+    std::string model = m[2].str();
+    std::string out = "truss|" + m[1].str() + '|' + model + '|' + m[3].str();
+    if (m[4].matched)
+      out += "|para " + m[4].str();
+    static const std::regex dimensionsRe(
+        "(\\d+(?:\\.\\d+)?)\\s*[xX]\\s*(\\d+(?:\\.\\d+)?)");
+    std::smatch dm;
+    if (std::regex_search(model, dm, dimensionsRe))
+      out += "|dims " + dm[1].str() + 'x' + dm[2].str();
+    if (std::regex_match(model, hangOnlyRe))
+      out += "|hang";
+    return out;
+  }
+  if (std::regex_search(line, m, trussRe)) {
+    std::string out = "length|" + m[1].str();
+    if (std::regex_search(line, hm, hangFindRe))
+      out += '|' + hm[1].str();
+    return out;
+  }
+  if (std::regex_match(line, m, fixtureLineRe))
+    return "fixture|" + m[1].str() + '|' + m[2].str();
+  if (std::regex_match(line, m, quantityOnlyRe))
+    return "quantity|" + m[1].str();
+  return {};
+}
+
+std::string ClassifyWithTokenizer(const std::string &line) {
+  std::string_view a;
+  std::string_view b;
+  RiderLineParser::TrussLine truss;
+  if (RiderLineParser::MatchHangLine(line, a))
+    return "hang|" + std::string(a);
+  if (RiderLineParser::MatchTrussLine(line, truss)) {
+    std::string out = "truss|" + std::string(truss.quantity) + '|' +
+                      std::string(truss.model) + '|' +
+                      std::string(truss.length);
+    if (truss.hasHang)
+      out += "|para " + std::string(truss.hang);
+    if (RiderLineParser::FindDimensions(truss.model, a, b))
+      out += "|dims " + std::string(a) + 'x' + std::string(b);
+    if (RiderLineParser::MatchHangOnly(truss.model, a))
+      out += "|hang";
+    return out;
+  }
+  if (RiderLineParser::FindTrussLength(line, a)) {
+    std::string out = "length|" + std::string(a);
+    if (RiderLineParser::FindHang(line, b))
+      out += '|' + std::string(b);
+    return out;
+  }
+  if (RiderLineParser::MatchFixtureLine(line, a, b))
+    return "fixture|" + std::string(a) + '|' + std::string(b);
+  if (RiderLineParser::MatchQuantityOnly(line, a))
+    return "quantity|" + std::string(a);
+  return {};
+}
+
+struct TokenizerComparison {
+  double regexMs = 0.0;
+  double tokenizerMs = 0.0;
+  std::size_t lines = 0;
+  std::size_t mismatches = 0;
+};
+
+TokenizerComparison CompareTokenizers(const std::vector<std::string> &lines) {
+  TokenizerComparison result;
+  result.lines = lines.size();
+  std::vector<std::string> regexOut;
+  std::vector<std::string> tokenizerOut;
+  regexOut.reserve(lines.size());
+  tokenizerOut.reserve(lines.size());
+
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &line : lines)
+    regexOut.push_back(ClassifyWithRegex(line));
+  auto end = std::chrono::steady_clock::now();
+  result.regexMs =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &line : lines)
+    tokenizerOut.push_back(ClassifyWithTokenizer(line));
+  end = std::chrono::steady_clock::now();
+  result.tokenizerMs =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    if (regexOut[i] != tokenizerOut[i]) {
+      if (result.mismatches < 10)
+        std::cerr << "Tokenizer mismatch on \"" << lines[i] << "\": regex \""
+                  << regexOut[i] << "\" vs \"" << tokenizerOut[i] << "\""
+                  << std::endl;
+      ++result.mismatches;
+    }
+  }
+  return result;
+}
 } // namespace
 
 int main(int argc, char **argv) {
@@ -99,6 +269,9 @@ int main(int argc, char **argv) {
   const std::string path =
       argc >= 2 ? argv[1] : std::string("tests/data/rider_large.txt");
   const int iterations = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 1;
+  const std::size_t syntheticLines =
+      argc >= 4 ? static_cast<std::size_t>(std::max(1, std::atoi(argv[3])))
+                : 10000;
 
   const std::size_t baselinePeak = ReadPeakRssKb();
   std::vector<IterationResult> results;
@@ -140,5 +313,35 @@ int main(int argc, char **argv) {
               << r.finalRssKb << " kB, fixtures " << r.fixtures << "\n";
   }
 
+  // Compare the legacy std::regex line matching against the hand-written
+  // tokenizer on a synthetic rider, then import that rider end to end.
+  const std::string synthetic = BuildSyntheticRider(syntheticLines);
+  const TokenizerComparison comparison =
+      CompareTokenizers(SplitLines(synthetic));
+
+  ConfigManager::Get().Reset();
+  const auto importStart = std::chrono::steady_clock::now();
+  const bool syntheticOk = RiderImporter::ImportText(synthetic);
+  const auto importEnd = std::chrono::steady_clock::now();
+  const double syntheticImportMs =
+      std::chrono::duration<double, std::milli>(importEnd - importStart)
+          .count();
+
+  std::cout << "\nSynthetic rider lines: " << comparison.lines << '\n'
+            << "Regex tokenizer (ms): " << comparison.regexMs << '\n'
+            << "Hand-written tokenizer (ms): " << comparison.tokenizerMs
+            << '\n'
+            << "Tokenizer speedup: "
+            << (comparison.tokenizerMs > 0.0
+                    ? comparison.regexMs / comparison.tokenizerMs
+                    : 0.0)
+            << "x\n"
+            << "Tokenizer mismatches: " << comparison.mismatches << '\n'
+            << "Synthetic import time (ms): " << syntheticImportMs << '\n'
+            << "Synthetic fixtures imported: "
+            << ConfigManager::Get().GetScene().fixtures.size() << std::endl;
+
+  if (comparison.mismatches > 0 || !syntheticOk)
+    return 1;
   return 0;
 }
@@ -28,6 +28,10 @@
 #include "truss.h"
 
 std::string ExtractPdfText(const std::string &) { return {}; }
+bool ExtractPdfTextPages(const std::string &, const PdfPageTextCallback &,
+                         const std::atomic<bool> *) {
+  return false;
+}
 
 namespace GdtfDictionary {
 std::optional<std::unordered_map<std::string, Entry>> Load() { return std::unordered_map<std::string, Entry>(); }
@@ -0,0 +1,188 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "riggingsolver.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace {
+
+bool Near(double a, double b) { return std::abs(a - b) < 1e-6; }
+
+Matrix At(float x, float y, float z) {
+  Matrix m;
+  m.o = {x, y, z};
+  return m;
+}
+
+void AddTruss(MvrScene &scene, const std::string &uuid, Matrix transform,
+              float lengthMm, float weightKg) {
+  Truss t;
+  t.uuid = uuid;
+  t.transform = transform;
+  t.lengthMm = lengthMm;
+  t.weightKg = weightKg;
+  scene.trusses[uuid] = t;
+}
+
+void AddHoist(MvrScene &scene, const std::string &uuid, Matrix transform) {
+  Support s;
+  s.uuid = uuid;
+  s.transform = transform;
+  scene.supports[uuid] = s;
+}
+
+void AddFixture(MvrScene &scene, const std::string &uuid, Matrix transform,
+                float weightKg) {
+  Fixture f;
+  f.uuid = uuid;
+  f.transform = transform;
+  f.weightKg = weightKg;
+  scene.fixtures[uuid] = f;
+}
+
+SceneChangeSet Change(SceneEntityKind kind, const std::string &uuid,
+                      uint32_t components) {
+  SceneChangeSet changes;
+  SceneChange change;
+  change.kind = kind;
+  change.uuid = uuid;
+  change.components = components;
+  changes.changes.push_back(change);
+  return changes;
+}
+
+} // namespace
+
+int main() {
+  // A 10 m truss hung at both ends, with a fixture a quarter along.
+  MvrScene scene;
+  AddTruss(scene, "t1", At(0, 0, 5000), 10000, 100);
+  AddHoist(scene, "h1", At(0, 0, 8000));
+  AddHoist(scene, "h2", At(10000, 0, 8000));
+  AddFixture(scene, "f1", At(2500, 0, 4700), 20);
+  AddFixture(scene, "floor", At(0, 5000, 0), 30);
+
+  RiggingSolver solver;
+  solver.Rebuild(scene);
+  assert(solver.IsBuilt());
+  assert(Near(solver.HoistLoadKg("h1"), 65));
+  assert(Near(solver.HoistLoadKg("h2"), 55));
+  assert(solver.TrussOf("f1") == "t1");
+  assert(solver.TrussOf("floor").empty());
+  assert(Near(solver.UnsupportedKg(), 0));
+
+  // Moving the fixture moves only its load.
+  scene.fixtures["f1"].transform = At(7500, 0, 4700);
+  solver.Apply(Change(SceneEntityKind::Fixture, "f1", SceneComponent::Transform),
+               scene);
+  assert(Near(solver.HoistLoadKg("h1"), 55));
+  assert(Near(solver.HoistLoadKg("h2"), 65));
+
+  // Patch edits do not touch loads; weight edits do.
+  scene.fixtures["f1"].weightKg = 40;
+  solver.Apply(Change(SceneEntityKind::Fixture, "f1", SceneComponent::Patch),
+               scene);
+  assert(Near(solver.HoistLoadKg("h2"), 65));
+  solver.Apply(
+      Change(SceneEntityKind::Fixture, "f1", SceneComponent::Properties),
+      scene);
+  assert(Near(solver.HoistLoadKg("h1"), 60));
+  assert(Near(solver.HoistLoadKg("h2"), 80));
+
+  // Removing a hoist leaves everything on the other one.
+  scene.supports.erase("h1");
+  solver.Apply(Change(SceneEntityKind::Support, "h1", SceneComponent::Removed),
+               scene);
+  assert(Near(solver.HoistLoadKg("h1"), 0));
+  assert(Near(solver.HoistLoadKg("h2"), 140));
+
+  // An overhanging load lifts the inner hoist.
+  MvrScene cantilever;
+  AddTruss(cantilever, "t", At(0, 0, 5000), 10000, 0);
+  AddHoist(cantilever, "a", At(0, 0, 8000));
+  AddHoist(cantilever, "b", At(5000, 0, 8000));
+  AddFixture(cantilever, "f", At(10000, 0, 4800), 10);
+  solver.Rebuild(cantilever);
+  assert(Near(solver.HoistLoadKg("a"), -10));
+  assert(Near(solver.HoistLoadKg("b"), 20));
+
+  // A truss without hoists reports its load as unsupported.
+  cantilever.supports.clear();
+  solver.Apply(SceneChangeSet{true, {}, 0}, cantilever);
+  assert(Near(solver.UnsupportedKg(), 10));
+  assert(solver.TrussOf("f") == "t");
+
+  // 1,000 hoists on 500 trusses with 10,000 fixtures; dragged fixtures
+  // must give the same loads as solving from scratch.
+  MvrScene rig;
+  for (int i = 0; i < 500; ++i) {
+    const float x = static_cast<float>(i % 25) * 12000.0f;
+    const float y = static_cast<float>(i / 25) * 3000.0f;
+    const std::string t = "t" + std::to_string(i);
+    AddTruss(rig, t, At(x, y, 6000), 10000, 150);
+    AddHoist(rig, t + "a", At(x + 500, y, 9000));
+    AddHoist(rig, t + "b", At(x + 9500, y, 9000));
+    for (int f = 0; f < 20; ++f)
+      AddFixture(rig, t + "f" + std::to_string(f),
+                 At(x + 250.0f + 500.0f * static_cast<float>(f), y, 5600),
+                 25);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  RiggingSolver incremental;
+  incremental.Rebuild(rig);
+  auto built = std::chrono::steady_clock::now();
+  for (int i = 0; i < 1000; ++i) {
+    const std::string uuid = "t" + std::to_string(i % 500) + "f" +
+                             std::to_string(i % 20);
+    Fixture &f = rig.fixtures[uuid];
+    f.transform.o[0] += 1300.0f;
+    f.transform.o[1] += 3000.0f * static_cast<float>(i % 3 == 0);
+    incremental.Apply(
+        Change(SceneEntityKind::Fixture, uuid, SceneComponent::Transform),
+        rig);
+  }
+  auto moved = std::chrono::steady_clock::now();
+
+  RiggingSolver fresh;
+  fresh.Rebuild(rig);
+  double total = 0.0;
+  for (const auto &[uuid, support] : rig.supports) {
+    assert(std::abs(incremental.HoistLoadKg(uuid) - fresh.HoistLoadKg(uuid)) <
+           1e-6);
+    total += fresh.HoistLoadKg(uuid);
+  }
+  for (const auto &[uuid, fixture] : rig.fixtures)
+    assert(incremental.TrussOf(uuid) == fresh.TrussOf(uuid));
+  // Every truss is hung, so its weight and the weight of everything on it
+  // reaches the hoists.
+  double hung = 500 * 150.0;
+  for (const auto &[uuid, fixture] : rig.fixtures)
+    if (!fresh.TrussOf(uuid).empty())
+      hung += fixture.weightKg;
+  assert(std::abs(total - hung) < 1e-6);
+
+  using ms = std::chrono::duration<double, std::milli>;
+  std::cout << "rebuild " << ms(built - start).count() << " ms, 1000 moves "
+            << ms(moved - built).count() << " ms\n";
+  return 0;
+}
@@ -0,0 +1,88 @@
+#include "scenechangejournal.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+int main() {
+  SceneChangeJournal journal;
+  std::vector<SceneChangeSet> received;
+  auto id = journal.Subscribe(
+      [&](const SceneChangeSet &set) { received.push_back(set); });
+
+  // A single publish is delivered immediately.
+  journal.Publish(SceneEntityKind::Fixture, "f1", SceneComponent::Transform);
+  assert(received.size() == 1);
+  assert(!received[0].reset);
+  assert(received[0].changes.size() == 1);
+  assert(received[0].changes[0].uuid == "f1");
+  assert(received[0].changes[0].oldRevision == 0);
+  assert(received[0].changes[0].newRevision == journal.GetRevision());
+  assert(journal.GetEntityRevision(SceneEntityKind::Fixture, "f1") ==
+         journal.GetRevision());
+  assert(journal.GetEntityRevision(SceneEntityKind::Truss, "f1") == 0);
+
+  // Changes inside a batch are merged per entity and delivered once.
+  const uint64_t f1Revision = journal.GetRevision();
+  {
+    SceneChangeJournal::Batch batch(journal);
+    journal.Publish(SceneEntityKind::Fixture, "f1", SceneComponent::Patch);
+    journal.Publish(SceneEntityKind::Truss,
+                    std::vector<std::string>{"t1", "t2"},
+                    SceneComponent::Properties);
+    journal.Publish(SceneEntityKind::Fixture, "f1", SceneComponent::Placement);
+    assert(received.size() == 1);
+  }
+  assert(received.size() == 2);
+  const SceneChangeSet &batched = received[1];
+  assert(batched.changes.size() == 3);
+  assert(batched.changes[0].uuid == "f1");
+  assert(batched.changes[0].components ==
+         (SceneComponent::Patch | SceneComponent::Placement));
+  assert(batched.changes[0].oldRevision == f1Revision);
+  assert(batched.changes[0].newRevision == journal.GetRevision());
+  assert(batched.Touches(SceneEntityKind::Truss));
+  assert(batched.Touches(SceneEntityKind::Fixture, SceneComponent::Patch));
+  assert(!batched.Touches(SceneEntityKind::Fixture, SceneComponent::Transform));
+  assert(!batched.Touches(SceneEntityKind::Support));
+
+  // Removing an entity forgets its revision.
+  journal.Publish(SceneEntityKind::Truss, "t1", SceneComponent::Removed);
+  assert(received.size() == 3);
+  assert(journal.GetEntityRevision(SceneEntityKind::Truss, "t1") == 0);
+
+  // A reset supersedes entity changes of the same batch.
+  {
+    SceneChangeJournal::Batch batch(journal);
+    journal.Publish(SceneEntityKind::Support, "s1", SceneComponent::Added);
+    journal.PublishReset();
+    journal.Publish(SceneEntityKind::Support, "s2", SceneComponent::Added);
+  }
+  assert(received.size() == 4);
+  assert(received[3].reset);
+  assert(received[3].changes.empty());
+  assert(received[3].Touches(SceneEntityKind::SceneObject));
+  assert(journal.GetEntityRevision(SceneEntityKind::Fixture, "f1") == 0);
+
+  // Empty publishes are ignored.
+  journal.Publish(SceneEntityKind::Fixture, std::vector<std::string>{},
+                  SceneComponent::All);
+  journal.Publish(SceneEntityKind::Fixture, "f1", 0);
+  assert(received.size() == 4);
+
+  // A listener may unsubscribe another one while being notified.
+  int secondCalls = 0;
+  SceneChangeJournal::ListenerId second = 0;
+  auto first = journal.Subscribe(
+      [&](const SceneChangeSet &) { journal.Unsubscribe(second); });
+  second = journal.Subscribe([&](const SceneChangeSet &) { ++secondCalls; });
+  journal.Publish(SceneEntityKind::SceneObject, "o1", SceneComponent::All);
+  assert(secondCalls == 0);
+  assert(received.size() == 5);
+
+  journal.Unsubscribe(first);
+  journal.Unsubscribe(id);
+  journal.Publish(SceneEntityKind::SceneObject, "o1", SceneComponent::All);
+  assert(received.size() == 5);
+  return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "sceneentityindex.h"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void AddFixture(MvrScene &scene, const std::string &uuid, int id,
+                const std::string &name) {
+  Fixture f;
+  f.uuid = uuid;
+  f.fixtureId = id;
+  f.instanceName = name;
+  scene.fixtures[uuid] = f;
+}
+
+SceneChangeSet Change(SceneEntityKind kind, const std::string &uuid,
+                      uint32_t components) {
+  SceneChangeSet changes;
+  SceneChange change;
+  change.kind = kind;
+  change.uuid = uuid;
+  change.components = components;
+  changes.changes.push_back(change);
+  return changes;
+}
+
+} // namespace
+
+int main() {
+  MvrScene scene;
+  AddFixture(scene, "a", 3, "Spot Left");
+  AddFixture(scene, "b", 1, "Wash");
+  AddFixture(scene, "c", 2, "Spot Right");
+  AddFixture(scene, "d", 2, "Wash");
+  Truss t;
+  t.uuid = "t1";
+  t.unitNumber = 10;
+  t.name = "Front Truss";
+  scene.trusses[t.uuid] = t;
+
+  SceneEntityIndex index;
+  assert(!index.IsBuilt());
+  index.Rebuild(scene);
+  assert(index.IsBuilt());
+  assert(index.Size(SceneEntityKind::Fixture) == 4);
+  assert(index.Size(SceneEntityKind::Truss) == 1);
+  assert(index.Size(SceneEntityKind::SceneObject) == 0);
+
+  // Ranges are ordered by id and include every entity sharing an id.
+  assert((index.Range(SceneEntityKind::Fixture, 1, 3) ==
+          std::vector<std::string>{"b", "c", "d", "a"}));
+  assert((index.Range(SceneEntityKind::Fixture, 2, 2) ==
+          std::vector<std::string>{"c", "d"}));
+  assert(index.Range(SceneEntityKind::Fixture, 4, 9).empty());
+  assert(index.Range(SceneEntityKind::Fixture, 3, 1).empty());
+  assert((index.Range(SceneEntityKind::Truss, 10, 10) ==
+          std::vector<std::string>{"t1"}));
+
+  // Names ignore case.
+  assert((index.FindByName(SceneEntityKind::Fixture, "wash") ==
+          std::vector<std::string>{"b", "d"}));
+  assert((index.FindByName(SceneEntityKind::Truss, "FRONT TRUSS") ==
+          std::vector<std::string>{"t1"}));
+  assert(index.FindByName(SceneEntityKind::Fixture, "front truss").empty());
+
+  // A repatched fixture moves to its new id.
+  scene.fixtures["b"].fixtureId = 7;
+  index.Apply(Change(SceneEntityKind::Fixture, "b", SceneComponent::Patch),
+              scene);
+  assert(index.Range(SceneEntityKind::Fixture, 1, 1).empty());
+  assert((index.Range(SceneEntityKind::Fixture, 7, 7) ==
+          std::vector<std::string>{"b"}));
+
+  // A renamed fixture is found under its new name only.
+  scene.fixtures["a"].instanceName = "Profile";
+  index.Apply(
+      Change(SceneEntityKind::Fixture, "a", SceneComponent::Properties),
+      scene);
+  assert(index.FindByName(SceneEntityKind::Fixture, "spot left").empty());
+  assert((index.FindByName(SceneEntityKind::Fixture, "profile") ==
+          std::vector<std::string>{"a"}));
+
+  // Transform-only changes cannot move an entity in the index.
+  scene.fixtures["c"].fixtureId = 99;
+  index.Apply(
+      Change(SceneEntityKind::Fixture, "c", SceneComponent::Transform),
+      scene);
+  assert((index.Range(SceneEntityKind::Fixture, 2, 2) ==
+          std::vector<std::string>{"c", "d"}));
+  scene.fixtures["c"].fixtureId = 2;
+
+  // Added and removed entities.
+  AddFixture(scene, "e", 5, "Blinder");
+  index.Apply(Change(SceneEntityKind::Fixture, "e", SceneComponent::Added),
+              scene);
+  assert(index.Size(SceneEntityKind::Fixture) == 5);
+  assert((index.Range(SceneEntityKind::Fixture, 5, 5) ==
+          std::vector<std::string>{"e"}));
+  scene.fixtures.erase("d");
+  index.Apply(Change(SceneEntityKind::Fixture, "d", SceneComponent::Removed),
+              scene);
+  assert(index.Size(SceneEntityKind::Fixture) == 4);
+  assert((index.Range(SceneEntityKind::Fixture, 2, 2) ==
+          std::vector<std::string>{"c"}));
+
+  // A reset drops the index until it is rebuilt.
+  SceneChangeSet reset;
+  reset.reset = true;
+  index.Apply(reset, scene);
+  assert(!index.IsBuilt());
+  assert(index.Range(SceneEntityKind::Fixture, 0, 100).empty());
+
+  // A large rig: range selections are a binary search.
+  MvrScene rig;
+  for (int i = 1; i <= 20000; ++i)
+    AddFixture(rig, "fx" + std::to_string(i), i, "Spot " + std::to_string(i));
+  auto start = std::chrono::steady_clock::now();
+  index.Rebuild(rig);
+  const double buildMs = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  start = std::chrono::steady_clock::now();
+  size_t selected = 0;
+  for (int i = 0; i < 100; ++i)
+    selected += index.Range(SceneEntityKind::Fixture, 1, 200).size();
+  const double rangeMs = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - start)
+                             .count() /
+                         100;
+  assert(selected == 100 * 200);
+  std::cout << "20000 fixtures indexed in " << buildMs << " ms, 200 selected in "
+            << rangeMs << " ms\n";
+  return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "trussloader.h"
+
+#include <cassert>
+#include <filesystem>
+#include <string>
+
+#include <wx/filename.h>
+#include <wx/wfstream.h>
+class wxZipStreamLink;
+#include <wx/zipstrm.h>
+
+namespace {
+std::string MakeTrussArchive() {
+  wxFileName tempName(wxFileName::CreateTempFileName("truss_cache_"));
+  const std::string outPath = tempName.GetFullPath().ToStdString() + ".gtruss";
+  wxRemoveFile(tempName.GetFullPath());
+
+  wxFFileOutputStream fileOut(outPath);
+  assert(fileOut.IsOk());
+  wxZipOutputStream zipOut(fileOut);
+
+  zipOut.PutNextEntry("truss.json");
+  const std::string meta =
+      "{\"Name\":\"F34 2m\",\"Manufacturer\":\"Test\",\"Model\":\"F34\","
+      "\"Length_mm\":2000,\"Width_mm\":290,\"Height_mm\":290,"
+      "\"Weight_kg\":12.5,\"CrossSection\":\"Quad\"}";
+  zipOut.Write(meta.data(), meta.size());
+  zipOut.PutNextEntry("model.3ds");
+  const std::string model = "not a real model";
+  zipOut.Write(model.data(), model.size());
+  zipOut.Close();
+
+  return outPath;
+}
+} // namespace
+
+int main() {
+  namespace fs = std::filesystem;
+  const std::string first = MakeTrussArchive();
+  const std::string second = first + ".copy.gtruss";
+  fs::copy_file(first, second, fs::copy_options::overwrite_existing);
+
+  Truss a;
+  Truss b;
+  assert(LoadTrussArchive(first, a));
+  assert(LoadTrussArchive(second, b));
+  assert(!a.symbolFile.empty());
+  assert(a.symbolFile == b.symbolFile);
+  assert(fs::exists(a.symbolFile));
+  assert(a.modelFile == first);
+  assert(b.modelFile == second);
+  assert(a.name == "F34 2m");
+  assert(b.lengthMm == 2000.0f);
+
+  // A cached entry whose extracted model was removed is extracted again.
+  fs::remove(a.symbolFile);
+  Truss c;
+  assert(LoadTrussArchive(first, c));
+  assert(c.symbolFile == a.symbolFile);
+  assert(fs::exists(c.symbolFile));
+
+  ClearTrussArchiveCache();
+  Truss d;
+  assert(LoadTrussArchive(second, d));
+  assert(d.symbolFile == a.symbolFile);
+
+  std::error_code ec;
+  fs::remove(first, ec);
+  fs::remove(second, ec);
+  fs::remove_all(fs::path(a.symbolFile).parent_path(), ec);
+  return 0;
+}
@@ -9,6 +9,24 @@ int main() {
   store.SetValue("zoom", "4.0");
   assert(store.GetFloat("zoom") == 2.0f);
 
+  auto zoom = store.ResolveFloat("zoom");
+  assert(zoom.IsValid());
+  assert(!store.ResolveFloat("missing").IsValid());
+  assert(store.GetFloat(zoom) == 2.0f);
+  auto before = store.GetFloatSnapshot();
+  const uint64_t revision = store.GetFloatRevision();
+  store.SetFloat("zoom", 0.75f);
+  assert(store.GetFloat(zoom) == 0.75f);
+  assert(store.GetFloatRevision() > revision);
+  assert(store.GetFloatSnapshot()->Get(zoom) == 0.75f);
+  assert(before->Get(zoom) == 2.0f);
+  store.RemoveKey("zoom");
+  assert(store.GetFloat(zoom) == 1.0f);
+  store.RegisterVariable("zoom", "float", 1.0f, 0.5f, 2.0f);
+  assert(store.ResolveFloat("zoom").IsValid());
+  store.SetValue("zoom", "4.0");
+  assert(store.GetFloat(zoom) == 2.0f);
+
   const std::filesystem::path out = std::filesystem::temp_directory_path() /
                                     "perastage_user_preferences_store_test.json";
   assert(store.SaveToFile(out.string()));
@@ -17,6 +35,7 @@ int main() {
   loaded.RegisterVariable("zoom", "float", 1.0f, 0.5f, 2.0f);
   assert(loaded.LoadFromFile(out.string()));
   assert(loaded.GetFloat("zoom") == 2.0f);
+  assert(loaded.GetFloatSnapshot()->Get(loaded.ResolveFloat("zoom")) == 2.0f);
   std::error_code ec;
   std::filesystem::remove(out, ec);
   return 0;
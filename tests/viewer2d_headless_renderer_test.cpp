@@ -0,0 +1,106 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+// Records a 2D view with Viewer2DHeadlessRenderer in a process that never
+// creates a window or GL context, and checks what ends up in the buffer.
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <variant>
+
+#include <wx/init.h>
+
+#include "configmanager.h"
+#include "fixture.h"
+#include "viewer2dheadlessrenderer.h"
+
+namespace {
+constexpr const char *kFixtureType = "HeadlessTestFixture";
+constexpr const char *kFixtureLayer = "Headless Rig";
+
+template <typename T> size_t CountCommands(const CommandBuffer &buffer) {
+  return std::count_if(buffer.commands.begin(), buffer.commands.end(),
+                       [](const CanvasCommand &command) {
+                         return std::holds_alternative<T>(command);
+                       });
+}
+
+bool HasSource(const CommandBuffer &buffer, const std::string &source) {
+  return std::find(buffer.sources.begin(), buffer.sources.end(), source) !=
+         buffer.sources.end();
+}
+} // namespace
+
+int main() {
+  wxInitializer initializer;
+  assert(initializer.IsOk());
+
+  auto &cfg = ConfigManager::Get();
+  cfg.Reset();
+  MvrScene &scene = cfg.GetScene();
+
+  // No GDTF file, so the fixture is drawn as the fallback cube.
+  Fixture fixture;
+  fixture.uuid = "headless-fx-1";
+  fixture.instanceName = "Headless Spot";
+  fixture.typeName = kFixtureType;
+  fixture.layer = kFixtureLayer;
+  fixture.fixtureId = 1;
+  fixture.address = "1.1";
+  fixture.transform.o = {2000.0f, 1000.0f, 5000.0f};
+  scene.fixtures[fixture.uuid] = fixture;
+
+  viewer2d::Viewer2DState state;
+  state.camera.view = static_cast<int>(Viewer2DView::Top);
+  state.camera.viewportWidth = 800;
+  state.camera.viewportHeight = 600;
+  state.renderOptions.showGrid = true;
+  state.renderOptions.gridStyle = 0;
+
+  Viewer2DHeadlessRenderer renderer;
+
+  CommandBuffer withGrid;
+  const Viewer2DViewState viewState = renderer.Capture(state, withGrid);
+  assert(!withGrid.commands.empty());
+  assert(withGrid.sources.size() == withGrid.commands.size());
+  assert(viewState.view == Viewer2DView::Top);
+  assert(viewState.viewportWidth == 800);
+  assert(viewState.viewportHeight == 600);
+
+  // The fixture cube is recorded under its type name.
+  assert(HasSource(withGrid, kFixtureType));
+
+  // Labels need NanoVG and therefore GL, so they are left out.
+  assert(CountCommands<TextCommand>(withGrid) == 0);
+
+  // A style 0 grid is 41 lines in each direction.
+  CommandBuffer withoutGrid;
+  renderer.Capture(state, withoutGrid, false, false);
+  assert(HasSource(withoutGrid, kFixtureType));
+  assert(CountCommands<LineCommand>(withGrid) -
+             CountCommands<LineCommand>(withoutGrid) ==
+         82);
+
+  // Hidden layers come from the state, not from ConfigManager.
+  state.layers.hiddenLayers = {kFixtureLayer};
+  CommandBuffer hidden;
+  renderer.Capture(state, hidden);
+  assert(!HasSource(hidden, kFixtureType));
+  assert(cfg.IsLayerVisible(kFixtureLayer));
+
+  return 0;
+}
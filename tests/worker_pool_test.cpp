@@ -0,0 +1,39 @@
+#include "workerpool.h"
+
+#include <atomic>
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+int main() {
+  WorkerPool pool(4);
+  assert(pool.ThreadCount() == 4);
+
+  auto future = pool.Submit([]() { return 21 * 2; });
+  assert(future.get() == 42);
+
+  std::vector<int> values(1000, 0);
+  ParallelFor(values.size(), [&](size_t i) { values[i] = static_cast<int>(i); },
+              pool);
+  for (size_t i = 0; i < values.size(); ++i)
+    assert(values[i] == static_cast<int>(i));
+
+  // Nested loops must not deadlock even when every worker is busy.
+  std::atomic<int> nested{0};
+  ParallelFor(8, [&](size_t) {
+    ParallelFor(8, [&](size_t) { ++nested; }, pool);
+  }, pool);
+  assert(nested == 64);
+
+  bool threw = false;
+  try {
+    ParallelFor(16, [](size_t i) {
+      if (i == 7)
+        throw std::runtime_error("boom");
+    }, pool);
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+  return 0;
+}
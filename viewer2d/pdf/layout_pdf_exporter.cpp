@@ -24,14 +24,14 @@
 #include <cctype>
 #include <cstdio>
 #include <filesystem>
-#include <fstream>
-#include <iomanip>
 #include <limits>
-#include <sstream>
+#include <map>
+#include <set>
 #include <string>
 #include <string_view>
 #include <cstdlib>
 #include <system_error>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,10 +39,14 @@
 
 
 #include "logger.h"
+#include "pdf_content_buffer.h"
+#include "pdf_content_renderer.h"
 #include "pdf_draw_commands.h"
 #include "pdf_font_metrics.h"
 #include "pdf_objects.h"
+#include "pdf_writer.h"
 #include "viewer2dcommandrenderer.h"
+#include "workerpool.h"
 
 namespace {
 using namespace layout_pdf_internal;
@@ -57,11 +61,6 @@ constexpr std::array<const char *, 7> kEventTableLabels = {
     "Venue:", "Location:", "Date:", "Stage:",
     "Version:", "Design:", "Mail:"};
 
-static bool ShouldTraceLabelOrder() {
-  static const bool enabled = std::getenv("PERASTAGE_TRACE_LABELS") != nullptr;
-  return enabled;
-}
-
 double ComputeTextLineAdvance(double ascent, double descent) {
   // Negative because PDF moves the text cursor downward with a negative y
   // translation. The advance mirrors the ascent + descent used by the
@@ -133,159 +132,6 @@ const SymbolDefinition *FindSymbolDefinitionExact(
   return nullptr;
 }
 
-// Emits only the stroke portion of a drawing command. Keeping strokes and
-// fills in separate functions allows the caller to control layering
-// explicitly, which is required to match the on-screen 2D viewer where fills
-// occlude internal wireframe edges within the same group.
-std::string RenderCommandsToStream(
-    const std::vector<CanvasCommand> &commands,
-    const std::vector<CommandMetadata> &metadata,
-    const std::vector<std::string> &sources, const Mapping &mapping,
-    const FloatFormatter &formatter, const RenderOptions &options) {
-  Transform current{};
-  std::vector<Transform> stack;
-  std::ostringstream content;
-  GraphicsStateCache stateCache;
-
-  std::vector<size_t> group;
-  std::string currentSource;
-
-  auto flushGroup = [&]() {
-    if (group.empty())
-      return;
-
-    // Use dedicated buffers for strokes and fills so layering is explicit and
-    // future exporters can reorder or post-process the layers independently.
-    std::ostringstream strokeLayer;
-    std::ostringstream fillLayer;
-
-    // Render all strokes first. They will be visually pushed underneath by the
-    // subsequent fill layer, mirroring how the real-time viewer relies on
-    // depth testing to hide internal wireframe segments.
-    for (size_t idx : group) {
-      if (!metadata[idx].hasStroke)
-        continue;
-      EmitCommandStroke(strokeLayer, stateCache, formatter, mapping, current,
-                        commands[idx], options);
-    }
-
-    // Render fills afterwards so they sit on top of any wireframe lines from
-    // the same piece, matching the 2D viewer's occlusion behavior.
-    for (size_t idx : group) {
-      if (!metadata[idx].hasFill)
-        continue;
-      EmitCommandFill(fillLayer, stateCache, formatter, mapping, current,
-                      commands[idx]);
-    }
-
-    content << strokeLayer.str() << fillLayer.str();
-
-    group.clear();
-  };
-
-  auto handleBarrier = [&](const auto &cmd, size_t idx) {
-    using T = std::decay_t<decltype(cmd)>;
-    if constexpr (std::is_same_v<T, SaveCommand>) {
-      stack.push_back(current);
-    } else if constexpr (std::is_same_v<T, RestoreCommand>) {
-      if (!stack.empty()) {
-        current = stack.back();
-        stack.pop_back();
-      }
-    } else if constexpr (std::is_same_v<T, TransformCommand>) {
-      current.scale = cmd.transform.scale;
-      current.offsetX = cmd.transform.offsetX;
-      current.offsetY = cmd.transform.offsetY;
-    } else if constexpr (std::is_same_v<T, TextCommand>) {
-      if (!options.includeText)
-        return;
-      auto pos = MapPointWithTransform(cmd.x, cmd.y, current, mapping);
-      if (ShouldTraceLabelOrder()) {
-        std::ostringstream trace;
-        trace << "[label-replay] index=" << idx;
-        if (idx < sources.size())
-          trace << " source=" << sources[idx];
-        trace << " text=\"" << cmd.text << "\" x=" << pos.x << " y="
-              << pos.y << " size=" << cmd.style.fontSize << " vAlign=";
-        switch (cmd.style.vAlign) {
-        case CanvasTextStyle::VerticalAlign::Baseline:
-          trace << "Baseline";
-          break;
-        case CanvasTextStyle::VerticalAlign::Middle:
-          trace << "Middle";
-          break;
-        case CanvasTextStyle::VerticalAlign::Top:
-          trace << "Top";
-          break;
-        case CanvasTextStyle::VerticalAlign::Bottom:
-          trace << "Bottom";
-          break;
-        }
-        Logger::Instance().Log(trace.str());
-      }
-      AppendText(content, formatter, pos, cmd, cmd.style, mapping.scale,
-                 options.fonts);
-    } else if constexpr (std::is_same_v<T, PlaceSymbolCommand>) {
-      if (!options.symbolKeyNames)
-        return;
-      auto nameIt = options.symbolKeyNames->find(cmd.key);
-      if (nameIt == options.symbolKeyNames->end())
-        return;
-      Transform2D local = TransformFromCanvas(cmd.transform);
-      AppendSymbolInstance(content, formatter, mapping, local, nameIt->second);
-    } else if constexpr (std::is_same_v<T, SymbolInstanceCommand>) {
-      if (!options.symbolIdNames)
-        return;
-      auto nameIt = options.symbolIdNames->find(cmd.symbolId);
-      if (nameIt == options.symbolIdNames->end())
-        return;
-      AppendSymbolInstance(content, formatter, mapping, cmd.transform,
-                           nameIt->second);
-    } else {
-      // Symbol control commands are handled at a higher level but must preserve
-      // ordering relative to drawing commands.
-    }
-  };
-
-  for (size_t i = 0; i < commands.size(); ++i) {
-    const auto &cmd = commands[i];
-
-    bool isBarrier = std::visit(
-        [&](auto &&c) {
-          using T = std::decay_t<decltype(c)>;
-          return std::is_same_v<T, SaveCommand> || std::is_same_v<T, RestoreCommand> ||
-                 std::is_same_v<T, TransformCommand> ||
-                 std::is_same_v<T, BeginSymbolCommand> ||
-                 std::is_same_v<T, EndSymbolCommand> ||
-                 std::is_same_v<T, PlaceSymbolCommand> ||
-                 std::is_same_v<T, SymbolInstanceCommand> ||
-                 std::is_same_v<T, TextCommand>;
-        },
-        cmd);
-
-    if (isBarrier) {
-      flushGroup();
-      std::visit([&](const auto &barrierCmd) { handleBarrier(barrierCmd, i); },
-                 cmd);
-      continue;
-    }
-
-    if (group.empty())
-      currentSource = sources[i];
-
-    if (sources[i] != currentSource) {
-      flushGroup();
-      currentSource = sources[i];
-    }
-
-    group.push_back(i);
-  }
-
-  flushGroup();
-
-  return content.str();
-}
-
 std::string MakePdfName(const std::string &key) {
   std::string name = "X";
   for (char ch : key) {
@@ -307,6 +153,47 @@ std::string MakeSymbolIdName(uint32_t symbolId) {
   return "S" + std::to_string(symbolId);
 }
 
+// Wraps stream data in a complete object body, deflating it when requested.
+// `dictEntries` holds any keys that precede /Length in the stream dictionary.
+std::string MakeStreamObject(std::string data, std::string_view dictEntries,
+                             bool compress) {
+  std::string compressed;
+  bool useCompression = false;
+  if (compress) {
+    std::string error;
+    useCompression = PdfDeflater::Compress(data, compressed, error);
+  }
+  const std::string &streamData = useCompression ? compressed : data;
+  PdfContentBuffer body(streamData.size() + dictEntries.size() + 64);
+  body << "<< ";
+  if (!dictEntries.empty())
+    body << dictEntries << ' ';
+  body << "/Length " << streamData.size();
+  if (useCompression)
+    body << " /Filter /FlateDecode";
+  body << " >>\nstream\n" << streamData << "endstream";
+  return body.Take();
+}
+
+// Encodes `count` independent objects on the worker pool and hands each
+// finished body to `write` in index order. Jobs are issued one window at a
+// time, sized to the number of threads that can work on it, so only that many
+// encoded objects are alive at once no matter how large the document is.
+template <typename Encode, typename Write>
+void EncodeInWindows(size_t count, Encode &&encode, Write &&write) {
+  const size_t window = WorkerPool::Shared().ThreadCount() + 1;
+  std::vector<std::string> bodies;
+  for (size_t start = 0; start < count; start += window) {
+    const size_t batch = std::min(window, count - start);
+    bodies.assign(batch, std::string());
+    ParallelFor(batch, [&](size_t i) { bodies[i] = encode(start + i); });
+    for (size_t i = 0; i < batch; ++i) {
+      write(start + i, bodies[i]);
+      std::string().swap(bodies[i]);
+    }
+  }
+}
+
 } // namespace
 
 Viewer2DExportResult ExportViewer2DToPdf(
@@ -483,28 +370,29 @@ Viewer2DExportResult ExportViewer2DToPdf(
   mainOptions.symbolIdNames = &xObjectIdNames;
   mainOptions.fonts = &fontCatalog;
   mainOptions.strokeScale = strokeScale;
-  std::string contentStr =
-      RenderCommandsToStream(mainCommands.commands, mainCommands.metadata,
-                             mainCommands.sources, pageMapping, formatter,
-                             mainOptions);
-  std::string compressedContent;
-  bool useCompression = false;
-  if (options.compressStreams) {
-    std::string error;
-    if (PdfDeflater::Compress(contentStr, compressedContent, error)) {
-      useCompression = true;
-    }
+  PdfContentBuffer contentStream;
+  RenderCommandsToStream(contentStream, mainCommands.commands,
+                         mainCommands.metadata, mainCommands.sources,
+                         pageMapping, formatter, mainOptions);
+
+  // Objects go to disk as soon as they are complete; the page content stays
+  // in memory only until it has been deflated into the file.
+  PdfWriter writer;
+  std::string writeError;
+  if (!writer.Open(outputPath, writeError)) {
+    result.message = writeError;
+    return result;
   }
-  std::vector<PdfObject> objects;
-  if (regularMetricsLoaded && AppendEmbeddedFontObjects(objects, regularFont)) {
+
+  if (regularMetricsLoaded && AppendEmbeddedFontObjects(writer, regularFont)) {
     // Embedded font loaded successfully.
   } else {
     Logger::Instance().Log(
         "PDF export: falling back to Type1 Helvetica (embedded font not found)");
-    AppendFallbackType1Font(objects, regularFont, "Helvetica");
+    AppendFallbackType1Font(writer, regularFont, "Helvetica");
   }
 
-  if (boldMetricsLoaded && AppendEmbeddedFontObjects(objects, boldFont)) {
+  if (boldMetricsLoaded && AppendEmbeddedFontObjects(writer, boldFont)) {
     // Embedded bold font loaded successfully.
   } else if (regularFont.objectId != 0) {
     boldFont.objectId = regularFont.objectId;
@@ -513,32 +401,23 @@ Viewer2DExportResult ExportViewer2DToPdf(
   } else {
     Logger::Instance().Log(
         "PDF export: falling back to Type1 Helvetica-Bold (embedded font not found)");
-    AppendFallbackType1Font(objects, boldFont, "Helvetica-Bold");
+    AppendFallbackType1Font(writer, boldFont, "Helvetica-Bold");
   }
 
   Mapping symbolMapping{};
   symbolMapping.scale = 1.0;
   symbolMapping.flipY = false;
 
-  auto appendSymbolObject = [&](const std::string &name,
-                                const std::vector<CanvasCommand> &commands,
+  auto appendSymbolObject = [&](const std::vector<CanvasCommand> &commands,
                                 const std::vector<CommandMetadata> &metadata,
                                 const std::vector<std::string> &sources,
                                 const SymbolBounds &bounds) {
     RenderOptions symbolOptions{};
     symbolOptions.includeText = false;
     symbolOptions.strokeScale = strokeScale;
-    std::string symbolContent =
-        RenderCommandsToStream(commands, metadata, sources, symbolMapping,
-                               formatter, symbolOptions);
-    std::string compressedSymbol;
-    bool compressed = false;
-    if (options.compressStreams) {
-      std::string error;
-      compressed = PdfDeflater::Compress(symbolContent, compressedSymbol, error);
-    }
-    const std::string &symbolStream =
-        compressed ? compressedSymbol : symbolContent;
+    PdfContentBuffer symbolBuffer;
+    RenderCommandsToStream(symbolBuffer, commands, metadata, sources,
+                           symbolMapping, formatter, symbolOptions);
     double minX = bounds.min.x * symbolMapping.scale;
     double minY = bounds.min.y * symbolMapping.scale;
     double maxX = bounds.max.x * symbolMapping.scale;
@@ -547,51 +426,41 @@ Viewer2DExportResult ExportViewer2DToPdf(
       std::swap(minX, maxX);
     if (minY > maxY)
       std::swap(minY, maxY);
-    std::ostringstream xobj;
-    xobj << "<< /Type /XObject /Subtype /Form /BBox ["
-         << formatter.Format(minX) << ' ' << formatter.Format(minY) << ' '
-         << formatter.Format(maxX) << ' ' << formatter.Format(maxY)
-         << "] /Resources << >> /Length " << symbolStream.size();
-    if (compressed)
-      xobj << " /Filter /FlateDecode";
-    xobj << " >>\nstream\n" << symbolStream << "endstream";
-    objects.push_back({xobj.str()});
-    return objects.size();
+    PdfContentBuffer dict;
+    dict << "/Type /XObject /Subtype /Form /BBox [" << formatter.Format(minX)
+         << ' ' << formatter.Format(minY) << ' ' << formatter.Format(maxX)
+         << ' ' << formatter.Format(maxY) << "] /Resources << >>";
+    return writer.WriteStream(dict.View(), symbolBuffer.View(),
+                              options.compressStreams);
   };
 
   for (const auto &entry : symbolDefinitions) {
-    auto nameIt = xObjectKeyNames.find(entry.first);
-    if (nameIt == xObjectKeyNames.end())
+    if (xObjectKeyNames.count(entry.first) == 0)
       continue;
     SymbolBounds bounds = ComputeSymbolBounds(entry.second.commands);
     xObjectKeyIds[entry.first] =
-        appendSymbolObject(nameIt->second, entry.second.commands,
-                           entry.second.metadata, entry.second.sources, bounds);
+        appendSymbolObject(entry.second.commands, entry.second.metadata,
+                           entry.second.sources, bounds);
   }
 
   if (symbolSnapshot) {
     for (uint32_t symbolId : usedSymbolIds) {
-      auto nameIt = xObjectIdNames.find(symbolId);
-      if (nameIt == xObjectIdNames.end())
+      if (xObjectIdNames.count(symbolId) == 0)
         continue;
       const auto &definition = symbolSnapshot->at(symbolId);
       xObjectIdIds[symbolId] =
-          appendSymbolObject(nameIt->second, definition.localCommands.commands,
+          appendSymbolObject(definition.localCommands.commands,
                              definition.localCommands.metadata,
                              definition.localCommands.sources,
                              definition.bounds);
     }
   }
 
-  std::ostringstream contentObj;
-  const std::string &streamData = useCompression ? compressedContent : contentStr;
-  contentObj << "<< /Length " << streamData.size();
-  if (useCompression)
-    contentObj << " /Filter /FlateDecode";
-  contentObj << " >>\nstream\n" << streamData << "endstream";
-  objects.push_back({contentObj.str()});
+  const size_t contentIndex =
+      writer.WriteStream({}, contentStream.View(), options.compressStreams);
+  contentStream = PdfContentBuffer();
 
-  std::ostringstream resources;
+  PdfContentBuffer resources;
   resources << "<< /Font << /F1 " << regularFont.objectId << " 0 R";
   if (boldFont.objectId != 0 && boldFont.objectId != regularFont.objectId)
     resources << " /F2 " << boldFont.objectId << " 0 R";
@@ -616,88 +485,95 @@ Viewer2DExportResult ExportViewer2DToPdf(
   }
   resources << " >>";
 
-  std::ostringstream pageObj;
-  size_t contentIndex = objects.size();
-  size_t pageIndex = contentIndex + 1;
-  size_t pagesIndex = pageIndex + 1;
-  size_t catalogIndex = pagesIndex + 1;
+  const size_t pageIndex = writer.ReserveObject();
+  const size_t pagesIndex = writer.ReserveObject();
+  const size_t catalogIndex = writer.ReserveObject();
 
+  PdfContentBuffer pageObj;
   pageObj << "<< /Type /Page /Parent " << pagesIndex << " 0 R /MediaBox [0 0 "
           << formatter.Format(pageW) << ' ' << formatter.Format(pageH)
           << "] /Contents " << contentIndex << " 0 R /Resources "
-          << resources.str() << " >>";
-  objects.push_back({pageObj.str()});
-  objects.push_back({"<< /Type /Pages /Kids [" + std::to_string(pageIndex) +
-                    " 0 R] /Count 1 >>"});
-  objects.push_back({"<< /Type /Catalog /Pages " + std::to_string(pagesIndex) +
-                    " 0 R >>"});
-
-  try {
-    std::ofstream file(outputPath, std::ios::binary);
-    if (!file.is_open()) {
-      result.message = "Unable to open the destination file for writing.";
-      return result;
-    }
-
-    file << "%PDF-1.4\n";
-    std::vector<long> offsets;
-    offsets.reserve(objects.size());
-    for (size_t i = 0; i < objects.size(); ++i) {
-      offsets.push_back(static_cast<long>(file.tellp()));
-      file << (i + 1) << " 0 obj\n" << objects[i].body << "\nendobj\n";
-    }
-
-    long xrefPos = static_cast<long>(file.tellp());
-    file << "xref\n0 " << (objects.size() + 1)
-         << "\n0000000000 65535 f \n";
-    for (long off : offsets) {
-      file << std::setw(10) << std::setfill('0') << off << " 00000 n \n";
-    }
-    file << "trailer\n<< /Size " << (objects.size() + 1)
-         << " /Root " << catalogIndex
-         << " 0 R >>\nstartxref\n" << xrefPos << "\n%%EOF";
-    result.success = true;
-  } catch (const std::exception &ex) {
-    result.message = std::string("Failed to generate PDF content: ") + ex.what();
-    return result;
-  } catch (...) {
-    result.message = "An unknown error occurred while generating the PDF plan.";
+          << resources << " >>";
+  writer.WriteObject(pageIndex, pageObj.View());
+  writer.WriteObject(pagesIndex, "<< /Type /Pages /Kids [" +
+                                     std::to_string(pageIndex) +
+                                     " 0 R] /Count 1 >>");
+  writer.WriteObject(catalogIndex, "<< /Type /Catalog /Pages " +
+                                       std::to_string(pagesIndex) + " 0 R >>");
+
+  if (!writer.Finish(catalogIndex, writeError)) {
+    result.message = writeError;
     return result;
   }
-
+  result.success = true;
   return result;
 }
 
-Viewer2DExportResult ExportLayoutToPdf(
-    const std::vector<LayoutViewExportData> &views,
-    const std::vector<LayoutLegendExportData> &legends,
-    const std::vector<LayoutEventTableExportData> &tables,
-    const std::vector<LayoutTextExportData> &texts,
-    const Viewer2DPrintOptions &options,
-    const std::filesystem::path &outputPath) {
-  Viewer2DExportResult result{};
+namespace {
 
-  if (views.empty()) {
-    result.message = "No layout views were provided for export.";
-    return result;
+// Identifies a rendered symbol form independently of the page and view that
+// asked for it, so a symbol repeated across the pages of a batch export is
+// written as a single XObject.
+struct SymbolFormKey {
+  std::string source;
+  double symbolScale = 1.0;
+  double strokeScale = 1.0;
+
+  bool operator<(const SymbolFormKey &other) const {
+    return std::tie(source, symbolScale, strokeScale) <
+           std::tie(other.source, other.symbolScale, other.strokeScale);
   }
+};
+
+SymbolFormKey MakeSymbolFormKey(const SymbolKey &key, double symbolScale,
+                                double strokeScale) {
+  return {"symbol:" + key.modelKey + '#' +
+              std::to_string(static_cast<int>(key.viewKind)) + '#' +
+              std::to_string(key.styleVersion),
+          symbolScale, strokeScale};
+}
 
-  if (outputPath.empty() || outputPath.filename().empty()) {
-    result.message = "No output file was provided for the PDF layout.";
-    return result;
-  }
+// State shared by every page of a layout document: the writer, the fonts that
+// are embedded once up front and the symbol forms written so far.
+struct LayoutDocument {
+  PdfWriter &writer;
+  const Viewer2DPrintOptions &options;
+  PdfFontDefinition regularFont;
+  PdfFontDefinition boldFont;
+  std::map<SymbolFormKey, size_t> symbolFormIds;
+  size_t pagesId = 0;
+};
+
+struct LayoutPageRef {
+  const std::vector<LayoutViewExportData> &views;
+  const std::vector<LayoutLegendExportData> &legends;
+  const std::vector<LayoutEventTableExportData> &tables;
+  const std::vector<LayoutTextExportData> &texts;
+  double pageWidthPt = 0.0;
+  double pageHeightPt = 0.0;
+};
+
+// Renders one layout page and writes its content streams, any symbol forms
+// the document does not have yet and the page object itself. The id of the
+// page object is returned through `pageId`.
+Viewer2DExportResult WriteLayoutPage(LayoutDocument &document,
+                                     const LayoutPageRef &page,
+                                     size_t &pageId) {
+  Viewer2DExportResult result{};
+  const auto &views = page.views;
+  const auto &legends = page.legends;
+  const auto &tables = page.tables;
+  const auto &texts = page.texts;
+  const Viewer2DPrintOptions &options = document.options;
+  PdfWriter &writer = document.writer;
 
-  const auto parent = outputPath.parent_path();
-  std::error_code pathEc;
-  if (!parent.empty() && !std::filesystem::exists(parent, pathEc)) {
-    result.message =
-        pathEc ? "Unable to verify the selected folder for the PDF layout." :
-                 "The selected folder does not exist.";
+  if (views.empty()) {
+    result.message = "No layout views were provided for export.";
     return result;
   }
 
-  const double pageW = options.pageWidthPt;
-  const double pageH = options.pageHeightPt;
+  const double pageW = page.pageWidthPt;
+  const double pageH = page.pageHeightPt;
   if (pageW <= 0.0 || pageH <= 0.0) {
     result.message = "The selected paper size leaves no space for drawing.";
     return result;
@@ -886,7 +762,6 @@ Viewer2DExportResult ExportLayoutToPdf(
     }
   }
 
-  std::ostringstream contentStream;
   auto encodeText = [&](const std::string &text) {
     return EncodeWinAnsi(text);
   };
@@ -956,83 +831,69 @@ Viewer2DExportResult ExportLayoutToPdf(
                              std::to_string(id));
   };
 
-  std::vector<PdfObject> objects;
-  PdfFontDefinition regularFont;
-  regularFont.key = "F1";
-  regularFont.family = "sans";
-  regularFont.baseName = "PerastageSans";
-  PdfFontDefinition boldFont;
-  boldFont.key = "F2";
-  boldFont.family = "sans-bold";
-  boldFont.baseName = "PerastageSansBold";
+  PdfFontDefinition &regularFont = document.regularFont;
+  PdfFontDefinition &boldFont = document.boldFont;
+  PdfFontCatalog fontCatalog{&regularFont, &boldFont};
 
-  auto loadFont = [&](PdfFontDefinition &font, bool bold) {
-    if (!LoadPdfFontMetrics(font, bold))
-      return false;
-    return AppendEmbeddedFontObjects(objects, font);
+  // Symbol forms are independent of each other, so they are collected first
+  // and then encoded and compressed in parallel. Object ids are assigned as
+  // the forms are written in job order, which keeps the output deterministic.
+  // Forms already written for an earlier page are only referenced.
+  struct SymbolFormJob {
+    SymbolFormKey form;
+    const std::vector<CanvasCommand> *commands = nullptr;
+    const std::vector<CommandMetadata> *metadata = nullptr;
+    const std::vector<std::string> *sources = nullptr;
+    double symbolScale = 1.0;
+    double strokeScale = 1.0;
+    SymbolBounds bounds{};
+  };
+  std::vector<SymbolFormJob> symbolJobs;
+  std::vector<std::pair<std::string, SymbolFormKey>> symbolNameForms;
+  std::unordered_set<std::string> queuedSymbolNames;
+  std::set<SymbolFormKey> queuedForms;
+  auto queueSymbolObject = [&](const std::string &name, SymbolFormKey form,
+                               const std::vector<CanvasCommand> &commands,
+                               const std::vector<CommandMetadata> &metadata,
+                               const std::vector<std::string> &sources,
+                               const SymbolBounds &bounds) {
+    if (!queuedSymbolNames.insert(name).second)
+      return;
+    symbolNameForms.emplace_back(name, form);
+    if (document.symbolFormIds.count(form) != 0 ||
+        !queuedForms.insert(form).second)
+      return;
+    const double symbolScale = form.symbolScale;
+    const double strokeScale = form.strokeScale;
+    symbolJobs.push_back({std::move(form), &commands, &metadata, &sources,
+                          symbolScale, strokeScale, bounds});
   };
 
-  if (!loadFont(regularFont, false)) {
-    Logger::Instance().Log(
-        "PDF export: falling back to Type1 Helvetica (embedded font not found)");
-    AppendFallbackType1Font(objects, regularFont, "Helvetica");
-  }
-
-  bool boldLoaded = loadFont(boldFont, true);
-  if (!boldLoaded && regularFont.objectId != 0) {
-    boldFont = regularFont;
-    boldFont.key = "F2";
-    boldFont.family = "sans-bold";
-  } else if (!boldLoaded) {
-    Logger::Instance().Log(
-        "PDF export: falling back to Type1 Helvetica-Bold (embedded font not found)");
-    AppendFallbackType1Font(objects, boldFont, "Helvetica-Bold");
-  }
-
-  PdfFontCatalog fontCatalog{&regularFont, &boldFont};
-
-  auto appendSymbolObject = [&](const std::string &name,
-                                const std::vector<CanvasCommand> &commands,
-                                const std::vector<CommandMetadata> &metadata,
-                                const std::vector<std::string> &sources,
-                                double symbolScale,
-                                double strokeScale,
-                                const SymbolBounds &bounds) {
+  auto encodeSymbolObject = [&](const SymbolFormJob &job) {
     Mapping symbolMapping{};
-    symbolMapping.scale = symbolScale;
+    symbolMapping.scale = job.symbolScale;
     symbolMapping.flipY = false;
     RenderOptions symbolOptions{};
     symbolOptions.includeText = false;
-    symbolOptions.strokeScale = strokeScale;
-    std::string symbolContent =
-        RenderCommandsToStream(commands, metadata, sources, symbolMapping,
-                               formatter, symbolOptions);
-    std::string compressedSymbol;
-    bool compressed = false;
-    if (options.compressStreams) {
-      std::string error;
-      compressed = PdfDeflater::Compress(symbolContent, compressedSymbol, error);
-    }
-    const std::string &symbolStream =
-        compressed ? compressedSymbol : symbolContent;
-    double minX = bounds.min.x * symbolMapping.scale;
-    double minY = bounds.min.y * symbolMapping.scale;
-    double maxX = bounds.max.x * symbolMapping.scale;
-    double maxY = bounds.max.y * symbolMapping.scale;
+    symbolOptions.strokeScale = job.strokeScale;
+    PdfContentBuffer symbolBuffer;
+    RenderCommandsToStream(symbolBuffer, *job.commands, *job.metadata,
+                           *job.sources, symbolMapping, formatter,
+                           symbolOptions);
+    double minX = job.bounds.min.x * symbolMapping.scale;
+    double minY = job.bounds.min.y * symbolMapping.scale;
+    double maxX = job.bounds.max.x * symbolMapping.scale;
+    double maxY = job.bounds.max.y * symbolMapping.scale;
     if (minX > maxX)
       std::swap(minX, maxX);
     if (minY > maxY)
       std::swap(minY, maxY);
-    std::ostringstream xobj;
-    xobj << "<< /Type /XObject /Subtype /Form /BBox ["
-         << formatter.Format(minX) << ' ' << formatter.Format(minY) << ' '
-         << formatter.Format(maxX) << ' ' << formatter.Format(maxY)
-         << "] /Resources << >> /Length " << symbolStream.size();
-    if (compressed)
-      xobj << " /Filter /FlateDecode";
-    xobj << " >>\nstream\n" << symbolStream << "endstream";
-    objects.push_back({xobj.str()});
-    return objects.size();
+    PdfContentBuffer dict;
+    dict << "/Type /XObject /Subtype /Form /BBox [" << formatter.Format(minX)
+         << ' ' << formatter.Format(minY) << ' ' << formatter.Format(maxX)
+         << ' ' << formatter.Format(maxY) << "] /Resources << >>";
+    return MakeStreamObject(symbolBuffer.Take(), dict.View(),
+                            options.compressStreams);
   };
 
 
@@ -1061,10 +922,10 @@ Viewer2DExportResult ExportLayoutToPdf(
       if (defIt == symbolDefinitions.end())
         continue;
       SymbolBounds bounds = ComputeSymbolBounds(defIt->second.commands);
-      xObjectNameIds[entry.second] =
-          appendSymbolObject(entry.second, defIt->second.commands,
-                             defIt->second.metadata, defIt->second.sources,
-                             1.0, group.strokeScale, bounds);
+      queueSymbolObject(entry.second,
+                        {"key:" + entry.first, 1.0, group.strokeScale},
+                        defIt->second.commands, defIt->second.metadata,
+                        defIt->second.sources, bounds);
     }
 
     if (symbolSnapshot) {
@@ -1072,21 +933,18 @@ Viewer2DExportResult ExportLayoutToPdf(
         auto defIt = symbolSnapshot->find(entry.first);
         if (defIt == symbolSnapshot->end())
           continue;
-        xObjectNameIds[entry.second] =
-            appendSymbolObject(entry.second,
-                               defIt->second.localCommands.commands,
-                               defIt->second.localCommands.metadata,
-                               defIt->second.localCommands.sources,
-                               1.0, group.strokeScale,
-                               defIt->second.bounds);
+        queueSymbolObject(
+            entry.second,
+            MakeSymbolFormKey(defIt->second.key, 1.0, group.strokeScale),
+            defIt->second.localCommands.commands,
+            defIt->second.localCommands.metadata,
+            defIt->second.localCommands.sources, defIt->second.bounds);
       }
     }
   }
 
   if (symbolSnapshot) {
     for (const auto &entry : legendSymbolNames) {
-      if (xObjectNameIds.count(entry.second) != 0)
-        continue;
       auto defIt = symbolSnapshot->find(entry.first);
       if (defIt == symbolSnapshot->end())
         continue;
@@ -1099,16 +957,24 @@ Viewer2DExportResult ExportLayoutToPdf(
         symbolScale =
             std::min(kLegendSymbolSize / symbolW, kLegendSymbolSize / symbolH);
       }
-      xObjectNameIds[entry.second] =
-          appendSymbolObject(entry.second,
-                             defIt->second.localCommands.commands,
-                             defIt->second.localCommands.metadata,
-                             defIt->second.localCommands.sources,
-                             symbolScale, legendStrokeScale,
-                             defIt->second.bounds);
+      queueSymbolObject(
+          entry.second,
+          MakeSymbolFormKey(defIt->second.key, symbolScale, legendStrokeScale),
+          defIt->second.localCommands.commands,
+          defIt->second.localCommands.metadata,
+          defIt->second.localCommands.sources, defIt->second.bounds);
     }
   }
 
+  EncodeInWindows(
+      symbolJobs.size(),
+      [&](size_t i) { return encodeSymbolObject(symbolJobs[i]); },
+      [&](size_t i, const std::string &body) {
+        document.symbolFormIds[symbolJobs[i].form] = writer.WriteObject(body);
+      });
+  for (const auto &entry : symbolNameForms)
+    xObjectNameIds[entry.first] = document.symbolFormIds.at(entry.second);
+
 
   struct LayoutRenderElement {
     enum class Type { View, Legend, EventTable, Text };
@@ -1150,7 +1016,7 @@ Viewer2DExportResult ExportLayoutToPdf(
                      return lhs.order < rhs.order;
                    });
 
-  auto renderViewGroup = [&](size_t idx) {
+  auto renderViewGroup = [&](PdfContentBuffer &contentStream, size_t idx) {
     const auto &group = layoutGroups[idx];
     std::unordered_map<std::string, std::string> viewKeyNames;
     std::unordered_map<uint32_t, std::string> viewIdNames;
@@ -1170,11 +1036,9 @@ Viewer2DExportResult ExportLayoutToPdf(
                   << formatter.Format(group.frameY) << ' '
                   << formatter.Format(group.frameW) << ' '
                   << formatter.Format(group.frameH) << " re f\n";
-    contentStream << RenderCommandsToStream(group.commands.commands,
-                                            group.commands.metadata,
-                                            group.commands.sources,
-                                            group.mapping, formatter,
-                                            mainOptions);
+    RenderCommandsToStream(contentStream, group.commands.commands,
+                           group.commands.metadata, group.commands.sources,
+                           group.mapping, formatter, mainOptions);
     contentStream << "Q\n";
     contentStream << "q\n0 0 0 RG 0.5 w "
                   << formatter.Format(group.frameX) << ' '
@@ -1183,7 +1047,7 @@ Viewer2DExportResult ExportLayoutToPdf(
                   << formatter.Format(group.frameH) << " re S\nQ\n";
   };
 
-  auto renderLegend = [&](size_t idx) {
+  auto renderLegend = [&](PdfContentBuffer &contentStream, size_t idx) {
     const auto &legend = legends[idx];
     const double frameX = static_cast<double>(legend.frame.x);
     const double frameY =
@@ -1432,7 +1296,7 @@ Viewer2DExportResult ExportLayoutToPdf(
                   << formatter.Format(frameH) << " re S\nQ\n";
   };
 
-  auto renderEventTable = [&](size_t idx) {
+  auto renderEventTable = [&](PdfContentBuffer &contentStream, size_t idx) {
     const auto &table = tables[idx];
     const double frameX = static_cast<double>(table.frame.x);
     const double frameY =
@@ -1521,7 +1385,7 @@ Viewer2DExportResult ExportLayoutToPdf(
                   << formatter.Format(frameH) << " re S\nQ\n";
   };
 
-  auto renderText = [&](size_t idx) {
+  auto renderText = [&](PdfContentBuffer &contentStream, size_t idx) {
     const auto &text = texts[idx];
     const double frameW = static_cast<double>(text.frame.width);
     const double frameH = static_cast<double>(text.frame.height);
@@ -1615,39 +1479,38 @@ Viewer2DExportResult ExportLayoutToPdf(
     }
   };
 
-  for (const auto &entry : renderOrder) {
-    if (entry.type == LayoutRenderElement::Type::View) {
-      renderViewGroup(entry.index);
-    } else if (entry.type == LayoutRenderElement::Type::Legend) {
-      renderLegend(entry.index);
-    } else if (entry.type == LayoutRenderElement::Type::EventTable) {
-      renderEventTable(entry.index);
-    } else {
-      renderText(entry.index);
-    }
-  }
-
-  std::string contentStr = contentStream.str();
-
-  std::string compressedContent;
-  bool useCompression = false;
-  if (options.compressStreams) {
-    std::string error;
-    if (PdfDeflater::Compress(contentStr, compressedContent, error)) {
-      useCompression = true;
-    }
-  }
-
-  std::ostringstream contentObj;
-  const std::string &streamData =
-      useCompression ? compressedContent : contentStr;
-  contentObj << "<< /Length " << streamData.size();
-  if (useCompression)
-    contentObj << " /Filter /FlateDecode";
-  contentObj << " >>\nstream\n" << streamData << "endstream";
-  objects.push_back({contentObj.str()});
-
-  std::ostringstream resources;
+  // Every layout element becomes its own content-stream fragment so views,
+  // legends, tables and text blocks can be encoded and deflated in parallel.
+  // The page lists the fragments in z-order through a /Contents array, which
+  // PDF readers concatenate into a single content stream.
+  std::vector<size_t> contentIds;
+  contentIds.reserve(renderOrder.size());
+  EncodeInWindows(
+      renderOrder.size(),
+      [&](size_t i) {
+        const auto &entry = renderOrder[i];
+        PdfContentBuffer fragment;
+        if (entry.type == LayoutRenderElement::Type::View) {
+          renderViewGroup(fragment, entry.index);
+        } else if (entry.type == LayoutRenderElement::Type::Legend) {
+          renderLegend(fragment, entry.index);
+        } else if (entry.type == LayoutRenderElement::Type::EventTable) {
+          renderEventTable(fragment, entry.index);
+        } else {
+          renderText(fragment, entry.index);
+        }
+        if (fragment.Empty())
+          return std::string();
+        return MakeStreamObject(fragment.Take(), {}, options.compressStreams);
+      },
+      [&](size_t, const std::string &body) {
+        if (!body.empty())
+          contentIds.push_back(writer.WriteObject(body));
+      });
+  if (contentIds.empty())
+    contentIds.push_back(writer.WriteStream({}, {}, false));
+
+  PdfContentBuffer resources;
   resources << "<< /Font << /F1 " << regularFont.objectId << " 0 R";
   if (boldFont.objectId != 0 && boldFont.objectId != regularFont.objectId)
     resources << " /F2 " << boldFont.objectId << " 0 R";
@@ -1663,55 +1526,155 @@ Viewer2DExportResult ExportLayoutToPdf(
   }
   resources << " >>";
 
-  std::ostringstream pageObj;
-  size_t contentIndex = objects.size();
-  size_t pageIndex = contentIndex + 1;
-  size_t pagesIndex = pageIndex + 1;
-  size_t catalogIndex = pagesIndex + 1;
-
-  pageObj << "<< /Type /Page /Parent " << pagesIndex
+  PdfContentBuffer pageObj;
+  pageObj << "<< /Type /Page /Parent " << document.pagesId
           << " 0 R /MediaBox [0 0 " << formatter.Format(pageW) << ' '
-          << formatter.Format(pageH) << "] /Contents " << contentIndex
-          << " 0 R /Resources " << resources.str() << " >>";
-  objects.push_back({pageObj.str()});
-  objects.push_back({"<< /Type /Pages /Kids [" + std::to_string(pageIndex) +
-                    " 0 R] /Count 1 >>"});
-  objects.push_back({"<< /Type /Catalog /Pages " +
-                    std::to_string(pagesIndex) + " 0 R >>"});
-
-  try {
-    std::ofstream file(outputPath, std::ios::binary);
-    if (!file.is_open()) {
-      result.message = "Unable to open the destination file for writing.";
-      return result;
+          << formatter.Format(pageH) << "] /Contents ";
+  if (contentIds.size() == 1) {
+    pageObj << contentIds.front() << " 0 R";
+  } else {
+    pageObj << '[';
+    for (size_t i = 0; i < contentIds.size(); ++i) {
+      if (i != 0)
+        pageObj << ' ';
+      pageObj << contentIds[i] << " 0 R";
     }
+    pageObj << ']';
+  }
+  pageObj << " /Resources " << resources << " >>";
+  pageId = writer.WriteObject(pageObj.View());
+  result.success = true;
+  return result;
+}
 
-    file << "%PDF-1.4\n";
-    std::vector<long> offsets;
-    offsets.reserve(objects.size());
-    for (size_t i = 0; i < objects.size(); ++i) {
-      offsets.push_back(static_cast<long>(file.tellp()));
-      file << (i + 1) << " 0 obj\n" << objects[i].body << "\nendobj\n";
-    }
+Viewer2DExportResult WriteLayoutDocument(const std::vector<LayoutPageRef> &pages,
+                                         const Viewer2DPrintOptions &options,
+                                         const std::filesystem::path &outputPath) {
+  Viewer2DExportResult result{};
 
-    long xrefPos = static_cast<long>(file.tellp());
-    file << "xref\n0 " << (objects.size() + 1)
-         << "\n0000000000 65535 f \n";
-    for (long off : offsets) {
-      file << std::setw(10) << std::setfill('0') << off << " 00000 n \n";
-    }
-    file << "trailer\n<< /Size " << (objects.size() + 1)
-         << " /Root " << catalogIndex
-         << " 0 R >>\nstartxref\n" << xrefPos << "\n%%EOF";
-    result.success = true;
-  } catch (const std::exception &ex) {
+  if (pages.empty()) {
+    result.message = "No layouts were provided for export.";
+    return result;
+  }
+
+  if (outputPath.empty() || outputPath.filename().empty()) {
+    result.message = "No output file was provided for the PDF layout.";
+    return result;
+  }
+
+  const auto parent = outputPath.parent_path();
+  std::error_code pathEc;
+  if (!parent.empty() && !std::filesystem::exists(parent, pathEc)) {
     result.message =
-        std::string("Failed to generate PDF content: ") + ex.what();
+        pathEc ? "Unable to verify the selected folder for the PDF layout." :
+                 "The selected folder does not exist.";
     return result;
-  } catch (...) {
-    result.message = "An unknown error occurred while generating the PDF plan.";
+  }
+
+  // Objects are written as soon as they are finished, so the document is
+  // never held in memory as a whole.
+  PdfWriter writer;
+  std::string writeError;
+  if (!writer.Open(outputPath, writeError)) {
+    result.message = writeError;
     return result;
   }
 
+  LayoutDocument document{writer, options, {}, {}, {}, 0};
+  PdfFontDefinition &regularFont = document.regularFont;
+  regularFont.key = "F1";
+  regularFont.family = "sans";
+  regularFont.baseName = "PerastageSans";
+  PdfFontDefinition &boldFont = document.boldFont;
+  boldFont.key = "F2";
+  boldFont.family = "sans-bold";
+  boldFont.baseName = "PerastageSansBold";
+
+  auto loadFont = [&](PdfFontDefinition &font, bool bold) {
+    if (!LoadPdfFontMetrics(font, bold))
+      return false;
+    return AppendEmbeddedFontObjects(writer, font);
+  };
+
+  if (!loadFont(regularFont, false)) {
+    Logger::Instance().Log(
+        "PDF export: falling back to Type1 Helvetica (embedded font not found)");
+    AppendFallbackType1Font(writer, regularFont, "Helvetica");
+  }
+
+  bool boldLoaded = loadFont(boldFont, true);
+  if (!boldLoaded && regularFont.objectId != 0) {
+    boldFont = regularFont;
+    boldFont.key = "F2";
+    boldFont.family = "sans-bold";
+  } else if (!boldLoaded) {
+    Logger::Instance().Log(
+        "PDF export: falling back to Type1 Helvetica-Bold (embedded font not found)");
+    AppendFallbackType1Font(writer, boldFont, "Helvetica-Bold");
+  }
+
+
+  // Pages point at their parent before the page tree can be written, so its
+  // id is reserved up front and the tree is emitted after the last page.
+  document.pagesId = writer.ReserveObject();
+  std::vector<size_t> pageIds;
+  pageIds.reserve(pages.size());
+  for (const auto &page : pages) {
+    size_t pageId = 0;
+    Viewer2DExportResult pageResult = WriteLayoutPage(document, page, pageId);
+    if (!pageResult.success)
+      return pageResult;
+    pageIds.push_back(pageId);
+  }
+
+  PdfContentBuffer pagesObj;
+  pagesObj << "<< /Type /Pages /Kids [";
+  for (size_t i = 0; i < pageIds.size(); ++i) {
+    if (i != 0)
+      pagesObj << ' ';
+    pagesObj << pageIds[i] << " 0 R";
+  }
+  pagesObj << "] /Count " << pageIds.size() << " >>";
+  writer.WriteObject(document.pagesId, pagesObj.View());
+  const size_t catalogIndex = writer.WriteObject(
+      "<< /Type /Catalog /Pages " + std::to_string(document.pagesId) +
+      " 0 R >>");
+
+  if (!writer.Finish(catalogIndex, writeError)) {
+    result.message = writeError;
+    return result;
+  }
+  result.success = true;
   return result;
 }
+
+} // namespace
+
+Viewer2DExportResult ExportLayoutToPdf(
+    const std::vector<LayoutViewExportData> &views,
+    const std::vector<LayoutLegendExportData> &legends,
+    const std::vector<LayoutEventTableExportData> &tables,
+    const std::vector<LayoutTextExportData> &texts,
+    const Viewer2DPrintOptions &options,
+    const std::filesystem::path &outputPath) {
+  std::vector<LayoutPageRef> pages;
+  pages.push_back({views, legends, tables, texts, options.pageWidthPt,
+                   options.pageHeightPt});
+  return WriteLayoutDocument(pages, options, outputPath);
+}
+
+Viewer2DExportResult ExportLayoutsToPdf(
+    const std::vector<LayoutPageExportData> &pages,
+    const Viewer2DPrintOptions &options,
+    const std::filesystem::path &outputPath) {
+  std::vector<LayoutPageRef> refs;
+  refs.reserve(pages.size());
+  for (const auto &page : pages) {
+    refs.push_back({page.views, page.legends, page.tables, page.texts,
+                    page.pageWidthPt > 0.0 ? page.pageWidthPt
+                                           : options.pageWidthPt,
+                    page.pageHeightPt > 0.0 ? page.pageHeightPt
+                                            : options.pageHeightPt});
+  }
+  return WriteLayoutDocument(refs, options, outputPath);
+}
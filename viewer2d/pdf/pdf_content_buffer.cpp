@@ -0,0 +1,35 @@
+#include "pdf_content_buffer.h"
+
+#include <array>
+#include <utility>
+
+namespace layout_pdf_internal {
+
+std::string PdfContentBuffer::Take() {
+  std::string out = std::move(bytes_);
+  bytes_.clear();
+  return out;
+}
+
+PdfContentBuffer &PdfContentBuffer::operator<<(PdfFixed number) {
+  // Coordinates and colors fit comfortably in the small buffer. Huge values
+  // (e.g. a degenerate mapping) fall back to a buffer sized for the longest
+  // fixed representation of a double.
+  char digits[32];
+  auto result = std::to_chars(digits, digits + sizeof(digits), number.value,
+                              std::chars_format::fixed, number.precision);
+  if (result.ec == std::errc()) {
+    bytes_.append(digits, result.ptr);
+    return *this;
+  }
+  std::array<char, 512> wide{};
+  result = std::to_chars(wide.data(), wide.data() + wide.size(), number.value,
+                         std::chars_format::fixed, number.precision);
+  if (result.ec == std::errc())
+    bytes_.append(wide.data(), result.ptr);
+  else
+    bytes_.push_back('0');
+  return *this;
+}
+
+} // namespace layout_pdf_internal
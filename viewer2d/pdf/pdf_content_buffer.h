@@ -0,0 +1,81 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace layout_pdf_internal {
+
+// Fixed-precision number waiting to be written. Produced by
+// FloatFormatter::Format so call sites can stream coordinates without
+// materializing a temporary std::string per value.
+struct PdfFixed {
+  double value = 0.0;
+  int precision = 3;
+};
+
+// Append-only byte buffer used to build PDF content streams and object
+// bodies. Numbers are written with std::to_chars, so the output never depends
+// on the C or C++ locale and no stream state is involved.
+class PdfContentBuffer {
+public:
+  PdfContentBuffer() = default;
+  explicit PdfContentBuffer(size_t reserveBytes) { bytes_.reserve(reserveBytes); }
+
+  void Reserve(size_t bytes) { bytes_.reserve(bytes); }
+  void Clear() { bytes_.clear(); }
+  size_t Size() const { return bytes_.size(); }
+  bool Empty() const { return bytes_.empty(); }
+  std::string_view View() const { return bytes_; }
+
+  // Moves the accumulated bytes out, leaving the buffer empty.
+  std::string Take();
+
+  PdfContentBuffer &Append(const char *data, size_t size) {
+    bytes_.append(data, size);
+    return *this;
+  }
+  PdfContentBuffer &operator<<(std::string_view text) {
+    bytes_.append(text);
+    return *this;
+  }
+  PdfContentBuffer &operator<<(const char *text) {
+    bytes_.append(text);
+    return *this;
+  }
+  PdfContentBuffer &operator<<(const std::string &text) {
+    bytes_.append(text);
+    return *this;
+  }
+  PdfContentBuffer &operator<<(char ch) {
+    bytes_.push_back(ch);
+    return *this;
+  }
+  PdfContentBuffer &operator<<(const PdfContentBuffer &other) {
+    bytes_.append(other.bytes_);
+    return *this;
+  }
+  PdfContentBuffer &operator<<(PdfFixed number);
+  // Floating-point values must go through PdfFixed to pick a precision, and
+  // bools have no PDF spelling here; without these they would silently
+  // convert to the char overload.
+  PdfContentBuffer &operator<<(double) = delete;
+  PdfContentBuffer &operator<<(float) = delete;
+  PdfContentBuffer &operator<<(bool) = delete;
+
+  template <std::integral T>
+    requires(!std::same_as<T, char> && !std::same_as<T, bool>)
+  PdfContentBuffer &operator<<(T value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    bytes_.append(digits, result.ptr);
+    return *this;
+  }
+
+private:
+  std::string bytes_;
+};
+
+} // namespace layout_pdf_internal
@@ -0,0 +1,168 @@
+#include "pdf_content_renderer.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <type_traits>
+#include <variant>
+
+#include "logger.h"
+
+namespace layout_pdf_internal {
+
+namespace {
+bool ShouldTraceLabelOrder() {
+  static const bool enabled = std::getenv("PERASTAGE_TRACE_LABELS") != nullptr;
+  return enabled;
+}
+
+void TraceLabel(size_t idx, const std::vector<std::string> &sources,
+                const TextCommand &cmd, const Point &pos) {
+  std::ostringstream trace;
+  trace << "[label-replay] index=" << idx;
+  if (idx < sources.size())
+    trace << " source=" << sources[idx];
+  trace << " text=\"" << cmd.text << "\" x=" << pos.x << " y=" << pos.y
+        << " size=" << cmd.style.fontSize << " vAlign=";
+  switch (cmd.style.vAlign) {
+  case CanvasTextStyle::VerticalAlign::Baseline:
+    trace << "Baseline";
+    break;
+  case CanvasTextStyle::VerticalAlign::Middle:
+    trace << "Middle";
+    break;
+  case CanvasTextStyle::VerticalAlign::Top:
+    trace << "Top";
+    break;
+  case CanvasTextStyle::VerticalAlign::Bottom:
+    trace << "Bottom";
+    break;
+  }
+  Logger::Instance().Log(trace.str());
+}
+} // namespace
+
+void RenderCommandsToStream(PdfContentBuffer &content,
+                            const std::vector<CanvasCommand> &commands,
+                            const std::vector<CommandMetadata> &metadata,
+                            const std::vector<std::string> &sources,
+                            const Mapping &mapping,
+                            const FloatFormatter &formatter,
+                            const RenderOptions &options) {
+  Transform current{};
+  std::vector<Transform> stack;
+  GraphicsStateCache stateCache;
+  content.Reserve(content.Size() +
+                  commands.size() * kEstimatedPdfBytesPerCommand);
+
+  std::vector<size_t> group;
+  std::string currentSource;
+
+  auto flushGroup = [&]() {
+    if (group.empty())
+      return;
+
+    // Render all strokes first. They will be visually pushed underneath by the
+    // subsequent fill pass, mirroring how the real-time viewer relies on
+    // depth testing to hide internal wireframe segments. Both passes write
+    // straight into the content buffer; the state cache sees the same call
+    // order as it would with separate layer buffers.
+    for (size_t idx : group) {
+      if (!metadata[idx].hasStroke)
+        continue;
+      EmitCommandStroke(content, stateCache, formatter, mapping, current,
+                        commands[idx], options);
+    }
+
+    // Render fills afterwards so they sit on top of any wireframe lines from
+    // the same piece, matching the 2D viewer's occlusion behavior.
+    for (size_t idx : group) {
+      if (!metadata[idx].hasFill)
+        continue;
+      EmitCommandFill(content, stateCache, formatter, mapping, current,
+                      commands[idx]);
+    }
+
+    group.clear();
+  };
+
+  auto handleBarrier = [&](const auto &cmd, size_t idx) {
+    using T = std::decay_t<decltype(cmd)>;
+    if constexpr (std::is_same_v<T, SaveCommand>) {
+      stack.push_back(current);
+    } else if constexpr (std::is_same_v<T, RestoreCommand>) {
+      if (!stack.empty()) {
+        current = stack.back();
+        stack.pop_back();
+      }
+    } else if constexpr (std::is_same_v<T, TransformCommand>) {
+      current.scale = cmd.transform.scale;
+      current.offsetX = cmd.transform.offsetX;
+      current.offsetY = cmd.transform.offsetY;
+    } else if constexpr (std::is_same_v<T, TextCommand>) {
+      if (!options.includeText)
+        return;
+      auto pos = MapPointWithTransform(cmd.x, cmd.y, current, mapping);
+      if (ShouldTraceLabelOrder())
+        TraceLabel(idx, sources, cmd, pos);
+      AppendText(content, formatter, pos, cmd, cmd.style, mapping.scale,
+                 options.fonts);
+    } else if constexpr (std::is_same_v<T, PlaceSymbolCommand>) {
+      if (!options.symbolKeyNames)
+        return;
+      auto nameIt = options.symbolKeyNames->find(cmd.key);
+      if (nameIt == options.symbolKeyNames->end())
+        return;
+      Transform2D local = TransformFromCanvas(cmd.transform);
+      AppendSymbolInstance(content, formatter, mapping, local, nameIt->second);
+    } else if constexpr (std::is_same_v<T, SymbolInstanceCommand>) {
+      if (!options.symbolIdNames)
+        return;
+      auto nameIt = options.symbolIdNames->find(cmd.symbolId);
+      if (nameIt == options.symbolIdNames->end())
+        return;
+      AppendSymbolInstance(content, formatter, mapping, cmd.transform,
+                           nameIt->second);
+    } else {
+      // Symbol control commands are handled at a higher level but must preserve
+      // ordering relative to drawing commands.
+    }
+  };
+
+  for (size_t i = 0; i < commands.size(); ++i) {
+    const auto &cmd = commands[i];
+
+    bool isBarrier = std::visit(
+        [&](auto &&c) {
+          using T = std::decay_t<decltype(c)>;
+          return std::is_same_v<T, SaveCommand> || std::is_same_v<T, RestoreCommand> ||
+                 std::is_same_v<T, TransformCommand> ||
+                 std::is_same_v<T, BeginSymbolCommand> ||
+                 std::is_same_v<T, EndSymbolCommand> ||
+                 std::is_same_v<T, PlaceSymbolCommand> ||
+                 std::is_same_v<T, SymbolInstanceCommand> ||
+                 std::is_same_v<T, TextCommand>;
+        },
+        cmd);
+
+    if (isBarrier) {
+      flushGroup();
+      std::visit([&](const auto &barrierCmd) { handleBarrier(barrierCmd, i); },
+                 cmd);
+      continue;
+    }
+
+    if (group.empty())
+      currentSource = sources[i];
+
+    if (sources[i] != currentSource) {
+      flushGroup();
+      currentSource = sources[i];
+    }
+
+    group.push_back(i);
+  }
+
+  flushGroup();
+}
+
+} // namespace layout_pdf_internal
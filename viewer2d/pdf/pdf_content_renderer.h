@@ -0,0 +1,26 @@
+#pragma once
+
+#include "pdf_draw_commands.h"
+
+#include <string>
+#include <vector>
+
+namespace layout_pdf_internal {
+
+// Rough upper bound of content-stream bytes produced per captured command.
+// Used to pre-size the output buffer so large rigs do not pay for repeated
+// reallocation while the stream grows.
+constexpr size_t kEstimatedPdfBytesPerCommand = 96;
+
+// Serializes captured canvas commands into PDF content-stream operators and
+// appends them to `content`. Commands from the same source are grouped so
+// strokes are emitted before fills, mirroring the on-screen occlusion.
+void RenderCommandsToStream(PdfContentBuffer &content,
+                            const std::vector<CanvasCommand> &commands,
+                            const std::vector<CommandMetadata> &metadata,
+                            const std::vector<std::string> &sources,
+                            const Mapping &mapping,
+                            const FloatFormatter &formatter,
+                            const RenderOptions &options);
+
+} // namespace layout_pdf_internal
@@ -4,7 +4,6 @@
 #include <array>
 #include <cmath>
 #include <limits>
-#include <sstream>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -35,7 +34,7 @@ bool SameColor(const CanvasColor &a, const CanvasColor &b) {
 }
 } // namespace
 
-void GraphicsStateCache::SetStroke(std::ostringstream &out,
+void GraphicsStateCache::SetStroke(PdfContentBuffer &out,
                                    const CanvasStroke &stroke,
                                    const FloatFormatter &fmt) {
   if (!joinStyleSet_) {
@@ -59,7 +58,7 @@ void GraphicsStateCache::SetStroke(std::ostringstream &out,
   }
 }
 
-void GraphicsStateCache::SetFill(std::ostringstream &out,
+void GraphicsStateCache::SetFill(PdfContentBuffer &out,
                                  const CanvasFill &fill,
                                  const FloatFormatter &fmt) {
   if (!hasFillColor_ || !SameColor(fill.color, fillColor_)) {
@@ -70,7 +69,7 @@ void GraphicsStateCache::SetFill(std::ostringstream &out,
   }
 }
 
-void AppendLine(std::ostringstream &out, GraphicsStateCache &cache,
+void AppendLine(PdfContentBuffer &out, GraphicsStateCache &cache,
                 const FloatFormatter &fmt, const Point &a, const Point &b,
                 const CanvasStroke &stroke) {
   cache.SetStroke(out, stroke, fmt);
@@ -78,7 +77,7 @@ void AppendLine(std::ostringstream &out, GraphicsStateCache &cache,
       << fmt.Format(b.x) << ' ' << fmt.Format(b.y) << " l\nS\n";
 }
 
-void AppendPolyline(std::ostringstream &out, GraphicsStateCache &cache,
+void AppendPolyline(PdfContentBuffer &out, GraphicsStateCache &cache,
                     const FloatFormatter &fmt, const std::vector<Point> &pts,
                     const CanvasStroke &stroke) {
   if (pts.size() < 2)
@@ -91,7 +90,7 @@ void AppendPolyline(std::ostringstream &out, GraphicsStateCache &cache,
   out << "S\n";
 }
 
-void AppendPolygon(std::ostringstream &out, GraphicsStateCache &cache,
+void AppendPolygon(PdfContentBuffer &out, GraphicsStateCache &cache,
                    const FloatFormatter &fmt, const std::vector<Point> &pts,
                    const CanvasStroke &stroke, const CanvasFill *fill) {
   if (pts.size() < 3)
@@ -116,7 +115,7 @@ void AppendPolygon(std::ostringstream &out, GraphicsStateCache &cache,
   }
 }
 
-void AppendRectangle(std::ostringstream &out, GraphicsStateCache &cache,
+void AppendRectangle(PdfContentBuffer &out, GraphicsStateCache &cache,
                      const FloatFormatter &fmt, const Point &origin, double w,
                      double h, const CanvasStroke &stroke,
                      const CanvasFill *fill) {
@@ -138,7 +137,7 @@ void AppendRectangle(std::ostringstream &out, GraphicsStateCache &cache,
   }
 }
 
-void AppendCircle(std::ostringstream &out, GraphicsStateCache &cache,
+void AppendCircle(PdfContentBuffer &out, GraphicsStateCache &cache,
                   const FloatFormatter &fmt, const Point &center,
                   double radius, const CanvasStroke &stroke,
                   const CanvasFill *fill) {
@@ -186,7 +185,7 @@ void AppendCircle(std::ostringstream &out, GraphicsStateCache &cache,
   }
 }
 
-void AppendText(std::ostringstream &out, const FloatFormatter &fmt,
+void AppendText(PdfContentBuffer &out, const FloatFormatter &fmt,
                 const Point &pos, const TextCommand &cmd,
                 const CanvasTextStyle &style, double scale,
                 const PdfFontCatalog *fonts) {
@@ -336,7 +335,7 @@ Transform2D TransformFromCanvas(const CanvasTransform &transform) {
   return out;
 }
 
-void AppendSymbolInstance(std::ostringstream &out, const FloatFormatter &fmt,
+void AppendSymbolInstance(PdfContentBuffer &out, const FloatFormatter &fmt,
                           const Mapping &mapping,
                           const Transform2D &transform,
                           const std::string &name) {
@@ -484,7 +483,7 @@ SymbolBounds ComputeSymbolBounds(const std::vector<CanvasCommand> &commands) {
 // fills in separate functions allows the caller to control layering
 // explicitly, which is required to match the on-screen 2D viewer where fills
 // occlude internal wireframe edges within the same group.
-void EmitCommandStroke(std::ostringstream &content, GraphicsStateCache &cache,
+void EmitCommandStroke(PdfContentBuffer &content, GraphicsStateCache &cache,
                        const FloatFormatter &formatter, const Mapping &mapping,
                        const Transform &current, const CanvasCommand &command,
                        const RenderOptions &options) {
@@ -541,7 +540,7 @@ void EmitCommandStroke(std::ostringstream &content, GraphicsStateCache &cache,
 // Emits only the fill portion of a drawing command. Stroke width is forced to
 // zero to ensure no outlines leak back in when rendering fills as a separate
 // pass.
-void EmitCommandFill(std::ostringstream &content, GraphicsStateCache &cache,
+void EmitCommandFill(PdfContentBuffer &content, GraphicsStateCache &cache,
                      const FloatFormatter &formatter, const Mapping &mapping,
                      const Transform &current, const CanvasCommand &command) {
   std::visit(
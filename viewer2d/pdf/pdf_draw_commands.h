@@ -1,10 +1,10 @@
 #pragma once
 
+#include "pdf_content_buffer.h"
 #include "pdf_font_metrics.h"
 #include "pdf_objects.h"
 #include "viewer2dcommandrenderer.h"
 
-#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -32,8 +32,8 @@ struct RenderOptions {
 
 class GraphicsStateCache {
 public:
-  void SetStroke(std::ostringstream &out, const CanvasStroke &stroke, const FloatFormatter &fmt);
-  void SetFill(std::ostringstream &out, const CanvasFill &fill, const FloatFormatter &fmt);
+  void SetStroke(PdfContentBuffer &out, const CanvasStroke &stroke, const FloatFormatter &fmt);
+  void SetFill(PdfContentBuffer &out, const CanvasFill &fill, const FloatFormatter &fmt);
 
 private:
   CanvasColor strokeColor_{};
@@ -53,29 +53,29 @@ Point MapPointWithTransform(double x, double y, const Transform &current,
 Transform2D TransformFromCanvas(const CanvasTransform &transform);
 SymbolBounds ComputeSymbolBounds(const std::vector<CanvasCommand> &commands);
 
-void AppendLine(std::ostringstream &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
+void AppendLine(PdfContentBuffer &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
                 const Point &a, const Point &b, const CanvasStroke &stroke);
-void AppendPolyline(std::ostringstream &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
+void AppendPolyline(PdfContentBuffer &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
                     const std::vector<Point> &pts, const CanvasStroke &stroke);
-void AppendPolygon(std::ostringstream &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
+void AppendPolygon(PdfContentBuffer &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
                    const std::vector<Point> &pts, const CanvasStroke &stroke, const CanvasFill *fill);
-void AppendRectangle(std::ostringstream &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
+void AppendRectangle(PdfContentBuffer &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
                      const Point &origin, double w, double h, const CanvasStroke &stroke,
                      const CanvasFill *fill);
-void AppendCircle(std::ostringstream &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
+void AppendCircle(PdfContentBuffer &out, GraphicsStateCache &cache, const FloatFormatter &fmt,
                   const Point &center, double radius, const CanvasStroke &stroke,
                   const CanvasFill *fill);
-void AppendText(std::ostringstream &out, const FloatFormatter &fmt, const Point &pos,
+void AppendText(PdfContentBuffer &out, const FloatFormatter &fmt, const Point &pos,
                 const TextCommand &cmd, const CanvasTextStyle &style, double scale,
                 const PdfFontCatalog *fonts);
-void AppendSymbolInstance(std::ostringstream &out, const FloatFormatter &fmt,
+void AppendSymbolInstance(PdfContentBuffer &out, const FloatFormatter &fmt,
                           const Mapping &mapping, const Transform2D &transform,
                           const std::string &name);
-void EmitCommandStroke(std::ostringstream &content, GraphicsStateCache &cache,
+void EmitCommandStroke(PdfContentBuffer &content, GraphicsStateCache &cache,
                        const FloatFormatter &formatter, const Mapping &mapping,
                        const Transform &current, const CanvasCommand &command,
                        const RenderOptions &options);
-void EmitCommandFill(std::ostringstream &content, GraphicsStateCache &cache,
+void EmitCommandFill(PdfContentBuffer &content, GraphicsStateCache &cache,
                      const FloatFormatter &formatter, const Mapping &mapping,
                      const Transform &current, const CanvasCommand &command);
 
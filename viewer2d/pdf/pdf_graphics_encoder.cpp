@@ -2,23 +2,16 @@
 
 #include <algorithm>
 #include <cmath>
-#include <iomanip>
 
 FloatFormatter::FloatFormatter(int precision)
     : precision_(std::clamp(precision, 0, 6)) {}
 
-std::string FloatFormatter::Format(double value) const {
-  std::ostringstream ss;
-  ss << std::fixed << std::setprecision(precision_) << value;
-  return ss.str();
-}
-
 bool GraphicsStateCache::SameColor(const CanvasColor &a, const CanvasColor &b) {
   return std::abs(a.r - b.r) < 1e-6 && std::abs(a.g - b.g) < 1e-6 &&
          std::abs(a.b - b.b) < 1e-6;
 }
 
-void GraphicsStateCache::SetStroke(std::ostringstream &out,
+void GraphicsStateCache::SetStroke(layout_pdf_internal::PdfContentBuffer &out,
                                    const CanvasStroke &stroke,
                                    const FloatFormatter &fmt) {
   if (!joinStyleSet_) { out << "1 j\n"; joinStyleSet_ = true; }
@@ -36,7 +29,8 @@ void GraphicsStateCache::SetStroke(std::ostringstream &out,
   }
 }
 
-void GraphicsStateCache::SetFill(std::ostringstream &out, const CanvasFill &fill,
+void GraphicsStateCache::SetFill(layout_pdf_internal::PdfContentBuffer &out,
+                                 const CanvasFill &fill,
                                  const FloatFormatter &fmt) {
   if (!hasFillColor_ || !SameColor(fill.color, fillColor_)) {
     out << fmt.Format(fill.color.r) << ' ' << fmt.Format(fill.color.g) << ' '
@@ -46,17 +40,18 @@ void GraphicsStateCache::SetFill(std::ostringstream &out, const CanvasFill &fill
   }
 }
 
-void AppendLine(std::ostringstream &out, GraphicsStateCache &cache,
-                const FloatFormatter &fmt, const Point &a, const Point &b,
-                const CanvasStroke &stroke) {
+void AppendLine(layout_pdf_internal::PdfContentBuffer &out,
+                GraphicsStateCache &cache, const FloatFormatter &fmt,
+                const Point &a, const Point &b, const CanvasStroke &stroke) {
   cache.SetStroke(out, stroke, fmt);
   out << fmt.Format(a.x) << ' ' << fmt.Format(a.y) << " m\n"
       << fmt.Format(b.x) << ' ' << fmt.Format(b.y) << " l\nS\n";
 }
 
-void AppendPolygon(std::ostringstream &out, GraphicsStateCache &cache,
-                   const FloatFormatter &fmt, const std::vector<Point> &pts,
-                   const CanvasStroke &stroke, const CanvasFill *fill) {
+void AppendPolygon(layout_pdf_internal::PdfContentBuffer &out,
+                   GraphicsStateCache &cache, const FloatFormatter &fmt,
+                   const std::vector<Point> &pts, const CanvasStroke &stroke,
+                   const CanvasFill *fill) {
   if (pts.size() < 3)
     return;
   auto emit = [&]() {
@@ -77,10 +72,10 @@ void AppendPolygon(std::ostringstream &out, GraphicsStateCache &cache,
   }
 }
 
-void AppendText(std::ostringstream &out, const FloatFormatter &fmt,
-                const Point &position, const std::string &text,
-                const CanvasTextStyle &style, double scale,
-                const PdfFontCatalog *fonts) {
+void AppendText(layout_pdf_internal::PdfContentBuffer &out,
+                const FloatFormatter &fmt, const Point &position,
+                const std::string &text, const CanvasTextStyle &style,
+                double scale, const PdfFontCatalog *fonts) {
   const PdfFontDefinition *font = fonts ? fonts->Resolve(style.fontFamily) : nullptr;
   const std::string encoded = EncodeWinAnsi(text);
   const double fontSize = std::max(1.0f, style.fontSize) * scale;
@@ -2,8 +2,8 @@
 
 #include "canvas2d.h"
 #include "font_metrics.h"
+#include "pdf_content_buffer.h"
 
-#include <sstream>
 #include <unordered_map>
 
 struct Point {
@@ -38,7 +38,9 @@ struct RenderOptions {
 class FloatFormatter {
 public:
   explicit FloatFormatter(int precision);
-  std::string Format(double value) const;
+  layout_pdf_internal::PdfFixed Format(double value) const {
+    return {value, precision_};
+  }
 
 private:
   int precision_;
@@ -46,10 +48,10 @@ private:
 
 class GraphicsStateCache {
 public:
-  void SetStroke(std::ostringstream &out, const CanvasStroke &stroke,
-                 const FloatFormatter &fmt);
-  void SetFill(std::ostringstream &out, const CanvasFill &fill,
-               const FloatFormatter &fmt);
+  void SetStroke(layout_pdf_internal::PdfContentBuffer &out,
+                 const CanvasStroke &stroke, const FloatFormatter &fmt);
+  void SetFill(layout_pdf_internal::PdfContentBuffer &out,
+               const CanvasFill &fill, const FloatFormatter &fmt);
 
 private:
   static bool SameColor(const CanvasColor &a, const CanvasColor &b);
@@ -63,15 +65,16 @@ private:
   bool capStyleSet_ = false;
 };
 
-void AppendLine(std::ostringstream &out, GraphicsStateCache &cache,
-                const FloatFormatter &fmt, const Point &a, const Point &b,
-                const CanvasStroke &stroke);
+void AppendLine(layout_pdf_internal::PdfContentBuffer &out,
+                GraphicsStateCache &cache, const FloatFormatter &fmt,
+                const Point &a, const Point &b, const CanvasStroke &stroke);
 
-void AppendPolygon(std::ostringstream &out, GraphicsStateCache &cache,
-                   const FloatFormatter &fmt, const std::vector<Point> &pts,
-                   const CanvasStroke &stroke, const CanvasFill *fill);
+void AppendPolygon(layout_pdf_internal::PdfContentBuffer &out,
+                   GraphicsStateCache &cache, const FloatFormatter &fmt,
+                   const std::vector<Point> &pts, const CanvasStroke &stroke,
+                   const CanvasFill *fill);
 
-void AppendText(std::ostringstream &out, const FloatFormatter &fmt,
-                const Point &position, const std::string &text,
-                const CanvasTextStyle &style, double scale,
-                const PdfFontCatalog *fonts);
+void AppendText(layout_pdf_internal::PdfContentBuffer &out,
+                const FloatFormatter &fmt, const Point &position,
+                const std::string &text, const CanvasTextStyle &style,
+                double scale, const PdfFontCatalog *fonts);
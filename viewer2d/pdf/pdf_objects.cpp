@@ -2,8 +2,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <iomanip>
-#include <sstream>
 
 #include <zlib.h>
 
@@ -12,13 +10,7 @@ namespace layout_pdf_internal {
 FloatFormatter::FloatFormatter(int precision)
     : precision_(std::clamp(precision, 0, 6)) {}
 
-std::string FloatFormatter::Format(double value) const {
-  std::ostringstream ss;
-  ss << std::fixed << std::setprecision(precision_) << value;
-  return ss.str();
-}
-
-bool PdfDeflater::Compress(const std::string &input, std::string &output,
+bool PdfDeflater::Compress(std::string_view input, std::string &output,
                            std::string &error) {
   if (input.empty()) {
     output.clear();
@@ -41,8 +33,7 @@ bool PdfDeflater::Compress(const std::string &input, std::string &output,
   return true;
 }
 
-bool AppendEmbeddedFontObjects(std::vector<PdfObject> &objects,
-                               PdfFontDefinition &font) {
+bool AppendEmbeddedFontObjects(PdfWriter &writer, PdfFontDefinition &font) {
   if (!font.metrics.valid || font.metrics.data.empty())
     return false;
   const double scale = font.metrics.unitsPerEm > 0 ? 1000.0 / font.metrics.unitsPerEm : 1.0;
@@ -54,27 +45,19 @@ bool AppendEmbeddedFontObjects(std::vector<PdfObject> &objects,
   int xMax = static_cast<int>(std::lround(font.metrics.xMax * scale));
   int yMax = static_cast<int>(std::lround(font.metrics.yMax * scale));
 
-  size_t fontFileIndex = objects.size() + 1;
-  std::ostringstream fontFileStream;
-  const bool needsNewline = font.metrics.data.empty() || font.metrics.data.back() != '\n';
-  const size_t streamLength = font.metrics.data.size() + (needsNewline ? 1u : 0u);
-  fontFileStream << "<< /Length " << streamLength << " /Length1 " << font.metrics.data.size()
-                 << " >>\nstream\n" << font.metrics.data;
-  if (needsNewline)
-    fontFileStream << '\n';
-  fontFileStream << "endstream";
-  objects.push_back({fontFileStream.str()});
+  PdfContentBuffer fontFileDict;
+  fontFileDict << "/Length1 " << font.metrics.data.size();
+  const size_t fontFileIndex =
+      writer.WriteStream(fontFileDict.View(), font.metrics.data, false);
 
-  size_t descriptorIndex = objects.size() + 1;
-  std::ostringstream descriptor;
+  PdfContentBuffer descriptor;
   descriptor << "<< /Type /FontDescriptor /FontName /" << font.baseName
              << " /Flags 32 /FontBBox [" << xMin << ' ' << yMin << ' ' << xMax << ' ' << yMax
              << "] /Ascent " << ascent << " /Descent " << descent << " /CapHeight " << capHeight
              << " /ItalicAngle 0 /StemV 80 /FontFile2 " << fontFileIndex << " 0 R >>";
-  objects.push_back({descriptor.str()});
+  const size_t descriptorIndex = writer.WriteObject(descriptor.View());
 
-  size_t fontIndex = objects.size() + 1;
-  std::ostringstream fontObject;
+  PdfContentBuffer fontObject(1200);
   fontObject << "<< /Type /Font /Subtype /TrueType /BaseFont /" << font.baseName
              << " /FirstChar 32 /LastChar 255 /Widths [";
   for (int code = 32; code <= 255; ++code) {
@@ -83,18 +66,16 @@ bool AppendEmbeddedFontObjects(std::vector<PdfObject> &objects,
       fontObject << ' ';
   }
   fontObject << "] /FontDescriptor " << descriptorIndex << " 0 R /Encoding /WinAnsiEncoding >>";
-  objects.push_back({fontObject.str()});
 
-  font.objectId = fontIndex;
+  font.objectId = writer.WriteObject(fontObject.View());
   font.embedded = true;
   return true;
 }
 
-void AppendFallbackType1Font(std::vector<PdfObject> &objects,
-                             PdfFontDefinition &font,
+void AppendFallbackType1Font(PdfWriter &writer, PdfFontDefinition &font,
                              const std::string &baseFont) {
-  objects.push_back({"<< /Type /Font /Subtype /Type1 /BaseFont /" + baseFont + " >>"});
-  font.objectId = objects.size();
+  font.objectId =
+      writer.WriteObject("<< /Type /Font /Subtype /Type1 /BaseFont /" + baseFont + " >>");
   font.embedded = false;
   font.baseName = baseFont;
 }
@@ -1,21 +1,21 @@
 #pragma once
 
+#include "pdf_content_buffer.h"
 #include "pdf_font_metrics.h"
+#include "pdf_writer.h"
 
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace layout_pdf_internal {
 
-struct PdfObject {
-  std::string body;
-};
-
 class FloatFormatter {
 public:
   explicit FloatFormatter(int precision);
-  std::string Format(double value) const;
+  // Returns a tag that PdfContentBuffer writes in place; no string is built.
+  PdfFixed Format(double value) const { return {value, precision_}; }
+  int Precision() const { return precision_; }
 
 private:
   int precision_;
@@ -23,14 +23,14 @@ private:
 
 class PdfDeflater {
 public:
-  static bool Compress(const std::string &input, std::string &output,
+  static bool Compress(std::string_view input, std::string &output,
                        std::string &error);
 };
 
-bool AppendEmbeddedFontObjects(std::vector<PdfObject> &objects,
-                               PdfFontDefinition &font);
-void AppendFallbackType1Font(std::vector<PdfObject> &objects,
-                             PdfFontDefinition &font,
+// Both helpers write the font objects straight to `writer` and store the id
+// of the resulting /Font object in `font.objectId`.
+bool AppendEmbeddedFontObjects(PdfWriter &writer, PdfFontDefinition &font);
+void AppendFallbackType1Font(PdfWriter &writer, PdfFontDefinition &font,
                              const std::string &baseFont);
 
 } // namespace layout_pdf_internal
@@ -1,35 +1,220 @@
 #include "pdf_writer.h"
 
-#include <fstream>
-#include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <system_error>
 
-bool WritePdfDocument(const std::filesystem::path &outputPath,
-                      const std::vector<PdfObject> &objects,
-                      size_t catalogObjectIndex, std::string &error) {
-  try {
-    std::ofstream file(outputPath, std::ios::binary);
-    if (!file.is_open()) {
-      error = "Unable to open the destination file for writing.";
-      return false;
+#include <zlib.h>
+
+namespace {
+constexpr size_t kDeflateChunkBytes = 64 * 1024;
+} // namespace
+
+PdfWriter::~PdfWriter() {
+  if (partPath_.empty() || finished_)
+    return;
+  if (file_.is_open())
+    file_.close();
+  std::error_code ec;
+  std::filesystem::remove(partPath_, ec);
+}
+
+bool PdfWriter::Open(const std::filesystem::path &path, std::string &error) {
+  path_ = path;
+  partPath_ = path;
+  partPath_ += ".part";
+  file_.open(partPath_, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) {
+    error = "Unable to open the destination file for writing.";
+    return false;
+  }
+  position_ = 0;
+  offsets_.clear();
+  failed_ = false;
+  finished_ = false;
+  error_.clear();
+  Put("%PDF-1.4\n");
+  return !failed_;
+}
+
+size_t PdfWriter::ReserveObject() {
+  offsets_.push_back(0);
+  return offsets_.size();
+}
+
+size_t PdfWriter::WriteObject(std::string_view body) {
+  const size_t id = ReserveObject();
+  WriteObject(id, body);
+  return id;
+}
+
+void PdfWriter::WriteObject(size_t id, std::string_view body) {
+  BeginObject(id);
+  Put(body);
+  Put("\nendobj\n");
+}
+
+size_t PdfWriter::WriteStream(std::string_view dictEntries,
+                              std::string_view data, bool compress) {
+  const size_t id = ReserveObject();
+  BeginObject(id);
+  Put("<< ");
+  if (!dictEntries.empty()) {
+    Put(dictEntries);
+    Put(" ");
+  }
+
+  if (!compress || data.empty()) {
+    Put("/Length " + std::to_string(data.size()) + " >>\nstream\n");
+    Put(data);
+    Put("\nendstream\nendobj\n");
+    return id;
+  }
+
+  const size_t lengthId = ReserveObject();
+  Put("/Length " + std::to_string(lengthId) +
+      " 0 R /Filter /FlateDecode >>\nstream\n");
+  uint64_t written = 0;
+  if (!PutDeflated(data, written))
+    return id;
+  Put("\nendstream\nendobj\n");
+  WriteObject(lengthId, std::to_string(written));
+  return id;
+}
+
+bool PdfWriter::Finish(size_t catalogId, std::string &error) {
+  if (!failed_) {
+    for (size_t i = 0; i < offsets_.size(); ++i) {
+      if (offsets_[i] == 0) {
+        Fail("PDF object " + std::to_string(i + 1) +
+             " was reserved but never written.");
+        break;
+      }
     }
+  }
+  if (!failed_ && (catalogId == 0 || catalogId > offsets_.size()))
+    Fail("The PDF catalog object was not written.");
 
-    file << "%PDF-1.4\n";
-    std::vector<long> offsets;
-    offsets.reserve(objects.size());
-    for (size_t i = 0; i < objects.size(); ++i) {
-      offsets.push_back(static_cast<long>(file.tellp()));
-      file << (i + 1) << " 0 obj\n" << objects[i].body << "\nendobj\n";
+  if (!failed_) {
+    const uint64_t xrefPos = position_;
+    std::string xref;
+    xref.reserve(32 + offsets_.size() * 20);
+    xref += "xref\n0 " + std::to_string(offsets_.size() + 1) +
+            "\n0000000000 65535 f \n";
+    char entry[32];
+    for (uint64_t off : offsets_) {
+      std::snprintf(entry, sizeof(entry), "%010llu 00000 n \n",
+                    static_cast<unsigned long long>(off));
+      xref += entry;
     }
+    xref += "trailer\n<< /Size " + std::to_string(offsets_.size() + 1) +
+            " /Root " + std::to_string(catalogId) + " 0 R >>\nstartxref\n" +
+            std::to_string(xrefPos) + "\n%%EOF";
+    Put(xref);
+  }
+
+  if (!failed_) {
+    file_.close();
+    if (file_.fail())
+      Fail("Failed to finish writing the PDF file.");
+  }
+  if (!failed_) {
+    std::error_code ec;
+    std::filesystem::rename(partPath_, path_, ec);
+    if (ec)
+      Fail("Unable to replace the destination file: " + ec.message());
+  }
+  if (failed_) {
+    error = error_;
+    return false;
+  }
+  finished_ = true;
+  return true;
+}
+
+void PdfWriter::Put(std::string_view bytes) {
+  if (failed_ || bytes.empty())
+    return;
+  file_.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  if (!file_) {
+    Fail("Failed to write the PDF file.");
+    return;
+  }
+  position_ += bytes.size();
+}
+
+void PdfWriter::BeginObject(size_t id) {
+  if (failed_)
+    return;
+  if (id == 0 || id > offsets_.size() || offsets_[id - 1] != 0) {
+    Fail("PDF object " + std::to_string(id) + " was written twice.");
+    return;
+  }
+  offsets_[id - 1] = position_;
+  Put(std::to_string(id) + " 0 obj\n");
+}
 
-    long xrefPos = static_cast<long>(file.tellp());
-    file << "xref\n0 " << (objects.size() + 1) << "\n0000000000 65535 f \n";
-    for (long off : offsets)
-      file << std::setw(10) << std::setfill('0') << off << " 00000 n \n";
+bool PdfWriter::PutDeflated(std::string_view data, uint64_t &written) {
+  if (failed_)
+    return false;
+  z_stream zs{};
+  if (deflateInit(&zs, Z_BEST_SPEED) != Z_OK) {
+    Fail("deflateInit failed");
+    return false;
+  }
+  deflateChunk_.resize(kDeflateChunkBytes);
+
+  // zlib counts input in uInt, so very large streams are fed in slices.
+  const auto *next = reinterpret_cast<const Bytef *>(data.data());
+  size_t remaining = data.size();
+  int zres = Z_OK;
+  do {
+    const size_t slice = std::min<size_t>(remaining, UINT_MAX);
+    zs.next_in = const_cast<Bytef *>(next);
+    zs.avail_in = static_cast<uInt>(slice);
+    next += slice;
+    remaining -= slice;
+    const int flush = remaining == 0 ? Z_FINISH : Z_NO_FLUSH;
+    do {
+      zs.next_out = deflateChunk_.data();
+      zs.avail_out = static_cast<uInt>(deflateChunk_.size());
+      zres = deflate(&zs, flush);
+      if (zres == Z_STREAM_ERROR) {
+        deflateEnd(&zs);
+        Fail("deflate failed");
+        return false;
+      }
+      const size_t produced = deflateChunk_.size() - zs.avail_out;
+      Put(std::string_view(reinterpret_cast<const char *>(deflateChunk_.data()),
+                           produced));
+      written += produced;
+    } while (zs.avail_out == 0);
+  } while (remaining > 0);
 
-    file << "trailer\n<< /Size " << (objects.size() + 1) << " /Root "
-         << catalogObjectIndex << " 0 R >>\nstartxref\n"
-         << xrefPos << "\n%%EOF";
-    return true;
+  deflateEnd(&zs);
+  if (zres != Z_STREAM_END && !failed_)
+    Fail("deflate did not finish the stream");
+  return !failed_;
+}
+
+void PdfWriter::Fail(std::string message) {
+  if (failed_)
+    return;
+  failed_ = true;
+  error_ = std::move(message);
+}
+
+bool WritePdfDocument(const std::filesystem::path &outputPath,
+                      const std::vector<PdfObject> &objects,
+                      size_t catalogObjectIndex, std::string &error) {
+  try {
+    PdfWriter writer;
+    if (!writer.Open(outputPath, error))
+      return false;
+    for (const auto &object : objects)
+      writer.WriteObject(object.body);
+    return writer.Finish(catalogObjectIndex, error);
   } catch (const std::exception &ex) {
     error = std::string("Failed to generate PDF content: ") + ex.what();
     return false;
@@ -1,13 +1,71 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct PdfObject {
   std::string body;
 };
 
+// Streams a PDF document to disk. Every object is written as soon as the
+// caller hands it over and its byte offset is recorded for the xref table, so
+// only the object currently being produced has to live in memory. Objects
+// referenced before they can be written (page tree, catalog) get their id up
+// front from ReserveObject() and are filled in later with WriteObject(id).
+//
+// The document is written to a "<path>.part" sibling and only renamed over
+// the destination by a successful Finish(), so an existing file survives a
+// failed or cancelled export. Write errors are sticky: once one occurs the
+// remaining calls are ignored and Finish() reports it. A writer destroyed
+// without a successful Finish() removes the partial file.
+class PdfWriter {
+public:
+  PdfWriter() = default;
+  PdfWriter(const PdfWriter &) = delete;
+  PdfWriter &operator=(const PdfWriter &) = delete;
+  ~PdfWriter();
+
+  bool Open(const std::filesystem::path &path, std::string &error);
+
+  size_t ReserveObject();
+  size_t WriteObject(std::string_view body);
+  void WriteObject(size_t id, std::string_view body);
+
+  // Writes a stream object. `dictEntries` holds any keys that precede
+  // /Length in the stream dictionary. Compressed data is deflated straight
+  // into the file in fixed-size chunks; its length is emitted as a separate
+  // object right after the stream since it is only known at the end.
+  size_t WriteStream(std::string_view dictEntries, std::string_view data,
+                     bool compress);
+
+  // Writes the xref table and trailer and closes the file.
+  bool Finish(size_t catalogId, std::string &error);
+
+  bool Failed() const { return failed_; }
+
+private:
+  void Put(std::string_view bytes);
+  void BeginObject(size_t id);
+  bool PutDeflated(std::string_view data, uint64_t &written);
+  void Fail(std::string message);
+
+  std::filesystem::path path_;
+  std::filesystem::path partPath_;
+  std::ofstream file_;
+  uint64_t position_ = 0;
+  // Byte offset of each object, indexed by id - 1. Zero marks an id that was
+  // reserved but not written yet; no object can start at offset zero.
+  std::vector<uint64_t> offsets_;
+  std::vector<unsigned char> deflateChunk_;
+  bool failed_ = false;
+  bool finished_ = false;
+  std::string error_;
+};
+
 bool WritePdfDocument(const std::filesystem::path &outputPath,
                       const std::vector<PdfObject> &objects,
                       size_t catalogObjectIndex, std::string &error);
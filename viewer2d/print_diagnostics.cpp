@@ -21,7 +21,6 @@
 #include <algorithm>
 #include <iomanip>
 #include <map>
-#include <numeric>
 #include <sstream>
 #include <type_traits>
 #include <unordered_map>
@@ -192,18 +191,17 @@ size_t EstimateBytes(const CanvasCommand &cmd) {
 
 } // namespace
 
-std::string BuildPrintDiagnostics(const CommandBuffer &buffer,
-                                  size_t topTypeCount) {
-  std::unordered_map<std::string, size_t> commandCounts;
+PrintCostModel ComputePrintCostModel(const CommandBuffer &buffer,
+                                     size_t topTypeCount) {
+  PrintCostModel model;
   std::map<int, size_t> polygonHistogram;
-  std::unordered_map<std::string, std::pair<size_t, size_t>> typePolygonStats;
-  size_t estimatedBytes = 0;
+  std::unordered_map<std::string, PrintPolygonContributor> typePolygonStats;
+  model.totalCommands = buffer.commands.size();
 
   for (size_t idx = 0; idx < buffer.commands.size(); ++idx) {
     const auto &cmd = buffer.commands[idx];
-    std::string name = CommandName(cmd);
-    ++commandCounts[name];
-    estimatedBytes += EstimateBytes(cmd);
+    ++model.commandCounts[CommandName(cmd)];
+    model.estimatedBytes += EstimateBytes(cmd);
 
     auto typeKey = (idx < buffer.sources.size() && !buffer.sources[idx].empty())
                        ? buffer.sources[idx]
@@ -214,58 +212,64 @@ std::string BuildPrintDiagnostics(const CommandBuffer &buffer,
       int verts = static_cast<int>(poly.points.size() / 2);
       ++polygonHistogram[verts];
       auto &entry = typePolygonStats[typeKey];
-      entry.first += 1;
-      entry.second += static_cast<size_t>(verts);
+      entry.polygons += 1;
+      entry.vertices += static_cast<size_t>(verts);
     } else if (std::holds_alternative<RectangleCommand>(cmd)) {
       ++polygonHistogram[4];
       auto &entry = typePolygonStats[typeKey];
-      entry.first += 1;
-      entry.second += 4;
+      entry.polygons += 1;
+      entry.vertices += 4;
     }
   }
 
-  std::vector<std::pair<std::string, std::pair<size_t, size_t>>> typeStats(
-      typePolygonStats.begin(), typePolygonStats.end());
-  std::sort(typeStats.begin(), typeStats.end(),
+  for (auto &[source, entry] : typePolygonStats) {
+    entry.source = source;
+    model.topContributors.push_back(std::move(entry));
+  }
+  std::sort(model.topContributors.begin(), model.topContributors.end(),
             [](const auto &a, const auto &b) {
-              return a.second.second > b.second.second;
+              if (a.vertices != b.vertices)
+                return a.vertices > b.vertices;
+              return a.source < b.source;
             });
+  if (model.topContributors.size() > topTypeCount)
+    model.topContributors.resize(topTypeCount);
 
-  size_t triangleCount = 0;
-  size_t quadCount = 0;
-  size_t complexCount = 0;
   for (const auto &[verts, count] : polygonHistogram) {
     if (verts == 3)
-      triangleCount += count;
+      model.triangles += count;
     else if (verts == 4)
-      quadCount += count;
+      model.quads += count;
     else if (verts >= 5)
-      complexCount += count;
+      model.complexPolygons += count;
   }
+  return model;
+}
+
+std::string BuildPrintDiagnostics(const CommandBuffer &buffer,
+                                  size_t topTypeCount) {
+  const PrintCostModel model = ComputePrintCostModel(buffer, topTypeCount);
 
   std::ostringstream report;
   report << "Print Viewer 2D diagnostics\n";
-  report << "Total commands: " << buffer.commands.size() << "\n";
+  report << "Total commands: " << model.totalCommands << "\n";
   report << "Command counts:\n";
-  for (const auto &[name, count] : commandCounts)
+  for (const auto &[name, count] : model.commandCounts)
     report << "  " << name << ": " << count << "\n";
 
   report << "Polygon histogram:\n";
-  report << "  Triangles: " << triangleCount << "\n";
-  report << "  Quads: " << quadCount << "\n";
-  report << "  5+ verts: " << complexCount << "\n";
+  report << "  Triangles: " << model.triangles << "\n";
+  report << "  Quads: " << model.quads << "\n";
+  report << "  5+ verts: " << model.complexPolygons << "\n";
 
   report << "Top polygon contributors:\n";
-  size_t printed = 0;
-  for (const auto &entry : typeStats) {
-    if (printed++ >= topTypeCount)
-      break;
-    report << "  " << entry.first << ": " << entry.second.first
-           << " polygons / " << entry.second.second << " verts\n";
+  for (const auto &entry : model.topContributors) {
+    report << "  " << entry.source << ": " << entry.polygons
+           << " polygons / " << entry.vertices << " verts\n";
   }
-  if (typeStats.empty())
+  if (model.topContributors.empty())
     report << "  (no polygon data)\n";
 
-  report << "Estimated content bytes: " << estimatedBytes << "\n";
+  report << "Estimated content bytes: " << model.estimatedBytes << "\n";
   return report.str();
 }
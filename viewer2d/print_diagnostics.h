@@ -18,7 +18,32 @@
 #pragma once
 
 #include "canvas2d.h"
+#include <map>
 #include <string>
+#include <vector>
+
+struct PrintPolygonContributor {
+  std::string source;
+  size_t polygons = 0;
+  size_t vertices = 0;
+};
+
+// Cost of a captured 2D command buffer once it is written as PDF content.
+// The byte estimate follows the operators the PDF encoder emits for each
+// command, so it tracks the size of the uncompressed content stream.
+struct PrintCostModel {
+  size_t totalCommands = 0;
+  std::map<std::string, size_t> commandCounts;
+  size_t triangles = 0;
+  size_t quads = 0;
+  size_t complexPolygons = 0;
+  // Sources with the most polygon vertices, largest first.
+  std::vector<PrintPolygonContributor> topContributors;
+  size_t estimatedBytes = 0;
+};
+
+PrintCostModel ComputePrintCostModel(const CommandBuffer &buffer,
+                                     size_t topTypeCount = 5);
 
 // Builds a textual report that summarizes the cost of the captured 2D commands
 // before exporting them to PDF.
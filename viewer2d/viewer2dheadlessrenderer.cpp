@@ -0,0 +1,73 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "viewer2dheadlessrenderer.h"
+
+#include <string>
+#include <unordered_set>
+
+Viewer2DHeadlessRenderer::Viewer2DHeadlessRenderer() {
+  controller_.SetCaptureOnly(true);
+}
+
+Viewer2DViewState
+Viewer2DHeadlessRenderer::Capture(const viewer2d::Viewer2DState &state,
+                                  CommandBuffer &buffer,
+                                  bool useSimplifiedFootprints,
+                                  bool includeGrid) {
+  const auto &camera = state.camera;
+  const auto &options = state.renderOptions;
+  const Viewer2DView view = static_cast<Viewer2DView>(camera.view);
+
+  // The layers come from the state, not from ConfigManager, so a capture
+  // does not disturb the views on screen.
+  controller_.SetHiddenLayersOverride(std::unordered_set<std::string>(
+      state.layers.hiddenLayers.begin(), state.layers.hiddenLayers.end()));
+  controller_.SetDarkMode(options.darkMode);
+  controller_.UpdateResourcesIfDirty();
+
+  buffer.Clear();
+  auto canvas = CreateRecordingCanvas(buffer, false);
+  // Same identity transform as Viewer2DPanel: the exporter applies the
+  // offsets and zoom from the returned view state.
+  CanvasTransform transform{};
+  canvas->BeginFrame();
+  canvas->SetTransform(transform);
+  controller_.SetCaptureCanvas(canvas.get(), view, includeGrid,
+                               useSimplifiedFootprints);
+  controller_.RenderScene(true,
+                          static_cast<Viewer2DRenderMode>(options.renderMode),
+                          view, options.showGrid, options.gridStyle,
+                          options.gridColorR, options.gridColorG,
+                          options.gridColorB, options.gridDrawAbove, true);
+  canvas->EndFrame();
+  controller_.SetCaptureCanvas(nullptr, view);
+
+  Viewer2DViewState viewState;
+  viewState.offsetPixelsX = camera.offsetPixelsX;
+  viewState.offsetPixelsY = camera.offsetPixelsY;
+  viewState.zoom = camera.zoom;
+  viewState.viewportWidth = camera.viewportWidth;
+  viewState.viewportHeight = camera.viewportHeight;
+  viewState.view = view;
+  return viewState;
+}
+
+std::shared_ptr<const SymbolDefinitionSnapshot>
+Viewer2DHeadlessRenderer::GetBottomSymbolCacheSnapshot() const {
+  return controller_.GetBottomSymbolCacheSnapshot();
+}
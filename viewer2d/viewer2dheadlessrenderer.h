@@ -0,0 +1,48 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "canvas2d.h"
+#include "viewer2dstate.h"
+#include "viewer2dviewstate.h"
+#include "viewer3dcontroller.h"
+
+#include <memory>
+
+// Records 2D views into command buffers without a window or GL context. It
+// owns its own capture-only controller, so layout export and benchmarks can
+// run in a plain process. The scene must not change while a capture runs.
+// Fixture labels are measured with NanoVG, which needs GL, so they are left
+// out: a capture holds the grid and scene geometry but no label text.
+class Viewer2DHeadlessRenderer {
+public:
+  Viewer2DHeadlessRenderer();
+
+  // Records the view described by `state` into `buffer` and returns the
+  // view state the exporter needs to rebuild its projection.
+  Viewer2DViewState Capture(const viewer2d::Viewer2DState &state,
+                            CommandBuffer &buffer,
+                            bool useSimplifiedFootprints = false,
+                            bool includeGrid = true);
+
+  std::shared_ptr<const SymbolDefinitionSnapshot>
+  GetBottomSymbolCacheSnapshot() const;
+
+private:
+  Viewer3DController controller_;
+};
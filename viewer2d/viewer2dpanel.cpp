@@ -59,6 +59,7 @@
 #include <new>
 #include <set>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 // Pixels per meter at default zoom level.
@@ -276,6 +277,14 @@ Viewer2DPanel::Viewer2DPanel(wxWindow *parent, bool allowOffscreenRender,
       m_persistViewState(persistViewState),
       m_enableSelection(enableSelection) {
   SetBackgroundStyle(wxBG_STYLE_CUSTOM);
+  const ConfigManager &cfg = ConfigManager::Get();
+  m_framePrefs = {cfg.ResolveFloat("view2d_dark_mode"),
+                  cfg.ResolveFloat("grid_show"),
+                  cfg.ResolveFloat("grid_style"),
+                  cfg.ResolveFloat("grid_color_r"),
+                  cfg.ResolveFloat("grid_color_g"),
+                  cfg.ResolveFloat("grid_color_b"),
+                  cfg.ResolveFloat("grid_draw_above")};
   m_controller.SetSelectionOutlineEnabled(m_enableSelection);
   m_glContext = new wxGLContext(this);
   if (m_enableSelection) {
@@ -564,19 +573,20 @@ void Viewer2DPanel::RenderInternal(bool swapBuffers) {
   // scene/layer visibility refreshes.
   if (!pauseHeavyTasks)
     m_controller.UpdateResourcesIfDirty();
-  bool darkMode = cfg.GetFloat("view2d_dark_mode") != 0.0f;
+  const FramePreferences &prefs = m_framePrefs;
+  bool darkMode = cfg.GetFloat(prefs.darkMode) != 0.0f;
   m_controller.SetDarkMode(darkMode);
   if (darkMode)
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
   else
     glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-  bool showGrid = cfg.GetFloat("grid_show") != 0.0f;
-  int gridStyle = static_cast<int>(cfg.GetFloat("grid_style"));
-  float gridR = cfg.GetFloat("grid_color_r");
-  float gridG = cfg.GetFloat("grid_color_g");
-  float gridB = cfg.GetFloat("grid_color_b");
-  bool drawAbove = cfg.GetFloat("grid_draw_above") != 0.0f;
+  bool showGrid = cfg.GetFloat(prefs.showGrid) != 0.0f;
+  int gridStyle = static_cast<int>(cfg.GetFloat(prefs.gridStyle));
+  float gridR = cfg.GetFloat(prefs.gridR);
+  float gridG = cfg.GetFloat(prefs.gridG);
+  float gridB = cfg.GetFloat(prefs.gridB);
+  bool drawAbove = cfg.GetFloat(prefs.drawAbove) != 0.0f;
 
   std::unique_ptr<ICanvas2D> recordingCanvas;
   if (m_captureNextFrame) {
@@ -868,7 +878,6 @@ void Viewer2DPanel::ApplySelectionDelta(
     m_dragSelectionPushedUndo = true;
   }
   auto &scene = cfg.GetScene();
-  std::lock_guard<std::mutex> sceneLock(m_dragTableUpdateSceneMutex);
 
   auto applyDelta = [&](auto &items) {
     for (const auto &uuid : m_dragSelectionUuids) {
@@ -902,27 +911,19 @@ void Viewer2DPanel::ApplySelectionDelta(
 void Viewer2DPanel::FinalizeSelectionDrag() {
   StopDragTableUpdates();
   ConfigManager &cfg = ConfigManager::Get();
+  // The tables refresh just the dragged rows and keep their selection.
   switch (m_dragTarget) {
   case DragTarget::Fixtures:
-    if (FixtureTablePanel::Instance()) {
-      auto selection = cfg.GetSelectedFixtures();
-      FixtureTablePanel::Instance()->ReloadData();
-      FixtureTablePanel::Instance()->SelectByUuid(selection);
-    }
+    cfg.NotifySceneChanged(SceneEntityKind::Fixture, m_dragSelectionUuids,
+                           SceneComponent::Transform);
     break;
   case DragTarget::Trusses:
-    if (TrussTablePanel::Instance()) {
-      auto selection = cfg.GetSelectedTrusses();
-      TrussTablePanel::Instance()->ReloadData();
-      TrussTablePanel::Instance()->SelectByUuid(selection);
-    }
+    cfg.NotifySceneChanged(SceneEntityKind::Truss, m_dragSelectionUuids,
+                           SceneComponent::Transform);
     break;
   case DragTarget::SceneObjects:
-    if (SceneObjectTablePanel::Instance()) {
-      auto selection = cfg.GetSelectedSceneObjects();
-      SceneObjectTablePanel::Instance()->ReloadData();
-      SceneObjectTablePanel::Instance()->SelectByUuid(selection);
-    }
+    cfg.NotifySceneChanged(SceneEntityKind::SceneObject, m_dragSelectionUuids,
+                           SceneComponent::Transform);
     break;
   default:
     break;
@@ -1064,7 +1065,7 @@ void Viewer2DPanel::StopDragTableUpdates() {
     std::lock_guard<std::mutex> lock(m_dragTableUpdateMutex);
     m_dragTableUpdateQueued = false;
     m_dragTableUpdateWorkerTarget = DragTarget::None;
-    m_dragTableUpdateUuids.clear();
+    m_dragTableUpdateSnapshots.clear();
   }
 }
 
@@ -1075,7 +1076,7 @@ void Viewer2DPanel::StartDragTableUpdateWorker() {
         std::chrono::milliseconds(kDragTableUpdateIntervalMs);
     while (true) {
       DragTarget target = DragTarget::None;
-      std::vector<std::string> uuids;
+      std::vector<DragTablePositionSnapshot> snapshots;
       {
         std::unique_lock<std::mutex> lock(m_dragTableUpdateMutex);
         m_dragTableUpdateCv.wait(lock, [this]() {
@@ -1098,15 +1099,11 @@ void Viewer2DPanel::StartDragTableUpdateWorker() {
         if (m_dragTableWorkerStop)
           break;
         target = m_dragTableUpdateWorkerTarget;
-        uuids = std::move(m_dragTableUpdateUuids);
+        snapshots = std::move(m_dragTableUpdateSnapshots);
         m_dragTableUpdateQueued = false;
       }
       lastUpdate = std::chrono::steady_clock::now();
 
-      if (uuids.empty())
-        continue;
-
-      auto snapshots = BuildDragTablePositionSnapshots(target, uuids);
       if (snapshots.empty())
         continue;
 
@@ -1157,13 +1154,11 @@ void Viewer2DPanel::StopDragTableUpdateWorker() {
 
 std::vector<Viewer2DPanel::DragTablePositionSnapshot>
 Viewer2DPanel::BuildDragTablePositionSnapshots(
-    DragTarget target, const std::vector<std::string> &uuids) {
+    DragTarget target, const std::vector<std::string> &uuids) const {
   std::vector<DragTablePositionSnapshot> snapshots;
   snapshots.reserve(uuids.size());
 
-  std::lock_guard<std::mutex> sceneLock(m_dragTableUpdateSceneMutex);
-  ConfigManager &cfg = ConfigManager::Get();
-  auto &scene = cfg.GetScene();
+  const MvrScene &scene = std::as_const(ConfigManager::Get()).GetScene();
 
   switch (target) {
   case DragTarget::Fixtures:
@@ -1205,10 +1200,11 @@ void Viewer2DPanel::QueueDragTableUpdate(DragTarget target,
   if (uuids.empty())
     return;
 
+  auto snapshots = BuildDragTablePositionSnapshots(target, uuids);
   {
     std::lock_guard<std::mutex> lock(m_dragTableUpdateMutex);
     m_dragTableUpdateWorkerTarget = target;
-    m_dragTableUpdateUuids = std::move(uuids);
+    m_dragTableUpdateSnapshots = std::move(snapshots);
     m_dragTableUpdateQueued = true;
   }
   m_dragTableUpdateCv.notify_one();
@@ -1351,8 +1347,8 @@ void Viewer2DPanel::OnMouseDClick(wxMouseEvent &event) {
   else
     it->second.address.clear();
 
-  if (FixtureTablePanel::Instance())
-    FixtureTablePanel::Instance()->ReloadData();
+  ConfigManager::Get().NotifySceneChanged(SceneEntityKind::Fixture, {uuid},
+                                          SceneComponent::Patch);
 
   UpdateScene(false);
   Refresh();
@@ -1541,7 +1537,7 @@ void Viewer2DPanel::OnRightUp(wxMouseEvent &event) {
     return;
   }
 
-  const auto &scene = ConfigManager::Get().GetScene();
+  const auto &scene = std::as_const(ConfigManager::Get()).GetScene();
   if (scene.fixtures.empty())
     return;
 
@@ -25,6 +25,8 @@
 #pragma once
 
 #include "canvas2d.h"
+#include "configmanager.h"
+#include "viewer2dviewstate.h"
 #include "viewer3dcontroller.h"
 #include <wx/glcanvas.h>
 #include <wx/wx.h>
@@ -39,17 +41,6 @@
 #include <thread>
 #include <vector>
 
-// Current viewport information used to rebuild the same projection when
-// exporting or printing the 2D view.
-struct Viewer2DViewState {
-  float offsetPixelsX = 0.0f;
-  float offsetPixelsY = 0.0f;
-  float zoom = 1.0f;
-  int viewportWidth = 0;
-  int viewportHeight = 0;
-  Viewer2DView view = Viewer2DView::Top;
-};
-
 class Viewer2DPanel : public wxGLCanvas {
 public:
   explicit Viewer2DPanel(wxWindow *parent, bool allowOffscreenRender = false,
@@ -163,9 +154,11 @@ private:
     float zMm = 0.0f;
   };
 
+  // Reads the live scene, so it runs on the UI thread; the worker only
+  // formats what it was handed.
   std::vector<DragTablePositionSnapshot>
   BuildDragTablePositionSnapshots(DragTarget target,
-                                  const std::vector<std::string> &uuids);
+                                  const std::vector<std::string> &uuids) const;
   void QueueDragTableUpdate(DragTarget target,
                             std::vector<std::string> uuids);
 
@@ -212,8 +205,14 @@ private:
   bool m_dragTableWorkerStop = false;
   bool m_dragTableUpdateQueued = false;
   DragTarget m_dragTableUpdateWorkerTarget = DragTarget::None;
-  std::vector<std::string> m_dragTableUpdateUuids;
-  std::mutex m_dragTableUpdateSceneMutex;
+  std::vector<DragTablePositionSnapshot> m_dragTableUpdateSnapshots;
+
+  // Preferences read on every frame, resolved once at construction.
+  struct FramePreferences {
+    ConfigManager::FloatHandle darkMode, showGrid, gridStyle, gridR, gridG,
+        gridB, drawAbove;
+  };
+  FramePreferences m_framePrefs;
 
   wxGLContext *m_glContext = nullptr;
   bool m_glInitialized = false;
@@ -100,6 +100,17 @@ struct LayoutTextExportData {
   std::vector<Line> lines;
 };
 
+// Content of one page in a multi-page layout export. A page size of zero
+// falls back to the size given in Viewer2DPrintOptions.
+struct LayoutPageExportData {
+  std::vector<LayoutViewExportData> views;
+  std::vector<LayoutLegendExportData> legends;
+  std::vector<LayoutEventTableExportData> tables;
+  std::vector<LayoutTextExportData> texts;
+  double pageWidthPt = 0.0;
+  double pageHeightPt = 0.0;
+};
+
 // Writes the captured 2D drawing commands to a vector PDF that mirrors the
 // current viewport state. Returns structured information so callers can surface
 // meaningful errors to the user.
@@ -117,3 +128,10 @@ Viewer2DExportResult ExportLayoutToPdf(
     const std::vector<LayoutTextExportData> &texts,
     const Viewer2DPrintOptions &options,
     const std::filesystem::path &outputPath);
+
+// Writes several layouts into one multi-page PDF, one page per entry. Fonts
+// are embedded once and symbol forms are shared by every page that uses them.
+Viewer2DExportResult ExportLayoutsToPdf(
+    const std::vector<LayoutPageExportData> &pages,
+    const Viewer2DPrintOptions &options,
+    const std::filesystem::path &outputPath);
@@ -0,0 +1,31 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "viewer3d_types.h"
+
+// Current viewport information used to rebuild the same projection when
+// exporting or printing the 2D view.
+struct Viewer2DViewState {
+  float offsetPixelsX = 0.0f;
+  float offsetPixelsY = 0.0f;
+  float zoom = 1.0f;
+  int viewportWidth = 0;
+  int viewportHeight = 0;
+  Viewer2DView view = Viewer2DView::Top;
+};
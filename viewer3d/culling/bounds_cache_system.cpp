@@ -144,11 +144,11 @@ void BoundsCacheSystem::RebuildIfDirty(
         local.max = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
         bool localFound = false;
         for (const auto &obj : itg->second) {
-          for (size_t vi = 0; vi + 2 < obj.mesh.vertices.size(); vi += 3) {
+          for (size_t vi = 0; vi + 2 < obj.mesh->vertices.size(); vi += 3) {
             std::array<float, 3> p = {
-                obj.mesh.vertices[vi] * RENDER_SCALE,
-                obj.mesh.vertices[vi + 1] * RENDER_SCALE,
-                obj.mesh.vertices[vi + 2] * RENDER_SCALE};
+                obj.mesh->vertices[vi] * RENDER_SCALE,
+                obj.mesh->vertices[vi + 1] * RENDER_SCALE,
+                obj.mesh->vertices[vi + 2] * RENDER_SCALE};
             p = TransformPoint(obj.transform, p);
             local.min[0] = std::min(local.min[0], p[0]);
             local.min[1] = std::min(local.min[1], p[1]);
@@ -246,7 +246,8 @@ void BoundsCacheSystem::RebuildIfDirty(
     }
 
     if (!found) {
-      float len = (t.lengthMm > 0 ? t.lengthMm * RENDER_SCALE : 0.3f);
+      float len = (t.lengthMm > 0 ? t.lengthMm : Truss::kDefaultLengthMm) *
+                  RENDER_SCALE;
       float halfy = (t.widthMm > 0 ? t.widthMm * RENDER_SCALE * 0.5f : 0.15f);
       float z1 = (t.heightMm > 0 ? t.heightMm * RENDER_SCALE : 0.3f);
       std::array<std::array<float, 3>, 8> corners = {
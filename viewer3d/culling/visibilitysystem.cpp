@@ -68,11 +68,13 @@ struct CullingSettings {
   float minPixels2D = 1.0f;
 };
 
-static CullingSettings GetCullingSettings3D(const ConfigManager &cfg) {
+static CullingSettings GetCullingSettings3D(
+    const ConfigManager &cfg,
+    const std::array<ConfigManager::FloatHandle, 3> &handles) {
   CullingSettings s{};
-  s.enabled = cfg.GetFloat("render_culling_enabled") >= 0.5f;
-  s.minPixels3D = std::max(0.0f, cfg.GetFloat("render_culling_min_pixels_3d"));
-  s.minPixels2D = std::max(0.0f, cfg.GetFloat("render_culling_min_pixels_2d"));
+  s.enabled = cfg.GetFloat(handles[0]) >= 0.5f;
+  s.minPixels3D = std::max(0.0f, cfg.GetFloat(handles[1]));
+  s.minPixels2D = std::max(0.0f, cfg.GetFloat(handles[2]));
   return s;
 }
 
@@ -131,6 +133,14 @@ static bool ShouldCullByScreenRect(const ScreenRect &rect, int width,
 
 } // namespace
 
+VisibilitySystem::VisibilitySystem(IVisibilityContext &controller)
+    : m_controller(controller) {
+  const ConfigManager &cfg = ConfigManager::Get();
+  m_cullingHandles = {cfg.ResolveFloat("render_culling_enabled"),
+                      cfg.ResolveFloat("render_culling_min_pixels_3d"),
+                      cfg.ResolveFloat("render_culling_min_pixels_2d")};
+}
+
 bool VisibilitySystem::EnsureBoundsComputed(
     const std::string &uuid, IVisibilityContext::ItemType type,
     const std::unordered_set<std::string> &hiddenLayers) {
@@ -199,10 +209,10 @@ bool VisibilitySystem::EnsureBoundsComputed(
         local.max = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
         bool localFound = false;
         for (const auto &obj : itg->second) {
-          for (size_t vi = 0; vi + 2 < obj.mesh.vertices.size(); vi += 3) {
-            std::array<float, 3> p = {obj.mesh.vertices[vi] * RENDER_SCALE,
-                                      obj.mesh.vertices[vi + 1] * RENDER_SCALE,
-                                      obj.mesh.vertices[vi + 2] * RENDER_SCALE};
+          for (size_t vi = 0; vi + 2 < obj.mesh->vertices.size(); vi += 3) {
+            std::array<float, 3> p = {obj.mesh->vertices[vi] * RENDER_SCALE,
+                                      obj.mesh->vertices[vi + 1] * RENDER_SCALE,
+                                      obj.mesh->vertices[vi + 2] * RENDER_SCALE};
             p = TransformPoint(obj.transform, p);
             local.min[0] = std::min(local.min[0], p[0]);
             local.min[1] = std::min(local.min[1], p[1]);
@@ -659,7 +669,7 @@ const IVisibilityContext::VisibleSet &VisibilitySystem::GetVisibleSet(
 void VisibilitySystem::RebuildVisibleSetCache() {
   ConfigManager &cfg = ConfigManager::Get();
   const auto hiddenLayers = SnapshotHiddenLayers(cfg);
-  const CullingSettings culling = GetCullingSettings3D(cfg);
+  const CullingSettings culling = GetCullingSettings3D(cfg, m_cullingHandles);
   int viewport[4] = {0, 0, 0, 0};
   double model[16] = {0.0};
   double proj[16] = {0.0};
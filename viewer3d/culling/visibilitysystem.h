@@ -1,11 +1,13 @@
 #pragma once
 
+#include "configmanager.h"
 #include "ivisibilitycontext.h"
 
+#include <array>
+
 class VisibilitySystem {
 public:
-  explicit VisibilitySystem(IVisibilityContext &controller)
-      : m_controller(controller) {}
+  explicit VisibilitySystem(IVisibilityContext &controller);
 
   bool EnsureBoundsComputed(const std::string &uuid, IVisibilityContext::ItemType type,
                             const std::unordered_set<std::string> &hiddenLayers);
@@ -24,4 +26,6 @@ public:
 
 private:
   IVisibilityContext &m_controller;
+  // Culling preferences, resolved once at construction.
+  std::array<ConfigManager::FloatHandle, 3> m_cullingHandles;
 };
@@ -27,6 +27,7 @@
 #include <string_view>
 #include <tinyxml2.h>
 #include <wx/wx.h>
+#include <wx/thread.h>
 #include <wx/wfstream.h>
 class wxZipStreamLink;
 #include <wx/zipstrm.h>
@@ -41,6 +42,7 @@ class wxZipStreamLink;
 #include <fstream>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <cfloat>
 #include <cstdint>
 #include <sstream>
@@ -175,8 +177,21 @@ bool IsLikelyLensGeometry(tinyxml2::XMLElement* node,
 }
 } // namespace
 
+// Shared by whoever looked it up: an entry dropped from the cache stays
+// alive, with its extracted files, until the last reader lets go of it.
 struct GdtfCacheEntry
 {
+    GdtfCacheEntry() = default;
+    GdtfCacheEntry(const GdtfCacheEntry&) = delete;
+    GdtfCacheEntry& operator=(const GdtfCacheEntry&) = delete;
+    ~GdtfCacheEntry()
+    {
+        if (!extractedDir.empty()) {
+            std::error_code ec;
+            fs::remove_all(extractedDir, ec);
+        }
+    }
+
     fs::file_time_type timestamp;
     std::string extractedDir;
     std::unique_ptr<tinyxml2::XMLDocument> doc;
@@ -184,7 +199,12 @@ struct GdtfCacheEntry
     std::vector<std::string> modes;
     std::unordered_map<std::string, std::vector<GdtfChannelInfo>> modeChannels;
     std::unordered_map<std::string, int> modeChannelCounts;
-    std::unordered_map<std::string, Mesh> meshCache;
+    // Guards meshCache and the log state below, which LoadGdtf updates
+    // from whichever thread loads the fixture. Models are read and parsed
+    // outside it.
+    std::mutex stateMutex;
+    // Loaded models keyed by MeshCacheKey, shared by the GdtfObjects.
+    std::unordered_map<std::string, std::shared_ptr<const Mesh>> meshCache;
     std::string fixtureName;
     bool propertiesParsed = false;
     float weightKg = 0.0f;
@@ -197,10 +217,14 @@ struct GdtfCacheEntry
     size_t emptyGeometryLogCount = 0;
 };
 
-static std::unordered_map<std::string, GdtfCacheEntry> g_gdtfCache;
+static std::unordered_map<std::string, std::shared_ptr<GdtfCacheEntry>> g_gdtfCache;
 static std::unordered_map<std::string, fs::file_time_type> g_failedGdtfCache;
 static std::unordered_map<std::string, size_t> g_gdtfFailedAttempts;
 static std::unordered_map<std::string, std::string> g_gdtfFailureReasons;
+// Guards the maps above. Channel counts are looked up from worker threads
+// (see AutoPatcher); the parsed fields of an entry are not modified after
+// it is inserted, so readers holding it need no lock.
+static std::mutex g_gdtfCacheMutex;
 
 struct MissingModelLog
 {
@@ -264,6 +288,24 @@ static void ApplyModelDimensions(Mesh& mesh, const GdtfModelInfo& modelInfo)
     }
 }
 
+// Models are scaled to the dimensions of the GDTF Model node, so two nodes
+// sharing a file but not the dimensions need separate meshes.
+static std::string MeshCacheKey(const std::string& source, const GdtfModelInfo& modelInfo)
+{
+    return source + "|" + std::to_string(modelInfo.length) + "|" +
+           std::to_string(modelInfo.width) + "|" + std::to_string(modelInfo.height);
+}
+
+// Finishes the winding and normals a viewer would otherwise fix up on upload,
+// so the shared mesh can stay const.
+static std::shared_ptr<const Mesh> MakeSharedMesh(Mesh&& mesh)
+{
+    EnsureOutwardWinding(mesh);
+    if (mesh.normals.size() < mesh.vertices.size())
+        ComputeNormals(mesh);
+    return std::make_shared<const Mesh>(std::move(mesh));
+}
+
 static std::string FindModelFile(const std::string& baseDir,
                                  const std::string& fileName)
 {
@@ -349,22 +391,32 @@ private:
     bool extracted = false;
 };
 
+// ExtractZip may run on a worker thread, so messages reach the console
+// panel through the main thread.
+static void AppendConsoleMessage(const wxString& msg)
+{
+    if (!ConsolePanel::Instance())
+        return;
+    if (wxIsMainThread() || !wxTheApp) {
+        ConsolePanel::Instance()->AppendMessage(msg);
+        return;
+    }
+    wxTheApp->CallAfter([msg]() {
+        if (ConsolePanel::Instance())
+            ConsolePanel::Instance()->AppendMessage(msg);
+    });
+}
+
 static bool ExtractZip(const std::string& zipPath, const std::string& destDir)
 {
     if (!fs::exists(zipPath)) {
-        if (ConsolePanel::Instance()) {
-            wxString msg = wxString::Format("GDTF: cannot open %s", wxString::FromUTF8(zipPath));
-            ConsolePanel::Instance()->AppendMessage(msg);
-        }
+        AppendConsoleMessage(wxString::Format("GDTF: cannot open %s", wxString::FromUTF8(zipPath)));
         return false;
     }
     wxLogNull logNo;
     wxFileInputStream input(zipPath);
     if (!input.IsOk()) {
-        if (ConsolePanel::Instance()) {
-            wxString msg = wxString::Format("GDTF: cannot open %s", wxString::FromUTF8(zipPath));
-            ConsolePanel::Instance()->AppendMessage(msg);
-        }
+        AppendConsoleMessage(wxString::Format("GDTF: cannot open %s", wxString::FromUTF8(zipPath)));
         return false;
     }
     wxZipInputStream zipStream(input);
@@ -380,10 +432,7 @@ static bool ExtractZip(const std::string& zipPath, const std::string& destDir)
         wxFileName::Mkdir(wxFileName(fullPath).GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
         std::ofstream output(fullPath, std::ios::binary);
         if (!output.is_open()) {
-            if (ConsolePanel::Instance()) {
-                wxString msg = wxString::Format("GDTF: cannot create %s", wxString::FromUTF8(fullPath));
-                ConsolePanel::Instance()->AppendMessage(msg);
-            }
+            AppendConsoleMessage(wxString::Format("GDTF: cannot create %s", wxString::FromUTF8(fullPath)));
             return false;
         }
         char buffer[4096];
@@ -468,7 +517,7 @@ static void ParseModes(tinyxml2::XMLElement* ft,
                                 wxString msg = wxString::Format(
                                     "GDTF: invalid DMX channel offset '%s'",
                                     wxString::FromUTF8(first));
-                                ConsolePanel::Instance()->AppendMessage(msg);
+                                AppendConsoleMessage(msg);
                             }
                         }
                     }
@@ -506,7 +555,7 @@ static void ParseModes(tinyxml2::XMLElement* ft,
                             wxString msg = wxString::Format(
                                 "GDTF: invalid DMX channel offset '%s'",
                                 wxString::FromUTF8(token));
-                            ConsolePanel::Instance()->AppendMessage(msg);
+                            AppendConsoleMessage(msg);
                         }
                     }
                 }
@@ -594,7 +643,7 @@ static std::string ParseModelColor(tinyxml2::XMLElement* ft)
     return os.str();
 }
 
-static GdtfCacheEntry* GetCachedGdtf(const std::string& gdtfPath,
+static std::shared_ptr<GdtfCacheEntry> GetCachedGdtf(const std::string& gdtfPath,
                                      bool* cachedFailure = nullptr,
                                      bool* fromCache = nullptr,
                                      std::string* failureReason = nullptr,
@@ -654,35 +703,46 @@ static GdtfCacheEntry* GetCachedGdtf(const std::string& gdtfPath,
     if (outStableKey)
         *outStableKey = stableKey;
 
-    auto failedIt = g_failedGdtfCache.find(stableKey);
-    if (failedIt != g_failedGdtfCache.end()) {
-        if (cachedFailure)
-            *cachedFailure = true;
-        auto reasonIt = g_gdtfFailureReasons.find(stableKey);
-        if (reasonIt != g_gdtfFailureReasons.end())
-            setReason(reasonIt->second);
-        return nullptr;
-    }
-
-    auto it = g_gdtfCache.find(stableKey);
-    if (it != g_gdtfCache.end()) {
-        if (it->second.doc && it->second.fixtureType) {
-            if (fromCache)
-                *fromCache = true;
-            return &it->second;
+    {
+        std::lock_guard<std::mutex> lock(g_gdtfCacheMutex);
+        auto failedIt = g_failedGdtfCache.find(stableKey);
+        if (failedIt != g_failedGdtfCache.end()) {
+            if (cachedFailure)
+                *cachedFailure = true;
+            auto reasonIt = g_gdtfFailureReasons.find(stableKey);
+            if (reasonIt != g_gdtfFailureReasons.end())
+                setReason(reasonIt->second);
+            return nullptr;
         }
 
-        fs::remove_all(it->second.extractedDir, ec);
-        g_gdtfCache.erase(it);
+        auto it = g_gdtfCache.find(stableKey);
+        if (it != g_gdtfCache.end()) {
+            if (it->second->doc && it->second->fixtureType) {
+                if (fromCache)
+                    *fromCache = true;
+                return it->second;
+            }
+            g_gdtfCache.erase(it);
+        }
     }
 
-    GdtfCacheEntry entry;
+    // Hashing above and extraction and parsing below run unlocked, so a
+    // thumbnail worker opening a new file does not hold up lookups of
+    // others. Two threads may parse the same new file; the first to insert
+    // wins and the other copy is dropped.
+    auto recordFailure = [&](const std::string& reason) {
+        setReason(reason);
+        std::lock_guard<std::mutex> lock(g_gdtfCacheMutex);
+        g_failedGdtfCache[stableKey] = timestamp;
+        g_gdtfFailureReasons[stableKey] = reason;
+    };
+
+    auto created = std::make_shared<GdtfCacheEntry>();
+    GdtfCacheEntry& entry = *created;
     entry.timestamp = timestamp;
     TempExtraction extraction(absPath.string());
     if (!extraction.IsValid()) {
-        g_failedGdtfCache[stableKey] = timestamp;
-        setReason("Unable to extract GDTF archive (corrupted or unreadable file)");
-        g_gdtfFailureReasons[stableKey] = failureReason ? *failureReason : "unknown error";
+        recordFailure("Unable to extract GDTF archive (corrupted or unreadable file)");
         return nullptr;
     }
     entry.extractedDir = extraction.Release();
@@ -690,19 +750,13 @@ static GdtfCacheEntry* GetCachedGdtf(const std::string& gdtfPath,
     entry.doc = std::make_unique<tinyxml2::XMLDocument>();
     std::string descPath = entry.extractedDir + "/description.xml";
     if (entry.doc->LoadFile(descPath.c_str()) != tinyxml2::XML_SUCCESS) {
-        fs::remove_all(entry.extractedDir, ec);
-        g_failedGdtfCache[stableKey] = timestamp;
-        setReason("Missing or invalid description.xml inside GDTF file");
-        g_gdtfFailureReasons[stableKey] = failureReason ? *failureReason : "unknown error";
+        recordFailure("Missing or invalid description.xml inside GDTF file");
         return nullptr;
     }
 
     entry.fixtureType = GetFixtureType(*entry.doc);
     if (!entry.fixtureType) {
-        fs::remove_all(entry.extractedDir, ec);
-        g_failedGdtfCache[stableKey] = timestamp;
-        setReason("GDTF description.xml is missing a <FixtureType> element");
-        g_gdtfFailureReasons[stableKey] = failureReason ? *failureReason : "unknown error";
+        recordFailure("GDTF description.xml is missing a <FixtureType> element");
         return nullptr;
     }
 
@@ -713,10 +767,11 @@ static GdtfCacheEntry* GetCachedGdtf(const std::string& gdtfPath,
     entry.modelColor = ParseModelColor(entry.fixtureType);
     entry.modelColorParsed = true;
 
-    auto res = g_gdtfCache.emplace(stableKey, std::move(entry));
+    std::lock_guard<std::mutex> lock(g_gdtfCacheMutex);
+    auto res = g_gdtfCache.try_emplace(stableKey, created);
     g_failedGdtfCache.erase(stableKey);
     g_gdtfFailureReasons.erase(stableKey);
-    return res.second ? &res.first->second : nullptr;
+    return res.first->second;
 }
 
 static void ParseGeometry(tinyxml2::XMLElement* node,
@@ -724,7 +779,8 @@ static void ParseGeometry(tinyxml2::XMLElement* node,
                           const std::unordered_map<std::string, GdtfModelInfo>& models,
                           const std::string& baseDir,
                           const std::unordered_map<std::string, tinyxml2::XMLElement*>& geomMap,
-                          std::unordered_map<std::string, Mesh>& meshCache,
+                          std::unordered_map<std::string, std::shared_ptr<const Mesh>>& meshCache,
+                          std::mutex& stateMutex,
                           std::vector<GdtfObject>& outObjects,
                           std::unordered_set<std::string>* missingModels,
                           std::unordered_set<std::string>* failedModelLoads,
@@ -744,7 +800,7 @@ static void ParseGeometry(tinyxml2::XMLElement* node,
             auto it = geomMap.find(refName);
             if (it != geomMap.end()) {
                 const char* m = node->Attribute("Model");
-                ParseGeometry(it->second, transform, models, baseDir, geomMap, meshCache, outObjects, missingModels, failedModelLoads, m ? m : overrideModel, parentIsLens);
+                ParseGeometry(it->second, transform, models, baseDir, geomMap, meshCache, stateMutex, outObjects, missingModels, failedModelLoads, m ? m : overrideModel, parentIsLens);
             }
         }
         return;
@@ -756,62 +812,87 @@ static void ParseGeometry(tinyxml2::XMLElement* node,
         auto it = models.find(modelName);
         if (it != models.end()) {
             const GdtfModelInfo& modelInfo = it->second;
-            Mesh mesh;
-            bool haveMesh = false;
+            std::shared_ptr<const Mesh> shared;
 
             if (!modelInfo.file.empty()) {
                 std::string path = FindModelFile(baseDir, modelInfo.file);
                 if (!path.empty()) {
-                    auto mit = meshCache.find(path);
-                    if (mit == meshCache.end()) {
-                        bool alreadyFailed = failedModelLoads && failedModelLoads->find(path) != failedModelLoads->end();
-                        if (!alreadyFailed) {
-                            bool loaded = false;
-                            if (HasExtension(path, ".3ds"))
-                                loaded = Load3DS(path, mesh);
-                            else if (HasExtension(path, ".glb"))
-                                loaded = LoadGLB(path, mesh);
-
-                            if (loaded) {
-                                ApplyModelDimensions(mesh, modelInfo);
-                                mit = meshCache.emplace(path, std::move(mesh)).first;
-                            } else {
-                                bool shouldLog = true;
-                                if (failedModelLoads)
-                                    shouldLog = failedModelLoads->insert(path).second;
-
-                                if (shouldLog && ConsolePanel::Instance()) {
-                                    wxString msg = wxString::Format("GDTF: failed to load model %s", wxString::FromUTF8(path));
-                                    ConsolePanel::Instance()->AppendMessage(msg);
-                                }
+                    const std::string key = MeshCacheKey(path, modelInfo);
+                    bool alreadyFailed = false;
+                    {
+                        std::lock_guard<std::mutex> lock(stateMutex);
+                        auto mit = meshCache.find(key);
+                        if (mit != meshCache.end())
+                            shared = mit->second;
+                        else
+                            alreadyFailed = failedModelLoads && failedModelLoads->find(path) != failedModelLoads->end();
+                    }
+                    if (!shared && !alreadyFailed) {
+                        Mesh mesh;
+                        bool loaded = false;
+                        if (HasExtension(path, ".3ds"))
+                            loaded = Load3DS(path, mesh);
+                        else if (HasExtension(path, ".glb"))
+                            loaded = LoadGLB(path, mesh);
+
+                        if (loaded) {
+                            ApplyModelDimensions(mesh, modelInfo);
+                            auto built = MakeSharedMesh(std::move(mesh));
+                            // Another thread may have loaded it meanwhile;
+                            // keep the first so objects share one mesh.
+                            std::lock_guard<std::mutex> lock(stateMutex);
+                            shared = meshCache.try_emplace(key, std::move(built)).first->second;
+                        } else {
+                            bool shouldLog = true;
+                            if (failedModelLoads) {
+                                std::lock_guard<std::mutex> lock(stateMutex);
+                                shouldLog = failedModelLoads->insert(path).second;
+                            }
+
+                            if (shouldLog && ConsolePanel::Instance()) {
+                                wxString msg = wxString::Format("GDTF: failed to load model %s", wxString::FromUTF8(path));
+                                AppendConsoleMessage(msg);
                             }
                         }
                     }
-                    if (mit != meshCache.end()) {
-                        mesh = mit->second;
-                        haveMesh = true;
-                    }
                 } else if (ConsolePanel::Instance()) {
                     std::string key = baseDir + "|" + modelInfo.file;
-                    if (!missingModels || missingModels->insert(key).second) {
+                    bool firstReport = true;
+                    if (missingModels) {
+                        std::lock_guard<std::mutex> lock(stateMutex);
+                        firstReport = missingModels->insert(key).second;
+                    }
+                    if (firstReport) {
                         wxString msg = wxString::Format(
                             "GDTF: missing model file %s in %s",
                             wxString::FromUTF8(modelInfo.file),
                             wxString::FromUTF8(baseDir));
-                        ConsolePanel::Instance()->AppendMessage(msg);
+                        AppendConsoleMessage(msg);
                     }
                 }
             }
 
-            if (!haveMesh && IsPrimitiveTypeDefined(modelInfo.primitiveType)) {
-                if (BuildPrimitiveMesh(modelInfo.primitiveType, mesh)) {
-                    ApplyModelDimensions(mesh, modelInfo);
-                    haveMesh = true;
+            if (!shared && IsPrimitiveTypeDefined(modelInfo.primitiveType)) {
+                const std::string key = MeshCacheKey("primitive:" + modelInfo.primitiveType, modelInfo);
+                {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    auto mit = meshCache.find(key);
+                    if (mit != meshCache.end())
+                        shared = mit->second;
+                }
+                if (!shared) {
+                    Mesh mesh;
+                    if (BuildPrimitiveMesh(modelInfo.primitiveType, mesh)) {
+                        ApplyModelDimensions(mesh, modelInfo);
+                        auto built = MakeSharedMesh(std::move(mesh));
+                        std::lock_guard<std::mutex> lock(stateMutex);
+                        shared = meshCache.try_emplace(key, std::move(built)).first->second;
+                    }
                 }
             }
 
-            if (haveMesh)
-                outObjects.push_back({mesh, transform, isLensGeometry});
+            if (shared)
+                outObjects.push_back({std::move(shared), transform, isLensGeometry});
         }
     }
 
@@ -821,7 +902,7 @@ static void ParseGeometry(tinyxml2::XMLElement* node,
             n=="MediaServerLayer" || n=="MediaServerCamera" || n=="MediaServerMaster" ||
             n=="Display" || n=="GeometryReference" || n=="Laser" || n=="WiringObject" ||
             n=="Inventory" || n=="Structure" || n=="Support" || n=="Magnet") {
-            ParseGeometry(child, transform, models, baseDir, geomMap, meshCache, outObjects, missingModels, failedModelLoads, nullptr, isLensGeometry);
+            ParseGeometry(child, transform, models, baseDir, geomMap, meshCache, stateMutex, outObjects, missingModels, failedModelLoads, nullptr, isLensGeometry);
         }
     }
 }
@@ -838,14 +919,20 @@ bool LoadGdtf(const std::string& gdtfPath,
     std::string failureReason;
     std::string cacheKey;
 
-    GdtfCacheEntry* entry = GetCachedGdtf(gdtfPath, &cachedFailure, &fromCache, &failureReason, &cacheKey);
+    std::shared_ptr<GdtfCacheEntry> entry =
+        GetCachedGdtf(gdtfPath, &cachedFailure, &fromCache, &failureReason, &cacheKey);
+    const std::string attemptsKey = cacheKey.empty() ? gdtfPath : cacheKey;
 
     if (!fromCache && !cachedFailure && ConsolePanel::Instance()) {
         wxString msg = wxString::Format("Loading GDTF %s", wxString::FromUTF8(gdtfPath));
-        ConsolePanel::Instance()->AppendMessage(msg);
+        AppendConsoleMessage(msg);
     }
     if (!entry || !entry->fixtureType) {
-        size_t failureCount = ++g_gdtfFailedAttempts[cacheKey.empty() ? gdtfPath : cacheKey];
+        size_t failureCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(g_gdtfCacheMutex);
+            failureCount = ++g_gdtfFailedAttempts[attemptsKey];
+        }
         if (outError)
             *outError = failureReason.empty() ? "unknown error" : failureReason;
         else if (ConsolePanel::Instance()) {
@@ -856,19 +943,22 @@ bool LoadGdtf(const std::string& gdtfPath,
                         wxString::FromUTF8(gdtfPath),
                         wxString::FromUTF8(failureReason.empty() ? "unknown error" : failureReason),
                         failureCount);
-                    ConsolePanel::Instance()->AppendMessage(msg);
+                    AppendConsoleMessage(msg);
                 }
             } else {
                 wxString msg = wxString::Format("GDTF: failed to load %s: %s",
                                                wxString::FromUTF8(gdtfPath),
                                                wxString::FromUTF8(failureReason.empty() ? "unknown error" : failureReason));
-                ConsolePanel::Instance()->AppendMessage(msg);
+                AppendConsoleMessage(msg);
             }
         }
         return false;
     }
 
-    g_gdtfFailedAttempts.erase(cacheKey.empty() ? gdtfPath : cacheKey);
+    {
+        std::lock_guard<std::mutex> lock(g_gdtfCacheMutex);
+        g_gdtfFailedAttempts.erase(attemptsKey);
+    }
 
     tinyxml2::XMLElement* ft = entry->fixtureType;
 
@@ -883,11 +973,16 @@ bool LoadGdtf(const std::string& gdtfPath,
             std::string primitive = primitiveType ? primitiveType : "";
             bool hasPrimitive = IsPrimitiveTypeDefined(primitive);
             if (hasName && !hasFile && !hasPrimitive) {
-                if (ConsolePanel::Instance() && entry->emptyModelFileLogged.insert(name).second) {
+                bool firstReport = false;
+                {
+                    std::lock_guard<std::mutex> lock(entry->stateMutex);
+                    firstReport = entry->emptyModelFileLogged.insert(name).second;
+                }
+                if (ConsolePanel::Instance() && firstReport) {
                     wxString msg = wxString::Format(
                         "GDTF: Model %s has empty File and undefined PrimitiveType",
                         wxString::FromUTF8(name));
-                    ConsolePanel::Instance()->AppendMessage(msg);
+                    AppendConsoleMessage(msg);
                 }
                 continue;
             }
@@ -904,7 +999,8 @@ bool LoadGdtf(const std::string& gdtfPath,
         }
     }
 
-    std::unordered_map<std::string, Mesh>& meshCache = entry->meshCache;
+    auto& meshCache = entry->meshCache;
+    std::mutex& stateMutex = entry->stateMutex;
     std::unordered_set<std::string>* missingModels = &entry->missingModelsLogged;
     std::unordered_set<std::string>* failedModelLoads = &entry->failedModelLoads;
     if (tinyxml2::XMLElement* geoms = ft->FirstChildElement("Geometries")) {
@@ -914,7 +1010,7 @@ bool LoadGdtf(const std::string& gdtfPath,
                 geomMap[n] = g;
         }
         for (tinyxml2::XMLElement* g = geoms->FirstChildElement(); g; g = g->NextSiblingElement()) {
-            ParseGeometry(g, MatrixUtils::Identity(), models, entry->extractedDir, geomMap, meshCache, outObjects, missingModels, failedModelLoads);
+            ParseGeometry(g, MatrixUtils::Identity(), models, entry->extractedDir, geomMap, meshCache, stateMutex, outObjects, missingModels, failedModelLoads);
         }
     }
 
@@ -922,21 +1018,24 @@ bool LoadGdtf(const std::string& gdtfPath,
         wxString msg = wxString::Format("GDTF: loaded %zu objects from %s",
                                        outObjects.size(),
                                        wxString::FromUTF8(gdtfPath));
-        ConsolePanel::Instance()->AppendMessage(msg);
+        AppendConsoleMessage(msg);
     }
 
     if (outObjects.empty()) {
         constexpr const char* kEmptyGeometryReason = "No geometry with models found";
-        size_t count = ++entry->emptyGeometryLogCount;
-        std::string extractionDir = entry->extractedDir;
-        auto timestamp = entry->timestamp;
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(entry->stateMutex);
+            count = ++entry->emptyGeometryLogCount;
+        }
 
+        // Readers still holding the entry keep it, and its extracted
+        // files, until they are done.
         if (!cacheKey.empty()) {
-            g_failedGdtfCache[cacheKey] = timestamp;
+            std::lock_guard<std::mutex> lock(g_gdtfCacheMutex);
+            g_failedGdtfCache[cacheKey] = entry->timestamp;
             g_gdtfFailureReasons[cacheKey] = kEmptyGeometryReason;
             g_gdtfCache.erase(cacheKey);
-            std::error_code ec;
-            fs::remove_all(extractionDir, ec);
         }
 
         if (outError)
@@ -946,19 +1045,22 @@ bool LoadGdtf(const std::string& gdtfPath,
                 wxString msg = wxString::Format(
                     "GDTF: loaded %s but no geometry with models was found",
                     wxString::FromUTF8(gdtfPath));
-                ConsolePanel::Instance()->AppendMessage(msg);
+                AppendConsoleMessage(msg);
             } else if (count == 2) {
                 wxString msg = wxString::Format(
                     "GDTF: loaded %s but no geometry with models was found (repeated %zu times, suppressing further messages)",
                     wxString::FromUTF8(gdtfPath),
                     count);
-                ConsolePanel::Instance()->AppendMessage(msg);
+                AppendConsoleMessage(msg);
             }
         }
         return false;
     }
 
-    entry->emptyGeometryLogCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(entry->stateMutex);
+        entry->emptyGeometryLogCount = 0;
+    }
     return true;
 }
 
@@ -968,7 +1070,7 @@ int GetGdtfModeChannelCount(const std::string& gdtfPath,
     if (gdtfPath.empty() || modeName.empty())
         return -1;
 
-    GdtfCacheEntry* entry = GetCachedGdtf(gdtfPath);
+    std::shared_ptr<const GdtfCacheEntry> entry = GetCachedGdtf(gdtfPath);
     if (!entry)
         return -1;
 
@@ -989,7 +1091,7 @@ std::vector<std::string> GetGdtfModes(const std::string& gdtfPath)
     if (gdtfPath.empty())
         return result;
 
-    GdtfCacheEntry* entry = GetCachedGdtf(gdtfPath);
+    std::shared_ptr<const GdtfCacheEntry> entry = GetCachedGdtf(gdtfPath);
     if (!entry)
         return result;
 
@@ -1004,7 +1106,7 @@ std::vector<GdtfChannelInfo> GetGdtfModeChannels(
     if (gdtfPath.empty() || modeName.empty())
         return result;
 
-    GdtfCacheEntry* entry = GetCachedGdtf(gdtfPath);
+    std::shared_ptr<const GdtfCacheEntry> entry = GetCachedGdtf(gdtfPath);
     if (!entry)
         return result;
 
@@ -1019,7 +1121,7 @@ std::string GetGdtfFixtureName(const std::string& gdtfPath)
     if (gdtfPath.empty())
         return {};
 
-    GdtfCacheEntry* entry = GetCachedGdtf(gdtfPath);
+    std::shared_ptr<const GdtfCacheEntry> entry = GetCachedGdtf(gdtfPath);
     if (!entry)
         return {};
 
@@ -1035,7 +1137,7 @@ bool GetGdtfProperties(const std::string& gdtfPath,
     if (gdtfPath.empty())
         return false;
 
-    GdtfCacheEntry* entry = GetCachedGdtf(gdtfPath);
+    std::shared_ptr<const GdtfCacheEntry> entry = GetCachedGdtf(gdtfPath);
     if (!entry)
         return false;
 
@@ -1049,7 +1151,7 @@ std::string GetGdtfModelColor(const std::string& gdtfPath)
     if (gdtfPath.empty())
         return {};
 
-    GdtfCacheEntry* entry = GetCachedGdtf(gdtfPath);
+    std::shared_ptr<const GdtfCacheEntry> entry = GetCachedGdtf(gdtfPath);
     if (!entry)
         return {};
 
@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "mesh.h"
@@ -24,7 +25,10 @@
 #include "types.h"
 
 struct GdtfObject {
-    Mesh mesh;
+    // Shared by every part of the fixture type that uses the same model, so
+    // repeated cells of e.g. a pixel batten keep a single copy. Never
+    // modified after loading.
+    std::shared_ptr<const Mesh> mesh;
     Matrix transform; // local transform relative to fixture
     bool isLens = false;
 };
@@ -46,7 +50,8 @@ struct GdtfChannelInfo {
     std::string function;      // Associated function/attribute
 };
 
-// Loads the models defined in a GDTF file. Returns true on success.
+// Loads the models defined in a GDTF file. Returns true on success. Safe to
+// call from worker threads; concurrent loads are serialised.
 bool LoadGdtf(const std::string& gdtfPath,
               std::vector<GdtfObject>& outObjects,
               std::string* outError = nullptr);
@@ -0,0 +1,377 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gdtfthumbnail.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr float kRenderScale = 0.001f; // mm to m, as in the preview
+constexpr int kSupersample = 2;
+constexpr int kMaxThumbnailSize = 1024;
+constexpr char kFileMagic[4] = {'P', 'S', 'T', 'H'};
+constexpr uint32_t kFileVersion = 1;
+
+struct Vec3 {
+    float x, y, z;
+};
+
+Vec3 Sub(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+
+float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+Vec3 Cross(const Vec3& a, const Vec3& b)
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+Vec3 Normalize(const Vec3& v)
+{
+    float len = std::sqrt(Dot(v, v));
+    return len > 0.0f ? Vec3{v.x / len, v.y / len, v.z / len} : v;
+}
+
+Vec3 TransformPoint(const Matrix& m, float x, float y, float z)
+{
+    return {m.u[0] * x + m.v[0] * y + m.w[0] * z + m.o[0],
+            m.u[1] * x + m.v[1] * y + m.w[1] * z + m.o[1],
+            m.u[2] * x + m.v[2] * y + m.w[2] * z + m.o[2]};
+}
+
+// A vertex projected to the image: x right and y down in pixels, depth
+// growing towards the viewer.
+struct ScreenVertex {
+    float x, y, depth;
+};
+
+std::string HashFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return {};
+    // FNV-1a, like the GDTF loader's cache key.
+    uint64_t hash = 14695981039346656037ull;
+    const uint64_t prime = 1099511628211ull;
+    char buffer[65536];
+    while (file.good()) {
+        file.read(buffer, sizeof(buffer));
+        std::streamsize read = file.gcount();
+        for (std::streamsize i = 0; i < read; ++i) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= prime;
+        }
+    }
+    if (file.bad())
+        return {};
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+}
+
+void WriteU32(std::ostream& out, uint32_t value)
+{
+    const unsigned char bytes[4] = {
+        static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+        static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24)};
+    out.write(reinterpret_cast<const char*>(bytes), 4);
+}
+
+bool ReadU32(std::istream& in, uint32_t& value)
+{
+    unsigned char bytes[4];
+    if (!in.read(reinterpret_cast<char*>(bytes), 4))
+        return false;
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+            (static_cast<uint32_t>(bytes[3]) << 24);
+    return true;
+}
+
+} // namespace
+
+GdtfThumbnail RenderGdtfThumbnail(const std::vector<GdtfObject>& objects,
+                                  int size)
+{
+    if (size <= 0 || size > kMaxThumbnailSize)
+        return {};
+
+    // Same view as FixturePreviewPanel: orbit yaw 45, pitch 30, Z up.
+    const float yaw = 45.0f * 3.14159265f / 180.0f;
+    const float pitch = 30.0f * 3.14159265f / 180.0f;
+    const Vec3 toCamera{std::cos(pitch) * std::sin(yaw),
+                        -std::cos(pitch) * std::cos(yaw), std::sin(pitch)};
+    const Vec3 forward{-toCamera.x, -toCamera.y, -toCamera.z};
+    const Vec3 right = Normalize(Cross(forward, Vec3{0.0f, 0.0f, 1.0f}));
+    const Vec3 up = Cross(right, forward);
+
+    // World-space triangles with their headlight shading.
+    std::vector<Vec3> corners;
+    std::vector<float> shades;
+    for (const auto& obj : objects) {
+        if (!obj.mesh)
+            continue;
+        const Mesh& mesh = *obj.mesh;
+        const size_t vertexCount = mesh.vertices.size() / 3;
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            Vec3 tri[3];
+            bool valid = true;
+            for (int k = 0; k < 3; ++k) {
+                const size_t index = mesh.indices[i + k];
+                if (index >= vertexCount) {
+                    valid = false;
+                    break;
+                }
+                tri[k] = TransformPoint(obj.transform,
+                                        mesh.vertices[index * 3] * kRenderScale,
+                                        mesh.vertices[index * 3 + 1] * kRenderScale,
+                                        mesh.vertices[index * 3 + 2] * kRenderScale);
+            }
+            if (!valid)
+                continue;
+            Vec3 normal = Normalize(Cross(Sub(tri[1], tri[0]), Sub(tri[2], tri[0])));
+            // Winding is not reliable across GDTF exporters, so both sides
+            // are lit.
+            shades.push_back(0.25f + 0.75f * std::fabs(Dot(normal, toCamera)));
+            corners.insert(corners.end(), tri, tri + 3);
+        }
+    }
+    if (corners.empty())
+        return {};
+
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (const auto& p : corners) {
+        const float x = Dot(p, right);
+        const float y = Dot(p, up);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    // Fit the projected bounds into the image with a one pixel margin.
+    const int canvas = size * kSupersample;
+    const float margin = static_cast<float>(kSupersample);
+    const float extent = std::max({maxX - minX, maxY - minY, 1e-6f});
+    const float scale = (canvas - 2.0f * margin) / extent;
+    const float offsetX = (canvas - (maxX - minX) * scale) * 0.5f;
+    const float offsetY = (canvas - (maxY - minY) * scale) * 0.5f;
+    auto project = [&](const Vec3& p) {
+        return ScreenVertex{offsetX + (Dot(p, right) - minX) * scale,
+                            offsetY + (maxY - Dot(p, up)) * scale,
+                            Dot(p, toCamera)};
+    };
+
+    std::vector<float> depth(static_cast<size_t>(canvas) * canvas, -FLT_MAX);
+    std::vector<float> shade(depth.size(), -1.0f);
+    for (size_t t = 0; t < shades.size(); ++t) {
+        const ScreenVertex a = project(corners[t * 3]);
+        const ScreenVertex b = project(corners[t * 3 + 1]);
+        const ScreenVertex c = project(corners[t * 3 + 2]);
+        const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        if (std::fabs(area) < 1e-12f)
+            continue;
+        const int x0 = std::max(0, static_cast<int>(std::floor(std::min({a.x, b.x, c.x}))));
+        const int x1 = std::min(canvas - 1, static_cast<int>(std::ceil(std::max({a.x, b.x, c.x}))));
+        const int y0 = std::max(0, static_cast<int>(std::floor(std::min({a.y, b.y, c.y}))));
+        const int y1 = std::min(canvas - 1, static_cast<int>(std::ceil(std::max({a.y, b.y, c.y}))));
+        const float invArea = 1.0f / area;
+        for (int y = y0; y <= y1; ++y) {
+            const float py = y + 0.5f;
+            for (int x = x0; x <= x1; ++x) {
+                const float px = x + 0.5f;
+                // Barycentric weights; their signs match the triangle's
+                // orientation when the pixel centre is inside.
+                const float wa = ((b.x - px) * (c.y - py) - (b.y - py) * (c.x - px)) * invArea;
+                const float wb = ((c.x - px) * (a.y - py) - (c.y - py) * (a.x - px)) * invArea;
+                const float wc = 1.0f - wa - wb;
+                if (wa < 0.0f || wb < 0.0f || wc < 0.0f)
+                    continue;
+                const float z = wa * a.depth + wb * b.depth + wc * c.depth;
+                const size_t index = static_cast<size_t>(y) * canvas + x;
+                if (z <= depth[index])
+                    continue;
+                depth[index] = z;
+                shade[index] = shades[t];
+            }
+        }
+    }
+
+    // Box filter the supersampled canvas down to the thumbnail.
+    GdtfThumbnail thumbnail;
+    thumbnail.width = size;
+    thumbnail.height = size;
+    thumbnail.rgba.assign(static_cast<size_t>(size) * size * 4, 0);
+    constexpr float kSamples = kSupersample * kSupersample;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            float covered = 0.0f;
+            float light = 0.0f;
+            for (int sy = 0; sy < kSupersample; ++sy) {
+                for (int sx = 0; sx < kSupersample; ++sx) {
+                    const size_t index =
+                        static_cast<size_t>(y * kSupersample + sy) * canvas +
+                        x * kSupersample + sx;
+                    if (shade[index] < 0.0f)
+                        continue;
+                    covered += 1.0f;
+                    light += shade[index];
+                }
+            }
+            if (covered == 0.0f)
+                continue;
+            const uint8_t grey = static_cast<uint8_t>(
+                std::clamp(light / covered * 230.0f, 0.0f, 255.0f));
+            uint8_t* pixel = &thumbnail.rgba[(static_cast<size_t>(y) * size + x) * 4];
+            pixel[0] = pixel[1] = pixel[2] = grey;
+            pixel[3] = static_cast<uint8_t>(covered / kSamples * 255.0f + 0.5f);
+        }
+    }
+    return thumbnail;
+}
+
+GdtfThumbnailCache::GdtfThumbnailCache(fs::path directory)
+    : directory(std::move(directory))
+{
+}
+
+std::string GdtfThumbnailCache::KeyFor(const std::string& gdtfPath)
+{
+    std::error_code ec;
+    fs::path path = fs::absolute(fs::u8path(gdtfPath), ec);
+    if (ec)
+        return {};
+    const uintmax_t size = fs::file_size(path, ec);
+    if (ec)
+        return {};
+    const fs::file_time_type modified = fs::last_write_time(path, ec);
+    if (ec)
+        return {};
+
+    const std::string pathKey = path.string();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = keys.find(pathKey);
+        if (it != keys.end() && it->second.size == size &&
+            it->second.modified == modified)
+            return it->second.key;
+    }
+    // Hashed unlocked so thumbnails of different files are keyed in
+    // parallel.
+    std::string key = HashFile(path);
+    if (key.empty())
+        return {};
+    std::lock_guard<std::mutex> lock(mutex);
+    keys[pathKey] = {size, modified, key};
+    return key;
+}
+
+fs::path GdtfThumbnailCache::PathFor(const std::string& key) const
+{
+    return directory / (key + ".thumb");
+}
+
+bool GdtfThumbnailCache::Find(const std::string& key, GdtfThumbnail& out)
+{
+    if (key.empty())
+        return false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = images.find(key);
+        if (it != images.end()) {
+            out = it->second;
+            return true;
+        }
+    }
+    if (directory.empty())
+        return false;
+
+    std::ifstream in(PathFor(key), std::ios::binary);
+    if (!in.is_open())
+        return false;
+    char magic[4];
+    uint32_t version = 0, width = 0, height = 0;
+    if (!in.read(magic, 4) || std::memcmp(magic, kFileMagic, 4) != 0 ||
+        !ReadU32(in, version) || version != kFileVersion ||
+        !ReadU32(in, width) || !ReadU32(in, height) || width == 0 ||
+        height == 0 || width > kMaxThumbnailSize || height > kMaxThumbnailSize)
+        return false;
+    GdtfThumbnail thumbnail;
+    thumbnail.width = static_cast<int>(width);
+    thumbnail.height = static_cast<int>(height);
+    thumbnail.rgba.resize(static_cast<size_t>(width) * height * 4);
+    if (!in.read(reinterpret_cast<char*>(thumbnail.rgba.data()),
+                 static_cast<std::streamsize>(thumbnail.rgba.size())))
+        return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    out = images.emplace(key, std::move(thumbnail)).first->second;
+    return true;
+}
+
+void GdtfThumbnailCache::Store(const std::string& key,
+                               const GdtfThumbnail& thumbnail)
+{
+    if (key.empty() || !thumbnail.IsValid())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        images[key] = thumbnail;
+    }
+    if (directory.empty())
+        return;
+
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec)
+        return;
+    // Written under a temporary name per thread and renamed, so a reader
+    // never sees a partial file.
+    const fs::path target = PathFor(key);
+    fs::path temp = target;
+    temp += "." + std::to_string(std::hash<std::thread::id>{}(
+                      std::this_thread::get_id())) +
+            ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return;
+        out.write(kFileMagic, 4);
+        WriteU32(out, kFileVersion);
+        WriteU32(out, static_cast<uint32_t>(thumbnail.width));
+        WriteU32(out, static_cast<uint32_t>(thumbnail.height));
+        out.write(reinterpret_cast<const char*>(thumbnail.rgba.data()),
+                  static_cast<std::streamsize>(thumbnail.rgba.size()));
+        if (!out) {
+            out.close();
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+    fs::rename(temp, target, ec);
+    if (ec)
+        fs::remove(temp, ec);
+}
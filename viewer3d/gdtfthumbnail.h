@@ -0,0 +1,79 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "gdtfloader.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Small RGBA image of a fixture model: rows top to bottom, straight alpha.
+struct GdtfThumbnail {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> rgba;
+
+    bool IsValid() const
+    {
+        return width > 0 && height > 0 &&
+               rgba.size() == static_cast<size_t>(width) * height * 4;
+    }
+};
+
+// Renders the objects of a loaded GDTF from the angle of the fixture preview
+// into a square image of `size` pixels. A software rasteriser is used so
+// thumbnails can be made on worker threads without a GL context. Returns an
+// invalid thumbnail when there is no geometry.
+GdtfThumbnail RenderGdtfThumbnail(const std::vector<GdtfObject>& objects,
+                                  int size);
+
+// Thumbnails keyed by a hash of the GDTF file contents, kept in memory and as
+// small files in `directory`, so a fixture type is rendered once rather than
+// once per session and renamed or copied files share their image. All
+// members may be called from any thread.
+class GdtfThumbnailCache {
+public:
+    explicit GdtfThumbnailCache(std::filesystem::path directory);
+
+    // Hash of the file contents as hex, or empty when the file cannot be
+    // read. Files are hashed once per size and modification time.
+    std::string KeyFor(const std::string& gdtfPath);
+
+    bool Find(const std::string& key, GdtfThumbnail& out);
+    // Keeps the thumbnail in memory and writes it to disk; a failed write
+    // only loses persistence.
+    void Store(const std::string& key, const GdtfThumbnail& thumbnail);
+
+private:
+    struct FileStamp {
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+        std::string key;
+    };
+
+    std::filesystem::path PathFor(const std::string& key) const;
+
+    std::filesystem::path directory;
+    std::mutex mutex;
+    std::unordered_map<std::string, FileStamp> keys;         // by file path
+    std::unordered_map<std::string, GdtfThumbnail> images;   // by key
+};
@@ -0,0 +1,182 @@
+/*
+ * This file is part of Perastage.
+ * Copyright (C) 2025 Luisma Peramato
+ *
+ * Perastage is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Perastage is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Perastage. If not, see <https://www.gnu.org/licenses/>.
+ */
+/*
+ * File: headlessgl.cpp
+ * Author: Luisma Peramato
+ * License: GNU General Public License v3.0
+ * Description: No-op OpenGL, GLU, GLEW and NanoVG entry points for builds
+ * that never create a GL context.
+ *
+ * perastage-cli and the headless tests link the shared viewer sources, which
+ * reference GL for the on-screen path. Capture-only rendering never reaches
+ * those calls, so these definitions satisfy the linker without pulling the
+ * system GL stack into processes that have no display. The GUI does not
+ * compile this file.
+ */
+
+#include <GL/glew.h>
+#ifdef __APPLE__
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl.h>
+#include <OpenGL/glu.h>
+#else
+#include <GL/gl.h>
+#include <GL/glu.h>
+#endif
+
+#include <nanovg.h>
+#define NANOVG_GL2
+#include <nanovg_gl.h>
+
+extern "C" {
+
+// OpenGL 1.1
+void GLAPIENTRY glBegin(GLenum) {}
+void GLAPIENTRY glColor3f(GLfloat, GLfloat, GLfloat) {}
+void GLAPIENTRY glColor4f(GLfloat, GLfloat, GLfloat, GLfloat) {}
+void GLAPIENTRY glColorMaterial(GLenum, GLenum) {}
+void GLAPIENTRY glCullFace(GLenum) {}
+void GLAPIENTRY glDisable(GLenum) {}
+void GLAPIENTRY glDisableClientState(GLenum) {}
+void GLAPIENTRY glDrawElements(GLenum, GLsizei, GLenum, const GLvoid *) {}
+void GLAPIENTRY glEnable(GLenum) {}
+void GLAPIENTRY glEnableClientState(GLenum) {}
+void GLAPIENTRY glEnd() {}
+void GLAPIENTRY glFrontFace(GLenum) {}
+void GLAPIENTRY glGetDoublev(GLenum, GLdouble *) {}
+void GLAPIENTRY glGetIntegerv(GLenum, GLint *) {}
+GLboolean GLAPIENTRY glIsEnabled(GLenum) { return GL_FALSE; }
+void GLAPIENTRY glLightModeli(GLenum, GLint) {}
+void GLAPIENTRY glLightfv(GLenum, GLenum, const GLfloat *) {}
+void GLAPIENTRY glLineWidth(GLfloat) {}
+void GLAPIENTRY glLoadIdentity() {}
+void GLAPIENTRY glMultMatrixf(const GLfloat *) {}
+void GLAPIENTRY glNormal3f(GLfloat, GLfloat, GLfloat) {}
+void GLAPIENTRY glNormalPointer(GLenum, GLsizei, const GLvoid *) {}
+void GLAPIENTRY glPointSize(GLfloat) {}
+void GLAPIENTRY glPolygonOffset(GLfloat, GLfloat) {}
+void GLAPIENTRY glPopMatrix() {}
+void GLAPIENTRY glPushMatrix() {}
+void GLAPIENTRY glScalef(GLfloat, GLfloat, GLfloat) {}
+void GLAPIENTRY glShadeModel(GLenum) {}
+void GLAPIENTRY glTranslatef(GLfloat, GLfloat, GLfloat) {}
+void GLAPIENTRY glVertex2f(GLfloat, GLfloat) {}
+void GLAPIENTRY glVertex3f(GLfloat, GLfloat, GLfloat) {}
+void GLAPIENTRY glVertexPointer(GLint, GLenum, GLsizei, const GLvoid *) {}
+
+// GLU
+void GLAPIENTRY gluLookAt(GLdouble, GLdouble, GLdouble, GLdouble, GLdouble,
+                          GLdouble, GLdouble, GLdouble, GLdouble) {}
+GLint GLAPIENTRY gluProject(GLdouble, GLdouble, GLdouble, const GLdouble *,
+                            const GLdouble *, const GLint *, GLdouble *,
+                            GLdouble *, GLdouble *) {
+  return GL_FALSE;
+}
+
+} // extern "C"
+
+// GLEW resolves buffer and vertex array entry points through these pointers
+// after glewInit(); point them at no-ops instead.
+namespace {
+void GLAPIENTRY NoBindBuffer(GLenum, GLuint) {}
+void GLAPIENTRY NoBufferData(GLenum, GLsizeiptr, const void *, GLenum) {}
+void GLAPIENTRY NoDeleteBuffers(GLsizei, const GLuint *) {}
+void GLAPIENTRY NoGenBuffers(GLsizei n, GLuint *buffers) {
+  for (GLsizei i = 0; i < n; ++i)
+    buffers[i] = 0;
+}
+GLboolean GLAPIENTRY NoIsBuffer(GLuint) { return GL_FALSE; }
+void GLAPIENTRY NoBindVertexArray(GLuint) {}
+void GLAPIENTRY NoDeleteVertexArrays(GLsizei, const GLuint *) {}
+void GLAPIENTRY NoGenVertexArrays(GLsizei n, GLuint *arrays) {
+  for (GLsizei i = 0; i < n; ++i)
+    arrays[i] = 0;
+}
+GLboolean GLAPIENTRY NoIsVertexArray(GLuint) { return GL_FALSE; }
+} // namespace
+
+extern "C" {
+
+PFNGLBINDBUFFERPROC __glewBindBuffer = NoBindBuffer;
+PFNGLBUFFERDATAPROC __glewBufferData = NoBufferData;
+PFNGLDELETEBUFFERSPROC __glewDeleteBuffers = NoDeleteBuffers;
+PFNGLGENBUFFERSPROC __glewGenBuffers = NoGenBuffers;
+PFNGLISBUFFERPROC __glewIsBuffer = NoIsBuffer;
+PFNGLBINDVERTEXARRAYPROC __glewBindVertexArray = NoBindVertexArray;
+PFNGLDELETEVERTEXARRAYSPROC __glewDeleteVertexArrays = NoDeleteVertexArrays;
+PFNGLGENVERTEXARRAYSPROC __glewGenVertexArrays = NoGenVertexArrays;
+PFNGLISVERTEXARRAYPROC __glewIsVertexArray = NoIsVertexArray;
+
+// NanoVG: no context is ever created, so every drawing call is a no-op.
+NVGcontext *nvgCreateGL2(int) { return nullptr; }
+void nvgDeleteGL2(NVGcontext *) {}
+void nvgBeginFrame(NVGcontext *, float, float, float) {}
+void nvgEndFrame(NVGcontext *) {}
+void nvgSave(NVGcontext *) {}
+void nvgRestore(NVGcontext *) {}
+void nvgReset(NVGcontext *) {}
+NVGcolor nvgRGBAf(float r, float g, float b, float a) {
+  NVGcolor color;
+  color.r = r;
+  color.g = g;
+  color.b = b;
+  color.a = a;
+  return color;
+}
+void nvgStrokeColor(NVGcontext *, NVGcolor) {}
+void nvgFillColor(NVGcontext *, NVGcolor) {}
+void nvgStrokeWidth(NVGcontext *, float) {}
+void nvgBeginPath(NVGcontext *) {}
+void nvgRect(NVGcontext *, float, float, float, float) {}
+void nvgFill(NVGcontext *) {}
+void nvgStroke(NVGcontext *) {}
+int nvgCreateFont(NVGcontext *, const char *, const char *) { return -1; }
+void nvgFontSize(NVGcontext *, float) {}
+void nvgFontFaceId(NVGcontext *, int) {}
+void nvgTextAlign(NVGcontext *, int) {}
+float nvgText(NVGcontext *, float x, float, const char *, const char *) {
+  return x;
+}
+void nvgTextBox(NVGcontext *, float, float, float, const char *,
+                const char *) {}
+float nvgTextBounds(NVGcontext *, float x, float y, const char *,
+                    const char *, float *bounds) {
+  if (bounds) {
+    bounds[0] = bounds[2] = x;
+    bounds[1] = bounds[3] = y;
+  }
+  return 0.0f;
+}
+void nvgTextBoxBounds(NVGcontext *, float x, float y, float, const char *,
+                      const char *, float *bounds) {
+  if (bounds) {
+    bounds[0] = bounds[2] = x;
+    bounds[1] = bounds[3] = y;
+  }
+}
+void nvgTextMetrics(NVGcontext *, float *ascender, float *descender,
+                    float *lineh) {
+  if (ascender)
+    *ascender = 0.0f;
+  if (descender)
+    *descender = 0.0f;
+  if (lineh)
+    *lineh = 0.0f;
+}
+
+} // extern "C"
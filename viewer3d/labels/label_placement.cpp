@@ -0,0 +1,187 @@
+#include "label_placement.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+
+constexpr float kMinCellSize = 16.0f;
+constexpr float kMaxCellSize = 512.0f;
+// Upper bound on grid cells so a tiny cell size on a huge viewport cannot
+// allocate without limit; boxes outside the grid fall into its edge cells.
+constexpr long long kMaxCells = 1 << 20;
+
+} // namespace
+
+void LabelPlacementEngine::ResetGrid(const std::vector<Request> &requests,
+                                     const Options &options) {
+  // Cells about the size of a typical label keep each box in a handful of
+  // cells and each cell short.
+  double extentSum = 0.0;
+  float maxExtent = 0.0f;
+  for (const auto &r : requests) {
+    const float extent = std::max(r.width, r.height);
+    extentSum += extent;
+    maxExtent = std::max(maxExtent, extent);
+  }
+  const float average =
+      requests.empty() ? kMinCellSize
+                       : static_cast<float>(extentSum / requests.size());
+  cellSize = std::clamp(average, kMinCellSize, kMaxCellSize);
+
+  // Labels near the border may stick out of the viewport by up to one box.
+  const float margin = maxExtent + options.gap;
+  originX = -margin;
+  originY = -margin;
+  const float spanX = std::max(0, options.viewportWidth) + 2.0f * margin;
+  const float spanY = std::max(0, options.viewportHeight) + 2.0f * margin;
+  columns = std::max(1, static_cast<int>(std::ceil(spanX / cellSize)));
+  rows = std::max(1, static_cast<int>(std::ceil(spanY / cellSize)));
+  while (static_cast<long long>(columns) * rows > kMaxCells) {
+    cellSize *= 2.0f;
+    columns = std::max(1, static_cast<int>(std::ceil(spanX / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(spanY / cellSize)));
+  }
+
+  inverseCellSize = 1.0f / cellSize;
+  cellHeads.assign(static_cast<size_t>(columns) * rows, -1);
+  entries.clear();
+
+  coveredCellSize = cellSize * 0.25f;
+  coveredColumns = columns * 4;
+  coveredRows = rows * 4;
+  covered.assign(static_cast<size_t>(coveredColumns) * coveredRows, 0);
+}
+
+void LabelPlacementEngine::CellRange(const Box &box, int &x0, int &y0, int &x1,
+                                     int &y1) const {
+  // Truncation instead of std::floor: coordinates left of the origin clamp
+  // to cell 0 either way, and floor is a library call on baseline x86-64.
+  auto cell = [this](float v, float origin, int count) {
+    const float f = (v - origin) * inverseCellSize;
+    if (!(f > 0.0f))
+      return 0;
+    return f >= static_cast<float>(count - 1) ? count - 1 : static_cast<int>(f);
+  };
+  x0 = cell(box.minX, originX, columns);
+  x1 = cell(box.maxX, originX, columns);
+  y0 = cell(box.minY, originY, rows);
+  y1 = cell(box.maxY, originY, rows);
+}
+
+bool LabelPlacementEngine::CentreCovered(float x, float y) const {
+  const float fx = (x - originX) / coveredCellSize;
+  const float fy = (y - originY) / coveredCellSize;
+  if (fx < 0.0f || fy < 0.0f || fx >= coveredColumns || fy >= coveredRows)
+    return false;
+  return covered[static_cast<size_t>(fy) * coveredColumns +
+                 static_cast<size_t>(fx)] != 0;
+}
+
+bool LabelPlacementEngine::Overlaps(const Box &box) const {
+  int x0, y0, x1, y1;
+  CellRange(box, x0, y0, x1, y1);
+  for (int cy = y0; cy <= y1; ++cy) {
+    for (int cx = x0; cx <= x1; ++cx) {
+      for (int32_t e = cellHeads[static_cast<size_t>(cy) * columns + cx];
+           e >= 0; e = entries[e].next) {
+        const Box &other = entries[e].box;
+        if (box.minX < other.maxX && other.minX < box.maxX &&
+            box.minY < other.maxY && other.minY < box.maxY)
+          return true;
+      }
+    }
+  }
+  return false;
+}
+
+void LabelPlacementEngine::Insert(const Box &box) {
+  int x0, y0, x1, y1;
+  CellRange(box, x0, y0, x1, y1);
+  for (int cy = y0; cy <= y1; ++cy) {
+    for (int cx = x0; cx <= x1; ++cx) {
+      int32_t &head = cellHeads[static_cast<size_t>(cy) * columns + cx];
+      entries.push_back({box, head});
+      head = static_cast<int32_t>(entries.size() - 1);
+    }
+  }
+
+  // Mark the fine cells the box covers completely.
+  const int fx0 = std::max(
+      0, static_cast<int>(std::ceil((box.minX - originX) / coveredCellSize)));
+  const int fy0 = std::max(
+      0, static_cast<int>(std::ceil((box.minY - originY) / coveredCellSize)));
+  const int fx1 = std::min(
+      coveredColumns,
+      static_cast<int>(std::floor((box.maxX - originX) / coveredCellSize)));
+  const int fy1 = std::min(
+      coveredRows,
+      static_cast<int>(std::floor((box.maxY - originY) / coveredCellSize)));
+  for (int fy = fy0; fy < fy1; ++fy)
+    std::fill_n(covered.begin() + static_cast<size_t>(fy) * coveredColumns + fx0,
+                std::max(0, fx1 - fx0), uint8_t{1});
+}
+
+void LabelPlacementEngine::Place(const std::vector<Request> &requests,
+                                 const Options &options,
+                                 std::vector<Placement> &out) {
+  out.assign(requests.size(), Placement{});
+  ResetGrid(requests, options);
+
+  order.resize(requests.size());
+  for (uint32_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  // Ties keep the request order so the layout is deterministic.
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    if (requests[a].priority != requests[b].priority)
+      return requests[a].priority > requests[b].priority;
+    return a < b;
+  });
+
+  const float viewW = static_cast<float>(std::max(0, options.viewportWidth));
+  const float viewH = static_cast<float>(std::max(0, options.viewportHeight));
+  const float halfGap = options.gap * 0.5f;
+  size_t placedCount = 0;
+
+  for (uint32_t i : order) {
+    if (options.maxPlaced > 0 && placedCount >= options.maxPlaced)
+      break;
+    const Request &r = requests[i];
+    const float halfW = std::max(0.0f, r.width) * 0.5f;
+    const float halfH = std::max(0.0f, r.height) * 0.5f;
+
+    // Centred on the anchor first, then moved one box over: above, below,
+    // to either side and to the corners.
+    const float stepX = 2.0f * halfW + options.gap;
+    const float stepY = 2.0f * halfH + options.gap;
+    const std::array<std::array<float, 2>, 9> offsets = {{{0.0f, 0.0f},
+                                                          {0.0f, -stepY},
+                                                          {0.0f, stepY},
+                                                          {stepX, 0.0f},
+                                                          {-stepX, 0.0f},
+                                                          {stepX, -stepY},
+                                                          {-stepX, -stepY},
+                                                          {stepX, stepY},
+                                                          {-stepX, stepY}}};
+
+    for (const auto &offset : offsets) {
+      const float cx = r.anchorX + offset[0];
+      const float cy = r.anchorY + offset[1];
+      // The gap is split between the two boxes that meet.
+      Box box{cx - halfW - halfGap, cy - halfH - halfGap, cx + halfW + halfGap,
+              cy + halfH + halfGap};
+      if (box.maxX < 0.0f || box.minX > viewW || box.maxY < 0.0f ||
+          box.minY > viewH)
+        continue;
+      if (box.maxX > box.minX && box.maxY > box.minY && CentreCovered(cx, cy))
+        continue;
+      if (Overlaps(box))
+        continue;
+      Insert(box);
+      out[i] = {true, offset[0], offset[1]};
+      ++placedCount;
+      break;
+    }
+  }
+}
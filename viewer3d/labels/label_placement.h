@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Greedy screen-space label placement. Labels are placed in priority order;
+// each one tries a few positions around its anchor and takes the first that
+// does not overlap a label placed before it. Placed boxes are bucketed in a
+// uniform grid so each overlap test only looks at nearby labels.
+class LabelPlacementEngine {
+public:
+  struct Request {
+    float anchorX = 0.0f; // screen pixels, y down
+    float anchorY = 0.0f;
+    float width = 0.0f;   // box around the label text
+    float height = 0.0f;
+    float priority = 0.0f; // higher is placed first
+  };
+
+  struct Placement {
+    bool placed = false;
+    // Offset of the box centre from the anchor.
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+  };
+
+  struct Options {
+    int viewportWidth = 0;
+    int viewportHeight = 0;
+    float gap = 2.0f;      // minimum distance between two boxes
+    size_t maxPlaced = 0;  // 0 places as many as fit
+  };
+
+  // Fills `out` with one placement per request. The result only depends on
+  // the inputs, so calling it twice with the same requests gives the same
+  // layout.
+  void Place(const std::vector<Request> &requests, const Options &options,
+             std::vector<Placement> &out);
+
+private:
+  struct Box {
+    float minX, minY, maxX, maxY;
+  };
+
+  // A placed box listed in one grid cell. The box is stored inline so an
+  // overlap test walks a single array.
+  struct CellEntry {
+    Box box;
+    int32_t next;
+  };
+
+  void ResetGrid(const std::vector<Request> &requests, const Options &options);
+  void CellRange(const Box &box, int &x0, int &y0, int &x1, int &y1) const;
+  bool CentreCovered(float x, float y) const;
+  bool Overlaps(const Box &box) const;
+  void Insert(const Box &box);
+
+  // Reused between calls to avoid per-frame allocations.
+  std::vector<uint32_t> order;
+  std::vector<int32_t> cellHeads;
+  std::vector<CellEntry> entries;
+  // Finer grid marking cells that lie completely inside a placed box. A
+  // candidate whose centre falls in a marked cell is rejected without
+  // walking any cell list, which is the common case in crowded areas.
+  std::vector<uint8_t> covered;
+  int coveredColumns = 0;
+  int coveredRows = 0;
+  float coveredCellSize = 1.0f;
+  float cellSize = 1.0f;
+  float inverseCellSize = 1.0f;
+  float originX = 0.0f;
+  float originY = 0.0f;
+  int columns = 0;
+  int rows = 0;
+};
@@ -29,7 +29,7 @@
 #include <iomanip>
 #include <nanovg.h>
 #include <sstream>
-#include <wx/tokenzr.h>
+#include <wx/string.h>
 
 namespace {
 
@@ -37,12 +37,10 @@ static constexpr float LABEL_FONT_SIZE_3D = 18.0f;
 static constexpr float LABEL_MAX_WIDTH = 300.0f;
 static constexpr float PIXELS_PER_METER = 25.0f;
 
-struct LabelLine2D {
-  int font;
-  std::string text;
-  float size;
-  std::string fontFamily;
-};
+using LabelLine2D = LabelRenderSystem::LabelLine;
+using FixtureLabelLayout = LabelRenderSystem::FixtureLabelLayout;
+
+constexpr float LABEL_LINE_SPACING_2D = 2.0f;
 
 struct CullingSettings {
   bool enabled = true;
@@ -95,16 +93,76 @@ bool IsLayerVisibleCached(const std::unordered_set<std::string> &hidden,
   return hidden.find(layer) == hidden.end();
 }
 
-CullingSettings GetCullingSettings(const ConfigManager &cfg) {
+} // namespace
+
+// Preferences read on every label pass, resolved to handles once per
+// LabelRenderSystem so the draw calls do not look them up by name.
+struct LabelPreferenceHandles {
+  using Handle = ConfigManager::FloatHandle;
+  using PerView = std::array<Handle, 4>;
+
+  explicit LabelPreferenceHandles(const ConfigManager &cfg) {
+    auto perView = [&](const std::string &prefix) {
+      // Index 3 (bottom) shares the top view settings.
+      return PerView{cfg.ResolveFloat(prefix + "_top"),
+                     cfg.ResolveFloat(prefix + "_front"),
+                     cfg.ResolveFloat(prefix + "_side"),
+                     cfg.ResolveFloat(prefix + "_top")};
+    };
+    cullingEnabled = cfg.ResolveFloat("render_culling_enabled");
+    cullingMinPixels3D = cfg.ResolveFloat("render_culling_min_pixels_3d");
+    cullingMinPixels2D = cfg.ResolveFloat("render_culling_min_pixels_2d");
+    optimizationsEnabled = cfg.ResolveFloat("label_optimizations_enabled");
+    showName = cfg.ResolveFloat("label_show_name");
+    showId = cfg.ResolveFloat("label_show_id");
+    showDmx = cfg.ResolveFloat("label_show_dmx");
+    showName2D = perView("label_show_name");
+    showId2D = perView("label_show_id");
+    showDmx2D = perView("label_show_dmx");
+    offsetDistance2D = perView("label_offset_distance");
+    offsetAngle2D = perView("label_offset_angle");
+    fontSizeName = cfg.ResolveFloat("label_font_size_name");
+    fontSizeId = cfg.ResolveFloat("label_font_size_id");
+    fontSizeDmx = cfg.ResolveFloat("label_font_size_dmx");
+    maxFixtures = cfg.ResolveFloat("label_max_fixtures");
+    maxTrusses = cfg.ResolveFloat("label_max_trusses");
+    maxObjects = cfg.ResolveFloat("label_max_objects");
+  }
+
+  Handle cullingEnabled;
+  Handle cullingMinPixels3D;
+  Handle cullingMinPixels2D;
+  Handle optimizationsEnabled;
+  Handle showName;
+  Handle showId;
+  Handle showDmx;
+  PerView showName2D;
+  PerView showId2D;
+  PerView showDmx2D;
+  PerView offsetDistance2D;
+  PerView offsetAngle2D;
+  Handle fontSizeName;
+  Handle fontSizeId;
+  Handle fontSizeDmx;
+  Handle maxFixtures;
+  Handle maxTrusses;
+  Handle maxObjects;
+};
+
+namespace {
+
+CullingSettings GetCullingSettings(const ConfigManager &cfg,
+                                   const LabelPreferenceHandles &prefs) {
   CullingSettings s{};
-  s.enabled = cfg.GetFloat("render_culling_enabled") >= 0.5f;
-  s.minPixels3D = std::max(0.0f, cfg.GetFloat("render_culling_min_pixels_3d"));
-  s.minPixels2D = std::max(0.0f, cfg.GetFloat("render_culling_min_pixels_2d"));
+  s.enabled = cfg.GetFloat(prefs.cullingEnabled) >= 0.5f;
+  s.minPixels3D = std::max(0.0f, cfg.GetFloat(prefs.cullingMinPixels3D));
+  s.minPixels2D = std::max(0.0f, cfg.GetFloat(prefs.cullingMinPixels2D));
   return s;
 }
 
-int GetLabelLimit(const ConfigManager &cfg, const char *key) {
-  return std::max(0, static_cast<int>(std::lround(cfg.GetFloat(key))));
+int GetLabelLimit(const ConfigManager &cfg,
+                  ConfigManager::FloatHandle handle) {
+  return std::max(0, static_cast<int>(std::lround(cfg.GetFloat(handle))));
 }
 
 bool ProjectBoundingBoxToScreen(const std::array<float, 3> &bbMin,
@@ -209,21 +267,96 @@ std::string FormatMeters(float mm) {
   return s;
 }
 
-wxString WrapEveryTwoWords(const wxString &text) {
-  wxStringTokenizer tk(text, " ");
-  wxString result;
+// Splits a name into lines of two words each, skipping empty words and
+// lines like wxStringTokenizer's default mode.
+std::vector<std::string> WrapEveryTwoWords(const std::string &text) {
+  std::string wrapped;
   int count = 0;
-  while (tk.HasMoreTokens()) {
-    if (count > 0) {
-      if (count % 2 == 0)
-        result += "\n";
-      else
-        result += " ";
+  size_t start = 0;
+  while (start <= text.size()) {
+    size_t end = text.find(' ', start);
+    if (end == std::string::npos)
+      end = text.size();
+    if (end > start) {
+      if (count > 0)
+        wrapped += count % 2 == 0 ? '\n' : ' ';
+      wrapped.append(text, start, end - start);
+      ++count;
+    }
+    start = end + 1;
+  }
+
+  std::vector<std::string> lines;
+  start = 0;
+  while (start < wrapped.size()) {
+    size_t end = wrapped.find('\n', start);
+    if (end == std::string::npos)
+      end = wrapped.size();
+    if (end > start)
+      lines.emplace_back(wrapped, start, end - start);
+    start = end + 1;
+  }
+  return lines;
+}
+
+// Measures every line of a label once; the results stay valid while the
+// text, font and size do.
+void MeasureLabelLines2D(NVGcontext *vg, FixtureLabelLayout &layout) {
+  layout.width = 0.0f;
+  layout.totalHeight = 0.0f;
+  if (!vg)
+    return;
+  nvgSave(vg);
+  nvgReset(vg);
+  for (size_t i = 0; i < layout.lines.size(); ++i) {
+    LabelLine2D &line = layout.lines[i];
+    nvgFontSize(vg, line.size);
+    nvgFontFaceId(vg, line.font);
+    nvgTextAlign(vg, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
+    float bounds[4];
+    nvgTextBounds(vg, 0.f, 0.f, line.text.c_str(), nullptr, bounds);
+    line.width = bounds[2] - bounds[0];
+    line.height = bounds[3] - bounds[1];
+    float lineh = 0.0f;
+    nvgTextMetrics(vg, &line.ascender, &line.descender, &lineh);
+    layout.width = std::max(layout.width, line.width);
+    layout.totalHeight += line.height;
+    if (i + 1 < layout.lines.size())
+      layout.totalHeight += LABEL_LINE_SPACING_2D;
+  }
+  nvgRestore(vg);
+}
+
+void BuildFixtureLabelLines(FixtureLabelLayout &layout) {
+  constexpr const char *kRegularFamily = "sans";
+  constexpr const char *kBoldFamily = "sans-bold";
+  layout.lines.clear();
+  if (layout.showName) {
+    for (auto &text : WrapEveryTwoWords(layout.name)) {
+      LabelLine2D line;
+      line.font = layout.font;
+      line.text = std::move(text);
+      line.size = layout.nameSize;
+      line.fontFamily = kRegularFamily;
+      layout.lines.push_back(std::move(line));
     }
-    result += tk.GetNextToken();
-    ++count;
   }
-  return result;
+  if (layout.showId) {
+    LabelLine2D line;
+    line.font = layout.font;
+    line.text = "ID: " + std::to_string(layout.fixtureId);
+    line.size = layout.idSize;
+    line.fontFamily = kRegularFamily;
+    layout.lines.push_back(std::move(line));
+  }
+  if (layout.showDmx && !layout.address.empty()) {
+    LabelLine2D line;
+    line.font = layout.boldFont >= 0 ? layout.boldFont : layout.font;
+    line.text = layout.address;
+    line.size = layout.dmxSize;
+    line.fontFamily = kBoldFamily;
+    layout.lines.push_back(std::move(line));
+  }
 }
 
 void DrawText2D(NVGcontext *vg, int font, const std::string &text, int x, int y,
@@ -299,11 +432,12 @@ void DrawText2D(NVGcontext *vg, int font, const std::string &text, int x, int y,
   nvgEndFrame(vg);
 }
 
-void DrawLabelLines2D(NVGcontext *vg, const std::vector<LabelLine2D> &lines,
+void DrawLabelLines2D(NVGcontext *vg, const FixtureLabelLayout &layout,
                       int x, int y,
                       NVGcolor textColor = nvgRGBAf(1.f, 1.f, 1.f, 1.f),
                       NVGcolor outlineColor = nvgRGBAf(0.f, 0.f, 0.f, 1.f),
                       bool outline = false) {
+  const auto &lines = layout.lines;
   if (!vg || lines.empty())
     return;
 
@@ -312,25 +446,7 @@ void DrawLabelLines2D(NVGcontext *vg, const std::vector<LabelLine2D> &lines,
   nvgBeginFrame(vg, vp[2], vp[3], 1.0f);
   nvgSave(vg);
 
-  const float lineSpacing = 2.0f;
-  std::vector<float> heights(lines.size());
-  for (size_t i = 0; i < lines.size(); ++i) {
-    nvgFontSize(vg, lines[i].size);
-    nvgFontFaceId(vg, lines[i].font);
-    nvgTextAlign(vg, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
-    float bounds[4];
-    nvgTextBounds(vg, 0.f, 0.f, lines[i].text.c_str(), nullptr, bounds);
-    heights[i] = bounds[3] - bounds[1];
-  }
-
-  float totalHeight = 0.0f;
-  for (size_t i = 0; i < heights.size(); ++i) {
-    totalHeight += heights[i];
-    if (i + 1 < heights.size())
-      totalHeight += lineSpacing;
-  }
-
-  float currentY = y - totalHeight * 0.5f;
+  float currentY = y - layout.totalHeight * 0.5f;
   for (size_t i = 0; i < lines.size(); ++i) {
     nvgFontSize(vg, lines[i].size);
     nvgFontFaceId(vg, lines[i].font);
@@ -349,7 +465,7 @@ void DrawLabelLines2D(NVGcontext *vg, const std::vector<LabelLine2D> &lines,
     }
     nvgFillColor(vg, textColor);
     nvgText(vg, static_cast<float>(x), currentY, lines[i].text.c_str(), nullptr);
-    currentY += heights[i] + lineSpacing;
+    currentY += lines[i].height + LABEL_LINE_SPACING_2D;
   }
 
   nvgRestore(vg);
@@ -363,19 +479,27 @@ bool ShouldTraceLabelOrder() {
 
 } // namespace
 
+LabelRenderSystem::LabelRenderSystem(ISelectionContext &controller)
+    : m_controller(controller),
+      m_prefs(
+          std::make_unique<LabelPreferenceHandles>(ConfigManager::Get())) {}
+
+LabelRenderSystem::~LabelRenderSystem() = default;
+
 void LabelRenderSystem::DrawFixtureLabels(int width, int height) {
   ConfigManager &cfg = ConfigManager::Get();
   ProjectionContext projection;
   FillProjectionContext(width, height, projection);
 
   const auto hiddenLayers = SnapshotHiddenLayers(cfg);
-  const CullingSettings culling = GetCullingSettings(cfg);
+  const CullingSettings culling = GetCullingSettings(cfg, *m_prefs);
   const float minLabelPixels = culling.minPixels3D;
+  const auto &prefs = *m_prefs;
   const bool useLabelOptimizations =
-      cfg.GetFloat("label_optimizations_enabled") >= 0.5f;
-  const bool showName = cfg.GetFloat("label_show_name") != 0.0f;
-  const bool showId = cfg.GetFloat("label_show_id") != 0.0f;
-  const bool showDmx = cfg.GetFloat("label_show_dmx") != 0.0f;
+      cfg.GetFloat(prefs.optimizationsEnabled) >= 0.5f;
+  const bool showName = cfg.GetFloat(prefs.showName) != 0.0f;
+  const bool showId = cfg.GetFloat(prefs.showId) != 0.0f;
+  const bool showDmx = cfg.GetFloat(prefs.showDmx) != 0.0f;
 
   const auto &fixtures = SceneDataManager::Instance().GetFixtures();
   const auto &visibleSet = m_controller.GetVisibleSet(
@@ -438,31 +562,17 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
   FillProjectionContext(width, height, projection);
 
   const auto hiddenLayers = SnapshotHiddenLayers(cfg);
-  const std::array<const char *, 4> nameKeys = {
-      "label_show_name_top", "label_show_name_front", "label_show_name_side",
-      "label_show_name_top"};
-  const std::array<const char *, 4> idKeys = {
-      "label_show_id_top", "label_show_id_front", "label_show_id_side",
-      "label_show_id_top"};
-  const std::array<const char *, 4> dmxKeys = {
-      "label_show_dmx_top", "label_show_dmx_front", "label_show_dmx_side",
-      "label_show_dmx_top"};
-  const std::array<const char *, 4> distKeys = {
-      "label_offset_distance_top", "label_offset_distance_front",
-      "label_offset_distance_side", "label_offset_distance_top"};
-  const std::array<const char *, 4> angleKeys = {
-      "label_offset_angle_top", "label_offset_angle_front",
-      "label_offset_angle_side", "label_offset_angle_top"};
+  const auto &prefs = *m_prefs;
 
   int viewIdx = static_cast<int>(view);
-  const bool showName = cfg.GetFloat(nameKeys[viewIdx]) != 0.0f;
-  const bool showId = cfg.GetFloat(idKeys[viewIdx]) != 0.0f;
-  const bool showDmx = cfg.GetFloat(dmxKeys[viewIdx]) != 0.0f;
-  const float nameSize = cfg.GetFloat("label_font_size_name") * zoom;
-  const float idSize = cfg.GetFloat("label_font_size_id") * zoom;
-  const float dmxSize = cfg.GetFloat("label_font_size_dmx") * zoom;
-  const float labelDist = cfg.GetFloat(distKeys[viewIdx]);
-  const float labelAngle = cfg.GetFloat(angleKeys[viewIdx]);
+  const bool showName = cfg.GetFloat(prefs.showName2D[viewIdx]) != 0.0f;
+  const bool showId = cfg.GetFloat(prefs.showId2D[viewIdx]) != 0.0f;
+  const bool showDmx = cfg.GetFloat(prefs.showDmx2D[viewIdx]) != 0.0f;
+  const float nameSize = cfg.GetFloat(prefs.fontSizeName) * zoom;
+  const float idSize = cfg.GetFloat(prefs.fontSizeId) * zoom;
+  const float dmxSize = cfg.GetFloat(prefs.fontSizeDmx) * zoom;
+  const float labelDist = cfg.GetFloat(prefs.offsetDistance2D[viewIdx]);
+  const float labelAngle = cfg.GetFloat(prefs.offsetAngle2D[viewIdx]);
 
   constexpr float deg2rad = 3.14159265358979323846f / 180.0f;
   const float angRad = labelAngle * deg2rad;
@@ -485,11 +595,11 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
     break;
   }
 
-  const CullingSettings culling = GetCullingSettings(cfg);
+  const CullingSettings culling = GetCullingSettings(cfg, *m_prefs);
   const float minLabelPixels = culling.minPixels2D;
   const bool useLabelOptimizations =
-      cfg.GetFloat("label_optimizations_enabled") >= 0.5f;
-  const int maxFixtureLabels = GetLabelLimit(cfg, "label_max_fixtures");
+      cfg.GetFloat(prefs.optimizationsEnabled) >= 0.5f;
+  const int maxFixtureLabels = GetLabelLimit(cfg, prefs.maxFixtures);
 
   struct FixtureLabelCandidate {
     const std::string *uuid = nullptr;
@@ -497,6 +607,7 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
     double area = 0.0;
   };
   std::vector<FixtureLabelCandidate> candidates;
+  ++m_labelPass;
 
   const auto &fixtures = SceneDataManager::Instance().GetFixtures();
   candidates.reserve(fixtures.size());
@@ -523,14 +634,20 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
     }
   }
 
-  if (useLabelOptimizations && maxFixtureLabels > 0 &&
-      static_cast<int>(candidates.size()) > maxFixtureLabels) {
-    std::partial_sort(candidates.begin(), candidates.begin() + maxFixtureLabels,
-                      candidates.end(), [](const auto &a, const auto &b) {
-                        return a.area > b.area;
-                      });
-    candidates.resize(maxFixtureLabels);
-  }
+  // Project the anchors and lay out the text of every candidate first so
+  // the placement below can see all label boxes.
+  struct PendingLabel {
+    const std::string *uuid = nullptr;
+    const FixtureLabelLayout *layout = nullptr;
+    double wx = 0.0;
+    double wy = 0.0;
+    double wz = 0.0;
+    int x = 0;
+    int y = 0;
+    double area = 0.0;
+  };
+  std::vector<PendingLabel> pending;
+  pending.reserve(candidates.size());
 
   for (const auto &candidate : candidates) {
     const std::string &uuid = *candidate.uuid;
@@ -550,78 +667,94 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
     if (!ProjectLabelAnchor(projection, wx, wy, wz, x, y))
       continue;
 
-    constexpr const char *kRegularFamily = "sans";
-    constexpr const char *kBoldFamily = "sans-bold";
-    std::vector<LabelLine2D> lines;
-    if (showName) {
-      wxString baseName = f.instanceName.empty() ? wxString::FromUTF8(uuid)
-                                                 : wxString::FromUTF8(f.instanceName);
-      wxString wrapped = WrapEveryTwoWords(baseName);
-      wxStringTokenizer nameLines(wrapped, "\n");
-      while (nameLines.HasMoreTokens()) {
-        wxString line = nameLines.GetNextToken();
-        auto utf8 = line.ToUTF8();
-        lines.push_back({m_controller.GetLabelFont(),
-                         std::string(utf8.data(), utf8.length()), nameSize,
-                         kRegularFamily});
-      }
+    const std::string &name = f.instanceName.empty() ? uuid : f.instanceName;
+    const int font = m_controller.GetLabelFont();
+    const int boldFont = m_controller.GetLabelBoldFont();
+    auto [layoutIt, inserted] = m_fixtureLabelLayouts.try_emplace(uuid);
+    FixtureLabelLayout &layout = layoutIt->second;
+    if (inserted || layout.name != name || layout.fixtureId != f.fixtureId ||
+        layout.address != f.address || layout.showName != showName ||
+        layout.showId != showId || layout.showDmx != showDmx ||
+        layout.nameSize != nameSize || layout.idSize != idSize ||
+        layout.dmxSize != dmxSize || layout.font != font ||
+        layout.boldFont != boldFont) {
+      layout.name = name;
+      layout.fixtureId = f.fixtureId;
+      layout.address = f.address;
+      layout.showName = showName;
+      layout.showId = showId;
+      layout.showDmx = showDmx;
+      layout.nameSize = nameSize;
+      layout.idSize = idSize;
+      layout.dmxSize = dmxSize;
+      layout.font = font;
+      layout.boldFont = boldFont;
+      BuildFixtureLabelLines(layout);
+      MeasureLabelLines2D(m_controller.GetNanoVGContext(), layout);
     }
-    if (showId) {
-      wxString idLine = "ID: " + wxString::Format("%d", f.fixtureId);
-      auto utf8 = idLine.ToUTF8();
-      lines.push_back({m_controller.GetLabelFont(), std::string(utf8.data(), utf8.length()),
-                       idSize, kRegularFamily});
+    layout.lastUsedPass = m_labelPass;
+    if (layout.lines.empty())
+      continue;
+    pending.push_back({&uuid, &layout, wx, wy, wz, x, y, candidate.area});
+  }
+
+  // With optimizations on, labels are placed greedily so they do not
+  // overlap: selected and highlighted fixtures first, then the ones that
+  // cover more of the screen. label_max_fixtures caps the placed labels.
+  const bool placeLabels = useLabelOptimizations && !pending.empty();
+  if (placeLabels) {
+    std::unordered_set<std::string> selected;
+    for (const auto &uuid : cfg.GetSelectedFixtures())
+      selected.insert(uuid);
+    const std::string &highlight = m_controller.GetHighlightUuid();
+
+    m_placementRequests.clear();
+    m_placementRequests.reserve(pending.size());
+    for (const auto &label : pending) {
+      LabelPlacementEngine::Request request;
+      request.anchorX = static_cast<float>(label.x);
+      request.anchorY = static_cast<float>(label.y);
+      // The outline adds a pixel on every side.
+      request.width = label.layout->width + 2.0f;
+      request.height = label.layout->totalHeight + 2.0f;
+      request.priority = static_cast<float>(label.area);
+      // Larger than any on-screen area, so selected labels always win.
+      if (selected.count(*label.uuid) || *label.uuid == highlight)
+        request.priority += 1e9f;
+      m_placementRequests.push_back(request);
     }
-    if (showDmx && !f.address.empty()) {
-      int dmxFont = m_controller.GetLabelBoldFont() >= 0 ? m_controller.GetLabelBoldFont()
-                                                 : m_controller.GetLabelFont();
-      wxString addrLine = wxString::FromUTF8(f.address);
-      auto utf8 = addrLine.ToUTF8();
-      lines.push_back(
-          {dmxFont, std::string(utf8.data(), utf8.length()), dmxSize, kBoldFamily});
+
+    LabelPlacementEngine::Options options;
+    options.viewportWidth = width;
+    options.viewportHeight = height;
+    options.maxPlaced = static_cast<size_t>(maxFixtureLabels);
+    m_labelPlacement.Place(m_placementRequests, options, m_placements);
+  }
+
+  for (size_t labelIndex = 0; labelIndex < pending.size(); ++labelIndex) {
+    const PendingLabel &label = pending[labelIndex];
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    if (placeLabels) {
+      const auto &placement = m_placements[labelIndex];
+      if (!placement.placed)
+        continue;
+      offsetX = placement.offsetX;
+      offsetY = placement.offsetY;
     }
-    if (lines.empty())
-      continue;
+    const std::string &uuid = *label.uuid;
+    const FixtureLabelLayout &layout = *label.layout;
+    const auto &lines = layout.lines;
+    const int x = label.x + static_cast<int>(std::lround(offsetX));
+    const int y = label.y + static_cast<int>(std::lround(offsetY));
 
     if (m_controller.GetCaptureCanvas()) {
       std::string labelSourceKey = "label:" + uuid;
       m_controller.GetCaptureCanvas()->SetSourceKey(labelSourceKey);
 
       const float pxToWorld = 1.0f / (PIXELS_PER_METER * zoom);
-      const float lineSpacingWorld = 2.0f * pxToWorld;
-
-      std::vector<float> worldFontSizes;
-      std::vector<float> lineHeightsWorld;
-      std::vector<float> ascentsWorld;
-      std::vector<float> descentsWorld;
-      worldFontSizes.reserve(lines.size());
-      lineHeightsWorld.reserve(lines.size());
-      ascentsWorld.reserve(lines.size());
-      descentsWorld.reserve(lines.size());
-
-      for (const auto &ln : lines) {
-        worldFontSizes.push_back(ln.size * pxToWorld);
-        nvgFontSize(m_controller.GetNanoVGContext(), ln.size);
-        nvgFontFaceId(m_controller.GetNanoVGContext(), ln.font);
-        nvgTextAlign(m_controller.GetNanoVGContext(), NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
-        float bounds2D[4];
-        nvgTextBounds(m_controller.GetNanoVGContext(), 0.f, 0.f, ln.text.c_str(), nullptr,
-                      bounds2D);
-        lineHeightsWorld.push_back((bounds2D[3] - bounds2D[1]) * pxToWorld);
-        float ascender = 0.0f;
-        float descender = 0.0f;
-        float lineh = 0.0f;
-        nvgTextMetrics(m_controller.GetNanoVGContext(), &ascender, &descender, &lineh);
-        ascentsWorld.push_back(ascender * pxToWorld);
-        descentsWorld.push_back(-descender * pxToWorld);
-      }
-
-      float totalHeight = 0.0f;
-      for (size_t i = 0; i < lineHeightsWorld.size(); ++i) {
-        totalHeight += lineHeightsWorld[i];
-        if (i + 1 < lineHeightsWorld.size())
-          totalHeight += lineSpacingWorld;
-      }
+      const float lineSpacingWorld = LABEL_LINE_SPACING_2D * pxToWorld;
+      const float totalHeight = layout.totalHeight * pxToWorld;
 
       auto toPlan2D = [](double px, double py, double pz, Viewer2DView labelView) {
         switch (labelView) {
@@ -636,15 +769,23 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
         return std::array<float, 2>{static_cast<float>(px), static_cast<float>(py)};
       };
 
-      auto canvasAnchor = toPlan2D(wx, wy, wz, view);
+      // Screen y grows downwards while the plan's y grows upwards. The bottom
+      // camera looks up from below, so its screen x runs along -X while the
+      // plan keeps +X.
+      auto canvasAnchor = toPlan2D(label.wx, label.wy, label.wz, view);
+      const float canvasOffsetX =
+          view == Viewer2DView::Bottom ? -std::lround(offsetX)
+                                       : std::lround(offsetX);
+      canvasAnchor[0] += canvasOffsetX * pxToWorld;
+      canvasAnchor[1] -= std::lround(offsetY) * pxToWorld;
       float currentY = canvasAnchor[1] + totalHeight * 0.5f;
       for (size_t i = 0; i < lines.size(); ++i) {
         CanvasTextStyle style;
         style.fontFamily = lines[i].fontFamily;
-        style.fontSize = worldFontSizes[i];
-        style.ascent = ascentsWorld[i];
-        style.descent = descentsWorld[i];
-        style.lineHeight = lineHeightsWorld[i];
+        style.fontSize = lines[i].size * pxToWorld;
+        style.ascent = lines[i].ascender * pxToWorld;
+        style.descent = -lines[i].descender * pxToWorld;
+        style.lineHeight = lines[i].height * pxToWorld;
         style.extraLineSpacing = lineSpacingWorld;
         style.color = {0.0f, 0.0f, 0.0f, 1.0f};
         style.outlineColor = {1.0f, 1.0f, 1.0f, 1.0f};
@@ -662,7 +803,7 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
         }
         m_controller.RecordText(canvasAnchor[0], baseline, lines[i].text, style);
         if (i + 1 < lines.size())
-          currentY -= lineHeightsWorld[i] + lineSpacingWorld;
+          currentY -= style.lineHeight + lineSpacingWorld;
       }
     }
 
@@ -672,8 +813,20 @@ void LabelRenderSystem::DrawAllFixtureLabels(int width, int height,
     NVGcolor outlineColor =
         m_controller.IsDarkMode() ? nvgRGBAf(0.f, 0.f, 0.f, 1.f)
                                 : nvgRGBAf(1.f, 1.f, 1.f, 1.f);
-    DrawLabelLines2D(m_controller.GetNanoVGContext(), lines, x, y, textColor, outlineColor,
-                     true);
+    DrawLabelLines2D(m_controller.GetNanoVGContext(), layout, x, y, textColor,
+                     outlineColor, true);
+  }
+
+  // Forget labels of fixtures that were deleted or have not been drawn for
+  // a while, once the cache has clearly outgrown the scene.
+  if (m_fixtureLabelLayouts.size() > 2 * fixtures.size() + 64) {
+    for (auto it = m_fixtureLabelLayouts.begin();
+         it != m_fixtureLabelLayouts.end();) {
+      if (it->second.lastUsedPass != m_labelPass)
+        it = m_fixtureLabelLayouts.erase(it);
+      else
+        ++it;
+    }
   }
 }
 
@@ -683,12 +836,13 @@ void LabelRenderSystem::DrawTrussLabels(int width, int height) {
   FillProjectionContext(width, height, projection);
 
   const auto hiddenLayers = SnapshotHiddenLayers(cfg);
-  const CullingSettings culling = GetCullingSettings(cfg);
+  const CullingSettings culling = GetCullingSettings(cfg, *m_prefs);
   const float minLabelPixels = culling.minPixels3D;
+  const auto &prefs = *m_prefs;
   const bool useLabelOptimizations =
-      cfg.GetFloat("label_optimizations_enabled") >= 0.5f;
+      cfg.GetFloat(prefs.optimizationsEnabled) >= 0.5f;
   int labelsDrawn = 0;
-  const int maxLabels = GetLabelLimit(cfg, "label_max_trusses");
+  const int maxLabels = GetLabelLimit(cfg, prefs.maxTrusses);
   const auto &trusses = SceneDataManager::Instance().GetTrusses();
 
   const auto &visibleSet = m_controller.GetVisibleSet(
@@ -741,12 +895,13 @@ void LabelRenderSystem::DrawSceneObjectLabels(int width, int height) {
   FillProjectionContext(width, height, projection);
 
   const auto hiddenLayers = SnapshotHiddenLayers(cfg);
-  const CullingSettings culling = GetCullingSettings(cfg);
+  const CullingSettings culling = GetCullingSettings(cfg, *m_prefs);
   const float minLabelPixels = culling.minPixels3D;
+  const auto &prefs = *m_prefs;
   const bool useLabelOptimizations =
-      cfg.GetFloat("label_optimizations_enabled") >= 0.5f;
+      cfg.GetFloat(prefs.optimizationsEnabled) >= 0.5f;
   int labelsDrawn = 0;
-  const int maxLabels = GetLabelLimit(cfg, "label_max_objects");
+  const int maxLabels = GetLabelLimit(cfg, prefs.maxObjects);
   const auto &objects = SceneDataManager::Instance().GetSceneObjects();
 
   const auto &visibleSet = m_controller.GetVisibleSet(
@@ -1,12 +1,21 @@
 #pragma once
 
 #include "iselectioncontext.h"
+#include "label_placement.h"
 #include "viewer3d_types.h"
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct LabelPreferenceHandles;
+
 class LabelRenderSystem {
 public:
-  explicit LabelRenderSystem(ISelectionContext &controller)
-      : m_controller(controller) {}
+  explicit LabelRenderSystem(ISelectionContext &controller);
+  ~LabelRenderSystem();
 
   void DrawFixtureLabels(int width, int height);
   void DrawTrussLabels(int width, int height);
@@ -14,6 +23,47 @@ public:
   void DrawAllFixtureLabels(int width, int height, Viewer2DView view,
                             float zoom);
 
+  // One text line of a 2D fixture label with its measured extents in
+  // pixels.
+  struct LabelLine {
+    int font = -1;
+    std::string text;
+    float size = 0.0f;
+    std::string fontFamily;
+    float width = 0.0f;
+    float height = 0.0f;
+    float ascender = 0.0f;
+    float descender = 0.0f;
+  };
+
+  // Wrapped and measured 2D label of one fixture. It is rebuilt only when
+  // the inputs below change, so panning just projects and draws it.
+  struct FixtureLabelLayout {
+    std::string name;
+    int fixtureId = 0;
+    std::string address;
+    bool showName = false;
+    bool showId = false;
+    bool showDmx = false;
+    float nameSize = 0.0f;
+    float idSize = 0.0f;
+    float dmxSize = 0.0f;
+    int font = -1;
+    int boldFont = -1;
+
+    std::vector<LabelLine> lines;
+    float width = 0.0f;       // pixels, widest line
+    float totalHeight = 0.0f; // pixels, including line spacing
+    uint64_t lastUsedPass = 0;
+  };
+
 private:
   ISelectionContext &m_controller;
+  std::unique_ptr<const LabelPreferenceHandles> m_prefs;
+  std::unordered_map<std::string, FixtureLabelLayout> m_fixtureLabelLayouts;
+  uint64_t m_labelPass = 0;
+
+  LabelPlacementEngine m_labelPlacement;
+  std::vector<LabelPlacementEngine::Request> m_placementRequests;
+  std::vector<LabelPlacementEngine::Placement> m_placements;
 };
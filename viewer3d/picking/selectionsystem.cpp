@@ -44,8 +44,9 @@ bool IsLayerVisibleCached(const std::unordered_set<std::string> &hidden,
   return hidden.find(layer) == hidden.end();
 }
 
-bool IsFastInteractionModeEnabled(const ConfigManager &cfg) {
-  return cfg.GetFloat("viewer3d_fast_interaction_mode") >= 0.5f;
+bool IsFastInteractionModeEnabled(const ConfigManager &cfg,
+                                  ConfigManager::FloatHandle handle) {
+  return cfg.GetFloat(handle) >= 0.5f;
 }
 
 std::string FormatMeters(float mm) {
@@ -57,6 +58,15 @@ std::string FormatMeters(float mm) {
 
 } // namespace
 
+SelectionSystem::SelectionSystem(ISelectionContext &controller)
+    : m_controller(controller) {
+  const ConfigManager &cfg = ConfigManager::Get();
+  m_fastInteractionMode = cfg.ResolveFloat("viewer3d_fast_interaction_mode");
+  m_labelHandles = {cfg.ResolveFloat("label_show_name"),
+                    cfg.ResolveFloat("label_show_id"),
+                    cfg.ResolveFloat("label_show_dmx")};
+}
+
 void SelectionSystem::SetHighlightUuid(const std::string &uuid) {
   m_controller.ApplyHighlightUuid(uuid);
 }
@@ -70,7 +80,7 @@ bool SelectionSystem::GetFixtureLabelAt(int mouseX, int mouseY, int width,
                                         wxPoint &outPos,
                                         std::string *outUuid) {
   ConfigManager &cfg = ConfigManager::Get();
-  if (m_controller.IsCameraMoving() && IsFastInteractionModeEnabled(cfg))
+  if (m_controller.IsCameraMoving() && IsFastInteractionModeEnabled(cfg, m_fastInteractionMode))
     return false;
 
   double model[16];
@@ -80,9 +90,9 @@ bool SelectionSystem::GetFixtureLabelAt(int mouseX, int mouseY, int width,
   glGetDoublev(GL_PROJECTION_MATRIX, proj);
   glGetIntegerv(GL_VIEWPORT, viewport);
   const auto hiddenLayers = SnapshotHiddenLayers(cfg);
-  bool showName = cfg.GetFloat("label_show_name") != 0.0f;
-  bool showId = cfg.GetFloat("label_show_id") != 0.0f;
-  bool showDmx = cfg.GetFloat("label_show_dmx") != 0.0f;
+  bool showName = cfg.GetFloat(m_labelHandles[0]) != 0.0f;
+  bool showId = cfg.GetFloat(m_labelHandles[1]) != 0.0f;
+  bool showDmx = cfg.GetFloat(m_labelHandles[2]) != 0.0f;
 
   const auto &fixtures = SceneDataManager::Instance().GetFixtures();
 
@@ -176,7 +186,7 @@ bool SelectionSystem::GetTrussLabelAt(int mouseX, int mouseY, int width,
                                       wxPoint &outPos,
                                       std::string *outUuid) {
   ConfigManager &cfg = ConfigManager::Get();
-  if (m_controller.IsCameraMoving() && IsFastInteractionModeEnabled(cfg))
+  if (m_controller.IsCameraMoving() && IsFastInteractionModeEnabled(cfg, m_fastInteractionMode))
     return false;
 
   double model[16];
@@ -265,7 +275,7 @@ bool SelectionSystem::GetSceneObjectLabelAt(int mouseX, int mouseY, int width,
                                             wxPoint &outPos,
                                             std::string *outUuid) {
   ConfigManager &cfg = ConfigManager::Get();
-  if (m_controller.IsCameraMoving() && IsFastInteractionModeEnabled(cfg))
+  if (m_controller.IsCameraMoving() && IsFastInteractionModeEnabled(cfg, m_fastInteractionMode))
     return false;
 
   double model[16];
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "configmanager.h"
 #include "iselectioncontext.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <wx/gdicmn.h>
@@ -8,7 +10,7 @@
 
 class SelectionSystem {
 public:
-  explicit SelectionSystem(ISelectionContext &controller) : m_controller(controller) {}
+  explicit SelectionSystem(ISelectionContext &controller);
 
   void SetHighlightUuid(const std::string &uuid);
   void SetSelectedUuids(const std::vector<std::string> &uuids);
@@ -34,4 +36,7 @@ public:
 
 private:
   ISelectionContext &m_controller;
+  // Preferences read on every hover, resolved once at construction.
+  ConfigManager::FloatHandle m_fastInteractionMode;
+  std::array<ConfigManager::FloatHandle, 3> m_labelHandles;
 };
@@ -135,6 +135,8 @@ void DrawWireframeCube(float size, float r, float g, float b,
   stroke.width = lineWidth;
   if (captureCanvas && recordCapture)
     RecordBoxEdges(x0, x1, y0, y1, z0, z1, captureTransform, stroke, recordLine);
+  if (captureOnly)
+    return;
 
   glLineWidth(1.0f);
   if (mode != Viewer2DRenderMode::Wireframe) {
@@ -33,8 +33,11 @@ void OpaqueFixturePass::Render(
 
   const auto &fixtures = SceneDataManager::Instance().GetFixtures();
 
-  glShadeModel(GL_FLAT);
-  const bool forceFixturesOnTop = wireframe;
+  // Capture-only frames record into the 2D canvas and must not touch GL.
+  const bool drawGL = !controller.m_captureOnly;
+  if (drawGL)
+    glShadeModel(GL_FLAT);
+  const bool forceFixturesOnTop = wireframe && drawGL;
   GLboolean depthEnabled = GL_FALSE;
   if (forceFixturesOnTop) {
     depthEnabled = glIsEnabled(GL_DEPTH_TEST);
@@ -46,7 +49,8 @@ void OpaqueFixturePass::Render(
     if (fixtureIt == fixtures.end())
       continue;
     const auto &f = fixtureIt->second;
-    glPushMatrix();
+    if (drawGL)
+      glPushMatrix();
 
     std::string fixtureCaptureKey;
     if (controller.m_captureCanvas && !skipCapture) {
@@ -169,7 +173,7 @@ void OpaqueFixturePass::Render(
                     partB = 0.35f;
                   }
                   controller.DrawMeshWithOutline(
-                      obj.mesh, partR, partG, partB, RENDER_SCALE, false, false,
+                      *obj.mesh, partR, partG, partB, RENDER_SCALE, false, false,
                       0.0f, 0.0f, 0.0f, wireframe, mode, applyCapture, false);
                   ++partIndex;
                 }
@@ -204,7 +208,8 @@ void OpaqueFixturePass::Render(
       if (itg != controller.m_resourceSyncState.loadedGdtf.end()) {
         size_t partIndex = 0;
         for (const auto &obj : itg->second) {
-          glPushMatrix();
+          if (!controller.m_captureOnly)
+            glPushMatrix();
           if (controller.m_captureCanvas && !skipCapture) {
             controller.m_captureCanvas->SetSourceKey(
                 fixtureCaptureKey + "_part" + std::to_string(partIndex));
@@ -227,11 +232,12 @@ void OpaqueFixturePass::Render(
             partB = 0.35f;
           }
           const bool drawUnlit = !is2DViewer && obj.isLens;
-          controller.DrawMeshWithOutline(obj.mesh, partR, partG, partB,
+          controller.DrawMeshWithOutline(*obj.mesh, partR, partG, partB,
                                          RENDER_SCALE, highlight, selected, cx,
                                          cy, cz, wireframe, mode, applyCapture,
                                          drawUnlit);
-          glPopMatrix();
+          if (!controller.m_captureOnly)
+            glPopMatrix();
           ++partIndex;
         }
       } else {
@@ -241,7 +247,11 @@ void OpaqueFixturePass::Render(
       }
     };
 
-    if (placedInstance) {
+    if (!placedInstance) {
+      drawFixtureGeometry();
+    } else if (drawGL) {
+      // The symbol instance already recorded the geometry; only the
+      // on-screen copy is left to draw.
       ICanvas2D *prevCanvas = controller.m_captureCanvas;
       bool prevCaptureOnly = controller.m_captureOnly;
       controller.m_captureCanvas = nullptr;
@@ -249,11 +259,10 @@ void OpaqueFixturePass::Render(
       drawFixtureGeometry();
       controller.m_captureCanvas = prevCanvas;
       controller.m_captureOnly = prevCaptureOnly;
-    } else {
-      drawFixtureGeometry();
     }
 
-    glPopMatrix();
+    if (drawGL)
+      glPopMatrix();
 
     if (controller.m_captureCanvas && !skipCapture)
       controller.m_captureCanvas->SetSourceKey("unknown");
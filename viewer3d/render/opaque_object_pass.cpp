@@ -31,13 +31,17 @@ void OpaqueObjectPass::Render(
 
   const auto &sceneObjects = SceneDataManager::Instance().GetSceneObjects();
 
-  glShadeModel(GL_FLAT);
+  // Capture-only frames record into the 2D canvas and must not touch GL.
+  const bool drawGL = !controller.m_captureOnly;
+  if (drawGL)
+    glShadeModel(GL_FLAT);
   for (const auto &uuid : visibleSet.objectUuids) {
     auto sceneIt = sceneObjects.find(uuid);
     if (sceneIt == sceneObjects.end())
       continue;
     const auto &m = sceneIt->second;
-    glPushMatrix();
+    if (drawGL)
+      glPushMatrix();
 
     std::string objectCaptureKey;
     if (controller.m_captureCanvas && !skipCapture) {
@@ -157,7 +161,8 @@ void OpaqueObjectPass::Render(
 
               float localMatrix[16];
               MatrixToArray(part.localTransform, localMatrix);
-              glPushMatrix();
+              if (!controller.m_captureOnly)
+                glPushMatrix();
               controller.ApplyTransform(localMatrix, false);
               auto partCaptureTransform = captureTransformFn;
               if (captureTransformFn)
@@ -170,7 +175,8 @@ void OpaqueObjectPass::Render(
                                              cz, wireframe, mode,
                                              partCaptureTransform, false,
                                              partMatrix);
-              glPopMatrix();
+              if (!controller.m_captureOnly)
+                glPopMatrix();
             }
           } else {
             controller.DrawCubeWithOutline(0.3f, r, g, b, isHighlighted,
@@ -244,7 +250,11 @@ void OpaqueObjectPass::Render(
       }
     }
 
-    if (placedInstance) {
+    if (!placedInstance) {
+      drawSceneObjectGeometry(applyCapture, highlight, selected);
+    } else if (drawGL) {
+      // The symbol instance already recorded the geometry; only the
+      // on-screen copy is left to draw.
       ICanvas2D *prevCanvas = controller.m_captureCanvas;
       bool prevCaptureOnly = controller.m_captureOnly;
       controller.m_captureCanvas = nullptr;
@@ -252,10 +262,9 @@ void OpaqueObjectPass::Render(
       drawSceneObjectGeometry(applyCapture, highlight, selected);
       controller.m_captureCanvas = prevCanvas;
       controller.m_captureOnly = prevCaptureOnly;
-    } else {
-      drawSceneObjectGeometry(applyCapture, highlight, selected);
     }
 
-    glPopMatrix();
+    if (drawGL)
+      glPopMatrix();
   }
 }
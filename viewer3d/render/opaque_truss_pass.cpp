@@ -33,13 +33,17 @@ void OpaqueTrussPass::Render(
 
   const auto &trusses = SceneDataManager::Instance().GetTrusses();
 
-  glShadeModel(GL_SMOOTH);
+  // Capture-only frames record into the 2D canvas and must not touch GL.
+  const bool drawGL = !controller.m_captureOnly;
+  if (drawGL)
+    glShadeModel(GL_SMOOTH);
   for (const auto &uuid : visibleSet.trussUuids) {
     auto trussIt = trusses.find(uuid);
     if (trussIt == trusses.end())
       continue;
     const auto &t = trussIt->second;
-    glPushMatrix();
+    if (drawGL)
+      glPushMatrix();
 
     std::string trussCaptureKey;
     if (controller.m_captureCanvas && !skipCapture) {
@@ -194,7 +198,11 @@ void OpaqueTrussPass::Render(
       }
     }
 
-    if (placedInstance) {
+    if (!placedInstance) {
+      drawTrussGeometry(applyCapture, highlight, selected);
+    } else if (drawGL) {
+      // The symbol instance already recorded the geometry; only the
+      // on-screen copy is left to draw.
       ICanvas2D *prevCanvas = controller.m_captureCanvas;
       bool prevCaptureOnly = controller.m_captureOnly;
       controller.m_captureCanvas = nullptr;
@@ -202,10 +210,9 @@ void OpaqueTrussPass::Render(
       drawTrussGeometry(applyCapture, highlight, selected);
       controller.m_captureCanvas = prevCanvas;
       controller.m_captureOnly = prevCaptureOnly;
-    } else {
-      drawTrussGeometry(applyCapture, highlight, selected);
     }
 
-    glPopMatrix();
+    if (drawGL)
+      glPopMatrix();
   }
 }
@@ -151,7 +151,8 @@ void SceneRenderer::DrawMeshWireframe(
     const Mesh &mesh, float scale,
     const std::function<std::array<float, 3>(const std::array<float, 3> &)> &
         captureTransform) {
-  const bool gpuHandlesValid = glIsBuffer(mesh.vboVertices) == GL_TRUE &&
+  const bool gpuHandlesValid = !m_controller.IsCaptureOnly() &&
+                               glIsBuffer(mesh.vboVertices) == GL_TRUE &&
                                glIsBuffer(mesh.eboLines) == GL_TRUE &&
                                glIsBuffer(mesh.eboTriangles) == GL_TRUE;
   const bool canUseGpuWireframe =
@@ -230,6 +231,10 @@ void SceneRenderer::DrawMeshWireframe(
 }
 
 void SceneRenderer::DrawMesh(const Mesh &mesh, float scale, const float *modelMatrix) {
+  // Solid meshes are never recorded, so a capture-only frame skips them.
+  if (m_controller.IsCaptureOnly())
+    return;
+
   const GLboolean cullWasEnabled = glIsEnabled(GL_CULL_FACE);
   if (cullWasEnabled)
     glDisable(GL_CULL_FACE);
@@ -392,6 +397,12 @@ void SceneRenderer::DrawGrid(int style, float r, float g, float b,
   const float size = 20.0f;
   const float step = 1.0f;
 
+  const bool drawGL = !m_controller.IsCaptureOnly();
+  const bool record =
+      m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid();
+  if (!drawGL && !record)
+    return;
+
   const LineRenderProfile profile =
       GetLineRenderProfile(m_controller.IsInteracting(), true,
                            m_controller.UseAdaptiveLineProfile());
@@ -399,126 +410,91 @@ void SceneRenderer::DrawGrid(int style, float r, float g, float b,
   stroke.color = {r, g, b, 1.0f};
   stroke.width = profile.lineWidth;
 
-  const GLboolean lineSmoothWasEnabled = glIsEnabled(GL_LINE_SMOOTH);
-  if (profile.enableLineSmoothing)
-    glEnable(GL_LINE_SMOOTH);
-  else
-    glDisable(GL_LINE_SMOOTH);
+  // Maps grid coordinates to the principal plane facing the view.
+  auto toWorld = [view](float u, float v) -> std::array<float, 3> {
+    switch (view) {
+    case Viewer2DView::Front:
+      return {u, 0.0f, v};
+    case Viewer2DView::Side:
+      return {0.0f, u, v};
+    case Viewer2DView::Top:
+    case Viewer2DView::Bottom:
+    default:
+      return {u, v, 0.0f};
+    }
+  };
+  auto segment = [&](float u0, float v0, float u1, float v1) {
+    const auto p0 = toWorld(u0, v0);
+    const auto p1 = toWorld(u1, v1);
+    if (drawGL) {
+      glVertex3f(p0[0], p0[1], p0[2]);
+      glVertex3f(p1[0], p1[1], p1[2]);
+    }
+    if (record)
+      m_controller.RecordLine(p0, p1, stroke);
+  };
+
+  GLboolean lineSmoothWasEnabled = GL_FALSE;
+  if (drawGL) {
+    lineSmoothWasEnabled = glIsEnabled(GL_LINE_SMOOTH);
+    if (profile.enableLineSmoothing)
+      glEnable(GL_LINE_SMOOTH);
+    else
+      glDisable(GL_LINE_SMOOTH);
+    m_controller.SetGLColor(r, g, b);
+  }
 
-  m_controller.SetGLColor(r, g, b);
   if (style == 0) {
-    glLineWidth(profile.lineWidth);
-    glBegin(GL_LINES);
+    if (drawGL) {
+      glLineWidth(profile.lineWidth);
+      glBegin(GL_LINES);
+    }
     for (float i = -size; i <= size; i += step) {
-      switch (view) {
-      case Viewer2DView::Top:
-      case Viewer2DView::Bottom:
-        glVertex3f(i, -size, 0.0f);
-        glVertex3f(i, size, 0.0f);
-        glVertex3f(-size, i, 0.0f);
-        glVertex3f(size, i, 0.0f);
-        if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid()) {
-          m_controller.RecordLine({i, -size, 0.0f}, {i, size, 0.0f}, stroke);
-          m_controller.RecordLine({-size, i, 0.0f}, {size, i, 0.0f}, stroke);
-        }
-        break;
-      case Viewer2DView::Front:
-        glVertex3f(i, 0.0f, -size);
-        glVertex3f(i, 0.0f, size);
-        glVertex3f(-size, 0.0f, i);
-        glVertex3f(size, 0.0f, i);
-        if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid()) {
-          m_controller.RecordLine({i, 0.0f, -size}, {i, 0.0f, size}, stroke);
-          m_controller.RecordLine({-size, 0.0f, i}, {size, 0.0f, i}, stroke);
-        }
-        break;
-      case Viewer2DView::Side:
-        glVertex3f(0.0f, i, -size);
-        glVertex3f(0.0f, i, size);
-        glVertex3f(0.0f, -size, i);
-        glVertex3f(0.0f, size, i);
-        if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid()) {
-          m_controller.RecordLine({0.0f, i, -size}, {0.0f, i, size}, stroke);
-          m_controller.RecordLine({0.0f, -size, i}, {0.0f, size, i}, stroke);
-        }
-        break;
-      }
+      segment(i, -size, i, size);
+      segment(-size, i, size, i);
     }
-    glEnd();
+    if (drawGL)
+      glEnd();
   } else if (style == 1) {
-    GLboolean pointSmooth = glIsEnabled(GL_POINT_SMOOTH);
-    glDisable(GL_POINT_SMOOTH);
-    glPointSize(2.0f);
-    glBegin(GL_POINTS);
+    GLboolean pointSmooth = GL_FALSE;
+    if (drawGL) {
+      pointSmooth = glIsEnabled(GL_POINT_SMOOTH);
+      glDisable(GL_POINT_SMOOTH);
+      glPointSize(2.0f);
+      glBegin(GL_POINTS);
+    }
     for (float x = -size; x <= size; x += step) {
       for (float y = -size; y <= size; y += step) {
-        switch (view) {
-        case Viewer2DView::Top:
-        case Viewer2DView::Bottom:
-          glVertex3f(x, y, 0.0f);
-          if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid())
-            m_controller.RecordLine({x, y, 0.0f}, {x, y, 0.0f}, stroke);
-          break;
-        case Viewer2DView::Front:
-          glVertex3f(x, 0.0f, y);
-          if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid())
-            m_controller.RecordLine({x, 0.0f, y}, {x, 0.0f, y}, stroke);
-          break;
-        case Viewer2DView::Side:
-          glVertex3f(0.0f, x, y);
-          if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid())
-            m_controller.RecordLine({0.0f, x, y}, {0.0f, x, y}, stroke);
-          break;
-        }
+        const auto p = toWorld(x, y);
+        if (drawGL)
+          glVertex3f(p[0], p[1], p[2]);
+        if (record)
+          m_controller.RecordLine(p, p, stroke);
       }
     }
-    glEnd();
-    if (pointSmooth)
-      glEnable(GL_POINT_SMOOTH);
+    if (drawGL) {
+      glEnd();
+      if (pointSmooth)
+        glEnable(GL_POINT_SMOOTH);
+    }
   } else {
     float half = step * 0.1f;
-    glLineWidth(profile.lineWidth);
-    glBegin(GL_LINES);
+    if (drawGL) {
+      glLineWidth(profile.lineWidth);
+      glBegin(GL_LINES);
+    }
     for (float x = -size; x <= size; x += step) {
       for (float y = -size; y <= size; y += step) {
-        switch (view) {
-        case Viewer2DView::Top:
-        case Viewer2DView::Bottom:
-          glVertex3f(x - half, y, 0.0f);
-          glVertex3f(x + half, y, 0.0f);
-          glVertex3f(x, y - half, 0.0f);
-          glVertex3f(x, y + half, 0.0f);
-          if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid()) {
-            m_controller.RecordLine({x - half, y, 0.0f}, {x + half, y, 0.0f}, stroke);
-            m_controller.RecordLine({x, y - half, 0.0f}, {x, y + half, 0.0f}, stroke);
-          }
-          break;
-        case Viewer2DView::Front:
-          glVertex3f(x - half, 0.0f, y);
-          glVertex3f(x + half, 0.0f, y);
-          glVertex3f(x, 0.0f, y - half);
-          glVertex3f(x, 0.0f, y + half);
-          if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid()) {
-            m_controller.RecordLine({x - half, 0.0f, y}, {x + half, 0.0f, y}, stroke);
-            m_controller.RecordLine({x, 0.0f, y - half}, {x, 0.0f, y + half}, stroke);
-          }
-          break;
-        case Viewer2DView::Side:
-          glVertex3f(0.0f, x - half, y);
-          glVertex3f(0.0f, x + half, y);
-          glVertex3f(0.0f, x, y - half);
-          glVertex3f(0.0f, x, y + half);
-          if (m_controller.GetCaptureCanvas() && m_controller.CaptureIncludesGrid()) {
-            m_controller.RecordLine({0.0f, x - half, y}, {0.0f, x + half, y}, stroke);
-            m_controller.RecordLine({0.0f, x, y - half}, {0.0f, x, y + half}, stroke);
-          }
-          break;
-        }
+        segment(x - half, y, x + half, y);
+        segment(x, y - half, x, y + half);
       }
     }
-    glEnd();
+    if (drawGL)
+      glEnd();
   }
 
+  if (!drawGL)
+    return;
   if (lineSmoothWasEnabled)
     glEnable(GL_LINE_SMOOTH);
   else
@@ -114,6 +114,57 @@ void EnsureModelLoaded(const std::string &path, ResourceSyncState &state,
   }
 }
 
+// Drops uploads whose loader mesh has been freed. Their key address may be
+// reused by a new mesh, so they leave the map at once; buffers still drawn
+// by a loadedGdtf part wait in the retired list until nothing uses them.
+void PruneGdtfGpuMeshes(ResourceSyncState &state,
+                        const ResourceSyncCallbacks &callbacks) {
+  auto release = [&](std::shared_ptr<Mesh> &uploaded) {
+    if (uploaded.use_count() > 1)
+      return false;
+    if (callbacks.releaseMeshBuffers)
+      callbacks.releaseMeshBuffers(*uploaded);
+    return true;
+  };
+  for (auto it = state.gdtfGpuMeshes.begin(); it != state.gdtfGpuMeshes.end();) {
+    if (!it->second.source.expired()) {
+      ++it;
+      continue;
+    }
+    if (!release(it->second.uploaded))
+      state.retiredGdtfGpuMeshes.push_back(std::move(it->second.uploaded));
+    it = state.gdtfGpuMeshes.erase(it);
+  }
+  auto &retired = state.retiredGdtfGpuMeshes;
+  retired.erase(std::remove_if(retired.begin(), retired.end(), release),
+                retired.end());
+}
+
+// Points the parts at this viewer's uploaded copy of their mesh, uploading
+// each unique model the first time it is seen.
+void UseUploadedGdtfMeshes(std::vector<GdtfObject> &objects,
+                           ResourceSyncState &state,
+                           const ResourceSyncCallbacks &callbacks) {
+  if (!callbacks.setupMeshBuffers)
+    return;
+  PruneGdtfGpuMeshes(state, callbacks);
+  for (auto &obj : objects) {
+    if (!obj.mesh)
+      continue;
+    auto it = state.gdtfGpuMeshes.find(obj.mesh.get());
+    if (it == state.gdtfGpuMeshes.end()) {
+      auto uploaded = std::make_shared<Mesh>(*obj.mesh);
+      callbacks.setupMeshBuffers(*uploaded);
+      it = state.gdtfGpuMeshes
+               .emplace(obj.mesh.get(),
+                        ResourceSyncState::GdtfGpuMesh{obj.mesh,
+                                                       std::move(uploaded)})
+               .first;
+    }
+    obj.mesh = it->second.uploaded;
+  }
+}
+
 } // namespace
 
 ResourceSyncResult ResourceSyncSystem::Sync(
@@ -131,6 +182,17 @@ ResourceSyncResult ResourceSyncSystem::Sync(
         callbacks.releaseMeshBuffers(mesh);
     }
     state.loadedMeshes.clear();
+    for (auto &[source, gpuMesh] : state.gdtfGpuMeshes) {
+      (void)source;
+      if (callbacks.releaseMeshBuffers)
+        callbacks.releaseMeshBuffers(*gpuMesh.uploaded);
+    }
+    state.gdtfGpuMeshes.clear();
+    for (auto &uploaded : state.retiredGdtfGpuMeshes) {
+      if (callbacks.releaseMeshBuffers)
+        callbacks.releaseMeshBuffers(*uploaded);
+    }
+    state.retiredGdtfGpuMeshes.clear();
     state.loadedGdtf.clear();
     state.failedGdtfReasons.clear();
     state.reportedGdtfFailureCounts.clear();
@@ -139,6 +201,8 @@ ResourceSyncResult ResourceSyncSystem::Sync(
     state.resolvedModelRefs.clear();
     state.lastSceneBasePath = basePath;
     result.assetsChanged = true;
+  } else {
+    PruneGdtfGpuMeshes(state, callbacks);
   }
 
   size_t sceneSignature = HashString(basePath);
@@ -286,6 +350,7 @@ ResourceSyncResult ResourceSyncSystem::Sync(
       std::vector<GdtfObject> objs;
       std::string gdtfError;
       if (LoadGdtf(gdtfPath, objs, &gdtfError)) {
+        UseUploadedGdtfMeshes(objs, state, callbacks);
         state.loadedGdtf[gdtfPath] = std::move(objs);
         result.assetsChanged = true;
       } else {
@@ -7,6 +7,7 @@
 #include "truss.h"
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -20,6 +21,19 @@ struct ResourceSyncState {
 
   std::unordered_map<std::string, Mesh> loadedMeshes;
   std::unordered_map<std::string, std::vector<GdtfObject>> loadedGdtf;
+  // Models shared by the GDTF parts, uploaded once per unique mesh. The
+  // loader's meshes are shared between GL contexts, so each viewer keeps
+  // its own copy with buffers; loadedGdtf parts point at these copies.
+  // The source is held weakly so that meshes the loader drops can be
+  // released here too.
+  struct GdtfGpuMesh {
+    std::weak_ptr<const Mesh> source;
+    std::shared_ptr<Mesh> uploaded;
+  };
+  std::unordered_map<const Mesh *, GdtfGpuMesh> gdtfGpuMeshes;
+  // Uploads whose source is gone but which loadedGdtf parts still draw;
+  // their buffers are released once the last part lets go.
+  std::vector<std::shared_ptr<Mesh>> retiredGdtfGpuMeshes;
   std::unordered_map<std::string, std::string> failedGdtfReasons;
   std::unordered_map<std::string, size_t> reportedGdtfFailureCounts;
   std::unordered_map<std::string, std::string> reportedGdtfFailureReasons;
@@ -41,6 +41,7 @@
 #endif
 #include <cstdlib>
 #include <numeric>
+#include <utility>
 
 #include "configmanager.h"
 #include "loader3ds.h"
@@ -65,7 +66,9 @@
 #include "gl_primitive_renderer.h"
 
 #include <wx/wx.h>
-#define NANOVG_GL2_IMPLEMENTATION
+// Declarations only; the GL2 backend is compiled into nanovg_gl2.cpp, which
+// only the GUI links.
+#define NANOVG_GL2
 #include <algorithm>
 #include <bit>
 #include <array>
@@ -76,6 +79,7 @@
 #include <nanovg.h>
 #include <nanovg_gl.h>
 #include <cstdint>
+#include <optional>
 #include <string_view>
 #include <sstream>
 #include <unordered_map>
@@ -118,6 +122,7 @@ struct Viewer3DController::Impl {
   bool captureIncludeGrid = true;
   bool captureOnly = false;
   bool captureUseSymbols = false;
+  std::optional<std::unordered_set<std::string>> hiddenLayersOverride;
   SymbolCache bottomSymbolCache;
   bool darkMode = false;
   bool showSelectionOutline2D = false;
@@ -141,6 +146,10 @@ struct Viewer3DController::Impl {
   std::unique_ptr<VisibilitySystem> visibilitySystem;
   std::unique_ptr<SelectionSystem> selectionSystem;
   std::unique_ptr<LabelRenderSystem> labelRenderSystem;
+  // Preferences read on every frame, resolved once per controller.
+  ConfigManager::FloatHandle fastInteractionModePref;
+  std::array<ConfigManager::FloatHandle, 3> interactionPrefs;
+  std::array<ConfigManager::FloatHandle, 3> cullingPrefs;
 };
 
 struct LineRenderProfile {
@@ -148,9 +157,10 @@ struct LineRenderProfile {
   bool enableLineSmoothing = false;
 };
 
-static std::unordered_set<std::string>
-SnapshotHiddenLayers(const ConfigManager &cfg) {
-  return cfg.GetHiddenLayers();
+static std::unordered_set<std::string> SnapshotHiddenLayers(
+    const ConfigManager &cfg,
+    const std::optional<std::unordered_set<std::string>> &override) {
+  return override ? *override : cfg.GetHiddenLayers();
 }
 
 static bool IsLayerVisibleCached(const std::unordered_set<std::string> &hidden,
@@ -160,8 +170,9 @@ static bool IsLayerVisibleCached(const std::unordered_set<std::string> &hidden,
   return hidden.find(layer) == hidden.end();
 }
 
-static bool IsFastInteractionModeEnabled(const ConfigManager &cfg) {
-  return cfg.GetFloat("viewer3d_fast_interaction_mode") >= 0.5f;
+static bool IsFastInteractionModeEnabled(const ConfigManager &cfg,
+                                         ConfigManager::FloatHandle handle) {
+  return cfg.GetFloat(handle) >= 0.5f;
 }
 
 static LineRenderProfile GetLineRenderProfile(bool isInteracting,
@@ -451,11 +462,13 @@ struct CullingSettings {
   float minPixels2D = 1.0f;
 };
 
-static CullingSettings GetCullingSettings3D(const ConfigManager &cfg) {
+static CullingSettings GetCullingSettings3D(
+    const ConfigManager &cfg,
+    const std::array<ConfigManager::FloatHandle, 3> &handles) {
   CullingSettings s{};
-  s.enabled = cfg.GetFloat("render_culling_enabled") >= 0.5f;
-  s.minPixels3D = std::max(0.0f, cfg.GetFloat("render_culling_min_pixels_3d"));
-  s.minPixels2D = std::max(0.0f, cfg.GetFloat("render_culling_min_pixels_2d"));
+  s.enabled = cfg.GetFloat(handles[0]) >= 0.5f;
+  s.minPixels3D = std::max(0.0f, cfg.GetFloat(handles[1]));
+  s.minPixels2D = std::max(0.0f, cfg.GetFloat(handles[2]));
   return s;
 }
 
@@ -610,6 +623,16 @@ Viewer3DController::Viewer3DController()
   m_impl->visibilitySystem = std::make_unique<VisibilitySystem>(*this);
   m_impl->selectionSystem = std::make_unique<SelectionSystem>(*this);
   m_impl->labelRenderSystem = std::make_unique<LabelRenderSystem>(*this);
+  const ConfigManager &cfg = ConfigManager::Get();
+  m_impl->fastInteractionModePref =
+      cfg.ResolveFloat("viewer3d_fast_interaction_mode");
+  m_impl->interactionPrefs = {
+      cfg.ResolveFloat("viewer3d_adaptive_line_profile"),
+      cfg.ResolveFloat("viewer3d_skip_outlines_when_moving"),
+      cfg.ResolveFloat("viewer3d_skip_capture_when_moving")};
+  m_impl->cullingPrefs = {cfg.ResolveFloat("render_culling_enabled"),
+                          cfg.ResolveFloat("render_culling_min_pixels_3d"),
+                          cfg.ResolveFloat("render_culling_min_pixels_2d")};
   // Actual initialization of OpenGL-dependent resources is delayed
   // until a valid context is available.
 }
@@ -619,6 +642,12 @@ Viewer3DController::~Viewer3DController() {
     (void)path;
     ReleaseMeshBuffers(mesh);
   }
+  for (auto &[source, gpuMesh] : m_impl->resourceSyncState.gdtfGpuMeshes) {
+    (void)source;
+    ReleaseMeshBuffers(*gpuMesh.uploaded);
+  }
+  for (auto &uploaded : m_impl->resourceSyncState.retiredGdtfGpuMeshes)
+    ReleaseMeshBuffers(*uploaded);
   if (m_impl->vg)
     nvgDeleteGL2(m_impl->vg);
 }
@@ -762,7 +791,8 @@ void Viewer3DController::Update() {
 
 void Viewer3DController::UpdateFrameStateLightweight() {
   ConfigManager &cfg = ConfigManager::Get();
-  const auto hiddenLayers = SnapshotHiddenLayers(cfg);
+  const auto hiddenLayers =
+      SnapshotHiddenLayers(cfg, m_impl->hiddenLayersOverride);
   if (hiddenLayers != m_impl->lastHiddenLayers) {
     Logger::Instance().Log("visibility dirty reason: hidden layers changed vs last frame snapshot");
     m_impl->visibilityChangedDirty = true;
@@ -781,8 +811,9 @@ void Viewer3DController::UpdateResourcesIfDirty() {
   ++m_impl->updateResourcesCallsPerFrame;
 
   ConfigManager &cfg = ConfigManager::Get();
-  const auto hiddenLayers = SnapshotHiddenLayers(cfg);
-  const std::string &base = cfg.GetScene().basePath;
+  const auto hiddenLayers =
+      SnapshotHiddenLayers(cfg, m_impl->hiddenLayersOverride);
+  const std::string &base = std::as_const(cfg).GetScene().basePath;
 
   const auto &trusses = SceneDataManager::Instance().GetTrusses();
   const auto &objects = SceneDataManager::Instance().GetSceneObjects();
@@ -808,12 +839,22 @@ void Viewer3DController::UpdateResourcesIfDirty() {
   }
 
   ResourceSyncCallbacks callbacks;
-  callbacks.setupMeshBuffers = [this](Mesh &mesh) { SetupMeshBuffers(mesh); };
-  callbacks.releaseMeshBuffers = [this](Mesh &mesh) { ReleaseMeshBuffers(mesh); };
-  callbacks.appendConsoleMessage = [](const std::string &msg) {
-    if (ConsolePanel::Instance())
-      ConsolePanel::Instance()->AppendMessage(wxString::FromUTF8(msg));
-  };
+  if (m_impl->captureOnly) {
+    // No GL context and possibly no UI thread: meshes stay on the CPU, where
+    // they are only recorded, and messages go to the log.
+    callbacks.appendConsoleMessage = [](const std::string &msg) {
+      Logger::Instance().Log(msg);
+    };
+  } else {
+    callbacks.setupMeshBuffers = [this](Mesh &mesh) { SetupMeshBuffers(mesh); };
+    callbacks.releaseMeshBuffers = [this](Mesh &mesh) {
+      ReleaseMeshBuffers(mesh);
+    };
+    callbacks.appendConsoleMessage = [](const std::string &msg) {
+      if (ConsolePanel::Instance())
+        ConsolePanel::Instance()->AppendMessage(wxString::FromUTF8(msg));
+    };
+  }
 
   const ResourceSyncResult syncResult = ResourceSyncSystem::Sync(
       base, visibleTrusses, visibleObjects, visibleFixtures,
@@ -889,15 +930,17 @@ void Viewer3DController::RenderScene(bool wireframe, Viewer2DRenderMode mode,
   context.gridOnTop = gridOnTop;
   context.is2DViewer = is2DViewer;
 
+  const auto &interactionHandles = m_impl->interactionPrefs;
   m_impl->useAdaptiveLineProfile =
-      cfg.GetFloat("viewer3d_adaptive_line_profile") >= 0.5f;
+      cfg.GetFloat(interactionHandles[0]) >= 0.5f;
 
   const bool skipOutlinesWhenMoving =
-      cfg.GetFloat("viewer3d_skip_outlines_when_moving") >= 0.5f;
+      cfg.GetFloat(interactionHandles[1]) >= 0.5f;
   const bool skipCaptureWhenMoving =
-      cfg.GetFloat("viewer3d_skip_capture_when_moving") >= 0.5f;
+      cfg.GetFloat(interactionHandles[2]) >= 0.5f;
 
-  context.fastInteractionMode = IsFastInteractionModeEnabled(cfg);
+  context.fastInteractionMode =
+      IsFastInteractionModeEnabled(cfg, m_impl->fastInteractionModePref);
 
   // During camera movement we prioritize frame pacing: keep drawing the
   // scene and camera updates, but defer optional CPU/GPU work until the
@@ -919,7 +962,8 @@ void Viewer3DController::RenderScene(bool wireframe, Viewer2DRenderMode mode,
   (void)isSideView;
   (void)isBottomView;
 
-  const CullingSettings culling = GetCullingSettings3D(cfg);
+  const CullingSettings culling =
+      GetCullingSettings3D(cfg, m_impl->cullingPrefs);
 
   // 2D orthographic projections use a very different depth setup than the 3D
   // camera, and the frustum/pixel culling pass can incorrectly reject every
@@ -955,7 +999,8 @@ void Viewer3DController::RenderScene(bool wireframe, Viewer2DRenderMode mode,
   (void)isWireframeMode;
   (void)isWhiteMode;
 
-  const auto hiddenLayers = SnapshotHiddenLayers(cfg);
+  const auto hiddenLayers =
+      SnapshotHiddenLayers(cfg, m_impl->hiddenLayersOverride);
   context.hiddenLayers = hiddenLayers;
 
   RenderPipeline pipeline(*this);
@@ -1027,10 +1072,12 @@ void Viewer3DController::RenderOpaqueFrame(const RenderFrameContext &context,
   const Viewer2DRenderMode mode = context.mode;
   const Viewer2DView view = context.view;
 
-  if (context.useLighting)
-    SetupBasicLighting();
-  else
-    glDisable(GL_LIGHTING);
+  if (!m_impl->captureOnly) {
+    if (context.useLighting)
+      SetupBasicLighting();
+    else
+      glDisable(GL_LIGHTING);
+  }
 
   if (context.drawGridBeforeScene)
     DrawGrid(context.gridStyle, context.gridR, context.gridG, context.gridB,
@@ -1083,10 +1130,12 @@ void Viewer3DController::RenderOverlayFrame(const RenderFrameContext &context,
                                             const VisibleSet &visibleSet) {
   (void)visibleSet;
   if (context.drawGridAfterScene) {
-    glDisable(GL_DEPTH_TEST);
+    if (!m_impl->captureOnly)
+      glDisable(GL_DEPTH_TEST);
     DrawGrid(context.gridStyle, context.gridR, context.gridG, context.gridB,
              context.view);
-    glEnable(GL_DEPTH_TEST);
+    if (!m_impl->captureOnly)
+      glEnable(GL_DEPTH_TEST);
   }
 
   DrawAxes();
@@ -1123,6 +1172,15 @@ void Viewer3DController::SetCaptureCanvas(ICanvas2D *canvas, Viewer2DView view,
   m_impl->captureUseSymbols = canvas ? useSymbolInstancing : false;
 }
 
+void Viewer3DController::SetCaptureOnly(bool captureOnly) {
+  m_impl->captureOnly = captureOnly;
+}
+
+void Viewer3DController::SetHiddenLayersOverride(
+    std::optional<std::unordered_set<std::string>> hiddenLayers) {
+  m_impl->hiddenLayersOverride = std::move(hiddenLayers);
+}
+
 bool Viewer3DController::IsCameraMoving() const { return m_impl->cameraMoving; }
 
 std::array<float, 3> Viewer3DController::AdjustColor(float r, float g,
@@ -1133,6 +1191,8 @@ std::array<float, 3> Viewer3DController::AdjustColor(float r, float g,
 }
 
 void Viewer3DController::SetGLColor(float r, float g, float b) const {
+  if (m_impl->captureOnly)
+    return;
   auto adjusted = AdjustColor(r, g, b);
   glColor3f(adjusted[0], adjusted[1], adjusted[2]);
 }
@@ -1323,6 +1383,19 @@ void Viewer3DController::ReleaseMeshBuffers(Mesh &mesh) {
 void Viewer3DController::DrawAxes() {
   const LineRenderProfile profile =
       GetLineRenderProfile(m_impl->isInteracting, false, m_impl->useAdaptiveLineProfile);
+  if (m_impl->captureCanvas) {
+    CanvasStroke stroke;
+    stroke.width = profile.lineWidth;
+    stroke.color = {1.0f, 0.0f, 0.0f, 1.0f};
+    RecordLine({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, stroke);
+    stroke.color = {0.0f, 1.0f, 0.0f, 1.0f};
+    RecordLine({0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, stroke);
+    stroke.color = {0.0f, 0.0f, 1.0f, 1.0f};
+    RecordLine({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, stroke);
+  }
+  if (m_impl->captureOnly)
+    return;
+
   const GLboolean lineSmoothWasEnabled = glIsEnabled(GL_LINE_SMOOTH);
   if (profile.enableLineSmoothing)
     glEnable(GL_LINE_SMOOTH);
@@ -1341,16 +1414,6 @@ void Viewer3DController::DrawAxes() {
   glVertex3f(0.0f, 0.0f, 0.0f);
   glVertex3f(0.0f, 0.0f, 1.0f); // Z
   glEnd();
-  if (m_impl->captureCanvas) {
-    CanvasStroke stroke;
-    stroke.width = profile.lineWidth;
-    stroke.color = {1.0f, 0.0f, 0.0f, 1.0f};
-    RecordLine({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, stroke);
-    stroke.color = {0.0f, 1.0f, 0.0f, 1.0f};
-    RecordLine({0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, stroke);
-    stroke.color = {0.0f, 0.0f, 1.0f, 1.0f};
-    RecordLine({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, stroke);
-  }
 
   if (lineSmoothWasEnabled)
     glEnable(GL_LINE_SMOOTH);
@@ -1363,6 +1426,8 @@ void Viewer3DController::DrawAxes() {
 // millimeters to meters using RENDER_SCALE.
 void Viewer3DController::ApplyTransform(const float matrix[16],
                                         bool scaleTranslation) {
+  if (m_impl->captureOnly)
+    return;
   float m[16];
   std::copy(matrix, matrix + 16, m);
   if (scaleTranslation) {
@@ -33,6 +33,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -128,6 +129,12 @@ public:
   void SetCaptureCanvas(ICanvas2D *canvas, Viewer2DView view,
                         bool includeGrid = true,
                         bool useSymbolInstancing = false);
+  // Records frames into the capture canvas only. The controller then makes
+  // no GL calls and keeps meshes on the CPU, so it can run without a context.
+  void SetCaptureOnly(bool captureOnly);
+  // Uses the given hidden layers instead of the ones in ConfigManager.
+  void SetHiddenLayersOverride(
+      std::optional<std::unordered_set<std::string>> hiddenLayers);
 
 private:
   struct Impl;
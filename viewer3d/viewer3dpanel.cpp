@@ -54,6 +54,7 @@
 #include <memory>
 #include <cmath>
 #include <set>
+#include <utility>
 
 wxDEFINE_EVENT(wxEVT_VIEWER_REFRESH, wxThreadEvent);
 wxBEGIN_EVENT_TABLE(Viewer3DPanel, wxGLCanvas)
@@ -614,7 +615,7 @@ void Viewer3DPanel::OnRightUp(wxMouseEvent& event)
         return;
     }
 
-    const auto& scene = ConfigManager::Get().GetScene();
+    const auto& scene = std::as_const(ConfigManager::Get()).GetScene();
     if (scene.fixtures.empty())
         return;
 
@@ -922,9 +923,8 @@ void Viewer3DPanel::OnMouseDClick(wxMouseEvent& event)
     else
         it->second.address.clear();
 
-    if (FixtureTablePanel::Instance()) {
-        FixtureTablePanel::Instance()->ReloadData();
-    }
+    ConfigManager::Get().NotifySceneChanged(SceneEntityKind::Fixture, {uuid},
+                                            SceneComponent::Patch);
 
     Refresh();
 }